@@ -0,0 +1,177 @@
+#include <sstream>
+
+#include "ityr/ityr.hpp"
+#include "ityr/autotune.hpp"
+
+/*
+ * Autotuning runtime options for a parallel sort over a global vector
+ *
+ * Each parameter given with `-p NAME=V1,V2,...` adds a runtime option and its candidate values to
+ * the search space. Without `-p`, options related to the software cache and the scheduler are tuned.
+ * The best configuration is written to an environment file, which can be loaded for later runs:
+ *   set -a; . ./ityr_autotune.env; set +a
+ */
+
+using elem_t = uint64_t;
+
+std::size_t n_input      = std::size_t(1) * 1024 * 1024;
+std::size_t cutoff_count = 4096;
+
+ityr::global_vector_options gvec_coll_opts(true, 1024);
+
+std::vector<ityr::autotune_param> params;
+ityr::autotune_options            tune_opts;
+
+double sort_kernel() {
+  std::size_t n = n_input;
+  std::size_t cutoff = cutoff_count;
+
+  ityr::global_vector<elem_t> v(gvec_coll_opts, n);
+  ityr::global_span<elem_t> s(v);
+
+  ityr::transform(
+      ityr::execution::parallel_policy(cutoff),
+      ityr::count_iterator<std::size_t>(0),
+      ityr::count_iterator<std::size_t>(n),
+      s.begin(),
+      [](std::size_t i) {
+        // splitmix64
+        uint64_t z = i + 0x9e3779b97f4a7c15;
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+        return z ^ (z >> 31);
+      });
+
+  auto t0 = ityr::gettime_ns();
+
+  ityr::sort(ityr::execution::parallel_policy(cutoff), s.begin(), s.end());
+
+  auto t1 = ityr::gettime_ns();
+
+  if (!ityr::is_sorted(ityr::execution::parallel_policy(cutoff), s.begin(), s.end())) {
+    printf("Wrong result: the global vector is not sorted\n");
+    exit(1);
+  }
+
+  return (t1 - t0) / 1000000000.0;
+}
+
+ityr::autotune_param parse_param(const std::string& arg) {
+  auto eq = arg.find('=');
+  if (eq == std::string::npos) {
+    printf("Invalid parameter '%s' (expected NAME=V1,V2,...)\n", arg.c_str());
+    exit(1);
+  }
+
+  ityr::autotune_param p;
+  p.name = arg.substr(0, eq);
+
+  std::stringstream ss(arg.substr(eq + 1));
+  std::string val;
+  while (std::getline(ss, val, ',')) {
+    p.values.push_back(val);
+  }
+  return p;
+}
+
+void show_help_and_exit(int argc [[maybe_unused]], char** argv) {
+  int rank;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  if (rank == 0) {
+    printf("Usage: %s [options]\n"
+           "  options:\n"
+           "    -n : Input size (size_t)\n"
+           "    -c : cutoff count for leaf tasks (size_t)\n"
+           "    -p : runtime option and its candidate values (NAME=V1,V2,...; can be repeated)\n"
+           "    -m : max # of configurations to be sampled (size_t)\n"
+           "    -r : # of kernel runs per configuration in the first round (int)\n"
+           "    -e : reduction factor of successive halving (int)\n"
+           "    -s : random seed for sampling configurations (uint64_t)\n"
+           "    -o : output environment file (string)\n", argv[0]);
+  }
+  exit(1);
+}
+
+int main(int argc, char** argv) {
+  // MPI must be kept initialized while Itoyori is initialized and finalized for each configuration
+  MPI_Init(&argc, &argv);
+
+  int opt;
+  while ((opt = getopt(argc, argv, "n:c:p:m:r:e:s:o:h")) != EOF) {
+    switch (opt) {
+      case 'n':
+        n_input = atol(optarg);
+        break;
+      case 'c':
+        cutoff_count = atol(optarg);
+        break;
+      case 'p':
+        params.push_back(parse_param(optarg));
+        break;
+      case 'm':
+        tune_opts.max_configs = atol(optarg);
+        break;
+      case 'r':
+        tune_opts.min_repeats = atoi(optarg);
+        break;
+      case 'e':
+        tune_opts.reduction_factor = atoi(optarg);
+        break;
+      case 's':
+        tune_opts.seed = atol(optarg);
+        break;
+      case 'o':
+        tune_opts.output_file = optarg;
+        break;
+      case 'h':
+      default:
+        show_help_and_exit(argc, argv);
+    }
+  }
+
+  if (tune_opts.min_repeats < 1 || tune_opts.reduction_factor < 2) {
+    show_help_and_exit(argc, argv);
+  }
+
+  if (params.empty()) {
+    params = {
+      {"ITYR_ORI_CACHE_SIZE"                 , {"16777216", "67108864", "268435456"}},
+      {"ITYR_ORI_SUB_BLOCK_SIZE"             , {"1024", "4096", "16384"}},
+      {"ITYR_ORI_MAX_DIRTY_CACHE_SIZE"       , {"4194304", "16777216"}},
+      {"ITYR_ORI_LAZY_RELEASE_CHECK_INTERVAL", {"10", "100"}},
+      {"ITYR_ITO_WSQUEUE_CAPACITY"           , {"1024", "4096"}},
+    };
+  }
+
+  int rank;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  if (rank == 0) {
+    printf("=============================================================\n"
+           "[Autotune]\n"
+           "N:                            %ld\n"
+           "Cutoff count:                 %ld\n"
+           "Max # of configurations:      %ld\n"
+           "Initial # of repeats:         %d\n"
+           "Reduction factor:             %d\n"
+           "Output file:                  %s\n"
+           "-------------------------------------------------------------\n",
+           n_input, cutoff_count, tune_opts.max_configs, tune_opts.min_repeats,
+           tune_opts.reduction_factor, tune_opts.output_file.c_str());
+
+    printf("[Search Space]\n");
+    for (auto&& p : params) {
+      printf("%s:", p.name.c_str());
+      for (auto&& v : p.values) {
+        printf(" %s", v.c_str());
+      }
+      printf("\n");
+    }
+    printf("=============================================================\n\n");
+    fflush(stdout);
+  }
+
+  ityr::autotune(params, sort_kernel, tune_opts);
+
+  MPI_Finalize();
+  return 0;
+}
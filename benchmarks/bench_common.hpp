@@ -0,0 +1,260 @@
+#pragma once
+
+#include <fstream>
+#include <sstream>
+#include <map>
+
+#include "ityr/ityr.hpp"
+
+/*
+ * Common harness for microbenchmarks
+ *
+ * Each benchmark collects latency samples (in ns per operation) in a process-local buffer.
+ * Because every process has its own copy of `local_samples`, threads can append samples on
+ * whichever process they are running. `report()` gathers the samples of all processes to rank 0,
+ * prints percentiles, and appends a row to the CSV file. If a baseline CSV file is given,
+ * the median latency is compared with the last baseline row of the same benchmark, parameter,
+ * and # of processes.
+ */
+
+namespace bench {
+
+inline const char* suite_name    = "";
+inline int         n_samples     = 1000;
+inline int         n_warmups     = 100;
+inline std::string output_file;
+inline std::string baseline_file;
+inline std::string filter;
+
+inline std::vector<uint64_t> local_samples;
+
+inline FILE*                                   csv_fp = nullptr;
+inline std::map<std::string, double>           baseline_p50;
+
+inline bool enabled(const std::string& benchmark) {
+  return filter.empty() || benchmark.find(filter) != std::string::npos;
+}
+
+inline void add_sample(uint64_t ns) {
+  local_samples.push_back(ns);
+}
+
+// Call `fn` `batch` times per sample and record the average latency of each call
+template <typename Fn>
+inline void measure(int batch, Fn&& fn) {
+  for (int i = 0; i < n_warmups; i++) {
+    fn();
+  }
+  for (int i = 0; i < n_samples; i++) {
+    auto t0 = ityr::gettime_ns();
+    for (int j = 0; j < batch; j++) {
+      fn();
+    }
+    auto t1 = ityr::gettime_ns();
+    add_sample((t1 - t0) / batch);
+  }
+}
+
+inline std::string baseline_key(const std::string& benchmark, const std::string& param) {
+  return std::string(suite_name) + "," + benchmark + "," + param + "," + std::to_string(ityr::n_ranks());
+}
+
+inline void load_baseline() {
+  std::ifstream ifs(baseline_file);
+  if (!ifs) {
+    fprintf(stderr, "Cannot open baseline file %s\n", baseline_file.c_str());
+    return;
+  }
+
+  std::string line;
+  std::getline(ifs, line); // header
+  while (std::getline(ifs, line)) {
+    std::vector<std::string> cols;
+    std::stringstream ss(line);
+    std::string col;
+    while (std::getline(ss, col, ',')) {
+      cols.push_back(col);
+    }
+    // suite,benchmark,param,n_ranks,n_samples,min_ns,p50_ns,...
+    // The file may contain rows of multiple runs; the last one for each key is used
+    if (cols.size() > 6) {
+      baseline_p50[cols[0] + "," + cols[1] + "," + cols[2] + "," + cols[3]] = std::stod(cols[6]);
+    }
+  }
+}
+
+// Collective
+inline void report(const std::string& benchmark, const std::string& param, std::size_t bytes_per_op = 0) {
+  auto my_rank = ityr::my_rank();
+  auto n_ranks = ityr::n_ranks();
+  auto comm    = ityr::common::topology::mpicomm();
+
+  auto counts = ityr::common::mpi_allgather_value(local_samples.size(), comm);
+
+  if (my_rank != 0) {
+    if (!local_samples.empty()) {
+      ityr::common::mpi_send(local_samples.data(), local_samples.size(), 0, 0, comm);
+    }
+    local_samples.clear();
+    return;
+  }
+
+  std::vector<uint64_t> samples = std::move(local_samples);
+  local_samples.clear();
+  for (ityr::rank_t i = 1; i < n_ranks; i++) {
+    if (counts[i] > 0) {
+      std::size_t offset = samples.size();
+      samples.resize(offset + counts[i]);
+      ityr::common::mpi_recv(samples.data() + offset, counts[i], i, 0, comm);
+    }
+  }
+
+  std::sort(samples.begin(), samples.end());
+
+  auto percentile = [&](double p) -> uint64_t {
+    if (samples.empty()) return 0;
+    std::size_t idx = std::min(static_cast<std::size_t>(p * samples.size()), samples.size() - 1);
+    return samples[idx];
+  };
+
+  double mean = 0;
+  for (auto s : samples) {
+    mean += s;
+  }
+  mean = samples.empty() ? 0 : mean / samples.size();
+
+  double ops_per_s   = mean > 0 ? 1e9 / mean : 0;
+  double bytes_per_s = ops_per_s * bytes_per_op;
+
+  printf("  %-24s %-14s n=%-8ld p50: %10ld ns  p90: %10ld ns  p99: %10ld ns",
+         benchmark.c_str(), param.c_str(), samples.size(),
+         percentile(0.5), percentile(0.9), percentile(0.99));
+  if (bytes_per_op > 0) {
+    printf("  %10.2f MB/s", bytes_per_s / 1e6);
+  }
+
+  auto it = baseline_p50.find(baseline_key(benchmark, param));
+  if (it != baseline_p50.end() && it->second > 0 && !samples.empty()) {
+    printf("  (p50 x%.3f of baseline)", percentile(0.5) / it->second);
+  }
+  printf("\n");
+  fflush(stdout);
+
+  if (csv_fp) {
+    fprintf(csv_fp, "%s,%s,%s,%d,%ld,%ld,%ld,%ld,%ld,%ld,%.1f,%.1f,%.1f\n",
+            suite_name, benchmark.c_str(), param.c_str(), n_ranks, samples.size(),
+            samples.empty() ? 0 : samples.front(), percentile(0.5), percentile(0.9), percentile(0.99),
+            samples.empty() ? 0 : samples.back(), mean, ops_per_s, bytes_per_s);
+    fflush(csv_fp);
+  }
+}
+
+inline void show_help_and_exit(char** argv, const char* extra_help) {
+  if (ityr::is_master()) {
+    printf("Usage: %s [options]\n"
+           "  options:\n"
+           "    -n : # of samples per benchmark (int)\n"
+           "    -w : # of warmup iterations per benchmark (int)\n"
+           "    -f : run only benchmarks whose names contain this string\n"
+           "    -o : output CSV file to append results to (default: <suite>.csv)\n"
+           "    -b : baseline CSV file to compare with\n"
+           "%s", argv[0], extra_help);
+  }
+  exit(1);
+}
+
+// Parse common options; `extra_opts` and `extra_fn` handle suite-specific options
+template <typename ExtraFn>
+inline void init(const char* name, int argc, char** argv,
+                 const char* extra_opts, const char* extra_help, ExtraFn&& extra_fn) {
+  suite_name  = name;
+  output_file = std::string(name) + ".csv";
+
+  std::string opts = std::string("n:w:f:o:b:h") + extra_opts;
+
+  int opt;
+  while ((opt = getopt(argc, argv, opts.c_str())) != EOF) {
+    switch (opt) {
+      case 'n':
+        n_samples = atoi(optarg);
+        break;
+      case 'w':
+        n_warmups = atoi(optarg);
+        break;
+      case 'f':
+        filter = optarg;
+        break;
+      case 'o':
+        output_file = optarg;
+        break;
+      case 'b':
+        baseline_file = optarg;
+        break;
+      case 'h':
+        show_help_and_exit(argv, extra_help);
+        break;
+      default:
+        if (!extra_fn(opt, optarg)) {
+          show_help_and_exit(argv, extra_help);
+        }
+    }
+  }
+
+  if (ityr::is_master()) {
+    printf("=============================================================\n"
+           "[%s]\n"
+           "# of processes:               %d\n"
+           "# of samples:                 %d\n"
+           "# of warmups:                 %d\n"
+           "Output file:                  %s\n"
+           "Baseline file:                %s\n"
+           "-------------------------------------------------------------\n",
+           suite_name, ityr::n_ranks(), n_samples, n_warmups, output_file.c_str(),
+           baseline_file.empty() ? "(none)" : baseline_file.c_str());
+
+    printf("[Compile Options]\n");
+    ityr::print_compile_options();
+    printf("-------------------------------------------------------------\n");
+    printf("[Runtime Options]\n");
+    ityr::print_runtime_options();
+    printf("=============================================================\n\n");
+    fflush(stdout);
+
+    // Rows are appended so that results of multiple runs (e.g., with different # of processes)
+    // are accumulated in a single file; the header is written only to a new (empty) file
+    csv_fp = fopen(output_file.c_str(), "a");
+    if (!csv_fp) {
+      perror("fopen");
+      exit(1);
+    }
+    fseek(csv_fp, 0, SEEK_END);
+    if (ftell(csv_fp) == 0) {
+      fprintf(csv_fp, "suite,benchmark,param,n_ranks,n_samples,min_ns,p50_ns,p90_ns,p99_ns,max_ns,mean_ns,ops_per_s,bytes_per_s\n");
+    }
+
+    if (!baseline_file.empty()) {
+      load_baseline();
+    }
+  }
+}
+
+inline void init(const char* name, int argc, char** argv) {
+  init(name, argc, argv, "", "", [](int, const char*) { return false; });
+}
+
+inline void fini() {
+  if (csv_fp) {
+    fclose(csv_fp);
+    csv_fp = nullptr;
+  }
+}
+
+inline std::vector<std::size_t> sizes_up_to(std::size_t max_size) {
+  std::vector<std::size_t> sizes;
+  for (std::size_t s = 8; s <= max_size; s *= 8) {
+    sizes.push_back(s);
+  }
+  return sizes;
+}
+
+}
@@ -0,0 +1,107 @@
+#include "bench_common.hpp"
+
+/*
+ * Microbenchmarks for the communication layer (RMA operations and the remotable allocator)
+ *
+ * Each process targets its neighbor ((my_rank + 1) % n_ranks), so that all processes communicate
+ * simultaneously. With a single process, the target is the process itself.
+ */
+
+std::size_t max_size = std::size_t(1) << 20;
+
+void bench_rma() {
+  namespace common = ityr::common;
+
+  auto comm    = common::topology::mpicomm();
+  auto my_rank = common::topology::my_rank();
+  auto n_ranks = common::topology::n_ranks();
+  auto target  = (my_rank + 1) % n_ranks;
+
+  common::mpi_win_manager<std::byte> win(comm, max_size);
+  std::vector<std::byte> buf(max_size);
+
+  for (auto size : bench::sizes_up_to(max_size)) {
+    if (bench::enabled("rma_get")) {
+      bench::measure(1, [&] {
+        common::mpi_get(buf.data(), size, target, 0, win.win());
+      });
+      bench::report("rma_get", std::to_string(size), size);
+    }
+
+    if (bench::enabled("rma_put")) {
+      bench::measure(1, [&] {
+        common::mpi_put(buf.data(), size, target, 0, win.win());
+      });
+      bench::report("rma_put", std::to_string(size), size);
+    }
+  }
+
+  if (bench::enabled("rma_atomic_faa")) {
+    common::mpi_win_manager<uint64_t> counter_win(comm, 1, uint64_t(0));
+    bench::measure(1, [&] {
+      common::mpi_atomic_faa_value<uint64_t>(1, target, 0, counter_win.win());
+    });
+    bench::report("rma_atomic_faa", "8", 0);
+  }
+}
+
+void bench_allocator() {
+  namespace common = ityr::common;
+
+  auto comm    = common::topology::mpicomm();
+  auto my_rank = common::topology::my_rank();
+  auto n_ranks = common::topology::n_ranks();
+  auto source  = (my_rank + n_ranks - 1) % n_ranks;
+
+  common::remotable_resource allocator(std::size_t(64) * 1024 * 1024, "benchmark remotable memory");
+
+  for (auto size : bench::sizes_up_to(max_size)) {
+    if (bench::enabled("alloc_free_local")) {
+      bench::measure(1, [&] {
+        void* p = allocator.allocate(size);
+        allocator.deallocate(p, size);
+      });
+      bench::report("alloc_free_local", std::to_string(size), 0);
+    }
+
+    if (bench::enabled("free_remote")) {
+      // Each process allocates objects and the neighbor process frees them remotely
+      for (int i = 0; i < bench::n_warmups + bench::n_samples; i++) {
+        void* p = allocator.allocate(size);
+        auto ps = common::mpi_allgather_value(p, comm);
+        void* remote_p = ps[source];
+
+        auto t0 = ityr::gettime_ns();
+        allocator.remote_deallocate(remote_p, size, source);
+        auto t1 = ityr::gettime_ns();
+
+        if (i >= bench::n_warmups) {
+          bench::add_sample(t1 - t0);
+        }
+
+        common::mpi_barrier(comm);
+        allocator.collect_deallocated();
+      }
+      bench::report("free_remote", std::to_string(size), 0);
+    }
+  }
+}
+
+int main(int argc, char** argv) {
+  ityr::init();
+
+  bench::init("common_bench", argc, argv, "s:",
+              "    -s : max message/object size in bytes (size_t)\n",
+              [](int opt, const char* arg) {
+                if (opt != 's') return false;
+                max_size = atol(arg);
+                return true;
+              });
+
+  bench_rma();
+  bench_allocator();
+
+  bench::fini();
+  ityr::fini();
+  return 0;
+}
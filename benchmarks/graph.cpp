@@ -0,0 +1,508 @@
+#include "ityr/ityr.hpp"
+
+/*
+ * Graph kernels (BFS and PageRank) over a CSR graph
+ *
+ * The CSR stores the in-edges of each vertex (`sources[offsets[v]..offsets[v+1])` are the vertices
+ * that have an edge to `v`), so both kernels pull values from neighbors and each task writes only
+ * to the vertices it owns (bottom-up BFS and pull-based PageRank).
+ *
+ * A graph can be loaded from a binary file (-f) of uint64_t words:
+ *   [n_vertices, n_edges, offsets[0..n_vertices], sources[0..n_edges)]
+ * Otherwise, a synthetic graph with 2^scale vertices, skewed in-degrees, and uniformly random
+ * sources is generated. The generated graph can be saved to a file (-o) for later runs.
+ */
+
+using vertex_t = uint64_t;
+using level_t  = int64_t;
+
+int         scale         = 16;
+int         edge_factor   = 16;
+int         n_repeats     = 10;
+int         n_pr_iters    = 10;
+double      damping       = 0.85;
+std::size_t cutoff_count  = 256;
+bool        verify_result = true;
+std::string input_file;
+std::string output_file;
+
+ityr::global_vector_options gvec_coll_opts(true, 1024);
+
+uint64_t hash64(uint64_t x) {
+  x += 0x9e3779b97f4a7c15ul;
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ul;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebul;
+  return x ^ (x >> 31);
+}
+
+// In-degrees follow a heavy-tailed distribution whose mean is `edge_factor`
+vertex_t gen_in_degree(vertex_t v, vertex_t n) {
+  double u = static_cast<double>((hash64(v) >> 11) + 1) / static_cast<double>(uint64_t(1) << 53);
+  return std::min(n, static_cast<vertex_t>(edge_factor * 0.5 / std::sqrt(u)));
+}
+
+struct graph {
+  vertex_t                      n_vertices = 0;
+  vertex_t                      n_edges    = 0;
+  ityr::global_vector<vertex_t> offsets     {gvec_coll_opts};
+  ityr::global_vector<vertex_t> sources     {gvec_coll_opts};
+  ityr::global_vector<vertex_t> out_degrees {gvec_coll_opts};
+};
+
+void generate_graph(graph& g) {
+  vertex_t n = vertex_t(1) << scale;
+
+  g.offsets.resize(n + 1);
+
+  ityr::root_exec([=, offsets = ityr::global_span<vertex_t>(g.offsets)] {
+    offsets[0] = 0;
+    ityr::transform_inclusive_scan(
+        ityr::execution::parallel_policy(cutoff_count),
+        ityr::count_iterator<vertex_t>(0),
+        ityr::count_iterator<vertex_t>(n),
+        offsets.begin() + 1,
+        ityr::reducer::plus<vertex_t>{},
+        [=](vertex_t v) { return gen_in_degree(v, n); });
+  });
+
+  vertex_t m = g.offsets.back();
+
+  g.n_vertices = n;
+  g.n_edges    = m;
+  g.sources.resize(m);
+
+  ityr::root_exec([=, offsets = ityr::global_span<vertex_t>(g.offsets),
+                      sources = ityr::global_span<vertex_t>(g.sources)] {
+    ityr::for_each(
+        ityr::execution::parallel_policy(cutoff_count),
+        ityr::count_iterator<vertex_t>(0),
+        ityr::count_iterator<vertex_t>(n),
+        ityr::make_global_iterator(offsets.begin()    , ityr::checkout_mode::read),
+        ityr::make_global_iterator(offsets.begin() + 1, ityr::checkout_mode::read),
+        [=](vertex_t v, vertex_t e_begin, vertex_t e_end) {
+          auto cs = ityr::make_checkout(sources.data() + e_begin, e_end - e_begin, ityr::checkout_mode::write);
+          for (vertex_t k = 0; k < e_end - e_begin; k++) {
+            cs[k] = hash64((v << 32) + k) % n;
+          }
+        });
+  });
+}
+
+void load_graph(graph& g) {
+  auto fp = ityr::make_unique_file<vertex_t>(input_file);
+  vertex_t n = fp[0];
+  vertex_t m = fp[1];
+
+  if (fp.size() != 2 + (n + 1) + m) {
+    if (ityr::is_master()) {
+      printf("Invalid graph file %s (expected %ld words, but got %ld)\n",
+             input_file.c_str(), 2 + (n + 1) + m, fp.size());
+    }
+    exit(1);
+  }
+
+  g.n_vertices = n;
+  g.n_edges    = m;
+  g.offsets.resize(n + 1);
+  g.sources.resize(m);
+
+  ityr::root_exec([=, p = fp.get(),
+                      offsets = ityr::global_span<vertex_t>(g.offsets),
+                      sources = ityr::global_span<vertex_t>(g.sources)] {
+    ityr::copy(ityr::execution::parallel_policy(cutoff_count),
+               p + 2, p + 2 + (n + 1), offsets.begin());
+    ityr::copy(ityr::execution::parallel_policy(cutoff_count),
+               p + 2 + (n + 1), p + 2 + (n + 1) + m, sources.begin());
+  });
+}
+
+void save_graph(const graph& g) {
+  vertex_t n = g.n_vertices;
+  vertex_t m = g.n_edges;
+
+  auto f = ityr::make_global_file<vertex_t>(output_file, 2 + (n + 1) + m);
+
+  ityr::root_exec([=, p = f.data(),
+                      offsets = ityr::global_span<const vertex_t>(g.offsets),
+                      sources = ityr::global_span<const vertex_t>(g.sources)] {
+    p[0] = n;
+    p[1] = m;
+    ityr::copy(ityr::execution::parallel_policy(cutoff_count),
+               offsets.begin(), offsets.end(), p + 2);
+    ityr::copy(ityr::execution::parallel_policy(cutoff_count),
+               sources.begin(), sources.end(), p + 2 + (n + 1));
+  });
+
+  f.sync();
+}
+
+// Out-degrees are computed from the run lengths of sorted sources
+void compute_out_degrees(graph& g) {
+  vertex_t n = g.n_vertices;
+  vertex_t m = g.n_edges;
+
+  ityr::global_vector<vertex_t> sorted(gvec_coll_opts, m);
+  ityr::global_vector<vertex_t> run_begin(gvec_coll_opts, n, 0);
+  ityr::global_vector<vertex_t> run_end(gvec_coll_opts, n, 0);
+
+  g.out_degrees.resize(n);
+
+  ityr::root_exec([=, sorted      = ityr::global_span<vertex_t>(sorted),
+                      run_begin   = ityr::global_span<vertex_t>(run_begin),
+                      run_end     = ityr::global_span<vertex_t>(run_end),
+                      sources     = ityr::global_span<const vertex_t>(g.sources),
+                      out_degrees = ityr::global_span<vertex_t>(g.out_degrees)] {
+    ityr::copy(ityr::execution::parallel_policy(cutoff_count), sources.begin(), sources.end(), sorted.begin());
+    ityr::sort(ityr::execution::parallel_policy(cutoff_count), sorted.begin(), sorted.end());
+
+    // Each vertex is written by exactly one position at the begin/end of its run
+    ityr::for_each(
+        ityr::execution::parallel_policy(cutoff_count),
+        ityr::count_iterator<vertex_t>(0),
+        ityr::count_iterator<vertex_t>(m),
+        ityr::make_global_iterator(sorted.begin(), ityr::checkout_mode::read),
+        [=](vertex_t j, vertex_t u) {
+          if (j == 0 || sorted[j - 1] != u) {
+            run_begin[u] = j;
+          }
+          if (j == m - 1 || sorted[j + 1] != u) {
+            run_end[u] = j + 1;
+          }
+        });
+
+    ityr::transform(
+        ityr::execution::parallel_policy(cutoff_count),
+        run_end.begin(), run_end.end(), run_begin.begin(), out_degrees.begin(),
+        [](vertex_t e, vertex_t b) { return e - b; });
+  });
+}
+
+
+// Bottom-up BFS from `root`; returns the number of levels
+level_t bfs(ityr::global_span<const vertex_t> offsets,
+            ityr::global_span<const vertex_t> sources,
+            ityr::global_span<level_t>        levels,
+            vertex_t                          root) {
+  ityr::fill(ityr::execution::parallel_policy(cutoff_count), levels.begin(), levels.end(), -1);
+  levels[root] = 0;
+
+  for (level_t level = 0;; level++) {
+    // A vertex is visited if any of its in-neighbors is in the current frontier
+    ityr::for_each(
+        ityr::execution::parallel_policy(cutoff_count),
+        ityr::make_global_iterator(offsets.begin()    , ityr::checkout_mode::read),
+        ityr::make_global_iterator(offsets.end() - 1  , ityr::checkout_mode::read),
+        ityr::make_global_iterator(offsets.begin() + 1, ityr::checkout_mode::read),
+        ityr::make_global_iterator(levels.begin()     , ityr::checkout_mode::read_write),
+        [=](vertex_t e_begin, vertex_t e_end, level_t& lv) {
+          if (lv != -1) return;
+          auto cs = ityr::make_checkout(sources.data() + e_begin, e_end - e_begin, ityr::checkout_mode::read);
+          for (vertex_t u : cs) {
+            if (levels[u] == level) {
+              lv = level + 1;
+              break;
+            }
+          }
+        });
+
+    auto n_found = ityr::transform_reduce(
+        ityr::execution::parallel_policy(cutoff_count),
+        levels.begin(), levels.end(),
+        ityr::reducer::plus<vertex_t>{},
+        [=](level_t lv) -> vertex_t { return lv == level + 1; });
+
+    if (n_found == 0) {
+      return level + 1;
+    }
+  }
+}
+
+// Number of edges within the traversed component (as in Graph500)
+vertex_t bfs_traversed_edges(ityr::global_span<const vertex_t> offsets,
+                             ityr::global_span<const level_t>  levels) {
+  return ityr::transform_reduce(
+      ityr::execution::parallel_policy(cutoff_count),
+      levels.begin(), levels.end(), ityr::count_iterator<vertex_t>(0),
+      ityr::reducer::plus<vertex_t>{},
+      [=](level_t lv, vertex_t v) -> vertex_t {
+        return lv == -1 ? 0 : offsets[v + 1] - offsets[v];
+      });
+}
+
+// Every reached vertex at level L must have an in-neighbor at level L-1 and no in-neighbor
+// at a level smaller than L-1, and unreached vertices must not have reached in-neighbors
+bool bfs_verify(ityr::global_span<const vertex_t> offsets,
+                ityr::global_span<const vertex_t> sources,
+                ityr::global_span<const level_t>  levels) {
+  return ityr::transform_reduce(
+      ityr::execution::parallel_policy(cutoff_count),
+      levels.begin(), levels.end(), ityr::count_iterator<vertex_t>(0),
+      ityr::reducer::logical_and{},
+      [=](level_t lv, vertex_t v) {
+        vertex_t e_begin = offsets[v];
+        vertex_t e_end   = offsets[v + 1];
+        auto cs = ityr::make_checkout(sources.data() + e_begin, e_end - e_begin, ityr::checkout_mode::read);
+
+        bool has_parent = (lv == 0);
+        for (vertex_t u : cs) {
+          level_t lu = levels[u];
+          if (lv == -1) {
+            if (lu != -1) return false;
+          } else if (lu != -1) {
+            if (lu < lv - 1) return false;
+            if (lu == lv - 1) has_parent = true;
+          }
+        }
+        return lv == -1 || has_parent;
+      });
+}
+
+// Pull-based PageRank (the rank of dangling vertices is not redistributed)
+void pagerank(ityr::global_span<const vertex_t> offsets,
+              ityr::global_span<const vertex_t> sources,
+              ityr::global_span<const vertex_t> out_degrees,
+              ityr::global_span<double>         ranks,
+              ityr::global_span<double>         contribs) {
+  double n = offsets.size() - 1;
+
+  ityr::fill(ityr::execution::parallel_policy(cutoff_count), ranks.begin(), ranks.end(), 1.0 / n);
+
+  for (int it = 0; it < n_pr_iters; it++) {
+    ityr::transform(
+        ityr::execution::parallel_policy(cutoff_count),
+        ranks.begin(), ranks.end(), out_degrees.begin(), contribs.begin(),
+        [](double r, vertex_t d) { return d > 0 ? r / d : 0.0; });
+
+    ityr::for_each(
+        ityr::execution::parallel_policy(cutoff_count),
+        ityr::make_global_iterator(offsets.begin()    , ityr::checkout_mode::read),
+        ityr::make_global_iterator(offsets.end() - 1  , ityr::checkout_mode::read),
+        ityr::make_global_iterator(offsets.begin() + 1, ityr::checkout_mode::read),
+        ityr::make_global_iterator(ranks.begin()      , ityr::checkout_mode::write),
+        [=](vertex_t e_begin, vertex_t e_end, double& r) {
+          auto cs = ityr::make_checkout(sources.data() + e_begin, e_end - e_begin, ityr::checkout_mode::read);
+          double sum = 0;
+          for (vertex_t u : cs) {
+            sum += contribs[u];
+          }
+          r = (1.0 - damping) / n + damping * sum;
+        });
+  }
+}
+
+vertex_t choose_root(const graph& g, int r) {
+  // Choose a vertex with out-edges so that BFS does not terminate immediately
+  for (uint64_t k = 0;; k++) {
+    vertex_t v = hash64((uint64_t(r) << 32) + k) % g.n_vertices;
+    if (g.out_degrees[v] > 0) return v;
+  }
+}
+
+void run_bfs(const graph& g) {
+  ityr::global_vector<level_t> levels_vec(gvec_coll_opts, g.n_vertices);
+
+  ityr::global_span<const vertex_t> offsets(g.offsets);
+  ityr::global_span<const vertex_t> sources(g.sources);
+  ityr::global_span<level_t>        levels(levels_vec);
+
+  for (int r = 0; r < n_repeats; r++) {
+    vertex_t root = choose_root(g, r);
+
+    ityr::profiler_begin();
+
+    auto t0 = ityr::gettime_ns();
+
+    level_t n_levels = ityr::root_exec([=] {
+      return bfs(offsets, sources, levels, root);
+    });
+
+    auto t1 = ityr::gettime_ns();
+
+    ityr::profiler_end();
+
+    vertex_t n_traversed = ityr::root_exec([=] {
+      return bfs_traversed_edges(offsets, levels);
+    });
+
+    if (ityr::is_master()) {
+      printf("[%d] BFS: %'ld ns (root = %ld, %ld levels, %'ld edges, %.3f MTEPS)",
+             r, t1 - t0, root, n_levels, n_traversed, n_traversed / static_cast<double>(t1 - t0) * 1e3);
+    }
+
+    if (verify_result) {
+      bool ok = ityr::root_exec([=] {
+        return bfs_verify(offsets, sources, levels);
+      });
+      if (ityr::is_master()) {
+        printf("%s", ok ? " - Result verified" : " - Wrong result");
+      }
+    }
+
+    if (ityr::is_master()) {
+      printf("\n");
+      fflush(stdout);
+    }
+
+    ityr::profiler_flush();
+  }
+}
+
+void run_pagerank(const graph& g) {
+  ityr::global_vector<double> ranks_vec(gvec_coll_opts, g.n_vertices);
+  ityr::global_vector<double> contribs_vec(gvec_coll_opts, g.n_vertices);
+
+  ityr::global_span<const vertex_t> offsets(g.offsets);
+  ityr::global_span<const vertex_t> sources(g.sources);
+  ityr::global_span<const vertex_t> out_degrees(g.out_degrees);
+  ityr::global_span<double>         ranks(ranks_vec);
+  ityr::global_span<double>         contribs(contribs_vec);
+
+  for (int r = 0; r < n_repeats; r++) {
+    ityr::profiler_begin();
+
+    auto t0 = ityr::gettime_ns();
+
+    ityr::root_exec([=] {
+      pagerank(offsets, sources, out_degrees, ranks, contribs);
+    });
+
+    auto t1 = ityr::gettime_ns();
+
+    ityr::profiler_end();
+
+    double rank_sum = ityr::root_exec([=] {
+      return ityr::reduce(ityr::execution::parallel_policy(cutoff_count), ranks.begin(), ranks.end());
+    });
+
+    if (ityr::is_master()) {
+      double n_edge_updates = static_cast<double>(g.n_edges) * n_pr_iters;
+      printf("[%d] PageRank: %'ld ns (%d iterations, %.3f MTEPS, sum of ranks = %f)\n",
+             r, t1 - t0, n_pr_iters, n_edge_updates / (t1 - t0) * 1e3, rank_sum);
+      fflush(stdout);
+    }
+
+    ityr::profiler_flush();
+  }
+}
+
+void run(const std::string& kernel) {
+  graph g;
+
+  auto t0 = ityr::gettime_ns();
+
+  if (input_file.empty()) {
+    generate_graph(g);
+  } else {
+    load_graph(g);
+  }
+  compute_out_degrees(g);
+
+  auto t1 = ityr::gettime_ns();
+
+  if (!output_file.empty()) {
+    save_graph(g);
+  }
+
+  if (ityr::is_master()) {
+    setlocale(LC_NUMERIC, "en_US.UTF-8");
+    printf("=============================================================\n"
+           "[Graph]\n"
+           "# of processes:               %d\n"
+           "Input:                        %s\n"
+           "# of vertices:                %ld\n"
+           "# of edges:                   %ld\n"
+           "Kernel:                       %s\n"
+           "# of PageRank iterations:     %d\n"
+           "# of repeats:                 %d\n"
+           "Cutoff count:                 %ld\n"
+           "Verify result:                %d\n"
+           "Graph construction time:      %'ld ns\n"
+           "-------------------------------------------------------------\n",
+           ityr::n_ranks(), input_file.empty() ? "(synthetic)" : input_file.c_str(),
+           g.n_vertices, g.n_edges, kernel.c_str(), n_pr_iters, n_repeats,
+           cutoff_count, verify_result, t1 - t0);
+
+    printf("[Compile Options]\n");
+    ityr::print_compile_options();
+    printf("-------------------------------------------------------------\n");
+    printf("[Runtime Options]\n");
+    ityr::print_runtime_options();
+    printf("=============================================================\n\n");
+    fflush(stdout);
+  }
+
+  if (kernel == "bfs" || kernel == "all") {
+    run_bfs(g);
+  }
+  if (kernel == "pagerank" || kernel == "all") {
+    run_pagerank(g);
+  }
+}
+
+void show_help_and_exit(int argc [[maybe_unused]], char** argv) {
+  if (ityr::is_master()) {
+    printf("Usage: %s [options]\n"
+           "  options:\n"
+           "    -s : scale of the synthetic graph (2^s vertices) (int)\n"
+           "    -e : average in-degree of the synthetic graph (int)\n"
+           "    -f : input graph file (the synthetic graph is used if not given)\n"
+           "    -o : output graph file to save the input graph\n"
+           "    -k : kernel to run (bfs, pagerank, or all)\n"
+           "    -i : # of PageRank iterations (int)\n"
+           "    -r : # of repeats (int)\n"
+           "    -c : cutoff count for leaf tasks (size_t)\n"
+           "    -v : verify the result (int)\n", argv[0]);
+  }
+  exit(1);
+}
+
+int main(int argc, char** argv) {
+  ityr::init();
+
+  std::string kernel = "all";
+
+  int opt;
+  while ((opt = getopt(argc, argv, "s:e:f:o:k:i:r:c:v:h")) != EOF) {
+    switch (opt) {
+      case 's':
+        scale = atoi(optarg);
+        break;
+      case 'e':
+        edge_factor = atoi(optarg);
+        break;
+      case 'f':
+        input_file = optarg;
+        break;
+      case 'o':
+        output_file = optarg;
+        break;
+      case 'k':
+        kernel = optarg;
+        break;
+      case 'i':
+        n_pr_iters = atoi(optarg);
+        break;
+      case 'r':
+        n_repeats = atoi(optarg);
+        break;
+      case 'c':
+        cutoff_count = atol(optarg);
+        break;
+      case 'v':
+        verify_result = atoi(optarg);
+        break;
+      case 'h':
+      default:
+        show_help_and_exit(argc, argv);
+    }
+  }
+
+  if (kernel != "bfs" && kernel != "pagerank" && kernel != "all") {
+    show_help_and_exit(argc, argv);
+  }
+
+  run(kernel);
+
+  ityr::fini();
+  return 0;
+}
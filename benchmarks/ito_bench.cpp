@@ -0,0 +1,114 @@
+#include "bench_common.hpp"
+
+/*
+ * Microbenchmarks for the threading layer (fork/join, work stealing, and work-stealing queues)
+ */
+
+uint64_t spin_ns = 1000000;
+
+void bench_fork_join() {
+  if (bench::enabled("fork_join")) {
+    ityr::root_exec([] {
+      bench::measure(100, [] {
+        ityr::ito::thread<void> th([] {});
+        th.join();
+      });
+    });
+    bench::report("fork_join", "empty", 0);
+  }
+
+  if (bench::enabled("parallel_invoke")) {
+    ityr::root_exec([] {
+      bench::measure(100, [] {
+        ityr::parallel_invoke([] {}, [] {});
+      });
+    });
+    bench::report("parallel_invoke", "2", 0);
+  }
+}
+
+void bench_steal() {
+  if (!bench::enabled("steal_latency") || ityr::n_ranks() == 1) return;
+
+  // The child thread spins for a while so that the parent continuation can be stolen.
+  // When the continuation is resumed on another process, the time from the fork is recorded.
+  ityr::root_exec([] {
+    for (int i = 0; i < bench::n_samples; i++) {
+      auto rank0 = ityr::my_rank();
+      auto t0    = ityr::gettime_ns();
+
+      ityr::ito::thread<void> th([=] {
+        while (ityr::gettime_ns() < t0 + spin_ns);
+      });
+
+      if (ityr::my_rank() != rank0) {
+        bench::add_sample(ityr::gettime_ns() - t0);
+      }
+
+      th.join();
+    }
+  });
+  bench::report("steal_latency", std::to_string(spin_ns), 0);
+}
+
+void bench_wsqueue() {
+  namespace ito    = ityr::ito;
+  namespace common = ityr::common;
+
+  auto comm    = common::topology::mpicomm();
+  auto my_rank = common::topology::my_rank();
+  auto n_ranks = common::topology::n_ranks();
+
+  int n_entries = bench::n_warmups + bench::n_samples;
+  ito::wsqueue<int> wsq(n_entries);
+
+  if (bench::enabled("wsqueue_push_pop")) {
+    bench::measure(100, [&] {
+      wsq.push(0);
+      wsq.pop();
+    });
+    bench::report("wsqueue_push_pop", "1", 0);
+  }
+
+  if (bench::enabled("wsqueue_steal") && n_ranks > 1) {
+    // Each process steals entries one by one from its neighbor
+    for (int i = 0; i < n_entries; i++) {
+      wsq.push(i);
+    }
+    common::mpi_barrier(comm);
+
+    auto target = (my_rank + 1) % n_ranks;
+    for (int i = 0; i < n_entries; i++) {
+      auto t0 = ityr::gettime_ns();
+      wsq.steal(target);
+      auto t1 = ityr::gettime_ns();
+
+      if (i >= bench::n_warmups) {
+        bench::add_sample(t1 - t0);
+      }
+    }
+    common::mpi_barrier(comm);
+
+    bench::report("wsqueue_steal", "1", 0);
+  }
+}
+
+int main(int argc, char** argv) {
+  ityr::init();
+
+  bench::init("ito_bench", argc, argv, "t:",
+              "    -t : spin time of the child thread in the steal latency benchmark (ns)\n",
+              [](int opt, const char* arg) {
+                if (opt != 't') return false;
+                spin_ns = atol(arg);
+                return true;
+              });
+
+  bench_fork_join();
+  bench_steal();
+  bench_wsqueue();
+
+  bench::fini();
+  ityr::fini();
+  return 0;
+}
@@ -0,0 +1,317 @@
+#include "ityr/ityr.hpp"
+
+/*
+ * k-means clustering (Lloyd's algorithm)
+ *
+ * Points are generated around `k` random centers with uniform noise, and the first `k` points
+ * are used as the initial centroids. In each iteration, leaf tasks check out a block of points
+ * and all centroids, assign each point to the nearest centroid, and accumulate per-cluster sums,
+ * which are combined by a parallel reduction. The new centroids are then written back to the
+ * global memory by the root thread.
+ */
+
+inline constexpr int n_dims = 4;
+inline constexpr int max_k  = 64;
+
+using point_t = std::array<double, n_dims>;
+
+std::size_t n_points      = std::size_t(1) << 20;
+int         n_clusters    = 16;
+int         n_iters       = 10;
+int         n_repeats     = 10;
+std::size_t block_size    = 1024;
+double      noise         = 5.0;
+bool        verify_result = true;
+
+ityr::global_vector_options gvec_coll_opts(true, 1024);
+
+uint64_t hash64(uint64_t x) {
+  x += 0x9e3779b97f4a7c15ul;
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ul;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebul;
+  return x ^ (x >> 31);
+}
+
+double hash_to_unit(uint64_t x) {
+  return static_cast<double>(hash64(x) >> 11) / static_cast<double>(uint64_t(1) << 53);
+}
+
+point_t gen_point(std::size_t i) {
+  uint64_t c = hash64(i) % n_clusters;
+  point_t p;
+  for (int d = 0; d < n_dims; d++) {
+    double center = hash_to_unit(c * n_dims + d) * 100.0;
+    p[d] = center + noise * (2.0 * hash_to_unit((uint64_t(i) << 8) + d + 1) - 1.0);
+  }
+  return p;
+}
+
+double dist2(const point_t& a, const point_t& b) {
+  double s = 0;
+  for (int d = 0; d < n_dims; d++) {
+    s += (a[d] - b[d]) * (a[d] - b[d]);
+  }
+  return s;
+}
+
+int nearest(const point_t& p, const point_t* centroids, int k) {
+  int    best   = 0;
+  double best_d = dist2(p, centroids[0]);
+  for (int c = 1; c < k; c++) {
+    double d = dist2(p, centroids[c]);
+    if (d < best_d) {
+      best   = c;
+      best_d = d;
+    }
+  }
+  return best;
+}
+
+struct cluster_acc {
+  std::array<point_t, max_k>  sums   = {};
+  std::array<uint64_t, max_k> counts = {};
+  double                      sse    = 0;
+};
+
+struct cluster_acc_plus {
+  cluster_acc operator()(const cluster_acc& l, const cluster_acc& r) const {
+    cluster_acc ret = l;
+    for (int c = 0; c < max_k; c++) {
+      for (int d = 0; d < n_dims; d++) {
+        ret.sums[c][d] += r.sums[c][d];
+      }
+      ret.counts[c] += r.counts[c];
+    }
+    ret.sse += r.sse;
+    return ret;
+  }
+};
+
+using cluster_reducer = ityr::reducer::monoid<cluster_acc, cluster_acc_plus>;
+
+// Returns the sum of squared errors before the last update
+double kmeans(ityr::global_span<const point_t> points,
+              ityr::global_span<int>           labels,
+              ityr::global_span<point_t>       centroids) {
+  int         k        = n_clusters;
+  std::size_t n        = points.size();
+  std::size_t n_blocks = (n + block_size - 1) / block_size;
+
+  ityr::copy(ityr::execution::seq, points.begin(), points.begin() + k, centroids.begin());
+
+  double sse = 0;
+
+  for (int it = 0; it < n_iters; it++) {
+    cluster_acc acc = ityr::transform_reduce(
+        ityr::execution::par,
+        ityr::count_iterator<std::size_t>(0),
+        ityr::count_iterator<std::size_t>(n_blocks),
+        cluster_reducer{},
+        [=](std::size_t b) {
+          std::size_t i_begin = b * block_size;
+          std::size_t i_end   = std::min(i_begin + block_size, n);
+
+          auto cs = ityr::make_checkout(centroids.data(), k, ityr::checkout_mode::read);
+          auto ps = ityr::make_checkout(points.data() + i_begin, i_end - i_begin, ityr::checkout_mode::read);
+          auto ls = ityr::make_checkout(labels.data() + i_begin, i_end - i_begin, ityr::checkout_mode::write);
+
+          cluster_acc a;
+          for (std::size_t i = 0; i < i_end - i_begin; i++) {
+            int c = nearest(ps[i], cs.data(), k);
+            ls[i] = c;
+            for (int d = 0; d < n_dims; d++) {
+              a.sums[c][d] += ps[i][d];
+            }
+            a.counts[c]++;
+            a.sse += dist2(ps[i], cs[c]);
+          }
+          return a;
+        });
+
+    auto cs = ityr::make_checkout(centroids.data(), k, ityr::checkout_mode::read_write);
+    for (int c = 0; c < k; c++) {
+      if (acc.counts[c] > 0) {
+        for (int d = 0; d < n_dims; d++) {
+          cs[c][d] = acc.sums[c][d] / acc.counts[c];
+        }
+      }
+    }
+
+    sse = acc.sse;
+  }
+
+  return sse;
+}
+
+std::vector<point_t> kmeans_serial() {
+  int k = n_clusters;
+
+  std::vector<point_t> centroids(k);
+  for (int c = 0; c < k; c++) {
+    centroids[c] = gen_point(c);
+  }
+
+  for (int it = 0; it < n_iters; it++) {
+    cluster_acc acc;
+    for (std::size_t i = 0; i < n_points; i++) {
+      point_t p = gen_point(i);
+      int c = nearest(p, centroids.data(), k);
+      for (int d = 0; d < n_dims; d++) {
+        acc.sums[c][d] += p[d];
+      }
+      acc.counts[c]++;
+    }
+    for (int c = 0; c < k; c++) {
+      if (acc.counts[c] > 0) {
+        for (int d = 0; d < n_dims; d++) {
+          centroids[c][d] = acc.sums[c][d] / acc.counts[c];
+        }
+      }
+    }
+  }
+
+  return centroids;
+}
+
+void run() {
+  ityr::global_vector<point_t> points_vec(gvec_coll_opts, n_points);
+  ityr::global_vector<int>     labels_vec(gvec_coll_opts, n_points);
+  ityr::global_vector<point_t> centroids_vec(gvec_coll_opts, n_clusters);
+
+  ityr::global_span<point_t> points(points_vec);
+  ityr::global_span<int>     labels(labels_vec);
+  ityr::global_span<point_t> centroids(centroids_vec);
+
+  ityr::root_exec([=] {
+    ityr::transform(
+        ityr::execution::parallel_policy(block_size),
+        ityr::count_iterator<std::size_t>(0),
+        ityr::count_iterator<std::size_t>(n_points),
+        points.begin(),
+        gen_point);
+  });
+
+  std::vector<point_t> answer;
+  if (verify_result && ityr::is_master()) {
+    answer = kmeans_serial();
+  }
+
+  for (int r = 0; r < n_repeats; r++) {
+    ityr::profiler_begin();
+
+    auto t0 = ityr::gettime_ns();
+
+    double sse = ityr::root_exec([=] {
+      return kmeans(points, labels, centroids);
+    });
+
+    auto t1 = ityr::gettime_ns();
+
+    ityr::profiler_end();
+
+    if (ityr::is_master()) {
+      // Distance computation: 3 flops per dimension for each (point, centroid) pair
+      double flops = 3.0 * n_dims * n_clusters * n_points * n_iters;
+      printf("[%d] %'ld ns (%.3f GFLOP/s, SSE = %f)", r, t1 - t0, flops / (t1 - t0), sse);
+
+      if (verify_result) {
+        auto cs = ityr::make_checkout(centroids.data(), n_clusters, ityr::checkout_mode::read);
+        double max_diff = 0;
+        for (int c = 0; c < n_clusters; c++) {
+          max_diff = std::max(max_diff, std::sqrt(dist2(cs[c], answer[c])));
+        }
+        if (max_diff < 1e-6) {
+          printf(" - Result verified");
+        } else {
+          printf(" - Wrong result: centroids differ from the serial result by %e", max_diff);
+        }
+      }
+
+      printf("\n");
+      fflush(stdout);
+    }
+
+    ityr::profiler_flush();
+  }
+}
+
+void show_help_and_exit(int argc [[maybe_unused]], char** argv) {
+  if (ityr::is_master()) {
+    printf("Usage: %s [options]\n"
+           "  options:\n"
+           "    -n : # of points (size_t)\n"
+           "    -k : # of clusters (int, at most %d)\n"
+           "    -i : # of iterations per repeat (int)\n"
+           "    -r : # of repeats (int)\n"
+           "    -b : # of points per leaf task (size_t)\n"
+           "    -v : verify the result (int)\n", argv[0], max_k);
+  }
+  exit(1);
+}
+
+int main(int argc, char** argv) {
+  ityr::init();
+
+  int opt;
+  while ((opt = getopt(argc, argv, "n:k:i:r:b:v:h")) != EOF) {
+    switch (opt) {
+      case 'n':
+        n_points = atol(optarg);
+        break;
+      case 'k':
+        n_clusters = atoi(optarg);
+        break;
+      case 'i':
+        n_iters = atoi(optarg);
+        break;
+      case 'r':
+        n_repeats = atoi(optarg);
+        break;
+      case 'b':
+        block_size = atol(optarg);
+        break;
+      case 'v':
+        verify_result = atoi(optarg);
+        break;
+      case 'h':
+      default:
+        show_help_and_exit(argc, argv);
+    }
+  }
+
+  if (n_clusters < 1 || n_clusters > max_k || static_cast<std::size_t>(n_clusters) > n_points) {
+    if (ityr::is_master()) {
+      printf("# of clusters (-k) must be in [1, min(%d, # of points)]\n", max_k);
+    }
+    exit(1);
+  }
+
+  if (ityr::is_master()) {
+    setlocale(LC_NUMERIC, "en_US.UTF-8");
+    printf("=============================================================\n"
+           "[k-means]\n"
+           "# of processes:               %d\n"
+           "# of points:                  %ld\n"
+           "# of dimensions:              %d\n"
+           "# of clusters:                %d\n"
+           "# of iterations:              %d\n"
+           "# of repeats:                 %d\n"
+           "Block size:                   %ld\n"
+           "Verify result:                %d\n"
+           "-------------------------------------------------------------\n",
+           ityr::n_ranks(), n_points, n_dims, n_clusters, n_iters, n_repeats, block_size, verify_result);
+
+    printf("[Compile Options]\n");
+    ityr::print_compile_options();
+    printf("-------------------------------------------------------------\n");
+    printf("[Runtime Options]\n");
+    ityr::print_runtime_options();
+    printf("=============================================================\n\n");
+    fflush(stdout);
+  }
+
+  run();
+
+  ityr::fini();
+  return 0;
+}
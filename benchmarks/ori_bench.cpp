@@ -0,0 +1,109 @@
+#include "bench_common.hpp"
+
+/*
+ * Microbenchmarks for the global address space (checkout/checkin and release)
+ *
+ * A global buffer is block-distributed over processes with `ityr::ori::mem_mapper::block`,
+ * and each process accesses the chunk owned by its neighbor ((my_rank + 1) % n_ranks).
+ * On a single node, the chunk is directly accessed via shared memory unless
+ * `ITYR_ENABLE_SHARED_MEMORY=0` is set; set it to measure the software cache path.
+ */
+
+std::size_t max_size = std::size_t(1) << 20;
+
+void run() {
+  namespace ori = ityr::ori;
+
+  auto my_rank = ityr::my_rank();
+  auto n_ranks = ityr::n_ranks();
+  auto target  = (my_rank + 1) % n_ranks;
+
+  std::size_t bs         = ori::get_block_size();
+  std::size_t chunk_size = (max_size + bs - 1) / bs * bs;
+
+  ori::global_ptr<std::byte> buf =
+    ori::malloc_coll<std::byte, ori::mem_mapper::block>(chunk_size * n_ranks);
+  ori::global_ptr<std::byte> remote_buf = buf + chunk_size * target;
+
+  for (auto size : bench::sizes_up_to(max_size)) {
+    if (bench::enabled("checkout_miss")) {
+      // Cache is invalidated by acquire() before every checkout (not timed)
+      for (int i = 0; i < bench::n_warmups + bench::n_samples; i++) {
+        ori::acquire();
+
+        auto t0 = ityr::gettime_ns();
+        auto p = ori::checkout(remote_buf, size, ori::mode::read);
+        ori::checkin(p, size, ori::mode::read);
+        auto t1 = ityr::gettime_ns();
+
+        if (i >= bench::n_warmups) {
+          bench::add_sample(t1 - t0);
+        }
+      }
+      bench::report("checkout_miss", std::to_string(size), size);
+    }
+
+    if (bench::enabled("checkout_hit")) {
+      ori::acquire();
+      bench::measure(1, [&] {
+        auto p = ori::checkout(remote_buf, size, ori::mode::read);
+        ori::checkin(p, size, ori::mode::read);
+      });
+      bench::report("checkout_hit", std::to_string(size), size);
+    }
+
+    if (bench::enabled("writeback")) {
+      // Dirty data is written back to the home process at release() (timed)
+      for (int i = 0; i < bench::n_warmups + bench::n_samples; i++) {
+        auto p = ori::checkout(remote_buf, size, ori::mode::write);
+        std::memset(p, i, size);
+        ori::checkin(p, size, ori::mode::write);
+
+        auto t0 = ityr::gettime_ns();
+        ori::release();
+        auto t1 = ityr::gettime_ns();
+
+        if (i >= bench::n_warmups) {
+          bench::add_sample(t1 - t0);
+        }
+      }
+      bench::report("writeback", std::to_string(size), size);
+    }
+
+    ityr::common::mpi_barrier(ityr::common::topology::mpicomm());
+  }
+
+  if (bench::enabled("checkout_tlb")) {
+    // Repeated small checkouts at the same address take the TLB fast path
+    ori::acquire();
+    auto p = ori::checkout(remote_buf, 8, ori::mode::read);
+    ori::checkin(p, 8, ori::mode::read);
+
+    bench::measure(100, [&] {
+      auto p = ori::checkout(remote_buf, 8, ori::mode::read);
+      ori::checkin(p, 8, ori::mode::read);
+    });
+    bench::report("checkout_tlb", "8", 0);
+  }
+
+  ori::release();
+  ori::free_coll(buf);
+}
+
+int main(int argc, char** argv) {
+  ityr::init();
+
+  bench::init("ori_bench", argc, argv, "s:",
+              "    -s : max checkout size in bytes (size_t)\n",
+              [](int opt, const char* arg) {
+                if (opt != 's') return false;
+                max_size = atol(arg);
+                return true;
+              });
+
+  run();
+
+  bench::fini();
+  ityr::fini();
+  return 0;
+}
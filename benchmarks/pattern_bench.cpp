@@ -0,0 +1,112 @@
+#include "bench_common.hpp"
+
+/*
+ * Benchmarks for parallel patterns over a global vector (for_each, reduce, inclusive_scan, and sort)
+ *
+ * Each sample is the time of one root_exec() call executing the pattern over the whole vector.
+ * The input is regenerated from a fixed seed before every sample (not timed).
+ */
+
+using elem_t = long;
+
+std::size_t n_input      = std::size_t(1) << 20;
+std::size_t cutoff_count = 4096;
+
+elem_t hash_elem(std::size_t i) {
+  uint64_t x = i * 0x9e3779b97f4a7c15ul;
+  x ^= x >> 31;
+  x *= 0xbf58476d1ce4e5b9ul;
+  x ^= x >> 29;
+  return static_cast<elem_t>(x & 0xffffffff);
+}
+
+void fill_array(ityr::global_span<elem_t> s) {
+  ityr::for_each(
+      ityr::execution::parallel_policy(cutoff_count),
+      ityr::count_iterator<std::size_t>(0),
+      ityr::count_iterator<std::size_t>(s.size()),
+      ityr::make_global_iterator(s.begin(), ityr::checkout_mode::write),
+      [](std::size_t i, elem_t& v) { v = hash_elem(i); });
+}
+
+template <typename Fn>
+void run_pattern(const char* name, ityr::global_span<elem_t> s, Fn&& fn) {
+  if (!bench::enabled(name)) return;
+
+  for (int i = 0; i < bench::n_warmups + bench::n_samples; i++) {
+    ityr::root_exec([=] {
+      fill_array(s);
+    });
+
+    auto t0 = ityr::gettime_ns();
+    ityr::root_exec(fn, s);
+    auto t1 = ityr::gettime_ns();
+
+    if (ityr::is_master() && i >= bench::n_warmups) {
+      bench::add_sample(t1 - t0);
+    }
+  }
+
+  bench::report(name, std::to_string(s.size()), s.size() * sizeof(elem_t));
+}
+
+void run() {
+  ityr::global_vector_options gvec_coll_opts(true, cutoff_count);
+
+  ityr::global_vector<elem_t> a_vec(gvec_coll_opts, n_input);
+  ityr::global_vector<elem_t> b_vec(gvec_coll_opts, n_input);
+
+  ityr::global_span<elem_t> a(a_vec);
+  ityr::global_span<elem_t> b(b_vec);
+
+  run_pattern("for_each", a, [](ityr::global_span<elem_t> s) {
+    ityr::for_each(
+        ityr::execution::parallel_policy(cutoff_count),
+        ityr::make_global_iterator(s.begin(), ityr::checkout_mode::read_write),
+        ityr::make_global_iterator(s.end()  , ityr::checkout_mode::read_write),
+        [](elem_t& v) { v += 1; });
+  });
+
+  run_pattern("reduce", a, [](ityr::global_span<elem_t> s) {
+    ityr::reduce(
+        ityr::execution::parallel_policy(cutoff_count),
+        s.begin(), s.end());
+  });
+
+  run_pattern("inclusive_scan", a, [=](ityr::global_span<elem_t> s) {
+    ityr::inclusive_scan(
+        ityr::execution::parallel_policy(cutoff_count),
+        s.begin(), s.end(), b.begin());
+  });
+
+  run_pattern("sort", a, [](ityr::global_span<elem_t> s) {
+    ityr::sort(
+        ityr::execution::parallel_policy(cutoff_count),
+        s.begin(), s.end());
+  });
+}
+
+int main(int argc, char** argv) {
+  ityr::init();
+
+  // Patterns take much longer than the primitives measured by the other suites
+  bench::n_samples = 10;
+  bench::n_warmups = 1;
+
+  bench::init("pattern_bench", argc, argv, "s:c:",
+              "    -s : # of elements in the global vector (size_t)\n"
+              "    -c : cutoff count for leaf tasks (size_t)\n",
+              [](int opt, const char* arg) {
+                switch (opt) {
+                  case 's': n_input      = atol(arg); return true;
+                  case 'c': cutoff_count = atol(arg); return true;
+                  default:                            return false;
+                }
+              });
+
+  run();
+
+  bench::fini();
+  ityr::fini();
+  return 0;
+}
@@ -0,0 +1,255 @@
+#include "ityr/ityr.hpp"
+
+/*
+ * Sparse matrix-vector multiplication (y = A * x) with a CSR matrix
+ *
+ * A synthetic n x n matrix is generated, where each row has a variable number of nonzeros.
+ * Most of them are within a band around the diagonal (`-b`), and a fraction of them (`-p`)
+ * are at random columns, which causes irregular accesses to remote parts of `x`.
+ */
+
+using index_t = uint64_t;
+
+std::size_t n_rows        = std::size_t(1) << 18;
+int         nnz_per_row   = 16;
+std::size_t bandwidth     = 1024;
+double      far_ratio     = 0.1;
+int         n_iters       = 10;
+int         n_repeats     = 10;
+std::size_t cutoff_count  = 256;
+bool        verify_result = true;
+
+ityr::global_vector_options gvec_coll_opts(true, 1024);
+
+uint64_t hash64(uint64_t x) {
+  x += 0x9e3779b97f4a7c15ul;
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ul;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebul;
+  return x ^ (x >> 31);
+}
+
+double hash_to_unit(uint64_t x) {
+  return static_cast<double>(hash64(x) >> 11) / static_cast<double>(uint64_t(1) << 53);
+}
+
+index_t gen_row_nnz(index_t i) {
+  return nnz_per_row / 2 + hash64(i) % nnz_per_row;
+}
+
+index_t gen_col(index_t i, index_t k) {
+  uint64_t h = hash64((i << 32) + k);
+  if (hash_to_unit(h) < far_ratio) {
+    return (h >> 8) % n_rows;
+  } else {
+    index_t lo = i > bandwidth ? i - bandwidth : 0;
+    index_t hi = std::min(i + bandwidth + 1, n_rows);
+    return lo + (h >> 8) % (hi - lo);
+  }
+}
+
+void generate_matrix(ityr::global_span<index_t> row_ptr,
+                     ityr::global_span<index_t> cols,
+                     ityr::global_span<double>  vals) {
+  ityr::for_each(
+      ityr::execution::parallel_policy(cutoff_count),
+      ityr::count_iterator<index_t>(0),
+      ityr::count_iterator<index_t>(n_rows),
+      ityr::make_global_iterator(row_ptr.begin()    , ityr::checkout_mode::read),
+      ityr::make_global_iterator(row_ptr.begin() + 1, ityr::checkout_mode::read),
+      [=](index_t i, index_t e_begin, index_t e_end) {
+        auto cs = ityr::make_checkout(cols.data() + e_begin, e_end - e_begin, ityr::checkout_mode::write);
+        auto vs = ityr::make_checkout(vals.data() + e_begin, e_end - e_begin, ityr::checkout_mode::write);
+        for (index_t k = 0; k < e_end - e_begin; k++) {
+          cs[k] = gen_col(i, k);
+          vs[k] = hash_to_unit((i << 32) + k + 1);
+        }
+      });
+}
+
+void spmv(ityr::global_span<const index_t> row_ptr,
+          ityr::global_span<const index_t> cols,
+          ityr::global_span<const double>  vals,
+          ityr::global_span<const double>  x,
+          ityr::global_span<double>        y) {
+  ityr::for_each(
+      ityr::execution::parallel_policy(cutoff_count),
+      ityr::make_global_iterator(row_ptr.begin()    , ityr::checkout_mode::read),
+      ityr::make_global_iterator(row_ptr.end() - 1  , ityr::checkout_mode::read),
+      ityr::make_global_iterator(row_ptr.begin() + 1, ityr::checkout_mode::read),
+      ityr::make_global_iterator(y.begin()          , ityr::checkout_mode::write),
+      [=](index_t e_begin, index_t e_end, double& yi) {
+        auto cs = ityr::make_checkout(cols.data() + e_begin, e_end - e_begin, ityr::checkout_mode::read);
+        auto vs = ityr::make_checkout(vals.data() + e_begin, e_end - e_begin, ityr::checkout_mode::read);
+        double sum = 0;
+        for (index_t k = 0; k < e_end - e_begin; k++) {
+          sum += vs[k] * x[cs[k]];
+        }
+        yi = sum;
+      });
+}
+
+void run() {
+  ityr::global_vector<index_t> row_ptr_vec(gvec_coll_opts, n_rows + 1);
+
+  ityr::root_exec([=, row_ptr = ityr::global_span<index_t>(row_ptr_vec)] {
+    row_ptr[0] = 0;
+    ityr::transform_inclusive_scan(
+        ityr::execution::parallel_policy(cutoff_count),
+        ityr::count_iterator<index_t>(0),
+        ityr::count_iterator<index_t>(n_rows),
+        row_ptr.begin() + 1,
+        ityr::reducer::plus<index_t>{},
+        gen_row_nnz);
+  });
+
+  index_t nnz = row_ptr_vec.back();
+
+  ityr::global_vector<index_t> cols_vec(gvec_coll_opts, nnz);
+  ityr::global_vector<double>  vals_vec(gvec_coll_opts, nnz);
+  ityr::global_vector<double>  x_vec(gvec_coll_opts, n_rows, 1.0);
+  ityr::global_vector<double>  y_vec(gvec_coll_opts, n_rows);
+
+  ityr::global_span<index_t> row_ptr(row_ptr_vec);
+  ityr::global_span<index_t> cols(cols_vec);
+  ityr::global_span<double>  vals(vals_vec);
+  ityr::global_span<double>  x(x_vec);
+  ityr::global_span<double>  y(y_vec);
+
+  ityr::root_exec([=] {
+    generate_matrix(row_ptr, cols, vals);
+  });
+
+  if (ityr::is_master()) {
+    printf("# of nonzeros: %ld\n\n", nnz);
+    fflush(stdout);
+  }
+
+  for (int r = 0; r < n_repeats; r++) {
+    ityr::profiler_begin();
+
+    auto t0 = ityr::gettime_ns();
+
+    ityr::root_exec([=] {
+      for (int it = 0; it < n_iters; it++) {
+        spmv(row_ptr, cols, vals, x, y);
+      }
+    });
+
+    auto t1 = ityr::gettime_ns();
+
+    ityr::profiler_end();
+
+    if (ityr::is_master()) {
+      double flops = 2.0 * nnz * n_iters;
+      printf("[%d] %'ld ns (%.3f GFLOP/s)", r, t1 - t0, flops / (t1 - t0));
+    }
+
+    if (verify_result) {
+      // Since x = (1, ..., 1), the sum of y equals the sum of all nonzeros
+      struct sums_t { double y; double vals; };
+      auto [sum_y, sum_vals] = ityr::root_exec([=] {
+        return sums_t{
+            ityr::reduce(ityr::execution::parallel_policy(cutoff_count), y.begin(), y.end()),
+            ityr::reduce(ityr::execution::parallel_policy(cutoff_count), vals.begin(), vals.end())};
+      });
+      if (ityr::is_master()) {
+        if (std::abs(sum_y - sum_vals) <= 1e-9 * std::abs(sum_vals)) {
+          printf(" - Result verified");
+        } else {
+          printf(" - Wrong result: sum of y should be %f but got %f", sum_vals, sum_y);
+        }
+      }
+    }
+
+    if (ityr::is_master()) {
+      printf("\n");
+      fflush(stdout);
+    }
+
+    ityr::profiler_flush();
+  }
+}
+
+void show_help_and_exit(int argc [[maybe_unused]], char** argv) {
+  if (ityr::is_master()) {
+    printf("Usage: %s [options]\n"
+           "  options:\n"
+           "    -n : # of rows (size_t)\n"
+           "    -k : average # of nonzeros per row (int)\n"
+           "    -b : bandwidth of nonzeros around the diagonal (size_t)\n"
+           "    -p : ratio of nonzeros at random columns (double)\n"
+           "    -i : # of SpMV iterations per repeat (int)\n"
+           "    -r : # of repeats (int)\n"
+           "    -c : cutoff count for leaf tasks (size_t)\n"
+           "    -v : verify the result (int)\n", argv[0]);
+  }
+  exit(1);
+}
+
+int main(int argc, char** argv) {
+  ityr::init();
+
+  int opt;
+  while ((opt = getopt(argc, argv, "n:k:b:p:i:r:c:v:h")) != EOF) {
+    switch (opt) {
+      case 'n':
+        n_rows = atol(optarg);
+        break;
+      case 'k':
+        nnz_per_row = atoi(optarg);
+        break;
+      case 'b':
+        bandwidth = atol(optarg);
+        break;
+      case 'p':
+        far_ratio = atof(optarg);
+        break;
+      case 'i':
+        n_iters = atoi(optarg);
+        break;
+      case 'r':
+        n_repeats = atoi(optarg);
+        break;
+      case 'c':
+        cutoff_count = atol(optarg);
+        break;
+      case 'v':
+        verify_result = atoi(optarg);
+        break;
+      case 'h':
+      default:
+        show_help_and_exit(argc, argv);
+    }
+  }
+
+  if (ityr::is_master()) {
+    setlocale(LC_NUMERIC, "en_US.UTF-8");
+    printf("=============================================================\n"
+           "[SpMV]\n"
+           "# of processes:               %d\n"
+           "# of rows:                    %ld\n"
+           "Average # of nonzeros / row:  %d\n"
+           "Bandwidth:                    %ld\n"
+           "Ratio of far nonzeros:        %f\n"
+           "# of iterations:              %d\n"
+           "# of repeats:                 %d\n"
+           "Cutoff count:                 %ld\n"
+           "Verify result:                %d\n"
+           "-------------------------------------------------------------\n",
+           ityr::n_ranks(), n_rows, nnz_per_row, bandwidth, far_ratio,
+           n_iters, n_repeats, cutoff_count, verify_result);
+
+    printf("[Compile Options]\n");
+    ityr::print_compile_options();
+    printf("-------------------------------------------------------------\n");
+    printf("[Runtime Options]\n");
+    ityr::print_runtime_options();
+    printf("=============================================================\n\n");
+    fflush(stdout);
+  }
+
+  run();
+
+  ityr::fini();
+  return 0;
+}
@@ -0,0 +1,201 @@
+#include "ityr/ityr.hpp"
+
+/*
+ * 2-D Jacobi stencil (5-point) on an n x n grid
+ *
+ * The grid is stored in row-major order in a global vector. Each leaf task updates a set of rows,
+ * reading the rows above and below it, so that neighboring tasks share halo rows through caches.
+ * The top boundary is fixed to 1 and the other boundaries are fixed to 0.
+ */
+
+std::size_t n_grid        = 2048;
+int         n_iters       = 10;
+int         n_repeats     = 10;
+std::size_t cutoff_rows   = 4;
+bool        verify_result = true;
+
+ityr::global_vector_options gvec_coll_opts(true, 1024);
+
+void init_grid(ityr::global_span<double> a) {
+  std::size_t n = n_grid;
+  ityr::for_each(
+      ityr::execution::parallel_policy(cutoff_rows * n),
+      ityr::count_iterator<std::size_t>(0),
+      ityr::count_iterator<std::size_t>(n * n),
+      ityr::make_global_iterator(a.begin(), ityr::checkout_mode::write),
+      [=](std::size_t k, double& v) { v = (k < n) ? 1.0 : 0.0; });
+}
+
+void jacobi_step(ityr::global_span<const double> a, ityr::global_span<double> b) {
+  std::size_t n = n_grid;
+  ityr::for_each(
+      ityr::execution::parallel_policy(cutoff_rows),
+      ityr::count_iterator<std::size_t>(1),
+      ityr::count_iterator<std::size_t>(n - 1),
+      [=](std::size_t i) {
+        auto src = ityr::make_checkout(a.data() + (i - 1) * n, 3 * n, ityr::checkout_mode::read);
+        auto dst = ityr::make_checkout(b.data() + i * n + 1, n - 2, ityr::checkout_mode::write);
+        const double* up   = src.data();
+        const double* mid  = src.data() + n;
+        const double* down = src.data() + 2 * n;
+        for (std::size_t j = 1; j < n - 1; j++) {
+          dst[j - 1] = 0.25 * (up[j] + down[j] + mid[j - 1] + mid[j + 1]);
+        }
+      });
+}
+
+double jacobi_serial_checksum() {
+  std::size_t n = n_grid;
+  std::vector<double> a(n * n, 0.0), b;
+  std::fill(a.begin(), a.begin() + n, 1.0);
+  b = a;
+  for (int it = 0; it < n_iters; it++) {
+    for (std::size_t i = 1; i < n - 1; i++) {
+      for (std::size_t j = 1; j < n - 1; j++) {
+        b[i * n + j] = 0.25 * (a[(i - 1) * n + j] + a[(i + 1) * n + j] + a[i * n + j - 1] + a[i * n + j + 1]);
+      }
+    }
+    std::swap(a, b);
+  }
+  return std::accumulate(a.begin(), a.end(), 0.0);
+}
+
+void run() {
+  ityr::global_vector<double> a_vec(gvec_coll_opts, n_grid * n_grid);
+  ityr::global_vector<double> b_vec(gvec_coll_opts, n_grid * n_grid);
+
+  ityr::global_span<double> a(a_vec);
+  ityr::global_span<double> b(b_vec);
+
+  double answer = 0;
+  if (verify_result && ityr::is_master()) {
+    answer = jacobi_serial_checksum();
+  }
+
+  for (int r = 0; r < n_repeats; r++) {
+    ityr::root_exec([=] {
+      init_grid(a);
+      init_grid(b);
+    });
+
+    ityr::profiler_begin();
+
+    auto t0 = ityr::gettime_ns();
+
+    ityr::root_exec([=] {
+      for (int it = 0; it < n_iters; it++) {
+        if (it % 2 == 0) {
+          jacobi_step(a, b);
+        } else {
+          jacobi_step(b, a);
+        }
+      }
+    });
+
+    auto t1 = ityr::gettime_ns();
+
+    ityr::profiler_end();
+
+    if (ityr::is_master()) {
+      double n_points = static_cast<double>(n_grid - 2) * (n_grid - 2) * n_iters;
+      printf("[%d] %'ld ns (%.3f GFLOP/s, %.3f Gpoints/s)",
+             r, t1 - t0, 4 * n_points / (t1 - t0), n_points / (t1 - t0));
+    }
+
+    if (verify_result) {
+      ityr::global_span<double> result = (n_iters % 2 == 0) ? a : b;
+      double checksum = ityr::root_exec([=] {
+        return ityr::reduce(ityr::execution::parallel_policy(cutoff_rows * n_grid), result.begin(), result.end());
+      });
+      if (ityr::is_master()) {
+        if (std::abs(checksum - answer) <= 1e-9 * std::abs(answer)) {
+          printf(" - Result verified");
+        } else {
+          printf(" - Wrong result: checksum should be %f but got %f", answer, checksum);
+        }
+      }
+    }
+
+    if (ityr::is_master()) {
+      printf("\n");
+      fflush(stdout);
+    }
+
+    ityr::profiler_flush();
+  }
+}
+
+void show_help_and_exit(int argc [[maybe_unused]], char** argv) {
+  if (ityr::is_master()) {
+    printf("Usage: %s [options]\n"
+           "  options:\n"
+           "    -n : grid size in each dimension (size_t)\n"
+           "    -i : # of Jacobi iterations per repeat (int)\n"
+           "    -r : # of repeats (int)\n"
+           "    -c : cutoff count of rows for leaf tasks (size_t)\n"
+           "    -v : verify the result (int)\n", argv[0]);
+  }
+  exit(1);
+}
+
+int main(int argc, char** argv) {
+  ityr::init();
+
+  int opt;
+  while ((opt = getopt(argc, argv, "n:i:r:c:v:h")) != EOF) {
+    switch (opt) {
+      case 'n':
+        n_grid = atol(optarg);
+        break;
+      case 'i':
+        n_iters = atoi(optarg);
+        break;
+      case 'r':
+        n_repeats = atoi(optarg);
+        break;
+      case 'c':
+        cutoff_rows = atol(optarg);
+        break;
+      case 'v':
+        verify_result = atoi(optarg);
+        break;
+      case 'h':
+      default:
+        show_help_and_exit(argc, argv);
+    }
+  }
+
+  if (n_grid < 3) {
+    if (ityr::is_master()) {
+      printf("Grid size (-n) must be at least 3\n");
+    }
+    exit(1);
+  }
+
+  if (ityr::is_master()) {
+    setlocale(LC_NUMERIC, "en_US.UTF-8");
+    printf("=============================================================\n"
+           "[Stencil]\n"
+           "# of processes:               %d\n"
+           "Grid size:                    %ld x %ld\n"
+           "# of iterations:              %d\n"
+           "# of repeats:                 %d\n"
+           "Cutoff rows:                  %ld\n"
+           "Verify result:                %d\n"
+           "-------------------------------------------------------------\n",
+           ityr::n_ranks(), n_grid, n_grid, n_iters, n_repeats, cutoff_rows, verify_result);
+
+    printf("[Compile Options]\n");
+    ityr::print_compile_options();
+    printf("-------------------------------------------------------------\n");
+    printf("[Runtime Options]\n");
+    ityr::print_runtime_options();
+    printf("=============================================================\n\n");
+    fflush(stdout);
+  }
+
+  run();
+
+  ityr::fini();
+  return 0;
+}
@@ -0,0 +1,221 @@
+#include "ityr/ityr.hpp"
+
+/*
+ * Unbalanced Tree Search (UTS)
+ *
+ * Counts the nodes of an implicitly defined unbalanced tree, whose shape is determined by
+ * a per-node random state. Two tree types of the original UTS benchmark are supported:
+ * - Geometric (-t 0): the number of children follows a geometric distribution with mean `b0`,
+ *   and nodes at depth `d` have no children (similar to T1).
+ * - Binomial (-t 1): the root has `b0` children, and other nodes have `m` children with
+ *   probability `q` (similar to T3). The expected tree size is `b0 / (1 - m * q)`.
+ *
+ * Unlike the original UTS, the random state is derived with a 64-bit mixing function instead of
+ * SHA-1, so the tree sizes differ from the published ones.
+ *
+ * As `m * q` approaches 1, binomial trees become very deep. Increase `ITYR_ITO_STACK_SIZE` if
+ * the thread stack overflows.
+ */
+
+using result_t = uint64_t;
+
+enum class tree_kind : int {
+  geometric = 0,
+  binomial  = 1,
+};
+
+tree_kind tree_type     = tree_kind::binomial;
+int       root_branch   = 2000;
+int       max_depth     = 10;
+int       bin_m         = 8;
+double    bin_q         = 0.12375;
+uint64_t  root_seed     = 42;
+int       n_repeats     = 10;
+bool      verify_result = true;
+
+uint64_t hash64(uint64_t x) {
+  x += 0x9e3779b97f4a7c15ul;
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ul;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebul;
+  return x ^ (x >> 31);
+}
+
+double hash_to_unit(uint64_t x) {
+  return static_cast<double>(hash64(x) >> 11) / static_cast<double>(uint64_t(1) << 53);
+}
+
+struct node {
+  uint64_t state;
+  int      depth;
+};
+
+node child_node(const node& parent, int i) {
+  return {hash64(parent.state ^ (0x9e3779b97f4a7c15ul * (i + 1))), parent.depth + 1};
+}
+
+int n_children(const node& n) {
+  switch (tree_type) {
+    case tree_kind::geometric: {
+      if (n.depth >= max_depth) return 0;
+      // geometric distribution with mean `root_branch`
+      double p = 1.0 / (1.0 + root_branch);
+      double u = hash_to_unit(n.state);
+      return static_cast<int>(std::floor(std::log(1.0 - u) / std::log(1.0 - p)));
+    }
+    case tree_kind::binomial: {
+      if (n.depth == 0) return root_branch;
+      return hash_to_unit(n.state) < bin_q ? bin_m : 0;
+    }
+    default:
+      return 0;
+  }
+}
+
+result_t uts(const node& n) {
+  return 1 + ityr::transform_reduce(
+      ityr::execution::par,
+      ityr::count_iterator<int>(0),
+      ityr::count_iterator<int>(n_children(n)),
+      ityr::reducer::plus<result_t>{},
+      [=](int i) { return uts(child_node(n, i)); });
+}
+
+result_t uts_serial(const node& n) {
+  result_t count = 1;
+  int nc = n_children(n);
+  for (int i = 0; i < nc; i++) {
+    count += uts_serial(child_node(n, i));
+  }
+  return count;
+}
+
+void run() {
+  node root = {hash64(root_seed), 0};
+
+  result_t answer = 0;
+  if (verify_result && ityr::is_master()) {
+    answer = uts_serial(root);
+  }
+
+  for (int r = 0; r < n_repeats; r++) {
+    ityr::profiler_begin();
+
+    auto t0 = ityr::gettime_ns();
+
+    result_t result = ityr::root_exec([=] {
+      return uts(root);
+    });
+
+    auto t1 = ityr::gettime_ns();
+
+    ityr::profiler_end();
+
+    if (ityr::is_master()) {
+      printf("[%d] %'ld ns (%'ld nodes, %.3f Mnodes/s)", r, t1 - t0, result, result / static_cast<double>(t1 - t0) * 1e3);
+
+      if (verify_result) {
+        if (result == answer) {
+          printf(" - Result verified");
+        } else {
+          printf(" - Wrong result: # of nodes should be %ld but got %ld", answer, result);
+        }
+      }
+
+      printf("\n");
+      fflush(stdout);
+    }
+
+    ityr::profiler_flush();
+  }
+}
+
+void show_help_and_exit(int argc [[maybe_unused]], char** argv) {
+  if (ityr::is_master()) {
+    printf("Usage: %s [options]\n"
+           "  options:\n"
+           "    -t : tree type (0: geometric, 1: binomial)\n"
+           "    -b : branching factor of the root (binomial) or mean branching factor (geometric) (int)\n"
+           "    -d : max depth of the geometric tree (int)\n"
+           "    -m : # of children of non-root nodes in the binomial tree (int)\n"
+           "    -q : probability of having children in the binomial tree (double)\n"
+           "    -s : root seed (int)\n"
+           "    -r : # of repeats (int)\n"
+           "    -v : verify the result (int)\n", argv[0]);
+  }
+  exit(1);
+}
+
+int main(int argc, char** argv) {
+  ityr::init();
+
+  int opt;
+  while ((opt = getopt(argc, argv, "t:b:d:m:q:s:r:v:h")) != EOF) {
+    switch (opt) {
+      case 't':
+        tree_type = static_cast<tree_kind>(atoi(optarg));
+        break;
+      case 'b':
+        root_branch = atoi(optarg);
+        break;
+      case 'd':
+        max_depth = atoi(optarg);
+        break;
+      case 'm':
+        bin_m = atoi(optarg);
+        break;
+      case 'q':
+        bin_q = atof(optarg);
+        break;
+      case 's':
+        root_seed = atol(optarg);
+        break;
+      case 'r':
+        n_repeats = atoi(optarg);
+        break;
+      case 'v':
+        verify_result = atoi(optarg);
+        break;
+      case 'h':
+      default:
+        show_help_and_exit(argc, argv);
+    }
+  }
+
+  if (tree_type != tree_kind::geometric && tree_type != tree_kind::binomial) {
+    show_help_and_exit(argc, argv);
+  }
+
+  if (ityr::is_master()) {
+    setlocale(LC_NUMERIC, "en_US.UTF-8");
+    printf("=============================================================\n"
+           "[UTS]\n"
+           "# of processes:               %d\n"
+           "Tree type:                    %s\n"
+           "Root branching factor:        %d\n",
+           ityr::n_ranks(), tree_type == tree_kind::geometric ? "geometric" : "binomial", root_branch);
+    if (tree_type == tree_kind::geometric) {
+      printf("Max depth:                    %d\n", max_depth);
+    } else {
+      printf("m:                            %d\n"
+             "q:                            %f\n", bin_m, bin_q);
+    }
+    printf("Root seed:                    %ld\n"
+           "# of repeats:                 %d\n"
+           "Verify result:                %d\n"
+           "-------------------------------------------------------------\n",
+           root_seed, n_repeats, verify_result);
+
+    printf("[Compile Options]\n");
+    ityr::print_compile_options();
+    printf("-------------------------------------------------------------\n");
+    printf("[Runtime Options]\n");
+    ityr::print_runtime_options();
+    printf("=============================================================\n\n");
+    fflush(stdout);
+  }
+
+  run();
+
+  ityr::fini();
+  return 0;
+}
@@ -188,6 +188,9 @@ void run() {
   ityr::global_vector<elem_t> a_vec(gvec_coll_opts, n_input);
   ityr::global_vector<elem_t> b_vec(gvec_coll_opts, n_input);
 
+  ityr::ori::set_coll_label(a_vec.data(), "a");
+  ityr::ori::set_coll_label(b_vec.data(), "b");
+
   ityr::global_span<elem_t> a(a_vec);
   ityr::global_span<elem_t> b(b_vec);
 
@@ -0,0 +1,301 @@
+#pragma once
+
+#include <fstream>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <set>
+
+#include "ityr/ityr.hpp"
+
+namespace ityr {
+
+/*
+ * Autotuner of runtime options
+ *
+ * This header is not included by `ityr/ityr.hpp`; include `ityr/autotune.hpp` to use `ityr::autotune()`.
+ */
+
+/**
+ * @brief Runtime option to be tuned and its candidate values.
+ * @see `ityr::autotune()`
+ */
+struct autotune_param {
+  std::string              name;   ///< Name of the runtime option (e.g., `"ITYR_ORI_CACHE_SIZE"`).
+  std::vector<std::string> values; ///< Candidate values of the runtime option.
+};
+
+/**
+ * @brief Settings of the autotuner.
+ * @see `ityr::autotune()`
+ */
+struct autotune_options {
+  std::size_t max_configs      = 64;                  ///< Max # of configurations sampled from the search space.
+  int         min_repeats      = 1;                   ///< # of kernel runs per configuration in the first round.
+  int         reduction_factor = 2;                   ///< Only 1/`reduction_factor` of configurations survive each round.
+  uint64_t    seed             = 0;                   ///< Random seed for sampling configurations.
+  std::string output_file      = "ityr_autotune.env"; ///< Environment file to write the best configuration to.
+  bool        verbose          = true;                ///< Print the time of each configuration.
+};
+
+/**
+ * @brief Result of the autotuner.
+ * @see `ityr::autotune()`
+ */
+struct autotune_result {
+  std::vector<std::pair<std::string, std::string>> config;        ///< Best values of the runtime options.
+  double                                           time;          ///< Best execution time of the kernel (s).
+  std::size_t                                      n_evaluations; ///< # of Itoyori runs performed.
+};
+
+namespace internal {
+
+using autotune_config = std::vector<std::pair<std::string, std::string>>;
+
+inline std::vector<autotune_config>
+autotune_sample_configs(const std::vector<autotune_param>& params, const autotune_options& opts) {
+  std::size_t n_total = 1;
+  for (auto&& p : params) {
+    if (p.values.empty()) {
+      common::die("[ityr::autotune] No candidate values are given for %s.", p.name.c_str());
+    }
+    n_total = (n_total > std::numeric_limits<std::size_t>::max() / p.values.size()) ?
+              std::numeric_limits<std::size_t>::max() : n_total * p.values.size();
+  }
+
+  // Each configuration is identified by a mixed-radix index over the candidate values.
+  // All processes sample the same set of indices because they use the same seed.
+  std::vector<std::size_t> indices;
+  if (n_total <= opts.max_configs) {
+    for (std::size_t i = 0; i < n_total; i++) {
+      indices.push_back(i);
+    }
+  } else {
+    std::mt19937_64 engine(opts.seed);
+    std::uniform_int_distribution<std::size_t> dist(0, n_total - 1);
+    std::set<std::size_t> sampled;
+    while (sampled.size() < opts.max_configs) {
+      sampled.insert(dist(engine));
+    }
+    indices.assign(sampled.begin(), sampled.end());
+  }
+
+  std::vector<autotune_config> configs;
+  for (std::size_t idx : indices) {
+    autotune_config c;
+    for (auto&& p : params) {
+      c.emplace_back(p.name, p.values[idx % p.values.size()]);
+      idx /= p.values.size();
+    }
+    configs.push_back(std::move(c));
+  }
+  return configs;
+}
+
+inline std::string autotune_config_str(const autotune_config& c) {
+  std::string s;
+  for (auto&& [name, val] : c) {
+    if (!s.empty()) s += " ";
+    s += name + "=" + val;
+  }
+  return s;
+}
+
+inline void autotune_check_registered(const autotune_config& c) {
+  auto& opts = common::get_options();
+  for (auto&& [name, val] : c) {
+    if (std::none_of(opts.begin(), opts.end(),
+                     [&](common::option_base* opt) { return opt->option_name() == name; })) {
+      common::die("[ityr::autotune] %s is not a runtime option of Itoyori.", name.c_str());
+    }
+  }
+}
+
+// Run the kernel `n_repeats` times with Itoyori initialized under the given configuration
+// and return the minimum execution time
+template <typename Fn>
+inline double autotune_eval(MPI_Comm comm, const autotune_config& c, int n_repeats, Fn& fn) {
+  // The configuration takes precedence over environment variables while Itoyori is initialized
+  for (auto&& [name, val] : c) {
+    common::set_option_override(name, val);
+  }
+
+  init(comm);
+
+  common::clear_option_overrides();
+
+  autotune_check_registered(c);
+
+  double t_min = std::numeric_limits<double>::max();
+  for (int r = 0; r < n_repeats; r++) {
+    double t;
+    if constexpr (std::is_void_v<std::invoke_result_t<Fn&>>) {
+      auto t0 = gettime_ns();
+      root_exec(fn);
+      auto t1 = gettime_ns();
+      t = (t1 - t0) / 1000000000.0;
+    } else {
+      t = static_cast<double>(root_exec(fn));
+    }
+    t_min = std::min(t_min, t);
+  }
+  t_min = common::mpi_bcast_value(t_min, 0, common::topology::mpicomm());
+
+  fini();
+
+  return t_min;
+}
+
+}
+
+/**
+ * @brief Search for the best values of runtime options for a kernel (collective).
+ *
+ * @param params Runtime options to be tuned and their candidate values.
+ * @param fn     Kernel function to be called by the root thread.
+ * @param opts   Settings of the autotuner (optional).
+ * @param comm   MPI communicator to be used in Itoyori (default: `MPI_COMM_WORLD`).
+ *
+ * @return The best configuration and its execution time.
+ *
+ * This function must be called while Itoyori is not initialized, because most runtime options are
+ * read only at `ityr::init()`. For each configuration, Itoyori is initialized with the options
+ * overriding the environment variables, `fn` is executed under `ityr::root_exec()` repeatedly, and Itoyori is
+ * finalized. If `fn` returns a value, it is used as the execution time in seconds (e.g., to exclude
+ * the time for input generation); otherwise, the time for `ityr::root_exec()` is measured.
+ * Global memory is freed between configurations, so `fn` must allocate its own data.
+ *
+ * The search is done by successive halving: up to `opts.max_configs` configurations are sampled from
+ * the cross product of candidate values, and in each round, all remaining configurations are run
+ * and only the fastest 1/`opts.reduction_factor` of them survive to the next round, which runs the
+ * kernel `opts.reduction_factor` times as many. The best configuration is written to
+ * `opts.output_file` (if not empty) as `NAME=VALUE` lines by the master process.
+ *
+ * Example:
+ * ```
+ * #include "ityr/autotune.hpp"
+ *
+ * int main() {
+ *   auto result = ityr::autotune(
+ *       {{"ITYR_ORI_CACHE_SIZE"    , {"67108864", "134217728", "268435456"}},
+ *        {"ITYR_ORI_SUB_BLOCK_SIZE", {"1024", "4096"}}},
+ *       [=] { run_kernel(); });
+ * }
+ * ```
+ */
+template <typename Fn>
+inline autotune_result autotune(const std::vector<autotune_param>& params,
+                                Fn&&                               fn,
+                                const autotune_options&            opts = {},
+                                MPI_Comm                           comm = MPI_COMM_WORLD) {
+  if (internal::instance::initialized()) {
+    common::die("[ityr::autotune] Itoyori must not be initialized when calling ityr::autotune().");
+  }
+  if (opts.min_repeats < 1 || opts.reduction_factor < 2) {
+    common::die("[ityr::autotune] min_repeats must be >= 1 and reduction_factor must be >= 2.");
+  }
+
+  // Keep MPI initialized across multiple Itoyori runs
+  common::mpi_initializer mi(comm);
+  bool is_master = common::mpi_comm_rank(comm) == 0;
+
+  auto configs = internal::autotune_sample_configs(params, opts);
+  std::vector<double> times(configs.size(), std::numeric_limits<double>::max());
+
+  std::vector<std::size_t> survivors(configs.size());
+  std::iota(survivors.begin(), survivors.end(), 0);
+
+  std::size_t n_evals = 0;
+  int n_repeats = opts.min_repeats;
+  int round = 0;
+
+  do {
+    if (is_master && opts.verbose) {
+      printf("[ityr::autotune] Round %d: %ld configurations x %d repeats\n",
+             round, survivors.size(), n_repeats);
+      fflush(stdout);
+    }
+
+    for (std::size_t i : survivors) {
+      double t = internal::autotune_eval(comm, configs[i], n_repeats, fn);
+      times[i] = std::min(times[i], t);
+      n_evals++;
+
+      if (is_master && opts.verbose) {
+        printf("  %s : %f s\n", internal::autotune_config_str(configs[i]).c_str(), t);
+        fflush(stdout);
+      }
+    }
+
+    std::stable_sort(survivors.begin(), survivors.end(),
+                     [&](std::size_t a, std::size_t b) { return times[a] < times[b]; });
+
+    std::size_t n_survivors = (survivors.size() + opts.reduction_factor - 1) / opts.reduction_factor;
+    survivors.resize(std::max(n_survivors, std::size_t(1)));
+
+    n_repeats *= opts.reduction_factor;
+    round++;
+  } while (survivors.size() > 1);
+
+  std::size_t best = survivors.front();
+  autotune_result result {configs[best], times[best], n_evals};
+
+  if (is_master) {
+    if (opts.verbose) {
+      printf("[ityr::autotune] Best configuration (%f s): %s\n",
+             result.time, internal::autotune_config_str(result.config).c_str());
+      fflush(stdout);
+    }
+
+    if (!opts.output_file.empty()) {
+      std::ofstream ofs(opts.output_file);
+      if (!ofs) {
+        common::die("[ityr::autotune] Cannot open %s.", opts.output_file.c_str());
+      }
+      ofs << "# Generated by ityr::autotune() (time: " << result.time << " s)" << std::endl;
+      for (auto&& [name, val] : result.config) {
+        ofs << name << "=" << val << std::endl;
+      }
+    }
+  }
+
+  return result;
+}
+
+ITYR_TEST_CASE("[ityr::autotune] successive halving") {
+  std::string output_file = "ityr_autotune_test.env";
+
+  autotune_options opts;
+  opts.output_file = output_file;
+  opts.verbose     = false;
+
+  auto result = autotune({{"ITYR_ORI_CACHE_SIZE"      , {"33554432", "16777216"}},
+                          {"ITYR_ITO_WSQUEUE_CAPACITY", {"1024", "2048"}}},
+                         [] {
+                           // smaller cache size and larger wsqueue capacity are "faster"
+                           return static_cast<double>(ori::cache_size_option::value()) /
+                                  static_cast<double>(ito::wsqueue_capacity_option::value());
+                         },
+                         opts);
+
+  ITYR_CHECK(result.n_evaluations == 4 + 2);
+  ITYR_CHECK(result.config.size() == 2);
+  ITYR_CHECK(result.config[0].second == "16777216");
+  ITYR_CHECK(result.config[1].second == "2048");
+  ITYR_CHECK(result.time == 16777216.0 / 2048.0);
+
+  common::mpi_barrier(MPI_COMM_WORLD);
+  if (common::mpi_comm_rank(MPI_COMM_WORLD) == 0) {
+    std::ifstream ifs(output_file);
+    std::string line;
+    std::getline(ifs, line); // comment
+    std::getline(ifs, line);
+    ITYR_CHECK(line == "ITYR_ORI_CACHE_SIZE=16777216");
+    std::getline(ifs, line);
+    ITYR_CHECK(line == "ITYR_ITO_WSQUEUE_CAPACITY=2048");
+    ifs.close();
+    std::remove(output_file.c_str());
+  }
+}
+
+}
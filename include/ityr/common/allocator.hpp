@@ -23,6 +23,7 @@ namespace ityr::common { namespace pmr = std::pmr; }
 #include "ityr/common/virtual_mem.hpp"
 #include "ityr/common/physical_mem.hpp"
 #include "ityr/common/freelist.hpp"
+#include "ityr/common/mem_usage.hpp"
 #include "ityr/common/profiler.hpp"
 #include "ityr/common/prof_events.hpp"
 #include "ityr/common/options.hpp"
@@ -35,9 +36,15 @@ class mpi_win_resource final : public pmr::memory_resource {
 public:
   mpi_win_resource(void*       base_addr,
                    std::size_t max_size,
-                   MPI_Win     win)
+                   MPI_Win     win,
+                   const char* name)
     : win_(win),
-      freelist_(reinterpret_cast<uintptr_t>(base_addr), max_size) {}
+      freelist_(reinterpret_cast<uintptr_t>(base_addr), max_size),
+      name_(name) {
+    usage_.capacity = max_size;
+  }
+
+  const mem_usage& usage() const { return usage_; }
 
   void* do_allocate(std::size_t bytes, std::size_t alignment) override {
     if (alignment % get_page_size() != 0) {
@@ -49,9 +56,12 @@ public:
 
     auto s = freelist_.get(real_bytes, alignment);
     if (!s.has_value()) {
-      die("[ityr::common::allocator] Could not allocate memory for malloc_local()");
+      die("[ityr::common::allocator] Could not allocate %ld bytes for %s (%ld/%ld bytes in use, peak %ld bytes)",
+          real_bytes, name_, usage_.current, usage_.capacity, usage_.peak);
     }
 
+    usage_.add(real_bytes);
+
     void* ret = reinterpret_cast<void*>(*s);
 
     if constexpr (use_dynamic_win) {
@@ -79,6 +89,8 @@ public:
     }
 
     freelist_.add(reinterpret_cast<uintptr_t>(p), real_bytes);
+
+    usage_.sub(real_bytes);
   }
 
   bool do_is_equal(const pmr::memory_resource& other) const noexcept override {
@@ -86,8 +98,10 @@ public:
   }
 
 private:
-  MPI_Win  win_;
-  freelist freelist_;
+  MPI_Win     win_;
+  freelist    freelist_;
+  const char* name_;
+  mem_usage   usage_;
 };
 
 class block_resource final : public pmr::memory_resource {
@@ -138,23 +152,32 @@ private:
 
 class remotable_resource final : public pmr::memory_resource {
 public:
-  remotable_resource(std::size_t local_max_size)
+  remotable_resource(std::size_t local_max_size, const char* name = "remotable memory")
     : local_max_size_(calc_local_max_size(local_max_size)),
       global_max_size_(local_max_size_ * topology::n_ranks()),
       vm_(reserve_same_vm_coll(global_max_size_, local_max_size_)),
       pm_(init_pm()),
       local_base_addr_(reinterpret_cast<std::byte*>(vm_.addr()) + local_max_size_ * topology::my_rank()),
       win_(create_win()),
-      win_mr_(local_base_addr_, local_max_size_, win()),
+      win_mr_(local_base_addr_, local_max_size_, win(), name),
       block_mr_(&win_mr_, allocator_block_size_option::value()),
       std_pool_mr_(my_std_pool_options(), &block_mr_),
       max_unflushed_free_objs_(allocator_max_unflushed_free_objs_option::value()),
       allocated_size_(0),
       collect_threshold_(std::size_t(16) * 1024),
-      collect_threshold_max_(local_max_size_ * 8 / 10) {}
+      collect_threshold_max_(local_max_size_ * 8 / 10) {
+    if constexpr (!use_dynamic_win) {
+      topology::check_numa_placement(name, local_base_addr_, local_max_size_);
+    }
+  }
 
   MPI_Win win() const { return win_.win(); }
 
+  // Objects not yet freed or collected (including headers)
+  mem_usage usage() const {
+    return {allocated_size_, peak_allocated_size_, local_max_size_};
+  }
+
   bool has(const void* p) const {
     return vm_.addr() <= p && p < reinterpret_cast<std::byte*>(vm_.addr()) + global_max_size_;
   }
@@ -199,6 +222,7 @@ public:
     allocated_list_end_ = h;
 
     allocated_size_ += real_bytes;
+    peak_allocated_size_ = std::max(peak_allocated_size_, allocated_size_);
 
     return ret;
   }
@@ -250,6 +274,9 @@ public:
     }
   }
 
+  // Unlike ori::noncoll_mem, this walks all live objects. Objects here are only scheduler-internal
+  // thread states and evacuated frames, whose number is bounded by the outstanding suspended
+  // threads, and collection runs only when the allocated size exceeds a doubling threshold.
   void collect_deallocated() {
     ITYR_PROFILER_RECORD(prof_event_allocator_collect);
 
@@ -326,6 +353,12 @@ private:
       pm.map_to_vm(begin_addr, local_max_size_, offset);
     }
 
+    if (topology::numa_enabled()) {
+      topology::numa_bind_local(reinterpret_cast<std::byte*>(vm_.addr()) + local_max_size_ * topology::my_rank(),
+                                local_max_size_);
+      mpi_barrier(topology::intra_mpicomm());
+    }
+
     return pm;
   }
 
@@ -396,6 +429,7 @@ private:
   header                            allocated_list_;
   header*                           allocated_list_end_ = &allocated_list_;
   std::size_t                       allocated_size_;
+  std::size_t                       peak_allocated_size_ = 0;
   std::size_t                       collect_threshold_;
   std::size_t                       collect_threshold_max_;
 };
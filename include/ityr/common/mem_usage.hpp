@@ -0,0 +1,68 @@
+#pragma once
+
+#include "ityr/common/util.hpp"
+#include "ityr/common/mpi_util.hpp"
+#include "ityr/common/topology.hpp"
+
+namespace ityr::common {
+
+/**
+ * @brief Current and peak usage of a memory pool.
+ *
+ * The unit depends on the pool (e.g., bytes, cache blocks, or queue entries).
+ * `capacity` is 0 if the pool does not have a fixed capacity.
+ */
+struct mem_usage {
+  std::size_t current  = 0;
+  std::size_t peak     = 0;
+  std::size_t capacity = 0;
+
+  void add(std::size_t n) {
+    current += n;
+    if (current > peak) peak = current;
+  }
+
+  void sub(std::size_t n) {
+    ITYR_CHECK(current >= n);
+    current -= n;
+  }
+
+  void set(std::size_t n) {
+    current = n;
+    if (current > peak) peak = current;
+  }
+};
+
+// Print the maximum usage among all processes (collective)
+inline void print_mem_usage(const char* name, const mem_usage& mu, const char* unit) {
+  auto current_max  = mpi_reduce_value(mu.current , 0, topology::mpicomm(), MPI_MAX);
+  auto peak_max     = mpi_reduce_value(mu.peak    , 0, topology::mpicomm(), MPI_MAX);
+  auto capacity_min = mpi_reduce_value(mu.capacity, 0, topology::mpicomm(), MPI_MIN);
+
+  if (topology::my_rank() == 0) {
+    if (capacity_min > 0) {
+      printf("  %-24s current %14ld  peak %14ld / %14ld %-7s (%5.1f %%)\n",
+             name, current_max, peak_max, capacity_min, unit, 100.0 * peak_max / capacity_min);
+    } else {
+      printf("  %-24s current %14ld  peak %14ld   %14s %-7s\n",
+             name, current_max, peak_max, "", unit);
+    }
+  }
+}
+
+ITYR_TEST_CASE("[ityr::common::mem_usage] current and peak usage") {
+  mem_usage mu;
+  mu.capacity = 100;
+  mu.add(30);
+  mu.add(50);
+  mu.sub(60);
+  ITYR_CHECK(mu.current == 20);
+  ITYR_CHECK(mu.peak == 80);
+  mu.set(10);
+  ITYR_CHECK(mu.current == 10);
+  ITYR_CHECK(mu.peak == 80);
+  mu.set(90);
+  ITYR_CHECK(mu.peak == 90);
+}
+
+}
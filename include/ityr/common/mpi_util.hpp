@@ -222,6 +222,22 @@ inline std::vector<T> mpi_allgather_value(const T& value,
   return result;
 }
 
+template <typename T>
+inline void mpi_gather(const T*    sendbuf,
+                       T*          recvbuf,
+                       std::size_t count,
+                       int         root_rank,
+                       MPI_Comm    comm) {
+  MPI_Gather(sendbuf,
+             count,
+             mpi_type<T>(),
+             recvbuf,
+             count,
+             mpi_type<T>(),
+             root_rank,
+             comm);
+}
+
 template <typename T>
 inline void mpi_scatter(const T*    sendbuf,
                         T*          recvbuf,
@@ -477,4 +493,29 @@ inline T getenv_coll(const std::string& env_var, T default_val) {
   return mpi_bcast_value(val, 0, comm);
 }
 
+inline std::string mpi_bcast_string(const std::string& str,
+                                    int                root_rank,
+                                    MPI_Comm           comm) {
+  std::string val = str;
+  std::size_t len = mpi_bcast_value(val.size(), root_rank, comm);
+  val.resize(len);
+  mpi_bcast(val.data(), len, root_rank, comm);
+  return val;
+}
+
+inline std::string getenv_coll(const std::string& env_var, const std::string& default_val) {
+  MPI_Comm comm = mpi_comm_root();
+
+  int rank = mpi_comm_rank(comm);
+  std::string val = default_val;
+
+  if (rank == 0) {
+    if (const char* val_str = std::getenv(env_var.c_str())) {
+      val = val_str;
+    }
+  }
+
+  return mpi_bcast_string(val, 0, comm);
+}
+
 }
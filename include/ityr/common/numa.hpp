@@ -67,6 +67,51 @@ inline void interleave(void* addr, std::size_t size, const node_bitmask& nodemas
   numa_interleave_memory(addr, size, nodemask.get());
 }
 
+struct page_placement {
+  std::size_t n_pages  = 0;
+  std::size_t n_local  = 0; // pages on `node`
+  std::size_t n_remote = 0; // pages on other nodes
+  std::size_t n_absent = 0; // pages not allocated yet
+};
+
+// Query which NUMA nodes the pages in [addr, addr + size) actually reside on
+inline page_placement query_placement(void* addr, std::size_t size, node_t node) {
+  page_placement ret;
+  if (!enabled()) return ret;
+
+  std::size_t page_size = get_page_size();
+  std::byte*  addr_b    = reinterpret_cast<std::byte*>(round_down_pow2(reinterpret_cast<uintptr_t>(addr), page_size));
+  std::byte*  addr_e    = reinterpret_cast<std::byte*>(round_up_pow2(reinterpret_cast<uintptr_t>(addr) + size, page_size));
+
+  constexpr std::size_t n_pages_per_query = 4096;
+  std::vector<void*> pages(n_pages_per_query);
+  std::vector<int>   status(n_pages_per_query);
+
+  for (std::byte* p = addr_b; p < addr_e; p += n_pages_per_query * page_size) {
+    std::size_t n = std::min(n_pages_per_query, std::size_t(addr_e - p) / page_size);
+    for (std::size_t i = 0; i < n; i++) {
+      pages[i] = p + i * page_size;
+    }
+    // query only (no page is moved if `nodes` is null)
+    if (numa_move_pages(0, n, pages.data(), nullptr, status.data(), 0) != 0) {
+      perror("numa_move_pages");
+      die("[ityr::common::numa] numa_move_pages() failed");
+    }
+    for (std::size_t i = 0; i < n; i++) {
+      if (status[i] == node) {
+        ret.n_local++;
+      } else if (status[i] >= 0) {
+        ret.n_remote++;
+      } else {
+        ret.n_absent++;
+      }
+    }
+    ret.n_pages += n;
+  }
+
+  return ret;
+}
+
 }
 
 #else
@@ -88,6 +133,15 @@ inline node_t get_current_node() { return 0; }
 inline void bind_to(void*, std::size_t, node_t) {}
 inline void interleave(void*, std::size_t, const node_bitmask&) {}
 
+struct page_placement {
+  std::size_t n_pages  = 0;
+  std::size_t n_local  = 0;
+  std::size_t n_remote = 0;
+  std::size_t n_absent = 0;
+};
+
+inline page_placement query_placement(void*, std::size_t, node_t) { return {}; }
+
 }
 
 #endif
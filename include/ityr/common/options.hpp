@@ -2,12 +2,14 @@
 
 #include <cstdio>
 #include <vector>
+#include <map>
+#include <sstream>
 #include <algorithm>
 
 #include "ityr/common/util.hpp"
 #include "ityr/common/mpi_util.hpp"
 
-#define ITYR_STR_EXPAND(x) #x
+#define ITYR_STR_EXPAND(...) #__VA_ARGS__
 #define ITYR_STR(x) ITYR_STR_EXPAND(x)
 #define ITYR_PRINT_MACRO(x) printf(#x "=" ITYR_STR_EXPAND(x) "\n")
 
@@ -47,6 +49,7 @@ inline void print_compile_options() {
 class option_base {
 public:
   virtual ~option_base() = default;
+  virtual std::string option_name() const = 0;
   virtual void print() const = 0;
 };
 
@@ -73,6 +76,10 @@ public:
     base_t::fini();
   }
 
+  std::string option_name() const override {
+    return Derived::name();
+  }
+
   void print() const override {
     std::cout << Derived::name() << "=" << val_ << std::endl;
   }
@@ -86,11 +93,51 @@ inline std::vector<option_base*>& get_options() {
   return opts;
 }
 
+// Option values that take precedence over environment variables when options are initialized
+// (e.g., by `ityr::autotune()`). They must be set identically in all processes.
+inline std::map<std::string, std::string>& get_option_overrides() {
+  static std::map<std::string, std::string> overrides;
+  return overrides;
+}
+
+inline void set_option_override(const std::string& name, const std::string& val) {
+  get_option_overrides()[name] = val;
+}
+
+inline void clear_option_overrides() {
+  get_option_overrides().clear();
+}
+
+template <typename T>
+inline T parse_option_value(const std::string& name, const std::string& str) {
+  if constexpr (std::is_same_v<T, std::string>) {
+    return str;
+  } else {
+    T val;
+    std::stringstream ss(str);
+    ss >> val;
+    if (ss.fail()) {
+      die("Value '%s' of option '%s' is invalid.\n", str.c_str(), name.c_str());
+    }
+    return val;
+  }
+}
+
+template <typename Option>
+inline auto get_option_value() {
+  using value_type = decltype(Option::default_value());
+  auto& overrides = get_option_overrides();
+  if (auto it = overrides.find(Option::name()); it != overrides.end()) {
+    return parse_option_value<value_type>(it->first, it->second);
+  }
+  return getenv_coll(Option::name(), Option::default_value());
+}
+
 template <typename Option>
 class option_initializer {
 public:
   option_initializer()
-    : init_(getenv_coll(Option::name(), Option::default_value())) {
+    : init_(get_option_value<Option>()) {
     auto& opts = get_options();
     option_base* opt = &Option::get();
     if (std::find(opts.begin(), opts.end(), opt) == opts.end()) {
@@ -132,6 +179,41 @@ struct prof_output_per_rank_option : public option<prof_output_per_rank_option,
   static bool default_value() { return false; }
 };
 
+struct prof_output_file_option : public option<prof_output_file_option, std::string> {
+  using option::option;
+  static std::string name() { return "ITYR_PROF_OUTPUT_FILE"; }
+  // Profiled results are also written to this file in a machine-readable format (disabled if empty)
+  static std::string default_value() { return ""; }
+};
+
+struct prof_output_format_option : public option<prof_output_format_option, std::string> {
+  using option::option;
+  static std::string name() { return "ITYR_PROF_OUTPUT_FORMAT"; }
+  // "json" (JSON Lines) or "csv"
+  static std::string default_value() { return "json"; }
+};
+
+struct prof_trace_format_option : public option<prof_trace_format_option, std::string> {
+  using option::option;
+  static std::string name() { return "ITYR_PROF_TRACE_FORMAT"; }
+  // "csv" (ityr_log_<rank>.ignore for each process) or
+  // "chrome" (Chrome trace event format in a single file ityr_trace.json)
+  static std::string default_value() { return "csv"; }
+};
+
+struct sampling_interval_option : public option<sampling_interval_option, std::size_t> {
+  using option::option;
+  static std::string name() { return "ITYR_SAMPLING_INTERVAL"; }
+  // in milliseconds (0 disables the sampling profiler)
+  static std::size_t default_value() { return 0; }
+};
+
+struct sampling_buffer_size_option : public option<sampling_buffer_size_option, std::size_t> {
+  using option::option;
+  static std::string name() { return "ITYR_SAMPLING_BUFFER_SIZE"; }
+  static std::size_t default_value() { return 4096; }
+};
+
 struct rma_use_mpi_win_allocate : public option<rma_use_mpi_win_allocate, bool> {
   using option::option;
   static std::string name() { return "ITYR_RMA_USE_MPI_WIN_ALLOCATE"; }
@@ -150,13 +232,47 @@ struct allocator_max_unflushed_free_objs_option : public option<allocator_max_un
   static std::size_t default_value() { return 10; }
 };
 
+struct hugepage_option : public option<hugepage_option, std::string> {
+  using option::option;
+  static std::string name() { return "ITYR_HUGEPAGE"; }
+  // "none", "thp" (transparent huge pages), or "hugetlbfs"
+  static std::string default_value() { return "none"; }
+};
+
+struct hugetlbfs_dir_option : public option<hugetlbfs_dir_option, std::string> {
+  using option::option;
+  static std::string name() { return "ITYR_HUGETLBFS_DIR"; }
+  static std::string default_value() { return "/dev/hugepages"; }
+};
+
+struct numa_check_option : public option<numa_check_option, bool> {
+  using option::option;
+  static std::string name() { return "ITYR_NUMA_CHECK"; }
+  static bool default_value() { return false; }
+};
+
+struct print_memory_stats_option : public option<print_memory_stats_option, bool> {
+  using option::option;
+  static std::string name() { return "ITYR_PRINT_MEMORY_STATS"; }
+  static bool default_value() { return false; }
+};
+
 struct runtime_options {
   option_initializer<enable_shared_memory_option>              ITYR_ANON_VAR;
   option_initializer<global_clock_sync_round_trips_option>     ITYR_ANON_VAR;
   option_initializer<prof_output_per_rank_option>              ITYR_ANON_VAR;
+  option_initializer<prof_output_file_option>                  ITYR_ANON_VAR;
+  option_initializer<prof_output_format_option>                ITYR_ANON_VAR;
+  option_initializer<prof_trace_format_option>                 ITYR_ANON_VAR;
+  option_initializer<sampling_interval_option>                 ITYR_ANON_VAR;
+  option_initializer<sampling_buffer_size_option>              ITYR_ANON_VAR;
   option_initializer<rma_use_mpi_win_allocate>                 ITYR_ANON_VAR;
   option_initializer<allocator_block_size_option>              ITYR_ANON_VAR;
   option_initializer<allocator_max_unflushed_free_objs_option> ITYR_ANON_VAR;
+  option_initializer<hugepage_option>                          ITYR_ANON_VAR;
+  option_initializer<hugetlbfs_dir_option>                     ITYR_ANON_VAR;
+  option_initializer<numa_check_option>                        ITYR_ANON_VAR;
+  option_initializer<print_memory_stats_option>                ITYR_ANON_VAR;
 };
 
 }
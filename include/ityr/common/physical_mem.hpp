@@ -21,44 +21,109 @@ public:
   physical_mem(const std::string& shm_name, std::size_t size, bool own)
     : shm_name_(shm_name), size_(size), own_(own), fd_(init_shmem_fd()) {}
 
+  /**
+   * @brief Shared memory that is backed by huge pages according to `ITYR_HUGEPAGE`.
+   *
+   * With `thp`, the memory is allocated with `shm_open()` and transparent huge pages are requested
+   * for every mapping (`madvise(MADV_HUGEPAGE)`). With `hugetlbfs`, the memory is allocated as a file
+   * in `ITYR_HUGETLBFS_DIR`; its size and all mappings must be multiples of the huge page size.
+   */
+  physical_mem(const std::string& shm_name, std::size_t size, bool own, bool use_hugepage)
+    : shm_name_(shm_name), size_(size), own_(own),
+      hugepage_(use_hugepage ? get_hugepage_mode() : hugepage_mode::none),
+      fd_(hugepage_ == hugepage_mode::hugetlbfs ? init_hugetlbfs_fd() : init_shmem_fd()) {}
+
+  /**
+   * @brief Use the region `[file_offset, file_offset + size)` of an existing file as physical memory.
+   *
+   * Stores to the mapped memory are written to the page cache of the file (`MAP_SHARED`).
+   * If `create` is true, the file is created (or truncated) and resized to cover the region.
+   */
+  static physical_mem from_file(const std::string& fpath,
+                                std::size_t        size,
+                                std::size_t        file_offset,
+                                bool               create = false) {
+    ITYR_CHECK(file_offset % get_page_size() == 0);
+    physical_mem pm;
+    pm.size_        = size;
+    pm.own_         = false;
+    pm.file_offset_ = file_offset;
+    pm.fd_          = open(fpath.c_str(), create ? (O_RDWR | O_CREAT | O_TRUNC) : O_RDWR, S_IRUSR | S_IWUSR);
+    if (pm.fd_ == -1) {
+      perror("open");
+      die("[ityr::common::physical_mem] open(%s) failed", fpath.c_str());
+    }
+    if (create && ftruncate(pm.fd_, file_offset + size) == -1) {
+      perror("ftruncate");
+      die("[ityr::common::physical_mem] ftruncate(%s, %lu) failed", fpath.c_str(), file_offset + size);
+    }
+    return pm;
+  }
+
   ~physical_mem() { destroy(); }
 
   physical_mem(const physical_mem&) = delete;
   physical_mem& operator=(const physical_mem&) = delete;
 
   physical_mem(physical_mem&& pm)
-    : shm_name_(std::move(pm.shm_name_)), size_(pm.size_), own_(pm.own_), fd_(pm.fd_) { pm.fd_ = -1; }
+    : shm_name_(std::move(pm.shm_name_)), size_(pm.size_), own_(pm.own_),
+      file_offset_(pm.file_offset_), hugepage_(pm.hugepage_), fd_(pm.fd_) { pm.fd_ = -1; }
   physical_mem& operator=(physical_mem&& pm) {
     destroy();
-    shm_name_ = std::move(pm.shm_name_);
-    size_     = pm.size_;
-    own_      = pm.own_;
-    fd_       = pm.fd_;
+    shm_name_    = std::move(pm.shm_name_);
+    size_        = pm.size_;
+    own_         = pm.own_;
+    file_offset_ = pm.file_offset_;
+    hugepage_    = pm.hugepage_;
+    fd_          = pm.fd_;
     pm.fd_ = -1;
     return *this;
   }
 
   std::size_t size() const { return size_; }
 
+  bool file_backed() const { return fd_ != -1 && shm_name_.empty(); }
+
+  hugepage_mode hugepage() const { return hugepage_; }
+
   void map_to_vm(void* addr, std::size_t size, std::size_t offset) const {
     ITYR_CHECK(addr != nullptr);
     ITYR_CHECK(reinterpret_cast<uintptr_t>(addr) % get_page_size() == 0);
     ITYR_CHECK(offset % get_page_size() == 0);
     ITYR_CHECK(offset + size <= size_);
+    if (hugepage_ == hugepage_mode::hugetlbfs) {
+      ITYR_CHECK(reinterpret_cast<uintptr_t>(addr) % get_hugepage_size() == 0);
+      ITYR_CHECK(offset % get_hugepage_size() == 0);
+      ITYR_CHECK(size % get_hugepage_size() == 0);
+    }
     // MAP_FIXED_NOREPLACE is never set here, as this map method is used to
     // map to physical memory a given virtual address, which is already reserved by mmap.
-    void* ret = mmap(addr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd_, offset);
+    void* ret = mmap(addr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd_, file_offset_ + offset);
     if (ret == MAP_FAILED) {
       perror("mmap");
+      if (hugepage_ == hugepage_mode::hugetlbfs) {
+        die("[ityr::common::physical_mem] mmap(%p, %lu, ...) failed (not enough huge pages reserved?)", addr, size);
+      }
       die("[ityr::common::physical_mem] mmap(%p, %lu, ...) failed", addr, size);
     }
+#ifdef MADV_HUGEPAGE
+    if (hugepage_ == hugepage_mode::thp) {
+      // Only hint; huge pages are used if shmem THP is enabled in the kernel (`shmem_enabled`)
+      madvise(addr, size, MADV_HUGEPAGE);
+    }
+#endif
   }
 
 private:
   void destroy() {
     if (fd_ != -1) {
       close(fd_);
-      if (own_ && shm_unlink(shm_name_.c_str()) == -1) {
+      if (own_ && hugepage_ == hugepage_mode::hugetlbfs) {
+        if (unlink(hugetlbfs_path().c_str()) == -1) {
+          perror("unlink");
+          die("[ityr::common::physical_mem] unlink(%s) failed", hugetlbfs_path().c_str());
+        }
+      } else if (own_ && shm_unlink(shm_name_.c_str()) == -1) {
         perror("shm_unlink");
         die("[ityr::common::physical_mem] shm_unlink() failed");
       }
@@ -83,10 +148,37 @@ private:
     return fd;
   }
 
-  std::string shm_name_;
-  std::size_t size_;
-  bool        own_;
-  int         fd_ = -1;
+  std::string hugetlbfs_path() const {
+    return hugetlbfs_dir_option::value() + shm_name_;
+  }
+
+  int init_hugetlbfs_fd() const {
+    validate_hugepage_granularity(size_, "the physical memory size");
+
+    int oflag = O_RDWR;
+    if (own_) oflag |= O_CREAT | O_TRUNC;
+
+    int fd = open(hugetlbfs_path().c_str(), oflag, S_IRUSR | S_IWUSR);
+    if (fd == -1) {
+      perror("open");
+      die("[ityr::common::physical_mem] open(%s) failed (is hugetlbfs mounted at %s?)",
+          hugetlbfs_path().c_str(), hugetlbfs_dir_option::value().c_str());
+    }
+
+    if (own_ && ftruncate(fd, size_) == -1) {
+      perror("ftruncate");
+      die("[ityr::common::physical_mem] ftruncate(%d, %lu) failed", fd, size_);
+    }
+
+    return fd;
+  }
+
+  std::string   shm_name_;
+  std::size_t   size_;
+  bool          own_;
+  std::size_t   file_offset_ = 0;
+  hugepage_mode hugepage_    = hugepage_mode::none;
+  int           fd_          = -1;
 };
 
 ITYR_TEST_CASE("[ityr::common::physical_mem] map physical memory to two different virtual addresses") {
@@ -132,4 +224,43 @@ ITYR_TEST_CASE("[ityr::common::physical_mem] map physical memory to two differen
   ITYR_CHECK(b2[0] == 417);
 }
 
+
+ITYR_TEST_CASE("[ityr::common::physical_mem] physical memory with transparent huge pages") {
+  singleton_initializer<hugepage_option> hugepage_opt(std::string("thp"));
+  runtime_options opts;
+  singleton_initializer<topology::instance> topo;
+
+  ITYR_CHECK(get_hugepage_mode() == hugepage_mode::thp);
+
+  std::size_t alignment = hugepage_alignment();
+  ITYR_CHECK(alignment == get_hugepage_size());
+  ITYR_CHECK(alignment % get_page_size() == 0);
+
+  std::stringstream ss;
+  ss << "/ityr_test_hugepage_" << topology::my_rank();
+
+  std::size_t alloc_size = 2 * alignment;
+
+  physical_mem pm(ss.str(), alloc_size, true, true);
+  ITYR_CHECK(pm.hugepage() == hugepage_mode::thp);
+
+  virtual_mem vm1(alloc_size, alignment);
+  virtual_mem vm2(alloc_size, alignment);
+  ITYR_CHECK(reinterpret_cast<uintptr_t>(vm1.addr()) % alignment == 0);
+  ITYR_CHECK(reinterpret_cast<uintptr_t>(vm2.addr()) % alignment == 0);
+
+  pm.map_to_vm(vm1.addr(), alloc_size, 0);
+  pm.map_to_vm(vm2.addr(), alloc_size, 0);
+
+  int* b1 = reinterpret_cast<int*>(vm1.addr());
+  int* b2 = reinterpret_cast<int*>(vm2.addr());
+  std::size_t n = alloc_size / sizeof(int);
+  for (std::size_t i = 0; i < n; i += 1024) {
+    b1[i] = i;
+  }
+  for (std::size_t i = 0; i < n; i += 1024) {
+    ITYR_CHECK(b2[i] == int(i));
+  }
+}
+
 }
@@ -30,8 +30,7 @@ struct prof_event_target_base : public profiler::event {
 
     do_acc(t1 - t0);
 
-    auto rank = topology::my_rank();
-    fprintf(stream, "%d,%lu,%d,%lu,%s,target=%d\n", rank, t0, rank, t1, str().c_str(), target_rank);
+    write_trace(stream, t0, t1, target_rank);
     return buf1;
   }
 };
@@ -0,0 +1,365 @@
+#pragma once
+
+#include <cstdio>
+#include <memory>
+
+#include "ityr/common/util.hpp"
+
+namespace ityr::common::profiler {
+
+/*
+ * Machine-readable output of profiled results
+ *
+ * Each profiled value is a record of (rank, category, name, metric, value), where rank is -1 for values
+ * summed over all processes. Records of the same rank, category, and name must be contiguous.
+ *
+ * - CSV: one line per record, prefixed with the output ID (incremented for each flush)
+ * - JSON: one line per output (JSON Lines), grouped as {"all": {category: {name: {metric: value}}}}
+ *   and {"ranks": [{"rank": i, category: ...}]}; categories without names directly have metrics
+ */
+
+struct output_record {
+  int         rank;
+  std::string category;
+  std::string name;
+  std::string metric;
+  uint64_t    value;
+};
+
+enum class output_format {
+  json,
+  csv,
+};
+
+inline output_format parse_output_format(const std::string& str) {
+  if (str == "json") {
+    return output_format::json;
+  } else if (str == "csv") {
+    return output_format::csv;
+  } else {
+    die("Unknown profiler output format '%s' (should be 'json' or 'csv')", str.c_str());
+  }
+}
+
+class json_writer {
+public:
+  json_writer(FILE* fp) : fp_(fp) {}
+
+  void begin_object(const char* key = nullptr) {
+    put_key(key);
+    std::fputc('{', fp_);
+    first_.push_back(true);
+  }
+
+  void end_object() {
+    std::fputc('}', fp_);
+    first_.pop_back();
+  }
+
+  void begin_array(const char* key = nullptr) {
+    put_key(key);
+    std::fputc('[', fp_);
+    first_.push_back(true);
+  }
+
+  void end_array() {
+    std::fputc(']', fp_);
+    first_.pop_back();
+  }
+
+  void value(const char* key, uint64_t v) {
+    put_key(key);
+    std::fprintf(fp_, "%lu", v);
+  }
+
+  void value(const char* key, int v) {
+    put_key(key);
+    std::fprintf(fp_, "%d", v);
+  }
+
+  static void put_string(FILE* fp, const std::string& str) {
+    std::fputc('"', fp);
+    for (char c : str) {
+      if (c == '"' || c == '\\') {
+        std::fputc('\\', fp);
+        std::fputc(c, fp);
+      } else if (static_cast<unsigned char>(c) < 0x20) {
+        std::fprintf(fp, "\\u%04x", c);
+      } else {
+        std::fputc(c, fp);
+      }
+    }
+    std::fputc('"', fp);
+  }
+
+private:
+  void put_key(const char* key) {
+    if (!first_.empty()) {
+      if (!first_.back()) std::fputc(',', fp_);
+      first_.back() = false;
+    }
+    if (key) {
+      put_string(fp_, key);
+      std::fputc(':', fp_);
+    }
+  }
+
+  FILE*             fp_;
+  std::vector<bool> first_;
+};
+
+inline void write_json(FILE* fp, std::size_t output_id, int n_ranks,
+                       const std::vector<output_record>& records) {
+  json_writer w(fp);
+  w.begin_object();
+  w.value("output_id", uint64_t(output_id));
+  w.value("n_ranks", n_ranks);
+
+  bool rank_open     = false;
+  bool ranks_open    = false;
+  bool category_open = false;
+  bool name_open     = false;
+  const output_record* prev = nullptr;
+
+  for (auto&& r : records) {
+    bool new_rank     = !prev || r.rank != prev->rank;
+    bool new_category = new_rank || r.category != prev->category;
+    bool new_name     = new_category || r.name != prev->name;
+
+    if (new_name && name_open) { w.end_object(); name_open = false; }
+    if (new_category && category_open) { w.end_object(); category_open = false; }
+    if (new_rank && rank_open) { w.end_object(); rank_open = false; }
+
+    if (new_rank) {
+      if (r.rank < 0) {
+        w.begin_object("all");
+      } else {
+        if (!ranks_open) {
+          w.begin_array("ranks");
+          ranks_open = true;
+        }
+        w.begin_object();
+        w.value("rank", r.rank);
+      }
+      rank_open = true;
+    }
+    if (new_category) {
+      w.begin_object(r.category.c_str());
+      category_open = true;
+    }
+    if (new_name && !r.name.empty()) {
+      w.begin_object(r.name.c_str());
+      name_open = true;
+    }
+
+    w.value(r.metric.c_str(), r.value);
+    prev = &r;
+  }
+
+  if (name_open) w.end_object();
+  if (category_open) w.end_object();
+  if (rank_open) w.end_object();
+  if (ranks_open) w.end_array();
+  w.end_object();
+  std::fputc('\n', fp);
+}
+
+inline void write_csv_header(FILE* fp) {
+  std::fprintf(fp, "output_id,rank,category,name,metric,value\n");
+}
+
+inline void write_csv(FILE* fp, std::size_t output_id,
+                      const std::vector<output_record>& records) {
+  for (auto&& r : records) {
+    std::fprintf(fp, "%ld,", output_id);
+    if (r.rank < 0) {
+      std::fprintf(fp, "all,");
+    } else {
+      std::fprintf(fp, "%d,", r.rank);
+    }
+    std::fprintf(fp, "%s,", r.category.c_str());
+    json_writer::put_string(fp, r.name); // CSV quoting is compatible for names without quotes
+    std::fprintf(fp, ",%s,%lu\n", r.metric.c_str(), r.value);
+  }
+}
+
+class output_file {
+public:
+  output_file(const std::string& filename, output_format format)
+    : fp_(std::fopen(filename.c_str(), "w"), &std::fclose),
+      format_(format) {
+    if (!fp_) {
+      die("Cannot open profiler output file '%s'", filename.c_str());
+    }
+    if (format_ == output_format::csv) {
+      write_csv_header(fp_.get());
+    }
+  }
+
+  void write(int n_ranks, const std::vector<output_record>& records) {
+    switch (format_) {
+      case output_format::json: write_json(fp_.get(), n_outputs_, n_ranks, records); break;
+      case output_format::csv:  write_csv(fp_.get(), n_outputs_, records); break;
+    }
+    std::fflush(fp_.get());
+    n_outputs_++;
+  }
+
+private:
+  std::unique_ptr<FILE, int (*)(FILE*)> fp_;
+  output_format                         format_;
+  std::size_t                           n_outputs_ = 0;
+};
+
+/*
+ * Chrome trace event format (loadable in Perfetto UI and chrome://tracing)
+ *
+ * Each process is shown as a process track ("rank N") that has a thread track for each category of
+ * events, so that intervals in the same thread track are properly nested. Timestamps are in us.
+ */
+
+enum class trace_format {
+  csv,
+  chrome,
+};
+
+inline trace_format parse_trace_format(const std::string& str) {
+  if (str == "csv") {
+    return trace_format::csv;
+  } else if (str == "chrome") {
+    return trace_format::chrome;
+  } else {
+    die("Unknown trace format '%s' (should be 'csv' or 'chrome')", str.c_str());
+  }
+}
+
+inline constexpr const char* chrome_trace_tracks[] = {"phase", "scheduler", "rma", "memory", "other"};
+
+// Events are assigned to tracks by their name prefixes
+inline int chrome_trace_track(const std::string& name) {
+  auto starts_with = [&](const char* prefix) { return name.rfind(prefix, 0) == 0; };
+  if (starts_with("P_")) return 0;
+  if (starts_with("sched_") || starts_with("wsqueue_")) return 1;
+  if (starts_with("mpi_") || starts_with("rma_") || starts_with("global_lock_")) return 2;
+  if (starts_with("core_") || starts_with("cache_") || starts_with("home_") ||
+      starts_with("allocator_")) return 3;
+  return 4;
+}
+
+inline void write_chrome_trace_header(FILE* fp, int n_ranks) {
+  // Events are written after metadata with a leading comma
+  std::fprintf(fp, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+  for (int rank = 0; rank < n_ranks; rank++) {
+    std::fprintf(fp, "%s\n{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,\"args\":{\"name\":\"rank %d\"}}",
+                 rank == 0 ? "" : ",", rank, rank);
+    std::fprintf(fp, ",\n{\"name\":\"process_sort_index\",\"ph\":\"M\",\"pid\":%d,\"args\":{\"sort_index\":%d}}",
+                 rank, rank);
+    for (int tid = 0; tid < int(std::size(chrome_trace_tracks)); tid++) {
+      std::fprintf(fp, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+                   rank, tid, chrome_trace_tracks[tid]);
+    }
+  }
+}
+
+inline void write_chrome_trace_footer(FILE* fp) {
+  std::fprintf(fp, "\n]}\n");
+}
+
+inline void write_chrome_trace_time(FILE* fp, const char* key, uint64_t t_ns) {
+  std::fprintf(fp, ",\"%s\":%lu.%03lu", key, t_ns / 1000, t_ns % 1000);
+}
+
+// `target_rank` is negative if the event has no target
+inline void write_chrome_trace_interval(FILE* fp, int rank, const std::string& name,
+                                        uint64_t t0, uint64_t t1, int target_rank) {
+  std::fprintf(fp, ",\n{\"name\":");
+  json_writer::put_string(fp, name);
+  std::fprintf(fp, ",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":%d,\"tid\":%d",
+               chrome_trace_tracks[chrome_trace_track(name)], rank, chrome_trace_track(name));
+  write_chrome_trace_time(fp, "ts", t0);
+  write_chrome_trace_time(fp, "dur", t1 - t0);
+  if (target_rank >= 0) {
+    std::fprintf(fp, ",\"args\":{\"target\":%d}", target_rank);
+  }
+  std::fprintf(fp, "}");
+}
+
+// Flow arrow from the phase track of `from_rank` to the enclosing slice of `to_rank` at time `t`
+inline void write_chrome_trace_flow(FILE* fp, const char* name, uint64_t id,
+                                    int from_rank, int to_rank, int to_tid, uint64_t t) {
+  std::fprintf(fp, ",\n{\"name\":\"%s\",\"cat\":\"flow\",\"ph\":\"s\",\"id\":%lu,\"pid\":%d,\"tid\":0",
+               name, id, from_rank);
+  write_chrome_trace_time(fp, "ts", t);
+  std::fprintf(fp, "}");
+  std::fprintf(fp, ",\n{\"name\":\"%s\",\"cat\":\"flow\",\"ph\":\"f\",\"bp\":\"e\",\"id\":%lu,\"pid\":%d,\"tid\":%d",
+               name, id, to_rank, to_tid);
+  write_chrome_trace_time(fp, "ts", t);
+  std::fprintf(fp, "}");
+}
+
+ITYR_TEST_CASE("[ityr::common::profiler] machine-readable output") {
+  std::vector<output_record> records = {
+    {-1, "event", "mpi_rma_get", "sum_time_ns", 100},
+    {-1, "event", "mpi_rma_get", "count"      , 2  },
+    {-1, "event", "mpi_rma_put", "count"      , 3  },
+    {-1, "dag"  , ""           , "work_ns"    , 40 },
+    { 0, "event", "mpi_rma_get", "count"      , 1  },
+    { 1, "event", "mpi_rma_get", "count"      , 1  },
+  };
+
+  auto read_all = [](FILE* fp) {
+    std::rewind(fp);
+    std::string s;
+    int c;
+    while ((c = std::fgetc(fp)) != EOF) s.push_back(c);
+    return s;
+  };
+
+  ITYR_SUBCASE("json") {
+    FILE* fp = std::tmpfile();
+    write_json(fp, 3, 2, records);
+    ITYR_CHECK(read_all(fp) ==
+               "{\"output_id\":3,\"n_ranks\":2,"
+               "\"all\":{\"event\":{\"mpi_rma_get\":{\"sum_time_ns\":100,\"count\":2},\"mpi_rma_put\":{\"count\":3}},"
+               "\"dag\":{\"work_ns\":40}},"
+               "\"ranks\":[{\"rank\":0,\"event\":{\"mpi_rma_get\":{\"count\":1}}},"
+               "{\"rank\":1,\"event\":{\"mpi_rma_get\":{\"count\":1}}}]}\n");
+    std::fclose(fp);
+  }
+
+  ITYR_SUBCASE("csv") {
+    FILE* fp = std::tmpfile();
+    write_csv(fp, 0, {records[0], records[3], records[5]});
+    ITYR_CHECK(read_all(fp) ==
+               "0,all,event,\"mpi_rma_get\",sum_time_ns,100\n"
+               "0,all,dag,\"\",work_ns,40\n"
+               "0,1,event,\"mpi_rma_get\",count,1\n");
+    std::fclose(fp);
+  }
+}
+
+
+ITYR_TEST_CASE("[ityr::common::profiler] chrome trace output") {
+  FILE* fp = std::tmpfile();
+  write_chrome_trace_header(fp, 2);
+  write_chrome_trace_interval(fp, 1, "P_sched_loop", 1000, 3500, -1);
+  write_chrome_trace_interval(fp, 1, "sched_steal (success)", 2000, 3000, 0);
+  write_chrome_trace_flow(fp, "steal", 42, 0, 1, 1, 2500);
+  write_chrome_trace_footer(fp);
+
+  std::rewind(fp);
+  std::string s;
+  int c;
+  while ((c = std::fgetc(fp)) != EOF) s.push_back(c);
+  std::fclose(fp);
+
+  ITYR_CHECK(s.find("{\"name\":\"P_sched_loop\",\"cat\":\"phase\",\"ph\":\"X\",\"pid\":1,\"tid\":0,"
+                    "\"ts\":1.000,\"dur\":2.500}") != std::string::npos);
+  ITYR_CHECK(s.find("\"cat\":\"scheduler\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":2.000,\"dur\":1.000,"
+                    "\"args\":{\"target\":0}}") != std::string::npos);
+  ITYR_CHECK(s.find("\"ph\":\"s\",\"id\":42,\"pid\":0,\"tid\":0,\"ts\":2.500}") != std::string::npos);
+  ITYR_CHECK(s.find("\"ph\":\"f\",\"bp\":\"e\",\"id\":42,\"pid\":1,\"tid\":1,\"ts\":2.500}") != std::string::npos);
+  ITYR_CHECK(s.compare(s.size() - 4, 4, "\n]}\n") == 0);
+}
+
+}
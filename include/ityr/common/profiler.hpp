@@ -10,6 +10,7 @@
 #include "ityr/common/topology.hpp"
 #include "ityr/common/wallclock.hpp"
 #include "ityr/common/options.hpp"
+#include "ityr/common/prof_output.hpp"
 
 #if __has_include(<mlog/mlog.h>)
 #include <mlog/mlog.h>
@@ -42,12 +43,38 @@ struct mode_trace {
   using interval_begin_data = void*;
 };
 
+/**
+ * @brief Profiled statistics of an event.
+ *
+ * Events whose names start with `P_` are phases, which are exclusive to each other and
+ * their times add up to the total profiled time.
+ */
+struct event_stats {
+  std::string            name;
+  wallclock::wallclock_t sum_time = 0; ///< Accumulated time of the event (ns).
+  wallclock::wallclock_t max_time = 0; ///< Maximum time of a single interval (ns).
+  wallclock::wallclock_t t_total  = 0; ///< Total profiled time (ns).
+  uint64_t               count    = 0; ///< Number of intervals.
+
+  bool is_phase() const { return name.compare(0, 2, "P_") == 0; }
+
+  template <typename Fn>
+  void for_each_field(Fn&& fn) {
+    fn("sum_time_ns"  , sum_time);
+    fn("max_time_ns"  , max_time);
+    fn("total_time_ns", t_total);
+    fn("count"        , count);
+  }
+};
+
 struct profiler_state {
   bool                   enabled;
   wallclock::wallclock_t t_begin;
   wallclock::wallclock_t t_end;
   bool                   output_per_rank;
   mlog_data_t            trace_md;
+  trace_format           trace_fmt;
+  uint64_t               trace_n_flows;
 };
 
 class event {
@@ -88,8 +115,7 @@ public:
 
     do_acc(t1 - t0);
 
-    auto rank = topology::my_rank();
-    fprintf(stream, "%d,%lu,%d,%lu,%s\n", rank, t0, rank, t1, str().c_str());
+    write_trace(stream, t0, t1);
     return buf1;
   }
 
@@ -101,6 +127,13 @@ public:
     count_ = 0;
   }
 
+  // Collective; prints additional analysis after the stats of all events are printed
+  virtual void print_report() {}
+
+  virtual void get_stats(std::vector<event_stats>& stats) const {
+    stats.push_back({str(), sum_time_, max_time_, state_.t_end - state_.t_begin, count_});
+  }
+
   virtual void print_stats() {
     auto t_total = state_.t_end - state_.t_begin;
     if (state_.output_per_rank) {
@@ -136,6 +169,37 @@ public:
   }
 
 protected:
+  // Write a decoded interval to the trace; if `flow_from_target` is true, a flow arrow from
+  // `target_rank` to this interval is also drawn (in the Chrome trace format)
+  void write_trace(FILE*                  stream,
+                   wallclock::wallclock_t t0,
+                   wallclock::wallclock_t t1,
+                   topology::rank_t       target_rank      = -1,
+                   bool                   flow_from_target = false) {
+    auto rank = topology::my_rank();
+    switch (state_.trace_fmt) {
+      case trace_format::csv: {
+        if (target_rank >= 0) {
+          fprintf(stream, "%d,%lu,%d,%lu,%s,target=%d\n", rank, t0, rank, t1, str().c_str(), target_rank);
+        } else {
+          fprintf(stream, "%d,%lu,%d,%lu,%s\n", rank, t0, rank, t1, str().c_str());
+        }
+        break;
+      }
+      case trace_format::chrome: {
+        auto name = str();
+        write_chrome_trace_interval(stream, rank, name, t0, t1, target_rank);
+        if (flow_from_target && target_rank >= 0) {
+          // flow IDs must be unique among all processes
+          uint64_t flow_id = (uint64_t(rank) << 40) + state_.trace_n_flows++;
+          write_chrome_trace_flow(stream, "steal", flow_id, target_rank, rank,
+                                  chrome_trace_track(name), t0 + (t1 - t0) / 2);
+        }
+        break;
+      }
+    }
+  }
+
   void do_acc(wallclock::wallclock_t t) {
     sum_time_ += t;
     max_time_ = std::max(max_time_, t);
@@ -176,9 +240,30 @@ class profiler {
 public:
   profiler() {
     state_.output_per_rank = prof_output_per_rank_option::value();
+    state_.trace_fmt       = parse_trace_format(prof_trace_format_option::value());
+    state_.trace_n_flows   = 0;
     if constexpr (std::is_same_v<Mode, mode_trace>) {
       mlog_init(&state_.trace_md, 1, 1 << 20);
-      trace_out_file_ = {std::fopen(trace_out_filename().c_str(), "w"), &std::fclose};
+      if (state_.trace_fmt == trace_format::csv) {
+        trace_out_file_ = {std::fopen(trace_out_filename().c_str(), "w"), &std::fclose};
+      } else if (topology::my_rank() == 0) {
+        // Traces of all processes are gathered to a single file
+        trace_out_file_ = {std::fopen(chrome_trace_out_filename().c_str(), "w"), &std::fclose};
+        write_chrome_trace_header(trace_out_file_.get(), topology::n_ranks());
+      }
+    }
+    auto output_filename = prof_output_file_option::value();
+    if (!output_filename.empty() && topology::my_rank() == 0) {
+      output_file_ = std::make_unique<output_file>(output_filename,
+                                                   parse_output_format(prof_output_format_option::value()));
+    }
+  }
+
+  ~profiler() {
+    if (trace_out_file_ && state_.trace_fmt == trace_format::chrome) {
+      // Traces of the other processes decoded after the last flush cannot be gathered here
+      std::fwrite(trace_buf_.data(), 1, trace_buf_.size(), trace_out_file_.get());
+      write_chrome_trace_footer(trace_out_file_.get());
     }
   }
 
@@ -200,10 +285,20 @@ public:
     }
   }
 
-  void flush() {
-    if constexpr (std::is_same_v<Mode, mode_trace>) {
-      mlog_flush_all(&state_.trace_md, trace_out_file_.get());
+  // Not collective; the decoded trace is written to the file at the next flush
+  std::vector<event_stats> get_stats() {
+    decode_trace();
+    std::vector<event_stats> stats;
+    for (auto&& e : events_) {
+      e->get_stats(stats);
     }
+    return stats;
+  }
+
+  // Collective
+  void flush() {
+    decode_trace();
+    write_trace();
     for (auto&& e : events_) {
       e->print_stats();
     }
@@ -212,15 +307,21 @@ public:
       fflush(stdout);
     }
     for (auto&& e : events_) {
-      e->clear();
+      e->print_report();
     }
-    if constexpr (std::is_same_v<Mode, mode_trace>) {
-      mlog_clear_all(&state_.trace_md);
+    for (auto&& e : events_) {
+      e->clear();
     }
   }
 
   profiler_state& get_state() { return state_; }
 
+  void write_output(const std::vector<output_record>& records) {
+    if (output_file_) {
+      output_file_->write(topology::n_ranks(), records);
+    }
+  }
+
   template <typename PhaseFrom, typename PhaseTo>
   void switch_phase() {
     if (state_.enabled) {
@@ -241,17 +342,74 @@ public:
   }
 
 private:
+  // Events are accumulated while the recorded trace is decoded (not collective)
+  void decode_trace() {
+    if constexpr (std::is_same_v<Mode, mode_trace>) {
+      if (state_.trace_fmt == trace_format::csv) {
+        mlog_flush_all(&state_.trace_md, trace_out_file_.get());
+      } else {
+        // The trace is converted into a memory buffer at each process and gathered to rank 0 at flush
+        char*       buf  = nullptr;
+        std::size_t size = 0;
+        FILE* stream = open_memstream(&buf, &size);
+        mlog_flush_all(&state_.trace_md, stream);
+        std::fclose(stream);
+        trace_buf_.insert(trace_buf_.end(), buf, buf + size);
+        std::free(buf);
+      }
+      mlog_clear_all(&state_.trace_md);
+    }
+  }
+
+  // Gather the decoded traces of all processes to rank 0 (collective)
+  void write_trace() {
+    if constexpr (std::is_same_v<Mode, mode_trace>) {
+      if (state_.trace_fmt != trace_format::chrome) return;
+
+      // The size argument of MPI_Send/MPI_Recv is int, so a large trace is sent in chunks
+      constexpr std::size_t chunk_size = std::size_t(1) << 30;
+
+      if (topology::my_rank() == 0) {
+        std::fwrite(trace_buf_.data(), 1, trace_buf_.size(), trace_out_file_.get());
+        std::vector<char> recv_buf;
+        for (topology::rank_t i = 1; i < topology::n_ranks(); i++) {
+          auto recv_size = mpi_recv_value<std::size_t>(i, 0, topology::mpicomm());
+          recv_buf.resize(std::min(recv_size, chunk_size));
+          for (std::size_t offset = 0; offset < recv_size; offset += chunk_size) {
+            std::size_t s = std::min(recv_size - offset, chunk_size);
+            mpi_recv(recv_buf.data(), s, i, 0, topology::mpicomm());
+            std::fwrite(recv_buf.data(), 1, s, trace_out_file_.get());
+          }
+        }
+        std::fflush(trace_out_file_.get());
+      } else {
+        mpi_send_value(trace_buf_.size(), 0, 0, topology::mpicomm());
+        for (std::size_t offset = 0; offset < trace_buf_.size(); offset += chunk_size) {
+          std::size_t s = std::min(trace_buf_.size() - offset, chunk_size);
+          mpi_send(trace_buf_.data() + offset, s, 0, 0, topology::mpicomm());
+        }
+      }
+      trace_buf_.clear();
+    }
+  }
+
   static std::string trace_out_filename() {
     std::stringstream ss;
     ss << "ityr_log_" << topology::my_rank() << ".ignore";
     return ss.str();
   }
 
+  static std::string chrome_trace_out_filename() {
+    return "ityr_trace.json";
+  }
+
   std::vector<event*>                   events_;
   profiler_state                        state_;
   event*                                last_phase_ = nullptr;
   typename Mode::interval_begin_data    phase_ibd_;
   std::unique_ptr<FILE, int (*)(FILE*)> trace_out_file_ = {nullptr, nullptr};
+  std::vector<char>                     trace_buf_;
+  std::unique_ptr<output_file>          output_file_;
 };
 
 using mode = ITYR_CONCAT(mode_, ITYR_PROFILER_MODE);
@@ -341,4 +499,43 @@ inline void flush() {
   }
 }
 
+// Statistics of this process since the last flush (not collective)
+inline std::vector<event_stats> get_stats() {
+  if constexpr (!std::is_same_v<mode, mode_disabled>) {
+    return instance::get().get_stats();
+  } else {
+    return {};
+  }
+}
+
+// Write records to the output file specified by ITYR_PROF_OUTPUT_FILE (only at rank 0)
+inline void write_output(const std::vector<output_record>& records) {
+  instance::get().write_output(records);
+}
+
+// Sum up statistics of all processes (collective)
+inline std::vector<event_stats> allreduce_stats(std::vector<event_stats> stats) {
+  std::vector<uint64_t> sums;
+  std::vector<uint64_t> maxs;
+  for (auto&& s : stats) {
+    sums.push_back(s.sum_time);
+    sums.push_back(s.t_total);
+    sums.push_back(s.count);
+    maxs.push_back(s.max_time);
+  }
+
+  std::vector<uint64_t> sums_all(sums.size());
+  std::vector<uint64_t> maxs_all(maxs.size());
+  mpi_allreduce(sums.data(), sums_all.data(), sums.size(), topology::mpicomm(), MPI_SUM);
+  mpi_allreduce(maxs.data(), maxs_all.data(), maxs.size(), topology::mpicomm(), MPI_MAX);
+
+  for (std::size_t i = 0; i < stats.size(); i++) {
+    stats[i].sum_time = sums_all[i * 3];
+    stats[i].t_total  = sums_all[i * 3 + 1];
+    stats[i].count    = sums_all[i * 3 + 2];
+    stats[i].max_time = maxs_all[i];
+  }
+  return stats;
+}
+
 }
@@ -0,0 +1,187 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <csignal>
+
+#include "ityr/common/util.hpp"
+#include "ityr/common/options.hpp"
+#include "ityr/common/topology.hpp"
+#include "ityr/common/wallclock.hpp"
+
+namespace ityr::common::sampling {
+
+/*
+ * Always-on sampling profiler
+ *
+ * Unlike `ityr::common::profiler`, this profiler is available in all builds. The runtime system
+ * maintains cumulative counters for each process, which costs only a plain increment per event.
+ * If `ITYR_SAMPLING_INTERVAL` (in milliseconds) is nonzero, a helper thread snapshots the counters
+ * periodically into a ring buffer of `ITYR_SAMPLING_BUFFER_SIZE` samples. The ring buffer is written
+ * to `ityr_samples_<rank>.csv` when the process receives SIGUSR1 and at finalization.
+ */
+
+enum class counter : std::size_t {
+  steal_attempt,
+  steal_success,
+  cache_hit,
+  cache_miss,
+  fetched_bytes,
+  written_back_bytes,
+  release,
+  acquire,
+  n_counters,
+};
+
+inline constexpr std::size_t n_counters = static_cast<std::size_t>(counter::n_counters);
+
+inline const char* str(counter c) {
+  switch (c) {
+    case counter::steal_attempt:      return "steal_attempt";
+    case counter::steal_success:      return "steal_success";
+    case counter::cache_hit:          return "cache_hit";
+    case counter::cache_miss:         return "cache_miss";
+    case counter::fetched_bytes:      return "fetched_bytes";
+    case counter::written_back_bytes: return "written_back_bytes";
+    case counter::release:            return "release";
+    case counter::acquire:            return "acquire";
+    default:                          return "unknown";
+  }
+}
+
+// Counters are global variables (not in a singleton) so that they can be updated without initialization
+inline std::array<std::atomic<uint64_t>, n_counters> counters {};
+
+inline void count(counter c, uint64_t n = 1) {
+  // Counters are updated only by the worker thread of each process and read by the sampler thread,
+  // so an atomic read-modify-write (with a lock prefix) is not needed
+  auto& a = counters[static_cast<std::size_t>(c)];
+  a.store(a.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+inline std::array<uint64_t, n_counters> snapshot() {
+  std::array<uint64_t, n_counters> values;
+  for (std::size_t i = 0; i < n_counters; i++) {
+    values[i] = counters[i].load(std::memory_order_relaxed);
+  }
+  return values;
+}
+
+inline std::atomic<bool> dump_requested {false};
+
+class sampler {
+public:
+  sampler()
+    : interval_ms_(sampling_interval_option::value()),
+      samples_(std::max(sampling_buffer_size_option::value(), std::size_t(1))) {
+    if (interval_ms_ > 0) {
+      struct sigaction sa;
+      sa.sa_handler = [](int) { dump_requested = true; };
+      sa.sa_flags = SA_RESTART;
+      sigemptyset(&sa.sa_mask);
+      if (sigaction(SIGUSR1, &sa, &prev_sa_) == -1) {
+        perror("sigaction");
+        die("sigaction() failed");
+      }
+
+      sampler_thread_ = std::thread([this] { sampler_loop(); });
+    }
+  }
+
+  ~sampler() {
+    if (sampler_thread_.joinable()) {
+      {
+        std::lock_guard lk(mutex_);
+        should_stop_ = true;
+      }
+      cv_.notify_one();
+      sampler_thread_.join();
+
+      sigaction(SIGUSR1, &prev_sa_, nullptr);
+
+      take_sample();
+      dump();
+    }
+  }
+
+  sampler(const sampler&) = delete;
+  sampler& operator=(const sampler&) = delete;
+
+private:
+  struct sample {
+    wallclock::wallclock_t           t;
+    std::array<uint64_t, n_counters> values;
+  };
+
+  void sampler_loop() {
+    std::unique_lock lk(mutex_);
+    while (!cv_.wait_for(lk, std::chrono::milliseconds(interval_ms_), [&] { return should_stop_; })) {
+      take_sample();
+      if (dump_requested.exchange(false)) {
+        dump();
+      }
+    }
+  }
+
+  void take_sample() {
+    samples_[n_samples_ % samples_.size()] = {wallclock::gettime_ns(), snapshot()};
+    n_samples_++;
+  }
+
+  void dump() const {
+    std::string filename = "ityr_samples_" + std::to_string(topology::my_rank()) + ".csv";
+    FILE* fp = std::fopen(filename.c_str(), "w");
+    if (!fp) {
+      perror("fopen");
+      return;
+    }
+
+    std::fprintf(fp, "time_ns");
+    for (std::size_t i = 0; i < n_counters; i++) {
+      std::fprintf(fp, ",%s", str(static_cast<counter>(i)));
+    }
+    std::fprintf(fp, "\n");
+
+    // oldest sample first
+    std::size_t n = std::min(n_samples_, samples_.size());
+    for (std::size_t k = n_samples_ - n; k < n_samples_; k++) {
+      const sample& s = samples_[k % samples_.size()];
+      std::fprintf(fp, "%lu", s.t);
+      for (uint64_t v : s.values) {
+        std::fprintf(fp, ",%lu", v);
+      }
+      std::fprintf(fp, "\n");
+    }
+
+    std::fclose(fp);
+  }
+
+  std::size_t             interval_ms_;
+  std::vector<sample>     samples_;
+  std::size_t             n_samples_ = 0;
+  std::thread             sampler_thread_;
+  std::mutex              mutex_;
+  std::condition_variable cv_;
+  bool                    should_stop_ = false;
+  struct sigaction        prev_sa_;
+};
+
+using instance = singleton<sampler>;
+
+ITYR_TEST_CASE("[ityr::common::sampling] counters") {
+  auto before = snapshot();
+  count(counter::cache_hit);
+  count(counter::fetched_bytes, 4096);
+  auto after = snapshot();
+  ITYR_CHECK(after[static_cast<std::size_t>(counter::cache_hit)] ==
+             before[static_cast<std::size_t>(counter::cache_hit)] + 1);
+  ITYR_CHECK(after[static_cast<std::size_t>(counter::fetched_bytes)] ==
+             before[static_cast<std::size_t>(counter::fetched_bytes)] + 4096);
+  ITYR_CHECK(after[static_cast<std::size_t>(counter::cache_miss)] ==
+             before[static_cast<std::size_t>(counter::cache_miss)]);
+}
+
+}
@@ -229,4 +229,53 @@ inline numa::node_t numa_n_nodes() { return instance::get().numa_n_nodes(); }
 inline numa::node_t numa_node(rank_t intra_rank) { return instance::get().numa_node(intra_rank); }
 inline const numa::node_bitmask& numa_nodemask_all() { return instance::get().numa_nodemask_all(); }
 
+// Bind the local memory region [addr, addr + size) of this process to its NUMA node
+inline void numa_bind_local(void* addr, std::size_t size) {
+  if (numa_enabled()) {
+    numa::bind_to(addr, size, numa_my_node());
+  }
+}
+
+/*
+ * Diagnostic for NUMA placement (collective; enabled by ITYR_NUMA_CHECK=1).
+ * Each process faults in its local region [addr, addr + size) and reports how many pages actually
+ * reside on its own NUMA node. Misplaced pages indicate that the memory was first touched or
+ * migrated by a process on another node, or that binding failed.
+ */
+inline void check_numa_placement(const char* region_name, void* addr, std::size_t size) {
+  if (!numa_check_option::value()) return;
+
+  if (numa_enabled()) {
+    // Read faults also allocate pages for shared memory
+    std::size_t page_size = get_page_size();
+    for (std::size_t o = 0; o < size; o += page_size) {
+      [[maybe_unused]] volatile std::byte b = reinterpret_cast<volatile std::byte*>(addr)[o];
+    }
+  }
+
+  numa::node_t my_node = numa_enabled() ? numa_my_node() : -1;
+  numa::page_placement pp = numa::query_placement(addr, size, my_node);
+
+  constexpr std::size_t n_fields = 5;
+  std::size_t vals[n_fields] = {std::size_t(my_node), pp.n_pages, pp.n_local, pp.n_remote, pp.n_absent};
+  std::vector<std::size_t> all_vals(n_fields * n_ranks());
+  mpi_allgather(vals, n_fields, all_vals.data(), n_fields, mpicomm());
+
+  if (my_rank() == 0) {
+    if (!numa_enabled()) {
+      printf("[ityr] NUMA placement of %s: NUMA is not available\n", region_name);
+      fflush(stdout);
+      return;
+    }
+
+    printf("[ityr] NUMA placement of %s:\n", region_name);
+    for (rank_t r = 0; r < n_ranks(); r++) {
+      const std::size_t* v = &all_vals[n_fields * r];
+      printf("  rank %d (node %d): %lu pages (local: %lu, remote: %lu, not present: %lu)%s\n",
+             r, int(v[0]), v[1], v[2], v[3], v[4], v[3] > 0 ? " <- misplaced" : "");
+    }
+    fflush(stdout);
+  }
+}
+
 }
@@ -5,6 +5,8 @@
 #include <cstdio>
 #include <cstdlib>
 #include <cstdint>
+#include <fstream>
+#include <string>
 
 #include "ityr/common/util.hpp"
 #include "ityr/common/mpi_util.hpp"
@@ -14,6 +16,63 @@ namespace ityr::common {
 
 class mmap_noreplace_exception : public std::exception {};
 
+enum class hugepage_mode {
+  none,
+  thp,       // transparent huge pages (`madvise(MADV_HUGEPAGE)`)
+  hugetlbfs, // explicit huge pages allocated from a hugetlbfs mount
+};
+
+inline hugepage_mode get_hugepage_mode() {
+  const std::string& mode = hugepage_option::value();
+  if (mode == "none" || mode.empty()) return hugepage_mode::none;
+  if (mode == "thp")                  return hugepage_mode::thp;
+  if (mode == "hugetlbfs")            return hugepage_mode::hugetlbfs;
+  die("[ityr::common] Unknown huge page mode: %s=%s (expected none, thp, or hugetlbfs)",
+      hugepage_option::name().c_str(), mode.c_str());
+}
+
+/*
+ * Default huge page size of the system (`Hugepagesize` in /proc/meminfo).
+ */
+inline std::size_t get_hugepage_size() {
+  static std::size_t hugepage_size = [] {
+    std::ifstream ifs("/proc/meminfo");
+    std::string key;
+    while (ifs >> key) {
+      if (key == "Hugepagesize:") {
+        std::size_t size_kb;
+        if (ifs >> size_kb) return size_kb * 1024;
+        break;
+      }
+      ifs.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+    }
+    return std::size_t(2) * 1024 * 1024;
+  }();
+  return hugepage_size;
+}
+
+/*
+ * Alignment of virtual memory reservations that are backed by huge pages when enabled.
+ * Regions aligned to the huge page size can be mapped with PMD entries by the kernel.
+ */
+inline std::size_t hugepage_alignment() {
+  return get_hugepage_mode() == hugepage_mode::none ? get_page_size() : get_hugepage_size();
+}
+
+/*
+ * Die if memory mapped in units of `granularity` cannot be backed by hugetlbfs pages,
+ * which must be mapped at huge page granularity.
+ */
+inline void validate_hugepage_granularity(std::size_t granularity, const char* what) {
+  if (get_hugepage_mode() == hugepage_mode::hugetlbfs &&
+      granularity % get_hugepage_size() != 0) {
+    die("[ityr::common] %s=hugetlbfs requires %s (%lu) to be a multiple of the huge page size (%lu); "
+        "enlarge it or use %s=thp instead",
+        hugepage_option::name().c_str(), what, granularity, get_hugepage_size(),
+        hugepage_option::name().c_str());
+  }
+}
+
 inline void munmap(void* addr, std::size_t size);
 
 inline void* mmap_no_physical_mem(void*       addr,
@@ -0,0 +1,292 @@
+#pragma once
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "ityr/common/util.hpp"
+#include "ityr/common/mpi_util.hpp"
+#include "ityr/common/topology.hpp"
+#include "ityr/ito/ito.hpp"
+#include "ityr/ori/ori.hpp"
+#include "ityr/pattern/parallel_loop.hpp"
+#include "ityr/container/global_span.hpp"
+
+namespace ityr {
+
+namespace internal {
+
+struct checkpoint_header {
+  char     magic[8];
+  uint64_t version;
+  uint64_t elem_size;
+  uint64_t count;
+};
+
+inline constexpr char        checkpoint_magic[8]    = {'I', 'T', 'Y', 'R', 'C', 'K', 'P', 'T'};
+inline constexpr uint64_t    checkpoint_version     = 1;
+// The data region is page-aligned in the file
+inline constexpr std::size_t checkpoint_data_offset = 4096;
+
+// Each home segment is further divided into intra-node processes sharing the same home memory
+template <typename T, typename Fn>
+inline void for_each_local_home_intra(ori::global_ptr<T> ptr, std::size_t count, Fn&& fn) {
+  auto intra_rank    = common::topology::intra_my_rank();
+  auto intra_n_ranks = common::topology::intra_n_ranks();
+  ori::for_each_local_home(ptr, count, [&](std::byte* home_addr, std::size_t offset, std::size_t size) {
+    std::size_t b = size * intra_rank / intra_n_ranks;
+    std::size_t e = size * (intra_rank + 1) / intra_n_ranks;
+    if (b < e) {
+      fn(home_addr + b, offset + b, e - b);
+    }
+  });
+}
+
+inline void checkpoint_pwrite(int fd, const std::byte* buf, std::size_t size, std::size_t offset) {
+  while (size > 0) {
+    ssize_t ret = pwrite(fd, buf, size, offset);
+    if (ret == -1) {
+      perror("pwrite");
+      common::die("[ityr::save_coll] pwrite() failed");
+    }
+    buf    += ret;
+    size   -= ret;
+    offset += ret;
+  }
+}
+
+inline void checkpoint_pread(int fd, std::byte* buf, std::size_t size, std::size_t offset) {
+  while (size > 0) {
+    ssize_t ret = pread(fd, buf, size, offset);
+    if (ret <= 0) {
+      if (ret == -1) perror("pread");
+      common::die("[ityr::load_coll] pread() failed (the checkpoint file may be truncated)");
+    }
+    buf    += ret;
+    size   -= ret;
+    offset += ret;
+  }
+}
+
+inline int checkpoint_open(const char* fpath, int flags) {
+  int fd = open(fpath, flags, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+  if (fd == -1) {
+    perror("open");
+    common::die("[ityr::checkpoint] open(%s) failed", fpath);
+  }
+  return fd;
+}
+
+template <typename T>
+inline void save_coll_spmd(global_span<T> s, const char* fpath) {
+  // Write back dirty cache data to home processes before directly reading home memory
+  ori::release();
+  common::mpi_barrier(common::topology::mpicomm());
+
+  if (common::topology::my_rank() == 0) {
+    int fd = checkpoint_open(fpath, O_WRONLY | O_CREAT | O_TRUNC);
+
+    checkpoint_header h;
+    std::memcpy(h.magic, checkpoint_magic, sizeof(h.magic));
+    h.version   = checkpoint_version;
+    h.elem_size = sizeof(T);
+    h.count     = s.size();
+    checkpoint_pwrite(fd, reinterpret_cast<const std::byte*>(&h), sizeof(h), 0);
+
+    if (ftruncate(fd, checkpoint_data_offset + s.size() * sizeof(T)) == -1) {
+      perror("ftruncate");
+      common::die("[ityr::save_coll] ftruncate() failed");
+    }
+    close(fd);
+  }
+
+  common::mpi_barrier(common::topology::mpicomm());
+
+  if (!s.empty()) {
+    int fd = checkpoint_open(fpath, O_WRONLY);
+    for_each_local_home_intra(s.data(), s.size(), [&](std::byte* home_addr, std::size_t offset, std::size_t size) {
+      checkpoint_pwrite(fd, home_addr, size, checkpoint_data_offset + offset);
+    });
+    if (fdatasync(fd) == -1) {
+      perror("fdatasync");
+      common::die("[ityr::save_coll] fdatasync() failed");
+    }
+    close(fd);
+  }
+
+  common::mpi_barrier(common::topology::mpicomm());
+}
+
+template <typename T>
+inline void load_coll_spmd(global_span<T> s, const char* fpath) {
+  // Home memory is directly overwritten; dirty cache data must not be written back after that
+  ori::release();
+  common::mpi_barrier(common::topology::mpicomm());
+
+  checkpoint_header h;
+  if (common::topology::my_rank() == 0) {
+    int fd = checkpoint_open(fpath, O_RDONLY);
+    checkpoint_pread(fd, reinterpret_cast<std::byte*>(&h), sizeof(h), 0);
+    close(fd);
+  }
+  h = common::mpi_bcast_value(h, 0, common::topology::mpicomm());
+
+  if (std::memcmp(h.magic, checkpoint_magic, sizeof(h.magic)) != 0 ||
+      h.version != checkpoint_version) {
+    common::die("[ityr::load_coll] %s is not a valid checkpoint file", fpath);
+  }
+  if (h.elem_size != sizeof(T) || h.count != s.size()) {
+    common::die("[ityr::load_coll] The checkpoint (elem_size=%lu, count=%lu) does not match "
+                "the global span (elem_size=%lu, count=%lu)",
+                h.elem_size, h.count, sizeof(T), s.size());
+  }
+
+  if (!s.empty()) {
+    int fd = checkpoint_open(fpath, O_RDONLY);
+    for_each_local_home_intra(s.data(), s.size(), [&](std::byte* home_addr, std::size_t offset, std::size_t size) {
+      checkpoint_pread(fd, home_addr, size, checkpoint_data_offset + offset);
+    });
+    close(fd);
+  }
+
+  common::mpi_barrier(common::topology::mpicomm());
+
+  // Invalidate stale cache data
+  ori::acquire();
+}
+
+template <typename Fn>
+inline void checkpoint_coll_exec(const std::string& fpath, Fn fn) {
+  if (ito::is_spmd()) {
+    fn(fpath.c_str());
+  } else if (ito::is_root()) {
+    ito::coll_exec([=, path = ito::coll_string(fpath)] { fn(path.get().c_str()); });
+  } else {
+    common::die("Checkpoint operations must be executed on the root thread or SPMD region.");
+  }
+}
+
+}
+
+/**
+ * @brief Save the contents of collective global memory to a file (collective).
+ *
+ * @param s     Global span of collective global memory (e.g., `ityr::global_vector` with the
+ *              `collective` option).
+ * @param fpath Path to the checkpoint file.
+ *
+ * Each process writes the elements whose home is the process directly from its home memory
+ * (without going through the cache) to the corresponding file offset in parallel.
+ * The file consists of a small header (the element size and count) and the elements in the
+ * order of indices. As the file format does not depend on the memory distribution, the checkpoint
+ * can be restored with different numbers of processes or memory distribution policies.
+ *
+ * This function must be called collectively by all processes (in the SPMD region or on the root
+ * thread). The file must be accessible from all processes with the same path (e.g., on a shared
+ * file system). `T` must be trivially copyable.
+ *
+ * Example:
+ * ```
+ * ityr::global_vector<double> v({.collective = true}, n);
+ * // ... compute ...
+ * ityr::save_coll(ityr::global_span<double>(v), "ckpt.bin");
+ * // ... restart ...
+ * ityr::load_coll(ityr::global_span<double>(v), "ckpt.bin");
+ * ```
+ *
+ * @see `ityr::load_coll()`
+ */
+template <typename T>
+inline void save_coll(global_span<T> s, const std::string& fpath) {
+  static_assert(std::is_trivially_copyable_v<T>);
+  internal::checkpoint_coll_exec(fpath, [=](const char* p) {
+    internal::save_coll_spmd(s, p);
+  });
+}
+
+/**
+ * @brief Load the contents of collective global memory from a file (collective).
+ *
+ * @param s     Global span of collective global memory to be overwritten.
+ * @param fpath Path to the checkpoint file saved by `ityr::save_coll()`.
+ *
+ * Each process reads the elements whose home is the process directly into its home memory
+ * in parallel. The program is aborted if the element size or count in the checkpoint does not
+ * match `s`.
+ *
+ * @see `ityr::save_coll()`
+ */
+template <typename T>
+inline void load_coll(global_span<T> s, const std::string& fpath) {
+  static_assert(std::is_trivially_copyable_v<T>);
+  static_assert(!std::is_const_v<T>);
+  internal::checkpoint_coll_exec(fpath, [=](const char* p) {
+    internal::load_coll_spmd(s, p);
+  });
+}
+
+ITYR_TEST_CASE("[ityr::checkpoint] save_coll and load_coll") {
+  ito::init();
+  ori::init();
+
+  auto my_rank = common::topology::my_rank();
+
+  long n = 100000;
+  std::string filename = "test_ckpt.bin";
+
+  auto p_block  = ori::malloc_coll<long, ori::mem_mapper::block >(n);
+  auto p_cyclic = ori::malloc_coll<long, ori::mem_mapper::cyclic>(n);
+
+  global_span<long> s_block (p_block , n);
+  global_span<long> s_cyclic(p_cyclic, n);
+
+  ito::root_exec([=] {
+    transform(
+        execution::parallel_policy(100),
+        count_iterator<long>(0), count_iterator<long>(n), s_block.begin(),
+        [](long i) { return i * 7; });
+
+    save_coll(s_block, filename);
+
+    fill(execution::parallel_policy(100), s_block.begin(), s_block.end(), -1);
+
+    // restore to the same memory layout
+    load_coll(s_block, filename);
+
+    for_each(
+        execution::parallel_policy(100),
+        count_iterator<long>(0), count_iterator<long>(n), s_block.begin(),
+        [](long i, long v) { ITYR_CHECK(v == i * 7); });
+
+    // restore to a different memory layout
+    load_coll(s_cyclic, filename);
+
+    for_each(
+        execution::parallel_policy(100),
+        count_iterator<long>(0), count_iterator<long>(n), s_cyclic.begin(),
+        [](long i, long v) { ITYR_CHECK(v == i * 7); });
+  });
+
+  // in the SPMD region
+  load_coll(s_block, filename);
+
+  ito::root_exec([=] {
+    for_each(
+        execution::parallel_policy(100),
+        count_iterator<long>(0), count_iterator<long>(n), s_block.begin(),
+        [](long i, long v) { ITYR_CHECK(v == i * 7); });
+  });
+
+  common::mpi_barrier(common::topology::mpicomm());
+
+  if (my_rank == 0) {
+    remove(filename.c_str());
+  }
+
+  ori::free_coll(p_block);
+  ori::free_coll(p_cyclic);
+
+  ori::fini();
+  ito::fini();
+}
+
+}
@@ -0,0 +1,256 @@
+#pragma once
+
+#include <sys/stat.h>
+
+#include "ityr/common/util.hpp"
+#include "ityr/common/mpi_util.hpp"
+#include "ityr/common/topology.hpp"
+#include "ityr/ito/ito.hpp"
+#include "ityr/ori/ori.hpp"
+#include "ityr/pattern/parallel_loop.hpp"
+#include "ityr/container/unique_file_ptr.hpp"
+
+namespace ityr {
+
+/**
+ * @brief Writable file-backed global memory.
+ *
+ * Unlike `ityr::unique_file_ptr`, which maps the whole file to every process in a read-only mode,
+ * a global file distributes the file to processes as collective global memory (with the block
+ * distribution). The home memory of each process is directly mapped (`MAP_SHARED`) to its slice
+ * of the file, and the file content can be accessed through global pointers (e.g., checkout/checkin
+ * operations or global iterators) as in `ityr::global_vector`.
+ *
+ * Modified data are written back from software caches to the page cache of the file, and `sync()`
+ * collectively flushes them to the storage. Therefore, large outputs can be written in parallel
+ * without staging them in another global memory region.
+ *
+ * The constructor, destructor, and `sync()` must be called collectively by all processes
+ * (i.e., in the SPMD region or in the root thread). The file must be accessible from all processes
+ * with the same path (e.g., on a shared file system).
+ *
+ * Example:
+ * ```
+ * // Create a new file of 1M elements and write to it in parallel
+ * ityr::global_file<long> f("out.bin", 1000000);
+ * ityr::transform(ityr::execution::par,
+ *                 ityr::count_iterator<long>(0), ityr::count_iterator<long>(f.size()),
+ *                 f.begin(), [](long i) { return i * i; });
+ * f.sync();
+ * ```
+ *
+ * @see `ityr::unique_file_ptr`
+ * @see `ityr::make_global_file()`
+ */
+template <typename T>
+class global_file {
+  static_assert(std::is_trivially_copyable_v<T>);
+
+public:
+  using element_type = T;
+  using value_type   = std::remove_cv_t<element_type>;
+  using size_type    = std::size_t;
+  using pointer      = ori::global_ptr<element_type>;
+  using iterator     = pointer;
+
+  constexpr global_file() noexcept {}
+
+  /**
+   * @brief Map an existing file (collective).
+   *
+   * The number of elements is determined by the file size, which must be a multiple of `sizeof(T)`.
+   */
+  explicit global_file(const std::string& fpath)
+    : global_file(fpath, file_count(fpath)) {}
+
+  /**
+   * @brief Create or open a file of `count` elements and map it (collective).
+   *
+   * If the file does not exist, it is created. The file is resized to `count` elements
+   * (newly extended regions are filled with zeros).
+   */
+  global_file(const std::string& fpath, size_type count)
+    : ptr_(alloc_coll(fpath, count)), n_(count) {}
+
+  ~global_file() { destroy(); }
+
+  global_file(const global_file&) = delete;
+  global_file& operator=(const global_file&) = delete;
+
+  global_file(global_file&& gf) noexcept
+    : ptr_(gf.ptr_), n_(gf.n_) { gf.ptr_ = nullptr; gf.n_ = 0; }
+  global_file& operator=(global_file&& gf) noexcept {
+    destroy();
+    ptr_ = gf.ptr_;
+    n_   = gf.n_;
+    gf.ptr_ = nullptr;
+    gf.n_   = 0;
+    return *this;
+  }
+
+  pointer data() const noexcept { return ptr_; }
+  size_type size() const noexcept { return n_; }
+  bool empty() const noexcept { return n_ == 0; }
+
+  iterator begin() const noexcept { return ptr_; }
+  iterator end() const noexcept { return ptr_ + n_; }
+
+  /**
+   * @brief Write all modified data to the file on the storage (collective).
+   *
+   * Dirty data in software caches are written back to the home processes, and then each
+   * process synchronously flushes its slice of the file (`msync()`).
+   */
+  void sync() {
+    if (!ptr_) return;
+    coll_exec_if_root([p = ptr_] {
+      ori::sync_file_coll(p);
+    });
+  }
+
+private:
+  void destroy() {
+    if (ptr_) {
+      coll_exec_if_root([p = ptr_] {
+        ori::free_coll(p);
+      });
+    }
+  }
+
+  template <typename Fn>
+  static auto coll_exec_if_root(Fn&& fn) {
+    if (ito::is_spmd()) {
+      return std::forward<Fn>(fn)();
+    } else if (!ito::is_root()) {
+      common::die("Collective operations for ityr::global_file must be executed on the root thread or SPMD region.");
+    }
+    return ito::coll_exec(std::forward<Fn>(fn));
+  }
+
+  static pointer alloc_coll(const std::string& fpath, size_type count) {
+    if (count == 0) return nullptr;
+    return coll_exec_if_root([=, path = ito::coll_string(fpath)] {
+      return ori::malloc_coll_file<T>(path.get(), count);
+    });
+  }
+
+  static size_type file_count(const std::string& fpath) {
+    size_type size = file_size(fpath);
+    if (size % sizeof(T) != 0) {
+      // Otherwise, the trailing bytes would be truncated when the file is unmapped
+      common::die("[ityr::global_file] The size of %s (%lu bytes) is not a multiple of the element size (%lu bytes)",
+                  fpath.c_str(), size, sizeof(T));
+    }
+    return size / sizeof(T);
+  }
+
+  static size_type file_size(const std::string& fpath) {
+    return coll_exec_if_root([=, path = ito::coll_string(fpath)] {
+      std::string p = path.get();
+      std::size_t size = 0;
+      if (common::topology::my_rank() == 0) {
+        struct stat sb;
+        if (stat(p.c_str(), &sb) == -1) {
+          perror("stat");
+          common::die("[ityr::global_file] stat(%s) failed", p.c_str());
+        }
+        size = sb.st_size;
+      }
+      return common::mpi_bcast_value(size, 0, common::topology::mpicomm());
+    });
+  }
+
+  pointer   ptr_ = nullptr;
+  size_type n_   = 0;
+};
+
+/**
+ * @brief Create a writable file-backed global memory for an existing file.
+ * @see `ityr::global_file`
+ */
+template <typename T>
+inline global_file<T> make_global_file(const std::string& fpath) {
+  return global_file<T>(fpath);
+}
+
+/**
+ * @brief Create a writable file-backed global memory of `count` elements.
+ * @see `ityr::global_file`
+ */
+template <typename T>
+inline global_file<T> make_global_file(const std::string& fpath, std::size_t count) {
+  return global_file<T>(fpath, count);
+}
+
+ITYR_TEST_CASE("[ityr::global_file] global_file") {
+  ito::init();
+  ori::init();
+
+  auto my_rank = common::topology::my_rank();
+
+  long n = 100000;
+  std::string filename = "test_rw.bin";
+
+  ITYR_SUBCASE("write and read") {
+    ito::root_exec([=] {
+      global_file<long> f = make_global_file<long>(filename, n);
+      ITYR_CHECK(f.size() == std::size_t(n));
+
+      transform(
+          execution::parallel_policy(100),
+          count_iterator<long>(0), count_iterator<long>(n), f.begin(),
+          [](long i) { return i * 3; });
+
+      f.sync();
+    });
+
+    if (my_rank == 0) {
+      std::vector<long> buf(n);
+      std::ifstream istream(filename, std::ios::binary | std::ios::ate);
+      ITYR_CHECK(std::size_t(istream.tellg()) == n * sizeof(long));
+      istream.seekg(0);
+      istream.read(reinterpret_cast<char*>(buf.data()), n * sizeof(long));
+      for (long i = 0; i < n; i++) {
+        ITYR_CHECK(buf[i] == i * 3);
+      }
+    }
+
+    common::mpi_barrier(common::topology::mpicomm());
+
+    // Update the existing file in the SPMD region
+    {
+      global_file<long> f = make_global_file<long>(filename);
+      ITYR_CHECK(f.size() == std::size_t(n));
+
+      ito::root_exec([=, p = f.data()] {
+        for_each(
+            execution::parallel_policy(100),
+            make_global_iterator(p    , checkout_mode::read_write),
+            make_global_iterator(p + n, checkout_mode::read_write),
+            [](long& v) { v += 1; });
+      });
+
+      // data should be written at destruction without explicit sync
+    }
+
+    {
+      unique_file_ptr<long> fp = make_unique_file<long>(filename);
+      ITYR_CHECK(fp.size() == std::size_t(n));
+      for (long i = 0; i < n; i++) {
+        ITYR_CHECK(fp[i] == i * 3 + 1);
+      }
+      common::mpi_barrier(common::topology::mpicomm());
+    }
+  }
+
+  common::mpi_barrier(common::topology::mpicomm());
+
+  if (my_rank == 0) {
+    remove(filename.c_str());
+  }
+
+  ori::fini();
+  ito::fini();
+}
+
+}
@@ -0,0 +1,709 @@
+#pragma once
+
+#include <array>
+
+#include "ityr/common/util.hpp"
+#include "ityr/ito/ito.hpp"
+#include "ityr/ori/ori.hpp"
+#include "ityr/pattern/count_iterator.hpp"
+#include "ityr/pattern/root_exec.hpp"
+#include "ityr/pattern/parallel_loop.hpp"
+#include "ityr/pattern/parallel_reduce.hpp"
+#include "ityr/container/checkout_span.hpp"
+
+namespace ityr {
+
+/**
+ * @brief Multi-dimensional index for `ityr::global_mdarray`.
+ */
+template <std::size_t Rank>
+using md_index = std::array<std::size_t, Rank>;
+
+/**
+ * @brief Distribution policy of tiles in `ityr::global_mdarray`.
+ */
+enum class mdarray_distribution {
+  /**
+   * @brief Tiles are contiguously distributed to processes (`ori::mem_mapper::block`).
+   */
+  block,
+
+  /**
+   * @brief Tiles are distributed to processes in a round-robin manner (`ori::mem_mapper::cyclic`).
+   */
+  cyclic,
+};
+
+namespace internal {
+
+template <std::size_t Rank>
+inline std::size_t md_product(const md_index<Rank>& a) {
+  std::size_t ret = 1;
+  for (std::size_t d = 0; d < Rank; d++) {
+    ret *= a[d];
+  }
+  return ret;
+}
+
+template <std::size_t Rank>
+inline md_index<Rank> md_unflatten(std::size_t i, const md_index<Rank>& shape) {
+  md_index<Rank> ret;
+  for (std::size_t d = Rank; d > 0; d--) {
+    ret[d - 1] = i % shape[d - 1];
+    i /= shape[d - 1];
+  }
+  return ret;
+}
+
+template <std::size_t Rank>
+inline std::size_t md_flatten(const md_index<Rank>& idx, const md_index<Rank>& shape) {
+  std::size_t ret = 0;
+  for (std::size_t d = 0; d < Rank; d++) {
+    ret = ret * shape[d] + idx[d];
+  }
+  return ret;
+}
+
+}
+
+/**
+ * @brief Global span for a multi-dimensional array with a tiled layout.
+ *
+ * A global mdspan is a lightweight view of `ityr::global_mdarray`, which can be freely copied to
+ * threads (e.g., captured by lambdas passed to `ityr::for_each_tile()`).
+ *
+ * The index space `[0, extents)` is divided into tiles of `tile_extents`. Elements are stored tile
+ * by tile (tiles are in row-major order), and the elements within each tile are also stored in
+ * row-major order. Each tile occupies `tile_stride()` elements, including the padding for tiles
+ * at the array boundary and for the alignment required by the tile distribution.
+ *
+ * @see `ityr::global_mdarray`
+ * @see `ityr::make_checkout()`
+ */
+template <typename T, std::size_t Rank>
+class global_mdspan {
+  static_assert(Rank > 0);
+
+public:
+  using element_type = T;
+  using value_type   = std::remove_cv_t<element_type>;
+  using size_type    = std::size_t;
+  using pointer      = ori::global_ptr<element_type>;
+  using index_type   = md_index<Rank>;
+
+  constexpr global_mdspan() noexcept {}
+
+  constexpr global_mdspan(pointer         ptr,
+                          const index_type& extents,
+                          const index_type& tile_extents,
+                          size_type       tile_stride) noexcept
+    : ptr_(ptr), extents_(extents), tile_extents_(tile_extents), tile_stride_(tile_stride) {}
+
+  template <typename R>
+  constexpr global_mdspan(const R& r) noexcept
+    : global_mdspan(r.data(), r.extents(), r.tile_extents(), r.tile_stride()) {}
+
+  constexpr pointer data() const noexcept { return ptr_; }
+
+  constexpr static size_type rank() noexcept { return Rank; }
+
+  constexpr const index_type& extents() const noexcept { return extents_; }
+  constexpr size_type extent(size_type d) const noexcept { return extents_[d]; }
+
+  constexpr const index_type& tile_extents() const noexcept { return tile_extents_; }
+  constexpr size_type tile_stride() const noexcept { return tile_stride_; }
+
+  /**
+   * @brief The number of elements (excluding padding).
+   */
+  size_type size() const noexcept { return internal::md_product(extents_); }
+
+  /**
+   * @brief The number of tiles in each dimension.
+   */
+  index_type tile_counts() const noexcept {
+    index_type ret;
+    for (size_type d = 0; d < Rank; d++) {
+      ret[d] = (extents_[d] + tile_extents_[d] - 1) / tile_extents_[d];
+    }
+    return ret;
+  }
+
+  /**
+   * @brief The total number of tiles.
+   */
+  size_type n_tiles() const noexcept { return internal::md_product(tile_counts()); }
+
+  /**
+   * @brief Global pointer to the first element of the `t`-th tile (in row-major order of tiles).
+   */
+  pointer tile_data(size_type t) const noexcept {
+    return ptr_ + t * tile_stride_;
+  }
+
+  /**
+   * @brief Index range `[lower, upper)` of the `t`-th tile.
+   */
+  std::pair<index_type, index_type> tile_bounds(size_type t) const noexcept {
+    index_type tidx = internal::md_unflatten(t, tile_counts());
+    index_type lo, hi;
+    for (size_type d = 0; d < Rank; d++) {
+      lo[d] = tidx[d] * tile_extents_[d];
+      hi[d] = std::min(lo[d] + tile_extents_[d], extents_[d]);
+    }
+    return {lo, hi};
+  }
+
+  /**
+   * @brief Expand the index range `[lower, upper)` by `width` in each direction (clipped to the array).
+   *
+   * This is useful for computing the range of a tile with its halo region.
+   */
+  std::pair<index_type, index_type> expand(const index_type& lower,
+                                           const index_type& upper,
+                                           size_type         width) const noexcept {
+    index_type lo, hi;
+    for (size_type d = 0; d < Rank; d++) {
+      lo[d] = lower[d] >= width ? lower[d] - width : 0;
+      hi[d] = std::min(upper[d] + width, extents_[d]);
+    }
+    return {lo, hi};
+  }
+
+  /**
+   * @brief Global pointer to the element at `idx`.
+   */
+  pointer element_ptr(const index_type& idx) const noexcept {
+    index_type tidx, lidx;
+    for (size_type d = 0; d < Rank; d++) {
+      ITYR_CHECK(idx[d] < extents_[d]);
+      tidx[d] = idx[d] / tile_extents_[d];
+      lidx[d] = idx[d] % tile_extents_[d];
+    }
+    return tile_data(internal::md_flatten(tidx, tile_counts())) +
+           internal::md_flatten(lidx, tile_extents_);
+  }
+
+private:
+  pointer    ptr_          = nullptr;
+  index_type extents_      = {};
+  index_type tile_extents_ = {};
+  size_type  tile_stride_  = 0;
+};
+
+/**
+ * @brief Checkout span for a rectangular region of a multi-dimensional array.
+ *
+ * A checkout mdspan is created by `ityr::make_checkout()` for `ityr::global_mdspan` and manages the
+ * lifetime of the checked-out memory, as `ityr::checkout_span` does. Elements are accessed by their
+ * global indices (`cs(i, j)` or `cs[{i, j}]`), which must be within the checked-out region.
+ *
+ * @see `ityr::make_checkout()`
+ */
+template <typename T, std::size_t Rank, typename Mode>
+class checkout_mdspan {
+public:
+  using element_type = T;
+  using value_type   = std::remove_cv_t<element_type>;
+  using size_type    = std::size_t;
+  using pointer      = element_type*;
+  using reference    = element_type&;
+  using index_type   = md_index<Rank>;
+
+  checkout_mdspan() {}
+
+  /**
+   * @brief Construct a checkout mdspan by checking out the region `[lower, upper)` of `s`.
+   *
+   * All memory regions required for the rectangular region are checked out in a nonblocking way,
+   * and then they are completed at once.
+   */
+  checkout_mdspan(global_mdspan<T, Rank> s, const index_type& lower, const index_type& upper, Mode)
+    : lower_(lower), upper_(upper), tile_extents_(s.tile_extents()) {
+    index_type box_shape, tile_shape, tile_counts = s.tile_counts();
+    for (size_type d = 0; d < Rank; d++) {
+      ITYR_CHECK(lower[d] <= upper[d]);
+      ITYR_CHECK(upper[d] <= s.extent(d));
+      if (lower[d] == upper[d]) return;
+      tile_lower_[d] = lower[d] / tile_extents_[d];
+      tile_shape[d]  = (upper[d] - 1) / tile_extents_[d] + 1 - tile_lower_[d];
+      box_shape[d]   = upper[d] - lower[d];
+    }
+
+    n_tiles_last_ = tile_shape[Rank - 1];
+    rows_.resize(internal::md_product(box_shape) / box_shape[Rank - 1] * n_tiles_last_);
+
+    // With the read mode, it is safe to fetch the gap between rows in each tile, which merges
+    // the checkout requests into one per tile. Otherwise, the gap must not be checked out, as it
+    // may be modified by others and would be overwritten at checkin.
+    constexpr bool merge_gaps = std::is_same_v<Mode, checkout_mode::read_t>;
+
+    // (row index, offset of the row segment from the beginning of the current run)
+    std::vector<std::pair<size_type, size_type>> run_rows;
+
+    for (size_type t = 0; t < internal::md_product(tile_shape); t++) {
+      index_type tidx = internal::md_unflatten(t, tile_shape);
+      index_type c_lo, c_shape;
+      for (size_type d = 0; d < Rank; d++) {
+        tidx[d] += tile_lower_[d];
+        size_type tile_lo = tidx[d] * tile_extents_[d];
+        c_lo[d]    = std::max(lower[d], tile_lo) - tile_lo;
+        c_shape[d] = std::min(upper[d], tile_lo + tile_extents_[d]) - tile_lo - c_lo[d];
+      }
+
+      auto tile_ptr = s.tile_data(internal::md_flatten(tidx, tile_counts));
+
+      size_type run_begin = 0;
+      size_type run_end   = 0;
+      run_rows.clear();
+
+      auto flush_run = [&]() {
+        if (run_end == run_begin) return;
+        checkout_span<T, Mode> cs;
+        cs.checkout_nb(tile_ptr + run_begin, run_end - run_begin, Mode{});
+        for (auto [r, offset] : run_rows) {
+          rows_[r] = {cs.data() + offset, c_lo[Rank - 1]};
+        }
+        css_.push_back(std::move(cs));
+        run_rows.clear();
+      };
+
+      size_type n_rows = internal::md_product(c_shape) / c_shape[Rank - 1];
+      for (size_type r = 0; r < n_rows; r++) {
+        index_type lidx = internal::md_unflatten(r * c_shape[Rank - 1], c_shape);
+        index_type bidx;
+        for (size_type d = 0; d < Rank; d++) {
+          lidx[d] += c_lo[d];
+          bidx[d] = tidx[d] * tile_extents_[d] + lidx[d] - lower[d];
+        }
+
+        size_type seg_begin = internal::md_flatten(lidx, tile_extents_);
+        size_type seg_end   = seg_begin + c_shape[Rank - 1];
+
+        if (run_end != run_begin && (seg_begin == run_end || merge_gaps)) {
+          run_end = seg_end;
+        } else {
+          flush_run();
+          run_begin = seg_begin;
+          run_end   = seg_end;
+        }
+
+        size_type row_id = internal::md_flatten(bidx, box_shape) / box_shape[Rank - 1] * n_tiles_last_ +
+                           (tidx[Rank - 1] - tile_lower_[Rank - 1]);
+        run_rows.emplace_back(row_id, seg_begin - run_begin);
+      }
+
+      flush_run();
+    }
+
+    ori::checkout_complete();
+  }
+
+  checkout_mdspan(const checkout_mdspan&) = delete;
+  checkout_mdspan& operator=(const checkout_mdspan&) = delete;
+
+  checkout_mdspan(checkout_mdspan&&) = default;
+  checkout_mdspan& operator=(checkout_mdspan&&) = default;
+
+  const index_type& lower() const noexcept { return lower_; }
+  const index_type& upper() const noexcept { return upper_; }
+
+  /**
+   * @brief The number of underlying checkout requests issued for this region.
+   */
+  size_type n_checkouts() const noexcept { return css_.size(); }
+
+  reference operator[](const index_type& idx) const {
+    size_type row = 0;
+    for (size_type d = 0; d < Rank - 1; d++) {
+      ITYR_CHECK(lower_[d] <= idx[d]);
+      ITYR_CHECK(idx[d] < upper_[d]);
+      row = row * (upper_[d] - lower_[d]) + (idx[d] - lower_[d]);
+    }
+    size_type i = idx[Rank - 1];
+    ITYR_CHECK(lower_[Rank - 1] <= i);
+    ITYR_CHECK(i < upper_[Rank - 1]);
+    size_type te = tile_extents_[Rank - 1];
+    const row_segment& rs = rows_[row * n_tiles_last_ + (i / te - tile_lower_[Rank - 1])];
+    ITYR_CHECK(rs.col_begin <= i % te);
+    return rs.data[i % te - rs.col_begin];
+  }
+
+  template <typename... Indices>
+  reference operator()(Indices... idxs) const {
+    static_assert(sizeof...(Indices) == Rank);
+    return (*this)[index_type{static_cast<size_type>(idxs)...}];
+  }
+
+  /**
+   * @brief Manually perform the checkin operation by discarding the current checkout mdspan.
+   */
+  void checkin() {
+    css_.clear();
+    rows_.clear();
+  }
+
+private:
+  // The checked-out part of a row within a tile, beginning at column `col_begin` of the tile
+  struct row_segment {
+    pointer   data;
+    size_type col_begin;
+  };
+
+  index_type                          lower_         = {};
+  index_type                          upper_         = {};
+  index_type                          tile_extents_  = {};
+  index_type                          tile_lower_    = {};
+  size_type                           n_tiles_last_  = 0;
+  std::vector<row_segment>            rows_;
+  std::vector<checkout_span<T, Mode>> css_;
+};
+
+/**
+ * @brief Checkout a rectangular region of a multi-dimensional array.
+ *
+ * @param s     Global mdspan to be checked out.
+ * @param lower Lower bound (inclusive) of the region.
+ * @param upper Upper bound (exclusive) of the region.
+ * @param mode  Checkout mode (`ityr::checkout_mode`).
+ *
+ * @return The checkout mdspan `ityr::checkout_mdspan` for the specified region.
+ *
+ * Only the tiles overlapping with the region are checked out, and the checkout requests for them
+ * are issued at once so that the communication is overlapped. Rows that are contiguous in memory
+ * are merged into a single request. With `ityr::checkout_mode::read`, all rows in the same tile
+ * are merged into one request (the gap between rows is also fetched).
+ *
+ * Example (stencil with a halo of width 1):
+ * ```
+ * ityr::for_each_tile(ityr::execution::par, s_out, [=](auto lo, auto hi) {
+ *   auto [hlo, hhi] = s_in.expand(lo, hi, 1);
+ *   auto cs_in  = ityr::make_checkout(s_in, hlo, hhi, ityr::checkout_mode::read);
+ *   auto cs_out = ityr::make_checkout(s_out, lo, hi, ityr::checkout_mode::write);
+ *   ...
+ * });
+ * ```
+ *
+ * @see `ityr::make_checkout()` for `ityr::global_span`.
+ */
+template <typename T, std::size_t Rank, typename Mode>
+inline checkout_mdspan<T, Rank, Mode> make_checkout(global_mdspan<T, Rank> s,
+                                                    const md_index<Rank>&  lower,
+                                                    const md_index<Rank>&  upper,
+                                                    Mode                   mode) {
+  return checkout_mdspan<T, Rank, Mode>{s, lower, upper, mode};
+}
+
+/**
+ * @brief Apply a function to each tile of a multi-dimensional array in parallel.
+ *
+ * @param policy Execution policy (`ityr::execution`). The cutoff count is in the number of tiles.
+ * @param s      Global mdspan.
+ * @param op     Operator called with the index range `[lower, upper)` of each tile.
+ *
+ * Tiles at the array boundary may be smaller than the tile extents.
+ */
+template <typename ExecutionPolicy, typename T, std::size_t Rank, typename Op>
+inline void for_each_tile(const ExecutionPolicy& policy,
+                          global_mdspan<T, Rank> s,
+                          Op                     op) {
+  for_each(
+      policy,
+      count_iterator<std::size_t>(0),
+      count_iterator<std::size_t>(s.n_tiles()),
+      [=](std::size_t t) {
+        auto [lo, hi] = s.tile_bounds(t);
+        op(lo, hi);
+      });
+}
+
+/**
+ * @brief Global multi-dimensional array with a tiled layout.
+ *
+ * A global mdarray is a collective container that manages a `Rank`-dimensional array in global memory.
+ * Its elements are stored in tiles of the given tile extents, so that a rectangular region (e.g., a
+ * tile with its halo in stencil computations) can be checked out with a few contiguous requests,
+ * rather than one request per row of a flattened row-major array.
+ * If the tile extents are equal to the array extents, the layout is the usual row-major layout.
+ *
+ * Tiles are distributed to processes by `ityr::mdarray_distribution`. With the cyclic distribution,
+ * each tile is padded to a multiple of the block size so that tiles do not straddle processes.
+ *
+ * A global mdarray must be allocated and deallocated by all processes collectively, either in the
+ * SPMD region or in the root thread. `T` must be trivially copyable, and elements are left
+ * uninitialized unless an initial value is given.
+ *
+ * Example:
+ * ```
+ * ityr::global_mdarray<double, 2> a({1000, 1000}, {64, 64}, 0.0);
+ * ityr::global_mdspan<double, 2> s(a);
+ *
+ * ityr::for_each_tile(ityr::execution::par, s, [=](auto lo, auto hi) {
+ *   auto cs = ityr::make_checkout(s, lo, hi, ityr::checkout_mode::read_write);
+ *   for (std::size_t i = lo[0]; i < hi[0]; i++) {
+ *     for (std::size_t j = lo[1]; j < hi[1]; j++) {
+ *       cs(i, j) += i + j;
+ *     }
+ *   }
+ * });
+ * ```
+ *
+ * @see `ityr::global_mdspan`
+ * @see `ityr::make_checkout()`
+ * @see `ityr::for_each_tile()`
+ */
+template <typename T, std::size_t Rank>
+class global_mdarray {
+  using this_t = global_mdarray;
+
+  static_assert(std::is_trivially_copyable_v<T>);
+
+public:
+  using element_type = T;
+  using value_type   = std::remove_cv_t<element_type>;
+  using size_type    = std::size_t;
+  using pointer      = ori::global_ptr<element_type>;
+  using index_type   = md_index<Rank>;
+
+  global_mdarray() noexcept {}
+
+  /**
+   * @brief Create a global mdarray (collective).
+   *
+   * @param extents      The number of elements in each dimension.
+   * @param tile_extents The number of elements of each tile in each dimension.
+   * @param dist         Distribution policy of tiles.
+   */
+  global_mdarray(const index_type&    extents,
+                 const index_type&    tile_extents,
+                 mdarray_distribution dist = mdarray_distribution::block)
+    : view_(nullptr, extents, tile_extents, 0) {
+    for (size_type d = 0; d < Rank; d++) {
+      ITYR_CHECK(tile_extents[d] > 0);
+    }
+
+    size_type tile_stride = internal::md_product(tile_extents);
+    if (dist == mdarray_distribution::cyclic) {
+      size_type bs = ori::get_block_size();
+      ITYR_CHECK(bs % sizeof(T) == 0);
+      tile_stride = common::round_up_pow2(tile_stride * sizeof(T), bs) / sizeof(T);
+    }
+
+    size_type n_elems = view_.n_tiles() * tile_stride;
+
+    pointer p = coll_exec_if_root([=] {
+      if (dist == mdarray_distribution::cyclic) {
+        return ori::malloc_coll<T, ori::mem_mapper::cyclic>(n_elems, tile_stride * sizeof(T));
+      } else {
+        return ori::malloc_coll<T, ori::mem_mapper::block>(n_elems);
+      }
+    });
+
+    view_ = global_mdspan<T, Rank>(p, extents, tile_extents, tile_stride);
+  }
+
+  /**
+   * @brief Create a global mdarray (collective) and fill all elements with `value`.
+   */
+  global_mdarray(const index_type&    extents,
+                 const index_type&    tile_extents,
+                 const value_type&    value,
+                 mdarray_distribution dist = mdarray_distribution::block)
+    : global_mdarray(extents, tile_extents, dist) {
+    fill(value);
+  }
+
+  ~global_mdarray() { destroy(); }
+
+  global_mdarray(const this_t&) = delete;
+  this_t& operator=(const this_t&) = delete;
+
+  global_mdarray(this_t&& other) noexcept : view_(other.view_) {
+    other.view_ = global_mdspan<T, Rank>{};
+  }
+  this_t& operator=(this_t&& other) noexcept {
+    destroy();
+    view_ = other.view_;
+    other.view_ = global_mdspan<T, Rank>{};
+    return *this;
+  }
+
+  pointer data() const noexcept { return view_.data(); }
+
+  constexpr static size_type rank() noexcept { return Rank; }
+
+  const index_type& extents() const noexcept { return view_.extents(); }
+  size_type extent(size_type d) const noexcept { return view_.extent(d); }
+
+  const index_type& tile_extents() const noexcept { return view_.tile_extents(); }
+  size_type tile_stride() const noexcept { return view_.tile_stride(); }
+
+  size_type size() const noexcept { return view_.size(); }
+  size_type n_tiles() const noexcept { return view_.n_tiles(); }
+
+  /**
+   * @brief Fill all elements with `value` in parallel (must be called in the SPMD region or on the root thread).
+   */
+  void fill(const value_type& value) {
+    root_exec_if_spmd([=, s = view_] {
+      // Each tile (including padding) is contiguous and can be checked out at once
+      for_each(
+          execution::par,
+          count_iterator<size_type>(0),
+          count_iterator<size_type>(s.n_tiles()),
+          [=](size_type t) {
+            auto cs = make_checkout(s.tile_data(t), s.tile_stride(), checkout_mode::write);
+            std::fill(cs.begin(), cs.end(), value);
+          });
+    });
+  }
+
+private:
+  void destroy() {
+    if (view_.data()) {
+      coll_exec_if_root([p = view_.data()] {
+        ori::free_coll(p);
+      });
+    }
+  }
+
+  template <typename Fn>
+  auto root_exec_if_spmd(Fn&& fn) const {
+    if (ito::is_spmd()) {
+      return root_exec(std::forward<Fn>(fn));
+    } else if (!ito::is_root()) {
+      common::die("Parallel operations for ityr::global_mdarray must be executed on the root thread or SPMD region.");
+    }
+    return std::forward<Fn>(fn)();
+  }
+
+  template <typename Fn>
+  auto coll_exec_if_root(Fn&& fn) const {
+    if (ito::is_spmd()) {
+      return std::forward<Fn>(fn)();
+    } else if (!ito::is_root()) {
+      common::die("Collective operations for ityr::global_mdarray must be executed on the root thread or SPMD region.");
+    }
+    return ityr::coll_exec(std::forward<Fn>(fn));
+  }
+
+  global_mdspan<T, Rank> view_;
+};
+
+ITYR_TEST_CASE("[ityr::container::global_mdarray] tiled checkout") {
+  ito::init();
+  ori::init();
+
+  using idx2 = md_index<2>;
+
+  std::size_t n = 100, m = 70;
+
+  auto check_stencil = [=](idx2 tile_extents, mdarray_distribution dist) {
+    global_mdarray<long, 2> a({n, m}, tile_extents, dist);
+    global_mdarray<long, 2> b({n, m}, tile_extents, 0, dist);
+    global_mdspan<long, 2> sa(a);
+    global_mdspan<long, 2> sb(b);
+
+    ITYR_CHECK(sa.size() == n * m);
+
+    long sum = root_exec([=] {
+      for_each_tile(execution::parallel_policy(1), sa, [=](idx2 lo, idx2 hi) {
+        auto cs = make_checkout(sa, lo, hi, checkout_mode::write);
+        for (std::size_t i = lo[0]; i < hi[0]; i++) {
+          for (std::size_t j = lo[1]; j < hi[1]; j++) {
+            cs(i, j) = i * 1000 + j;
+          }
+        }
+      });
+
+      // 5-point stencil
+      for_each_tile(execution::parallel_policy(1), sb, [=](idx2 lo, idx2 hi) {
+        auto [hlo, hhi] = sa.expand(lo, hi, 1);
+        auto cs_a = make_checkout(sa, hlo, hhi, checkout_mode::read);
+        auto cs_b = make_checkout(sb, lo, hi, checkout_mode::read_write);
+        for (std::size_t i = std::max(lo[0], std::size_t(1)); i < std::min(hi[0], n - 1); i++) {
+          for (std::size_t j = std::max(lo[1], std::size_t(1)); j < std::min(hi[1], m - 1); j++) {
+            cs_b(i, j) += cs_a(i - 1, j) + cs_a(i + 1, j) + cs_a(i, j - 1) + cs_a(i, j + 1) - 4 * cs_a(i, j);
+          }
+          if (lo[1] == 0) {
+            cs_b(i, 0) = cs_a(i, 0);
+          }
+        }
+      });
+
+      return transform_reduce(
+          execution::parallel_policy(1),
+          count_iterator<std::size_t>(0), count_iterator<std::size_t>(n * m),
+          reducer::plus<long>{},
+          [=](std::size_t k) {
+            auto cs = make_checkout(sb.element_ptr({k / m, k % m}), 1, checkout_mode::read);
+            return cs[0];
+          });
+    });
+
+    // The stencil result is zero for the linear function; only the left boundary remains
+    long expected = 0;
+    for (std::size_t i = 1; i < n - 1; i++) {
+      expected += i * 1000;
+    }
+    ITYR_CHECK(sum == expected);
+  };
+
+  ITYR_SUBCASE("row-major") {
+    check_stencil({n, m}, mdarray_distribution::block);
+  }
+
+  ITYR_SUBCASE("tiled (block)") {
+    check_stencil({16, 16}, mdarray_distribution::block);
+  }
+
+  ITYR_SUBCASE("tiled (cyclic)") {
+    check_stencil({8, 32}, mdarray_distribution::cyclic);
+  }
+
+  ITYR_SUBCASE("number of checkouts") {
+    global_mdarray<int, 2> a({64, 64}, {16, 16}, 0);
+    global_mdspan<int, 2> s(a);
+    root_exec([=] {
+      {
+        // one tile with halo: covers 3x3 tiles; each tile is checked out once
+        auto cs = make_checkout(s, {15, 15}, {33, 33}, checkout_mode::read);
+        ITYR_CHECK(cs.n_checkouts() == 9);
+      }
+      {
+        // full-width rows are contiguous
+        auto cs = make_checkout(s, {16, 0}, {32, 16}, checkout_mode::read_write);
+        ITYR_CHECK(cs.n_checkouts() == 1);
+      }
+      {
+        // partial rows must not be merged with the write mode
+        auto cs = make_checkout(s, {0, 0}, {4, 2}, checkout_mode::write);
+        ITYR_CHECK(cs.n_checkouts() == 4);
+      }
+    });
+  }
+
+  ITYR_SUBCASE("3D") {
+    using idx3 = md_index<3>;
+    global_mdarray<int, 3> a({10, 11, 12}, {4, 4, 4}, 1);
+    global_mdspan<int, 3> s(a);
+    int sum = root_exec([=] {
+      auto cs = make_checkout(s, {1, 2, 3}, {9, 10, 11}, checkout_mode::read);
+      int ret = 0;
+      for (std::size_t i = 1; i < 9; i++) {
+        for (std::size_t j = 2; j < 10; j++) {
+          for (std::size_t k = 3; k < 11; k++) {
+            ret += cs[idx3{i, j, k}];
+          }
+        }
+      }
+      return ret;
+    });
+    ITYR_CHECK(sum == 8 * 8 * 8);
+  }
+
+  ori::fini();
+  ito::fini();
+}
+
+}
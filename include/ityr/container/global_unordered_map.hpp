@@ -0,0 +1,718 @@
+#pragma once
+
+#include <optional>
+
+#include "ityr/common/util.hpp"
+#include "ityr/common/topology.hpp"
+#include "ityr/ito/ito.hpp"
+#include "ityr/ori/ori.hpp"
+#include "ityr/pattern/count_iterator.hpp"
+#include "ityr/pattern/root_exec.hpp"
+#include "ityr/pattern/serial_loop.hpp"
+#include "ityr/pattern/parallel_loop.hpp"
+#include "ityr/pattern/parallel_reduce.hpp"
+#include "ityr/pattern/parallel_sort.hpp"
+#include "ityr/pattern/parallel_search.hpp"
+#include "ityr/container/checkout_span.hpp"
+
+#if __has_include(<ankerl/unordered_dense.h>)
+#include <ankerl/unordered_dense.h>
+namespace ityr::internal {
+template <typename Key>
+using default_hash = ankerl::unordered_dense::hash<Key>;
+}
+#else
+#include <functional>
+namespace ityr::internal {
+template <typename Key>
+using default_hash = std::hash<Key>;
+}
+#endif
+
+namespace ityr {
+
+namespace internal {
+
+inline uint64_t mix_hash(uint64_t h) {
+  // Some hash functions (e.g., std::hash for integers) are identity functions, but both the upper
+  // and lower bits are used to choose shards and buckets.
+  h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9;
+  h = (h ^ (h >> 27)) * 0x94d049bb133111eb;
+  return h ^ (h >> 31);
+}
+
+}
+
+/**
+ * @brief Global unordered map partitioned by the key hash.
+ *
+ * A global unordered map is an associative container that stores key-value pairs in global memory.
+ * The key space is partitioned by hash values into shards, and each shard is an open-addressing
+ * hash table (with linear probing) allocated in the global memory of one process.
+ * The number of shards is the number of processes (`ityr::n_ranks()`) multiplied by `shards_per_rank`.
+ *
+ * A global unordered map is a collective container; it must be allocated and deallocated by all
+ * processes collectively, either in the SPMD region or in the root thread.
+ * When a shard becomes too full during insertion, all shards are collectively grown (rehashed) to
+ * twice the size, and the remaining requests are applied to the grown table. `reserve()` can be
+ * used to avoid repeated growth when the number of elements is known in advance.
+ *
+ * Operations are batched. `insert()` and `update()` first sort the requests by their shard and
+ * bucket, and then the requests for each shard are processed as a group by the process that owns
+ * the shard (the home of its slots). Therefore, no lock is required, and the slots of a shard are
+ * accessed locally. `find()` performs independent lookups in parallel; hot keys are served from the
+ * local software cache of global memory. Batch operations must be called in the SPMD region or on
+ * the root thread.
+ *
+ * `Key` and `Value` must be trivially copyable. The hash function is `ankerl::unordered_dense::hash`
+ * by default (`std::hash` if unordered_dense is not available).
+ *
+ * Example:
+ * ```
+ * struct kv { long first; long second; };
+ * ityr::global_vector<kv> reqs({.collective = true}, {{1, 10}, {2, 20}, {1, 30}});
+ * ityr::global_vector<long> keys({.collective = true}, {1, 3});
+ * ityr::global_vector<std::optional<long>> values({.collective = true}, 2);
+ *
+ * ityr::global_unordered_map<long, long> m(1000);
+ * m.insert(ityr::execution::par, reqs.begin(), reqs.end());
+ * // m = {1: 10, 2: 20}
+ *
+ * m.update(ityr::execution::par, reqs.begin(), reqs.end(),
+ *          [](long& v, const kv& r) { v += r.second; });
+ * // m = {1: 50, 2: 40}
+ *
+ * m.find(ityr::execution::par, keys.begin(), keys.end(), values.begin());
+ * // values = {50, std::nullopt}
+ * ```
+ *
+ * @see [std::unordered_map -- cppreference.com](https://en.cppreference.com/w/cpp/container/unordered_map)
+ * @see `ityr::global_vector`
+ */
+template <typename Key, typename Value,
+          typename Hash = internal::default_hash<Key>, typename KeyEqual = std::equal_to<Key>>
+class global_unordered_map {
+  using this_t = global_unordered_map;
+
+  static_assert(std::is_trivially_copyable_v<Key>);
+  static_assert(std::is_trivially_copyable_v<Value>);
+
+public:
+  using key_type    = Key;
+  using mapped_type = Value;
+  using hasher      = Hash;
+  using key_equal   = KeyEqual;
+  using size_type   = std::size_t;
+
+  constexpr static size_type default_shards_per_rank = 16;
+
+  /**
+   * @brief Create a global unordered map (collective).
+   *
+   * @param capacity        The maximum number of elements expected to be stored.
+   * @param shards_per_rank The number of shards allocated in each process.
+   *
+   * The number of buckets is twice the capacity (rounded up to a power of two for each shard),
+   * so that the load factor is kept low.
+   */
+  explicit global_unordered_map(size_type capacity,
+                                size_type shards_per_rank = default_shards_per_rank) {
+    ITYR_CHECK(shards_per_rank > 0);
+
+    size_type n_shards = common::topology::n_ranks() * shards_per_rank;
+
+    table_.n_shards = n_shards;
+    table_.shard_sizes = coll_exec_if_root([=] {
+      return ori::malloc_coll<size_type>(n_shards);
+    });
+
+    root_exec_if_spmd([=, t = table_] {
+      fill(execution::parallel_policy(cutoff_count), t.shard_sizes, t.shard_sizes + n_shards, size_type(0));
+    });
+
+    table_ = allocate_slots(table_, calc_shard_capacity(2 * capacity, n_shards));
+  }
+
+  ~global_unordered_map() { destroy(); }
+
+  global_unordered_map(const this_t&) = delete;
+  this_t& operator=(const this_t&) = delete;
+
+  global_unordered_map(this_t&& other) noexcept
+    : table_(other.table_), size_(other.size_) {
+    other.table_.slots       = nullptr;
+    other.table_.shard_sizes = nullptr;
+    other.size_ = 0;
+  }
+  this_t& operator=(this_t&& other) noexcept {
+    destroy();
+    table_ = other.table_;
+    size_  = other.size_;
+    other.table_.slots       = nullptr;
+    other.table_.shard_sizes = nullptr;
+    other.size_ = 0;
+    return *this;
+  }
+
+  size_type size() const noexcept { return size_; }
+
+  bool empty() const noexcept { return size_ == 0; }
+
+  size_type bucket_count() const noexcept { return table_.n_shards * table_.shard_capacity; }
+
+  size_type n_shards() const noexcept { return table_.n_shards; }
+
+  /**
+   * @brief Grow the map so that at least `capacity` elements can be stored without growing (collective).
+   *
+   * @param capacity The number of elements expected to be stored.
+   *
+   * This must be called in the SPMD region or on the root thread. If the current number of buckets
+   * is sufficient, nothing happens.
+   */
+  void reserve(size_type capacity) {
+    size_type shard_capacity = calc_shard_capacity(2 * capacity, table_.n_shards);
+    if (shard_capacity <= table_.shard_capacity) return;
+
+    table_ = root_exec_if_spmd([=, t = table_] {
+      return grow(t, shard_capacity);
+    });
+  }
+
+  /**
+   * @brief Insert key-value pairs (batched).
+   *
+   * @param policy Execution policy (`ityr::execution`).
+   * @param first  Begin iterator of the key-value pairs.
+   * @param last   End iterator of the key-value pairs.
+   *
+   * @return The number of newly inserted elements.
+   *
+   * Each element in `[first, last)` must have `first` (key) and `second` (value) members.
+   * Existing elements are not overwritten. If the same key appears multiple times in the range,
+   * the first one is inserted.
+   */
+  template <typename ExecutionPolicy, typename ForwardIterator>
+  size_type insert(const ExecutionPolicy& policy,
+                   ForwardIterator        first,
+                   ForwardIterator        last) {
+    return apply_grouped(policy, first, last,
+        [](mapped_type& v, bool found, const auto& req) {
+          if (!found) v = req.second;
+        });
+  }
+
+  /**
+   * @brief Update values for keys (batched).
+   *
+   * @param policy Execution policy (`ityr::execution`).
+   * @param first  Begin iterator of the update requests.
+   * @param last   End iterator of the update requests.
+   * @param op     Update operator called as `op(value, request)`.
+   *
+   * @return The number of newly inserted elements.
+   *
+   * Each element in `[first, last)` must have the `first` member as the key. For each request,
+   * `op` is applied to the value for its key; if the key does not exist, a value-initialized
+   * element is inserted before the update. Requests for the same key are applied in the order
+   * they appear in the range.
+   */
+  template <typename ExecutionPolicy, typename ForwardIterator, typename UpdateOp>
+  size_type update(const ExecutionPolicy& policy,
+                   ForwardIterator        first,
+                   ForwardIterator        last,
+                   UpdateOp               op) {
+    return apply_grouped(policy, first, last,
+        [=](mapped_type& v, bool found, const auto& req) {
+          if (!found) v = mapped_type{};
+          op(v, req);
+        });
+  }
+
+  /**
+   * @brief Look up values for keys (batched).
+   *
+   * @param policy  Execution policy (`ityr::execution`).
+   * @param first   Begin iterator of the keys.
+   * @param last    End iterator of the keys.
+   * @param first_d Output iterator of `std::optional<Value>`.
+   *
+   * For each key in `[first, last)`, the value for the key is written to the corresponding element
+   * in the output range, or `std::nullopt` if the key does not exist.
+   */
+  template <typename ExecutionPolicy, typename ForwardIterator, typename ForwardIteratorD>
+  void find(const ExecutionPolicy& policy,
+            ForwardIterator        first,
+            ForwardIterator        last,
+            ForwardIteratorD       first_d) const {
+    using value_type_d = typename std::iterator_traits<ForwardIteratorD>::value_type;
+
+    root_exec_if_spmd([=, t = table_] {
+      ityr::for_each(
+          policy,
+          internal::convert_to_global_iterator(first  , checkout_mode::read),
+          internal::convert_to_global_iterator(last   , checkout_mode::read),
+          internal::convert_to_global_iterator(first_d, internal::dest_checkout_mode_t<value_type_d>{}),
+          [=](const key_type& key, auto&& d) {
+            d = t.lookup(key);
+          });
+    });
+  }
+
+  /**
+   * @brief Apply an operator to each element in the map.
+   *
+   * @param policy Execution policy (`ityr::execution`).
+   * @param op     Operator called as `op(key, value)` for each element.
+   *
+   * The elements are visited in an unspecified order.
+   */
+  template <typename ExecutionPolicy, typename Op>
+  void for_each(const ExecutionPolicy& policy, Op op) const {
+    root_exec_if_spmd([=, t = table_] {
+      ityr::for_each(
+          policy,
+          make_global_iterator(t.slots                , checkout_mode::read),
+          make_global_iterator(t.slots + t.n_slots(), checkout_mode::read),
+          [=](const slot& s) {
+            if (s.occupied) op(s.key, s.value);
+          });
+    });
+  }
+
+private:
+  constexpr static size_type cutoff_count = 1024;
+
+  // The number of slots checked out at once in probing
+  constexpr static size_type probe_window = 16;
+
+  struct slot {
+    key_type    key;
+    mapped_type value;
+    bool        occupied;
+  };
+
+  // Trivially copyable descriptor of the hash table to be passed to parallel tasks
+  struct table {
+    ori::global_ptr<slot>      slots;
+    ori::global_ptr<size_type> shard_sizes;
+    size_type                  n_shards;
+    size_type                  shard_capacity;
+
+    size_type n_slots() const { return n_shards * shard_capacity; }
+
+    // A shard is grown before its load factor exceeds 3/4, which keeps probe sequences short
+    size_type max_shard_size() const { return shard_capacity / 4 * 3; }
+
+    uint64_t hash(const key_type& key) const {
+      return internal::mix_hash(hasher{}(key));
+    }
+
+    size_type shard_of(uint64_t h) const {
+      return ((h >> 32) * n_shards) >> 32;
+    }
+
+    size_type bucket_of(uint64_t h) const {
+      return h & (shard_capacity - 1);
+    }
+
+    // Calls `fn(slot)` for the slot containing the key or the empty slot where the key should be
+    // inserted, and returns false if no such slot exists. Slots are checked out `probe_window` slots
+    // at a time, so that a probe sequence usually costs a single checkout.
+    template <typename Mode, typename Fn>
+    bool probe(const key_type& key, uint64_t h, Mode mode, Fn&& fn) const {
+      auto shard_begin = slots + shard_of(h) * shard_capacity;
+      size_type b = bucket_of(h);
+      size_type n_probed = 0;
+      while (n_probed < shard_capacity) {
+        size_type w = std::min({probe_window, shard_capacity - b, shard_capacity - n_probed});
+        auto cs = make_checkout(shard_begin + b, w, mode);
+        for (auto& s : cs) {
+          if (!s.occupied || key_equal{}(s.key, key)) {
+            std::forward<Fn>(fn)(s);
+            return true;
+          }
+        }
+        n_probed += w;
+        b = (b + w) & (shard_capacity - 1);
+      }
+      return false;
+    }
+
+    std::optional<mapped_type> lookup(const key_type& key) const {
+      std::optional<mapped_type> ret;
+      probe(key, hash(key), checkout_mode::read, [&](const slot& s) {
+        if (s.occupied) ret = s.value;
+      });
+      return ret;
+    }
+
+    // Calls `fn(s)` for each shard `s` processed by this process. A shard is owned by the node
+    // which is the home of its first slot, and the shards of a node are divided among the
+    // intra-node processes.
+    template <typename Fn>
+    void for_each_owned_shard(Fn&& fn) const {
+      auto intra_rank    = common::topology::intra_my_rank();
+      auto intra_n_ranks = common::topology::intra_n_ranks();
+      std::size_t shard_bytes = shard_capacity * sizeof(slot);
+      ori::for_each_local_home(slots, n_slots(), [&](std::byte*, std::size_t offset, std::size_t size) {
+        size_type s_b = (offset + shard_bytes - 1) / shard_bytes;
+        size_type s_e = std::min(n_shards, (offset + size + shard_bytes - 1) / shard_bytes);
+        for (size_type s = s_b; s < s_e; s++) {
+          if (s % intra_n_ranks == size_type(intra_rank)) {
+            fn(s);
+          }
+        }
+      });
+    }
+  };
+
+  template <typename Request>
+  struct request_entry {
+    uint64_t hash;
+    bool     done;
+    Request  req;
+  };
+
+  struct apply_result {
+    size_type n_inserted;
+    size_type n_failed;
+  };
+
+  struct apply_grouped_result {
+    table     t;
+    size_type n_inserted;
+  };
+
+  static size_type calc_shard_capacity(size_type n_slots, size_type n_shards) {
+    return common::next_pow2(std::max(size_type(1), (n_slots + n_shards - 1) / n_shards));
+  }
+
+  void destroy() {
+    if (table_.slots != nullptr) {
+      coll_exec_if_root([t = table_] {
+        ori::free_coll(t.slots);
+        ori::free_coll(t.shard_sizes);
+      });
+      table_.slots       = nullptr;
+      table_.shard_sizes = nullptr;
+    }
+  }
+
+  table allocate_slots(table t, size_type shard_capacity) const {
+    t.shard_capacity = shard_capacity;
+
+    // With the block distribution, the shards are evenly and contiguously distributed to processes
+    t.slots = coll_exec_if_root([n_slots = t.n_slots()] {
+      return ori::malloc_coll<slot, ori::mem_mapper::block>(n_slots);
+    });
+
+    root_exec_if_spmd([=] {
+      fill(execution::parallel_policy(cutoff_count), t.slots, t.slots + t.n_slots(), slot{});
+    });
+
+    return t;
+  }
+
+  // Collectively rehash all elements into a new table with `shard_capacity` slots per shard.
+  // As the number of shards does not change, each element stays in the same shard; each shard
+  // is moved by the owner of the new shard. Must be called on the root thread.
+  static table grow(const table& t, size_type shard_capacity) {
+    table nt = t;
+    nt.shard_capacity = shard_capacity;
+    nt.slots = ityr::coll_exec([=] {
+      return ori::malloc_coll<slot, ori::mem_mapper::block>(nt.n_slots());
+    });
+
+    fill(execution::parallel_policy(cutoff_count), nt.slots, nt.slots + nt.n_slots(), slot{});
+
+    ityr::coll_exec([=] {
+      nt.for_each_owned_shard([&](size_type s) {
+        auto shard_begin = t.slots + s * t.shard_capacity;
+        ityr::for_each(
+            execution::sequenced_policy(cutoff_count),
+            make_global_iterator(shard_begin                 , checkout_mode::read),
+            make_global_iterator(shard_begin + t.shard_capacity, checkout_mode::read),
+            [&](const slot& old_s) {
+              if (!old_s.occupied) return;
+              [[maybe_unused]] bool ok = nt.probe(old_s.key, nt.hash(old_s.key), checkout_mode::read_write,
+                                                  [&](slot& new_s) { new_s = old_s; });
+              ITYR_CHECK(ok);
+            });
+      });
+    });
+
+    ityr::coll_exec([=] { ori::free_coll(t.slots); });
+
+    return nt;
+  }
+
+  // Applies the requests of the shards owned by each process on that process (collective).
+  // Requests that would exceed the shard size limit are not applied and are counted as failed.
+  template <typename Request, typename Op>
+  static apply_result apply_on_owners(const table&                            t,
+                                      ori::global_ptr<request_entry<Request>> entries,
+                                      ori::global_ptr<size_type>              bounds,
+                                      std::size_t                             checkout_count,
+                                      Op                                      op) {
+    return ityr::coll_exec([=] {
+      apply_result r = {0, 0};
+
+      t.for_each_owned_shard([&](size_type s) {
+        size_type b, e;
+        {
+          auto cs = make_checkout(bounds + s, 2, checkout_mode::read);
+          b = cs[0];
+          e = cs[1];
+        }
+        if (b == e) return;
+
+        auto scs = make_checkout(t.shard_sizes + s, 1, checkout_mode::read_write);
+        size_type& shard_size = scs[0];
+
+        ityr::for_each(
+            execution::sequenced_policy(checkout_count),
+            make_global_iterator(entries + b, checkout_mode::read_write),
+            make_global_iterator(entries + e, checkout_mode::read_write),
+            [&](request_entry<Request>& en) {
+              if (en.done) return;
+
+              t.probe(en.req.first, en.hash, checkout_mode::read_write, [&](slot& sl) {
+                bool found = sl.occupied;
+                if (!found) {
+                  if (shard_size >= t.max_shard_size()) return;
+                  sl.key      = en.req.first;
+                  sl.occupied = true;
+                  shard_size++;
+                  r.n_inserted++;
+                }
+                op(sl.value, found, en.req);
+                en.done = true;
+              });
+
+              if (!en.done) r.n_failed++;
+            });
+      });
+
+      return apply_result{
+        common::mpi_allreduce_value(r.n_inserted, common::topology::mpicomm(), MPI_SUM),
+        common::mpi_allreduce_value(r.n_failed  , common::topology::mpicomm(), MPI_SUM),
+      };
+    });
+  }
+
+  template <typename ExecutionPolicy, typename ForwardIterator, typename Op>
+  size_type apply_grouped(const ExecutionPolicy& policy,
+                          ForwardIterator        first,
+                          ForwardIterator        last,
+                          Op                     op) {
+    size_type n = std::distance(first, last);
+    if (n == 0) return 0;
+
+    using value_type = typename std::iterator_traits<ForwardIterator>::value_type;
+    using entry_t    = request_entry<value_type>;
+
+    auto [t, n_inserted] = root_exec_if_spmd([=, t0 = table_] {
+      table t = t0;
+
+      auto first_ = internal::convert_to_global_iterator(first, internal::src_checkout_mode_t<value_type>{});
+
+      auto entries = ityr::coll_exec([=] { return ori::malloc_coll<entry_t>(n); });
+      auto bounds  = ityr::coll_exec([=] { return ori::malloc_coll<size_type>(t.n_shards + 1); });
+
+      // The requests are copied together with their hashes, so that the owner of each shard
+      // reads the requests for its shards as a contiguous batch
+      transform(
+          policy,
+          first_, std::next(first_, n), entries,
+          [=](const auto& req) { return entry_t{t.hash(req.first), false, req}; });
+
+      // Group the requests by the shard; sorting by the bucket as well improves locality within
+      // a shard, and stability keeps the requests for the same key in their original order
+      stable_sort(
+          policy, entries, entries + n,
+          [=](const entry_t& a, const entry_t& b) {
+            auto sa = t.shard_of(a.hash);
+            auto sb = t.shard_of(b.hash);
+            return sa < sb || (sa == sb && t.bucket_of(a.hash) < t.bucket_of(b.hash));
+          });
+
+      lower_bound_batch(
+          policy, entries, entries + n,
+          count_iterator<size_type>(0), count_iterator<size_type>(t.n_shards + 1), bounds,
+          [=](const entry_t& e, size_type s) { return t.shard_of(e.hash) < s; });
+
+      // The shard of each request does not change by growing, so the grouping is reused.
+      // Requests for the same key fail together (the key is absent and the shard is full),
+      // so their order is preserved across retries.
+      size_type n_inserted = 0;
+      while (true) {
+        auto r = apply_on_owners(t, entries, bounds, policy.checkout_count, op);
+        n_inserted += r.n_inserted;
+        if (r.n_failed == 0) break;
+
+        t = grow(t, t.shard_capacity * 2);
+      }
+
+      ityr::coll_exec([=] {
+        ori::free_coll(entries);
+        ori::free_coll(bounds);
+      });
+
+      return apply_grouped_result{t, n_inserted};
+    });
+
+    table_ = t;
+    size_ += n_inserted;
+    return n_inserted;
+  }
+
+  template <typename Fn>
+  auto root_exec_if_spmd(Fn&& fn) const {
+    if (ito::is_spmd()) {
+      return root_exec(std::forward<Fn>(fn));
+    } else if (!ito::is_root()) {
+      common::die("Batch operations for ityr::global_unordered_map must be executed on the root thread or SPMD region.");
+    }
+    return std::forward<Fn>(fn)();
+  }
+
+  template <typename Fn>
+  auto coll_exec_if_root(Fn&& fn) const {
+    if (ito::is_spmd()) {
+      return std::forward<Fn>(fn)();
+    } else if (!ito::is_root()) {
+      common::die("Collective operations for ityr::global_unordered_map must be executed on the root thread or SPMD region.");
+    }
+    return ityr::coll_exec(std::forward<Fn>(fn));
+  }
+
+  table     table_ = {nullptr, nullptr, 0, 0};
+  size_type size_  = 0;
+};
+
+ITYR_TEST_CASE("[ityr::container::global_unordered_map] insert, update, find") {
+  ito::init();
+  ori::init();
+
+  struct kv {
+    long first;
+    long second;
+  };
+
+  long n = 100000;
+  long n_keys = n / 2;
+
+  ori::global_ptr<kv>                  reqs   = ori::malloc_coll<kv>(n);
+  ori::global_ptr<long>                keys   = ori::malloc_coll<long>(n);
+  ori::global_ptr<std::optional<long>> values = ori::malloc_coll<std::optional<long>>(n);
+
+  ito::root_exec([=] {
+    // each key (a multiple of 3) appears twice
+    transform(
+        execution::parallel_policy(100),
+        count_iterator<long>(0), count_iterator<long>(n), reqs,
+        [=](long i) { return kv{i % n_keys * 3, i}; });
+
+    transform(
+        execution::parallel_policy(100),
+        count_iterator<long>(0), count_iterator<long>(n), keys,
+        [=](long i) { return i; });
+  });
+
+  ITYR_SUBCASE("SPMD") {
+    global_unordered_map<long, long> m(n_keys);
+    ITYR_CHECK(m.empty());
+
+    ITYR_CHECK(m.insert(execution::parallel_policy(100), reqs, reqs + n) == std::size_t(n_keys));
+    ITYR_CHECK(m.size() == std::size_t(n_keys));
+
+    m.find(execution::parallel_policy(100), keys, keys + n, values);
+
+    ito::root_exec([=] {
+      for_each(
+          execution::parallel_policy(100),
+          count_iterator<long>(0), count_iterator<long>(n),
+          make_global_iterator(values, checkout_mode::read),
+          [=](long k, const std::optional<long>& v) {
+            if (k % 3 == 0 && k / 3 < n_keys) {
+              ITYR_CHECK(v.has_value());
+              // the first occurrence is inserted
+              ITYR_CHECK(*v == k / 3);
+            } else {
+              ITYR_CHECK(!v.has_value());
+            }
+          });
+    });
+
+    std::size_t n_inserted = m.update(execution::parallel_policy(100), reqs, reqs + n,
+                                      [](long& v, const kv& r) { v += r.second; });
+    ITYR_CHECK(n_inserted == 0);
+
+    m.for_each(execution::parallel_policy(100), [=](long k, long v) {
+      ITYR_CHECK(v == k / 3 * 3 + n_keys);
+    });
+  }
+
+  ITYR_SUBCASE("growth") {
+    // much smaller than the number of keys
+    global_unordered_map<long, long> m(16, 1);
+    std::size_t bucket_count = m.bucket_count();
+
+    ITYR_CHECK(m.insert(execution::parallel_policy(100), reqs, reqs + n) == std::size_t(n_keys));
+    ITYR_CHECK(m.size() == std::size_t(n_keys));
+    ITYR_CHECK(m.bucket_count() > bucket_count);
+
+    m.reserve(n_keys * 4);
+    ITYR_CHECK(m.bucket_count() >= std::size_t(n_keys * 8));
+
+    m.find(execution::parallel_policy(100), keys, keys + n, values);
+
+    ito::root_exec([=] {
+      for_each(
+          execution::parallel_policy(100),
+          count_iterator<long>(0), count_iterator<long>(n),
+          make_global_iterator(values, checkout_mode::read),
+          [=](long k, const std::optional<long>& v) {
+            if (k % 3 == 0 && k / 3 < n_keys) {
+              ITYR_CHECK(v == k / 3);
+            } else {
+              ITYR_CHECK(!v.has_value());
+            }
+          });
+    });
+  }
+
+  ITYR_SUBCASE("root thread") {
+    ito::root_exec([=] {
+      global_unordered_map<long, long> m(n_keys, 1);
+
+      std::size_t n_inserted = m.update(execution::parallel_policy(100), reqs, reqs + n,
+                                        [](long& v, const kv&) { v++; });
+      ITYR_CHECK(n_inserted == std::size_t(n_keys));
+
+      m.find(execution::parallel_policy(100), keys, keys + n, values);
+
+      for_each(
+          execution::parallel_policy(100),
+          count_iterator<long>(0), count_iterator<long>(n),
+          make_global_iterator(values, checkout_mode::read),
+          [=](long k, const std::optional<long>& v) {
+            if (k % 3 == 0 && k / 3 < n_keys) {
+              ITYR_CHECK(v == 2);
+            } else {
+              ITYR_CHECK(!v.has_value());
+            }
+          });
+    });
+  }
+
+  ori::free_coll(reqs);
+  ori::free_coll(keys);
+  ori::free_coll(values);
+
+  ori::fini();
+  ito::fini();
+}
+
+}
@@ -0,0 +1,321 @@
+#pragma once
+
+#include <numeric>
+
+#include "ityr/common/util.hpp"
+#include "ityr/common/topology.hpp"
+#include "ityr/ito/ito.hpp"
+#include "ityr/ori/ori.hpp"
+#include "ityr/pattern/count_iterator.hpp"
+#include "ityr/pattern/root_exec.hpp"
+#include "ityr/pattern/parallel_loop.hpp"
+#include "ityr/container/checkout_span.hpp"
+
+namespace ityr {
+
+/**
+ * @brief Trivially copyable handle of `ityr::search_index` to be passed to parallel tasks.
+ *
+ * @see `ityr::search_index`
+ */
+template <typename T>
+class search_index_view {
+  using elem_t = std::remove_const_t<T>;
+
+public:
+  using value_type = T;
+  using size_type  = std::size_t;
+
+  search_index_view() {}
+  search_index_view(ori::global_ptr<T>      first,
+                    size_type               n,
+                    size_type               stride,
+                    ori::global_ptr<elem_t> replicas,
+                    size_type               n_samples,
+                    size_type               replica_stride)
+    : first_(first), n_(n), stride_(stride),
+      replicas_(replicas), n_samples_(n_samples), replica_stride_(replica_stride) {}
+
+  /**
+   * @brief Search for the first element that is not less than the given value.
+   *
+   * @return Global pointer to the first element `x` such that `comp(x, value)` is false, or the end
+   *         of the range if no such element exists.
+   */
+  template <typename U, typename Compare>
+  ori::global_ptr<T> lower_bound(const U& value, Compare comp) const {
+    return partition_point([&](const auto& x) { return comp(x, value); });
+  }
+
+  template <typename U>
+  ori::global_ptr<T> lower_bound(const U& value) const {
+    return lower_bound(value, std::less<>{});
+  }
+
+  /**
+   * @brief Search for the first element that is greater than the given value.
+   *
+   * @return Global pointer to the first element `x` such that `comp(value, x)` is true, or the end
+   *         of the range if no such element exists.
+   */
+  template <typename U, typename Compare>
+  ori::global_ptr<T> upper_bound(const U& value, Compare comp) const {
+    return partition_point([&](const auto& x) { return !comp(value, x); });
+  }
+
+  template <typename U>
+  ori::global_ptr<T> upper_bound(const U& value) const {
+    return upper_bound(value, std::less<>{});
+  }
+
+  /**
+   * @brief Search for the partition point of the range with respect to `pred`.
+   *
+   * @return Global pointer to the first element `x` such that `pred(x)` is false, or the end of
+   *         the range if no such element exists.
+   */
+  template <typename Predicate>
+  ori::global_ptr<T> partition_point(Predicate pred) const {
+    if (n_ == 0) return first_;
+
+    // The local replica of the samples tells which interval between two samples contains the
+    // partition point, without any communication
+    size_type i = [&] {
+      auto cs = make_checkout(replicas_ + replica_stride_ * common::topology::inter_my_rank(),
+                              n_samples_, checkout_mode::read);
+      return std::distance(cs.begin(), std::partition_point(cs.begin(), cs.end(), pred));
+    }();
+
+    if (i == 0) return first_;
+
+    // The partition point is within ((i - 1) * stride, i * stride], which is fetched at once
+    size_type b = (i - 1) * stride_ + 1;
+    size_type e = std::min(i * stride_, n_);
+    if (b >= e) return first_ + b;
+
+    auto cs = make_checkout(first_ + b, e - b, checkout_mode::read);
+    return first_ + b + std::distance(cs.begin(), std::partition_point(cs.begin(), cs.end(), pred));
+  }
+
+private:
+  ori::global_ptr<T>      first_;
+  size_type               n_              = 0;
+  size_type               stride_         = 1;
+  ori::global_ptr<elem_t> replicas_;
+  size_type               n_samples_      = 0;
+  size_type               replica_stride_ = 0;
+};
+
+/**
+ * @brief Sampled index of a sorted range in global memory.
+ *
+ * A single lookup by `ityr::lower_bound()` is a sequence of dependent one-element remote accesses,
+ * and the upper levels of its implicit search tree cannot be kept in the cache across fork/join
+ * boundaries, where the cache is invalidated. A search index instead samples every `stride`-th
+ * element of the range and keeps a replica of the samples in the home memory of each node.
+ * A lookup first searches the local replica without communication, and then checks out only the
+ * `stride` elements between two adjacent samples. As a result, a lookup costs one remote fetch.
+ *
+ * The stride is the checkout granularity of the execution policy passed at construction
+ * (`ityr::execution::sequenced_policy::checkout_count` or `ityr::execution::parallel_policy::checkout_count`).
+ * Each node holds `(number of elements) / stride` samples, which should be small enough to be
+ * replicated. The index is not updated when the range is modified.
+ *
+ * A search index is a collective object; it must be created and destroyed by all processes
+ * collectively, either in the SPMD region or in the root thread. To look up in parallel tasks,
+ * pass the trivially copyable `ityr::search_index_view` obtained by `view()`.
+ *
+ * Example:
+ * ```
+ * ityr::global_vector<int> v({.collective = true}, {1, 2, 2, 4, 5});
+ * ityr::search_index<int> idx(ityr::execution::par, v.data(), v.data() + v.size());
+ * auto it = idx.lower_bound(2);
+ * // it = v.data() + 1
+ * ```
+ *
+ * @see `ityr::lower_bound()`
+ * @see `ityr::lower_bound_batch()`
+ */
+template <typename T>
+class search_index {
+  using this_t = search_index;
+  using elem_t = std::remove_const_t<T>;
+
+  static_assert(std::is_trivially_copyable_v<elem_t>);
+
+public:
+  using value_type = T;
+  using size_type  = std::size_t;
+
+  /**
+   * @brief Create a search index of the sorted range `[first, last)` (collective).
+   */
+  template <typename ExecutionPolicy>
+  search_index(const ExecutionPolicy& policy,
+               ori::global_ptr<T>     first,
+               ori::global_ptr<T>     last) {
+    size_type n         = std::distance(first, last);
+    size_type stride    = std::max(std::size_t(1), policy.checkout_count);
+    size_type n_samples = (n + stride - 1) / stride;
+
+    if (n_samples > 0) {
+      // Each replica is aligned to the block size, so that it resides in the home of one node
+      // with the block distribution
+      size_type unit = std::lcm(sizeof(elem_t), std::size_t(ori::get_block_size())) / sizeof(elem_t);
+      size_type replica_stride = (n_samples + unit - 1) / unit * unit;
+
+      replicas_ = coll_exec_if_root([=] {
+        return ori::malloc_coll<elem_t, ori::mem_mapper::block>(
+            replica_stride * common::topology::inter_n_ranks());
+      });
+
+      root_exec_if_spmd([=, replicas = replicas_] {
+        transform(
+            policy,
+            count_iterator<size_type>(0), count_iterator<size_type>(n_samples), replicas,
+            [=](size_type i) {
+              auto cs = make_checkout(first + i * stride, 1, checkout_mode::read);
+              return cs[0];
+            });
+
+        // The first replica is copied to the home of the other nodes
+        ityr::coll_exec([=] {
+          auto inter_rank = common::topology::inter_my_rank();
+          if (inter_rank != 0 && common::topology::intra_my_rank() == 0) {
+            ityr::copy(
+                execution::sequenced_policy(policy.checkout_count),
+                replicas, replicas + n_samples,
+                replicas + replica_stride * inter_rank);
+          }
+        });
+      });
+
+      view_ = search_index_view<T>(first, n, stride, replicas_, n_samples, replica_stride);
+
+    } else {
+      view_ = search_index_view<T>(first, 0, stride, nullptr, 0, 0);
+    }
+  }
+
+  ~search_index() { destroy(); }
+
+  search_index(const this_t&) = delete;
+  this_t& operator=(const this_t&) = delete;
+
+  search_index(this_t&& other) noexcept
+    : view_(other.view_), replicas_(other.replicas_) {
+    other.replicas_ = nullptr;
+  }
+  this_t& operator=(this_t&& other) noexcept {
+    destroy();
+    view_     = other.view_;
+    replicas_ = other.replicas_;
+    other.replicas_ = nullptr;
+    return *this;
+  }
+
+  search_index_view<T> view() const noexcept { return view_; }
+
+  template <typename U, typename Compare>
+  ori::global_ptr<T> lower_bound(const U& value, Compare comp) const {
+    return view_.lower_bound(value, comp);
+  }
+
+  template <typename U>
+  ori::global_ptr<T> lower_bound(const U& value) const {
+    return view_.lower_bound(value);
+  }
+
+  template <typename U, typename Compare>
+  ori::global_ptr<T> upper_bound(const U& value, Compare comp) const {
+    return view_.upper_bound(value, comp);
+  }
+
+  template <typename U>
+  ori::global_ptr<T> upper_bound(const U& value) const {
+    return view_.upper_bound(value);
+  }
+
+private:
+  void destroy() {
+    if (replicas_ != nullptr) {
+      coll_exec_if_root([replicas = replicas_] {
+        ori::free_coll(replicas);
+      });
+      replicas_ = nullptr;
+    }
+  }
+
+  template <typename Fn>
+  auto root_exec_if_spmd(Fn&& fn) const {
+    if (ito::is_spmd()) {
+      return root_exec(std::forward<Fn>(fn));
+    } else if (!ito::is_root()) {
+      common::die("ityr::search_index must be created on the root thread or SPMD region.");
+    }
+    return std::forward<Fn>(fn)();
+  }
+
+  template <typename Fn>
+  auto coll_exec_if_root(Fn&& fn) const {
+    if (ito::is_spmd()) {
+      return std::forward<Fn>(fn)();
+    } else if (!ito::is_root()) {
+      common::die("Collective operations for ityr::search_index must be executed on the root thread or SPMD region.");
+    }
+    return ityr::coll_exec(std::forward<Fn>(fn));
+  }
+
+  search_index_view<T>    view_;
+  ori::global_ptr<elem_t> replicas_;
+};
+
+ITYR_TEST_CASE("[ityr::container::search_index] lower_bound, upper_bound") {
+  ito::init();
+  ori::init();
+
+  long n = 100000;
+  ori::global_ptr<long> p = ori::malloc_coll<long>(n);
+
+  ito::root_exec([=] {
+    // each multiple of 3 appears three times: {0, 0, 0, 3, 3, 3, 6, ...}
+    transform(
+        execution::parallel_policy(100),
+        count_iterator<long>(0), count_iterator<long>(n), p,
+        [=](long i) { return i / 3 * 3; });
+  });
+
+  auto check = [=](search_index_view<long> idx) {
+    for_each(
+        execution::parallel_policy(100),
+        count_iterator<long>(-5), count_iterator<long>(n + 5),
+        [=](long v) {
+          ITYR_CHECK(idx.lower_bound(v) - p == std::clamp((v + 2) / 3 * 3, 0L, n));
+          ITYR_CHECK(idx.upper_bound(v) - p == (v < 0 ? 0 : std::clamp(v / 3 * 3 + 3, 0L, n)));
+        });
+  };
+
+  ITYR_SUBCASE("SPMD") {
+    for (std::size_t checkout_count : {1, 7, 128}) {
+      search_index<long> idx(execution::parallel_policy(128, checkout_count), p, p + n);
+      ito::root_exec([=, v = idx.view()] { check(v); });
+    }
+  }
+
+  ITYR_SUBCASE("root thread") {
+    ito::root_exec([=] {
+      search_index<long> idx(execution::sequenced_policy(64), p, p + n);
+      check(idx.view());
+
+      search_index<long> idx_empty(execution::sequenced_policy(64), p, p);
+      ITYR_CHECK(idx_empty.lower_bound(0) == p);
+    });
+  }
+
+  ori::free_coll(p);
+
+  ori::fini();
+  ito::fini();
+}
+
+}
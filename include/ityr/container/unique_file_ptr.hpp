@@ -21,7 +21,8 @@ namespace ityr {
  * At construction, the same virtual address space is allocated among all processes and
  * the file content is directly mapped to the virtual address (via `mmap()`).
  *
- * Currently, only the read-only mode is supported.
+ * Currently, only the read-only mode is supported. For writable file-backed memory distributed
+ * to processes, use `ityr::global_file`.
  *
  * @see `ityr::make_unique_ptr()`
  */
@@ -120,16 +121,8 @@ private:
     if (ito::is_spmd()) {
       return ori::file_mem_alloc_coll(fpath, mlock);
     } else if (ito::is_root()) {
-      // FIXME: ugly hack to pass heap-allocated string to other processes
-      constexpr std::size_t max_chars = 256;
-      if (fpath.size() >= max_chars) {
-        common::die("File path length for unique_file_ptr must be less than %ld.", max_chars);
-      }
-      std::array<char, max_chars> buf;
-      std::strncpy(buf.data(), fpath.c_str(), max_chars - 1);
-      buf.back() = '\0';
-      return ito::coll_exec([=] {
-        return ori::file_mem_alloc_coll(buf.data(), mlock);
+      return ito::coll_exec([=, path = ito::coll_string(fpath)] {
+        return ori::file_mem_alloc_coll(path.get(), mlock);
       });
     } else {
       common::die("Collective operations for ityr::global_vector must be executed on the root thread or SPMD region.");
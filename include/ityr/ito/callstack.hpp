@@ -8,20 +8,41 @@
 #include "ityr/common/topology.hpp"
 #include "ityr/common/virtual_mem.hpp"
 #include "ityr/common/physical_mem.hpp"
+#include "ityr/common/mem_usage.hpp"
 
 namespace ityr::ito {
 
 class callstack {
 public:
   callstack(std::size_t size)
-    : vm_(common::reserve_same_vm_coll(size, common::get_page_size())),
+    : vm_(common::reserve_same_vm_coll(size, common::hugepage_alignment())),
       pm_(init_stack_pm()),
-      win_(common::topology::mpicomm(), reinterpret_cast<std::byte*>(vm_.addr()), vm_.size()) {}
+      win_(common::topology::mpicomm(), reinterpret_cast<std::byte*>(vm_.addr()), vm_.size()) {
+    common::topology::check_numa_placement("the call stack", vm_.addr(), vm_.size());
+  }
 
   void* top() const { return vm_.addr(); }
   void* bottom() const { return reinterpret_cast<std::byte*>(vm_.addr()) + vm_.size(); }
   std::size_t size() const { return vm_.size(); }
 
+  // Called with the stack pointer at thread creation to record the peak stack depth
+  void record_depth(const void* sp) {
+    std::size_t depth = reinterpret_cast<const std::byte*>(bottom()) - reinterpret_cast<const std::byte*>(sp);
+    if (depth > peak_depth_) peak_depth_ = depth;
+  }
+
+  // The current depth is nonzero only when called from a thread running on this call stack
+  common::mem_usage usage() const {
+    const std::byte* sp = reinterpret_cast<const std::byte*>(__builtin_frame_address(0));
+    common::mem_usage mu;
+    if (top() <= sp && sp < bottom()) {
+      mu.current = reinterpret_cast<const std::byte*>(bottom()) - sp;
+    }
+    mu.peak     = std::max(peak_depth_, mu.current);
+    mu.capacity = size();
+    return mu;
+  }
+
   void direct_copy_from(void*                    addr,
                         std::size_t              size,
                         common::topology::rank_t target_rank) const {
@@ -42,14 +63,17 @@ private:
   }
 
   common::physical_mem init_stack_pm() {
-    common::physical_mem pm(stack_shmem_name(common::topology::my_rank()), vm_.size(), true);
+    common::validate_hugepage_granularity(vm_.size(), "the stack size (ITYR_ITO_STACK_SIZE)");
+    common::physical_mem pm(stack_shmem_name(common::topology::my_rank()), vm_.size(), true, true);
     pm.map_to_vm(vm_.addr(), vm_.size(), 0);
+    common::topology::numa_bind_local(vm_.addr(), vm_.size());
     return pm;
   }
 
   common::virtual_mem                vm_;
   common::physical_mem               pm_;
   common::mpi_win_manager<std::byte> win_;
+  std::size_t                        peak_depth_ = 0;
 };
 
 }
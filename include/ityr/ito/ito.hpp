@@ -76,6 +76,34 @@ inline auto coll_exec(const Fn& fn, const Args&... args) {
   return w.coll_exec(fn, args...);
 }
 
+/*
+ * A string to be passed to all processes in `coll_exec()`. Function objects passed to `coll_exec()`
+ * are copied bitwise to other processes, so they cannot carry heap-allocated strings. Instead, this
+ * holds a pointer to the string, which is valid only on the calling process, and `get()` broadcasts
+ * the string from it. `get()` must be called collectively within `coll_exec()` (or in the SPMD region).
+ */
+class coll_string {
+public:
+  coll_string(const std::string& str)
+    : str_(&str),
+      origin_(common::topology::my_rank()),
+      spmd_(is_spmd()) {}
+
+  std::string get() const {
+    if (spmd_) {
+      // Each process has its own string
+      return *str_;
+    }
+    bool is_origin = common::topology::my_rank() == origin_;
+    return common::mpi_bcast_string(is_origin ? *str_ : std::string(), origin_, common::topology::mpicomm());
+  }
+
+private:
+  const std::string*       str_;
+  common::topology::rank_t origin_;
+  bool                     spmd_;
+};
+
 template <typename PreSuspendCallback, typename PostSuspendCallback>
 inline void migrate_to(common::topology::rank_t target_rank,
                        PreSuspendCallback&&     pre_suspend_cb,
@@ -135,6 +163,76 @@ inline void dag_prof_print() {
   w.sched().dag_prof_print();
 }
 
+inline dag_prof_result dag_prof_get_result() {
+  auto& w = worker::instance::get();
+  ITYR_CHECK(w.is_spmd());
+  return w.sched().dag_prof_get_result();
+}
+
+inline void dag_prof_set_label(const char* label) {
+  auto& w = worker::instance::get();
+  ITYR_CHECK(!w.is_spmd());
+  w.sched().dag_prof_set_label(label);
+}
+
+inline const char* dag_prof_get_label() {
+  auto& w = worker::instance::get();
+  ITYR_CHECK(!w.is_spmd());
+  return w.sched().dag_prof_get_label();
+}
+
+// Attribute the strands executed in this scope to the given task label (nullptr keeps the current label)
+class dag_prof_label_scope {
+public:
+  explicit dag_prof_label_scope(const char* label) {
+    if constexpr (dag_profiler::enabled) {
+      if (label) {
+        prev_label_ = dag_prof_get_label();
+        changed_    = true;
+        dag_prof_set_label(label);
+      }
+    }
+  }
+
+  ~dag_prof_label_scope() {
+    if constexpr (dag_profiler::enabled) {
+      if (changed_) {
+        dag_prof_set_label(prev_label_);
+      }
+    }
+  }
+
+  dag_prof_label_scope(const dag_prof_label_scope&) = delete;
+  dag_prof_label_scope& operator=(const dag_prof_label_scope&) = delete;
+
+  dag_prof_label_scope(dag_prof_label_scope&&) = delete;
+  dag_prof_label_scope& operator=(dag_prof_label_scope&&) = delete;
+
+private:
+  const char* prev_label_ = nullptr;
+  bool        changed_    = false;
+};
+
+inline mem_stats get_mem_stats() {
+  auto& w = worker::instance::get();
+  return w.sched().get_mem_stats();
+}
+
+inline void mem_stats_print() {
+  mem_stats ms = get_mem_stats();
+  if (common::topology::my_rank() == 0) {
+    printf("[Threads]\n");
+  }
+  common::print_mem_usage("Call stack:"            , ms.stack                , "bytes");
+  common::print_mem_usage("Work-stealing queue:"   , ms.wsqueue              , "entries");
+  common::print_mem_usage("Thread states:"         , ms.thread_state_heap    , "bytes");
+  common::print_mem_usage("Suspended threads:"     , ms.suspended_thread_heap, "bytes");
+  if (common::topology::my_rank() == 0) {
+    printf("\n");
+    fflush(stdout);
+  }
+}
+
 ITYR_TEST_CASE("[ityr::ito] fib") {
   init();
 
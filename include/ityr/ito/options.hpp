@@ -15,6 +15,11 @@ inline void print_compile_options() {
 #define ITYR_ITO_DAG_PROF disabled
 #endif
   ITYR_PRINT_MACRO(ITYR_ITO_DAG_PROF);
+
+#ifndef ITYR_ITO_DAG_PROF_MAX_LABELS
+#define ITYR_ITO_DAG_PROF_MAX_LABELS 16
+#endif
+  ITYR_PRINT_MACRO(ITYR_ITO_DAG_PROF_MAX_LABELS);
 }
 
 struct stack_size_option : public common::option<stack_size_option, std::size_t> {
@@ -77,6 +82,12 @@ struct adws_min_drange_size_option : public common::option<adws_min_drange_size_
   static double default_value() { return 0.01; }
 };
 
+struct dag_prof_top_n_option : public common::option<dag_prof_top_n_option, std::size_t> {
+  using option::option;
+  static std::string name() { return "ITYR_ITO_DAG_PROF_TOP_N"; }
+  static std::size_t default_value() { return 10; }
+};
+
 struct runtime_options {
   common::option_initializer<stack_size_option>                      ITYR_ANON_VAR;
   common::option_initializer<wsqueue_capacity_option>                ITYR_ANON_VAR;
@@ -88,6 +99,7 @@ struct runtime_options {
   common::option_initializer<adws_max_depth_option>                  ITYR_ANON_VAR;
   common::option_initializer<adws_max_dtree_reuse_option>            ITYR_ANON_VAR;
   common::option_initializer<adws_min_drange_size_option>            ITYR_ANON_VAR;
+  common::option_initializer<dag_prof_top_n_option>                  ITYR_ANON_VAR;
 };
 
 }
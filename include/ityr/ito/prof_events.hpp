@@ -5,24 +5,36 @@
 #include "ityr/common/wallclock.hpp"
 #include "ityr/common/profiler.hpp"
 #include "ityr/common/prof_events.hpp"
+#include "ityr/ito/steal_analytics.hpp"
 
 namespace ityr::ito {
 
 struct prof_event_sched_steal : public common::prof_event_target_base {
   using prof_event_target_base::prof_event_target_base;
+  using prof_event_target_base::interval_begin;
+
+  auto interval_begin(common::profiler::mode_stats,
+                      common::wallclock::wallclock_t t,
+                      common::topology::rank_t       target_rank) {
+    target_rank_ = target_rank;
+    return t;
+  }
 
   void interval_end(common::profiler::mode_stats,
                     common::wallclock::wallclock_t                    t,
                     common::profiler::mode_stats::interval_begin_data ibd,
-                    bool                                              success) {
+                    bool                                              success,
+                    std::size_t                                       bytes = 0) {
     do_acc(t - ibd, success);
+    analytics_.record(ibd, t, target_rank_, success, bytes);
   }
 
   void interval_end(common::profiler::mode_trace,
                     common::wallclock::wallclock_t                    t,
                     common::profiler::mode_trace::interval_begin_data ibd,
-                    bool                                              success) {
-    MLOG_END(&state_.trace_md, 0, ibd, trace_decoder_base, this, t, success);
+                    bool                                              success,
+                    std::size_t                                       bytes [[maybe_unused]] = 0) {
+    MLOG_END(&state_.trace_md, 0, ibd, trace_decoder_base, this, t, success, bytes);
   }
 
   void* trace_decoder(FILE* stream, void* buf0, void* buf1) override {
@@ -30,12 +42,13 @@ struct prof_event_sched_steal : public common::prof_event_target_base {
     auto target_rank = MLOG_READ_ARG(&buf0, common::topology::rank_t);
     auto t1          = MLOG_READ_ARG(&buf1, common::wallclock::wallclock_t);
     auto success     = MLOG_READ_ARG(&buf1, bool);
+    auto bytes       = MLOG_READ_ARG(&buf1, std::size_t);
 
     do_acc(t1 - t0, success);
+    analytics_.record(t0, t1, target_rank, success, bytes);
 
     success_mode_ = success;
-    auto rank = common::topology::my_rank();
-    fprintf(stream, "%d,%lu,%d,%lu,%s,target=%d\n", rank, t0, rank, t1, str().c_str(), target_rank);
+    write_trace(stream, t0, t1, target_rank, success);
     return buf1;
   }
 
@@ -43,6 +56,12 @@ struct prof_event_sched_steal : public common::prof_event_target_base {
     return success_mode_ ? "sched_steal (success)" : "sched_steal (fail)";
   }
 
+  void get_stats(std::vector<common::profiler::event_stats>& stats) const override {
+    auto t_total = state_.t_end - state_.t_begin;
+    stats.push_back({"sched_steal (success)", sum_time_success_, max_time_success_, t_total, count_success_});
+    stats.push_back({"sched_steal (fail)"   , sum_time_fail_   , max_time_fail_   , t_total, count_fail_   });
+  }
+
   void print_stats() override {
     success_mode_ = true;
     sum_time_ = sum_time_success_;
@@ -56,7 +75,12 @@ struct prof_event_sched_steal : public common::prof_event_target_base {
     common::profiler::event::print_stats();
   }
 
+  void print_report() override {
+    analytics_.print();
+  }
+
   void clear() override {
+    analytics_.clear();
     sum_time_success_ = 0;
     sum_time_fail_    = 0;
     max_time_success_ = 0;
@@ -85,6 +109,8 @@ private:
   counter_t                      count_success_    = 0;
   counter_t                      count_fail_       = 0;
   bool                           success_mode_;
+  common::topology::rank_t       target_rank_;
+  steal_analytics                analytics_;
 };
 
 struct prof_event_sched_mailbox_put : public common::prof_event_target_base {
@@ -134,7 +160,39 @@ struct prof_event_wsqueue_empty_batch : public common::prof_event_target_base {
 
 struct prof_phase_sched_loop : public common::profiler::event {
   using event::event;
+  using event::interval_end;
+
+  void interval_end(common::profiler::mode_stats,
+                    common::wallclock::wallclock_t                    t,
+                    common::profiler::mode_stats::interval_begin_data ibd) {
+    do_acc(t - ibd);
+    timeline_.add(state_.t_begin, ibd, t);
+  }
+
+  void* trace_decoder(FILE* stream, void* buf0 [[maybe_unused]], void* buf1) override {
+    auto t0 = MLOG_READ_ARG(&buf0, common::wallclock::wallclock_t);
+    auto t1 = MLOG_READ_ARG(&buf1, common::wallclock::wallclock_t);
+
+    do_acc(t1 - t0);
+    timeline_.add(state_.t_begin, t0, t1);
+
+    write_trace(stream, t0, t1);
+    return buf1;
+  }
+
   std::string str() const override { return "P_sched_loop"; }
+
+  void print_report() override {
+    timeline_.print(state_.t_begin, state_.t_end);
+  }
+
+  void clear() override {
+    event::clear();
+    timeline_.clear();
+  }
+
+private:
+  idle_timeline timeline_;
 };
 
 struct prof_phase_sched_fork : public common::profiler::event {
@@ -7,6 +7,7 @@
 #include "ityr/common/logger.hpp"
 #include "ityr/common/allocator.hpp"
 #include "ityr/common/profiler.hpp"
+#include "ityr/common/sampling.hpp"
 #include "ityr/ito/util.hpp"
 #include "ityr/ito/options.hpp"
 #include "ityr/ito/context.hpp"
@@ -308,8 +309,8 @@ public:
       stack_base_(reinterpret_cast<context_frame*>(stack_.bottom()) - 1),
       primary_wsq_(adws_wsqueue_capacity_option::value(), max_depth_),
       migration_wsq_(adws_wsqueue_capacity_option::value(), max_depth_),
-      thread_state_allocator_(thread_state_allocator_size_option::value()),
-      suspended_thread_allocator_(suspended_thread_allocator_size_option::value()),
+      thread_state_allocator_(thread_state_allocator_size_option::value(), "the thread state allocator"),
+      suspended_thread_allocator_(suspended_thread_allocator_size_option::value(), "the suspended thread allocator"),
       dtree_(max_depth_) {}
 
   template <typename T, typename SchedLoopCallback, typename Fn, typename... Args>
@@ -460,6 +461,9 @@ public:
     th.state = ts;
     th.serialized = false;
 
+    // the new thread inherits the task label of the parent
+    const char* dag_label = tls_->dag_prof.label();
+
     dist_range new_drange;
     common::topology::rank_t target_rank;
     if (tls_->drange.is_cross_worker()) {
@@ -489,13 +493,14 @@ public:
     if (target_rank == my_rank) {
       /* Put the continuation into the local queue and execute the new task (work-first) */
 
-      suspend([&, ts, fn = std::forward<Fn>(fn),
+      suspend([&, ts, dag_label, fn = std::forward<Fn>(fn),
                args_tuple = std::make_tuple(std::forward<Args>(args)...)](context_frame* cf) mutable {
         common::verbose<3>("push context frame [%p, %p) into task queue", cf, cf->parent_frame);
 
         tls_ = new (alloca(sizeof(thread_local_storage)))
                thread_local_storage{nullptr, new_drange, tls_->dtree_node_ref,
                                     tls_->tg_version, true, {}};
+        tls_->dag_prof.set_label(dag_label);
 
         std::size_t cf_size = reinterpret_cast<uintptr_t>(cf->parent_frame) - reinterpret_cast<uintptr_t>(cf);
 
@@ -507,6 +512,8 @@ public:
                               tls_->dtree_node_ref.depth);
         }
 
+        stack_.record_depth(cf);
+
         tls_->dag_prof.start();
         tls_->dag_prof.increment_thread_count();
         tls_->dag_prof.increment_strand_count();
@@ -548,7 +555,7 @@ public:
     } else {
       /* Pass the new task to another worker and execute the continuation */
 
-      auto new_task_fn = [&, my_rank, ts, new_drange,
+      auto new_task_fn = [&, my_rank, ts, new_drange, dag_label,
                           dtree_node_ref = tls_->dtree_node_ref,
                           tg_version = tls_->tg_version,
                           on_drift_fork_cb, on_drift_die_cb, fn = std::forward<Fn>(fn),
@@ -559,6 +566,7 @@ public:
         tls_ = new (alloca(sizeof(thread_local_storage)))
                thread_local_storage{nullptr, new_drange, dtree_node_ref,
                                     tg_version, true, {}};
+        tls_->dag_prof.set_label(dag_label);
 
         if (new_drange.is_cross_worker()) {
           dtree_.copy_parents(dtree_node_ref);
@@ -836,6 +844,33 @@ public:
     }
   }
 
+  dag_prof_result dag_prof_get_result() const {
+    return dag_prof_result_.get_result();
+  }
+
+  void dag_prof_set_label(const char* label) {
+    tls_->dag_prof.set_label(label);
+  }
+
+  const char* dag_prof_get_label() const {
+    return tls_->dag_prof.label();
+  }
+
+  // The depths of the primary and migration queues are merged, as only one of them is used for forks
+  mem_stats get_mem_stats() const {
+    common::mem_usage pwsq = primary_wsq_.usage();
+    common::mem_usage mwsq = migration_wsq_.usage();
+
+    mem_stats ms;
+    ms.stack                 = stack_.usage();
+    ms.wsqueue               = {std::max(pwsq.current, mwsq.current),
+                                std::max(pwsq.peak, mwsq.peak),
+                                std::min(pwsq.capacity, mwsq.capacity)};
+    ms.thread_state_heap     = thread_state_allocator_.usage();
+    ms.suspended_thread_heap = suspended_thread_allocator_.usage();
+    return ms;
+  }
+
 private:
   struct coll_task {
     void*                    task_ptr;
@@ -1072,6 +1107,7 @@ private:
 
     primary_wsq_.for_each_nonempty_queue(target_rank, min_depth, max_depth, false, [&](int d) {
       auto ibd = common::profiler::interval_begin<prof_event_sched_steal>(target_rank);
+      common::sampling::count(common::sampling::counter::steal_attempt);
 
       if (!primary_wsq_.lock().trylock(target_rank, d)) {
         common::profiler::interval_end<prof_event_sched_steal>(ibd, false);
@@ -1101,7 +1137,8 @@ private:
 
         primary_wsq_.lock().unlock(target_rank, d);
 
-        common::profiler::interval_end<prof_event_sched_steal>(ibd, true);
+        common::profiler::interval_end<prof_event_sched_steal>(ibd, true, pwe->frame_size);
+        common::sampling::count(common::sampling::counter::steal_success);
 
         common::profiler::switch_phase<prof_phase_sched_loop, prof_phase_sched_resume_stolen>();
 
@@ -1120,7 +1157,8 @@ private:
 
         primary_wsq_.lock().unlock(target_rank, d);
 
-        common::profiler::interval_end<prof_event_sched_steal>(ibd, true);
+        common::profiler::interval_end<prof_event_sched_steal>(ibd, true, pwe->frame_size);
+        common::sampling::count(common::sampling::counter::steal_success);
 
         common::profiler::switch_phase<prof_phase_sched_loop, prof_phase_sched_resume_stolen>();
 
@@ -1149,6 +1187,7 @@ private:
 
     migration_wsq_.for_each_nonempty_queue(target_rank, min_depth, max_depth, true, [&](int d) {
       auto ibd = common::profiler::interval_begin<prof_event_sched_steal>(target_rank);
+      common::sampling::count(common::sampling::counter::steal_attempt);
 
       if (!migration_wsq_.lock().trylock(target_rank, d)) {
         common::profiler::interval_end<prof_event_sched_steal>(ibd, false);
@@ -1176,7 +1215,8 @@ private:
 
         migration_wsq_.lock().unlock(target_rank, d);
 
-        common::profiler::interval_end<prof_event_sched_steal>(ibd, true);
+        common::profiler::interval_end<prof_event_sched_steal>(ibd, true, mwe->frame_size);
+        common::sampling::count(common::sampling::counter::steal_success);
 
         common::profiler::switch_phase<prof_phase_sched_loop, prof_phase_sched_start_new>();
 
@@ -1193,7 +1233,8 @@ private:
 
         migration_wsq_.lock().unlock(target_rank, d);
 
-        common::profiler::interval_end<prof_event_sched_steal>(ibd, true);
+        common::profiler::interval_end<prof_event_sched_steal>(ibd, true, mwe->frame_size);
+        common::sampling::count(common::sampling::counter::steal_success);
 
         common::profiler::switch_phase<prof_phase_sched_loop, prof_phase_sched_resume_stolen>();
 
@@ -1212,7 +1253,8 @@ private:
 
         migration_wsq_.lock().unlock(target_rank, d);
 
-        common::profiler::interval_end<prof_event_sched_steal>(ibd, true);
+        common::profiler::interval_end<prof_event_sched_steal>(ibd, true, mwe->frame_size);
+        common::sampling::count(common::sampling::counter::steal_success);
 
         common::profiler::switch_phase<prof_phase_sched_loop, prof_phase_sched_resume_stolen>();
 
@@ -7,6 +7,7 @@
 #include "ityr/common/logger.hpp"
 #include "ityr/common/allocator.hpp"
 #include "ityr/common/profiler.hpp"
+#include "ityr/common/sampling.hpp"
 #include "ityr/ito/util.hpp"
 #include "ityr/ito/options.hpp"
 #include "ityr/ito/context.hpp"
@@ -63,8 +64,8 @@ public:
       // This stack base is updated only in coll_exec().
       stack_base_(reinterpret_cast<context_frame*>(stack_.bottom()) - 1),
       wsq_(wsqueue_capacity_option::value()),
-      thread_state_allocator_(thread_state_allocator_size_option::value()),
-      suspended_thread_allocator_(suspended_thread_allocator_size_option::value()) {}
+      thread_state_allocator_(thread_state_allocator_size_option::value(), "the thread state allocator"),
+      suspended_thread_allocator_(suspended_thread_allocator_size_option::value(), "the suspended thread allocator") {}
 
   template <typename T, typename SchedLoopCallback, typename Fn, typename... Args>
   T root_exec(SchedLoopCallback cb, Fn&& fn, Args&&... args) {
@@ -134,14 +135,19 @@ public:
     th.state = ts;
     th.serialized = false;
 
-    suspend([&, ts, fn = std::forward<Fn>(fn),
+    // the new thread inherits the task label of the parent
+    const char* dag_label = tls_->dag_prof.label();
+
+    suspend([&, ts, dag_label, fn = std::forward<Fn>(fn),
              args_tuple = std::make_tuple(std::forward<Args>(args)...)](context_frame* cf) mutable {
       common::verbose<2>("push context frame [%p, %p) into task queue", cf, cf->parent_frame);
 
       tls_ = new (alloca(sizeof(thread_local_storage))) thread_local_storage{};
+      tls_->dag_prof.set_label(dag_label);
 
       std::size_t cf_size = reinterpret_cast<uintptr_t>(cf->parent_frame) - reinterpret_cast<uintptr_t>(cf);
       wsq_.push(wsqueue_entry{cf, cf_size});
+      stack_.record_depth(cf);
 
       tls_->dag_prof.start();
       tls_->dag_prof.increment_thread_count();
@@ -403,6 +409,27 @@ public:
     }
   }
 
+  dag_prof_result dag_prof_get_result() const {
+    return dag_prof_result_.get_result();
+  }
+
+  void dag_prof_set_label(const char* label) {
+    tls_->dag_prof.set_label(label);
+  }
+
+  const char* dag_prof_get_label() const {
+    return tls_->dag_prof.label();
+  }
+
+  mem_stats get_mem_stats() const {
+    mem_stats ms;
+    ms.stack                 = stack_.usage();
+    ms.wsqueue               = wsq_.usage();
+    ms.thread_state_heap     = thread_state_allocator_.usage();
+    ms.suspended_thread_heap = suspended_thread_allocator_.usage();
+    return ms;
+  }
+
 private:
   struct coll_task {
     void*                    task_ptr;
@@ -466,6 +493,7 @@ private:
     auto target_rank = get_random_rank(0, common::topology::n_ranks() - 1);
 
     auto ibd = common::profiler::interval_begin<prof_event_sched_steal>(target_rank);
+    common::sampling::count(common::sampling::counter::steal_attempt);
 
     if (wsq_.empty(target_rank)) {
       common::profiler::interval_end<prof_event_sched_steal>(ibd, false);
@@ -491,7 +519,8 @@ private:
 
     wsq_.lock().unlock(target_rank);
 
-    common::profiler::interval_end<prof_event_sched_steal>(ibd, true);
+    common::profiler::interval_end<prof_event_sched_steal>(ibd, true, we->frame_size);
+    common::sampling::count(common::sampling::counter::steal_success);
 
     common::profiler::switch_phase<prof_phase_sched_loop, prof_phase_sched_resume_stolen>();
 
@@ -62,6 +62,11 @@ public:
   void dag_prof_begin() {}
   void dag_prof_end() {}
   void dag_prof_print() const {}
+  dag_prof_result dag_prof_get_result() const { return {}; }
+  void dag_prof_set_label(const char*) {}
+  const char* dag_prof_get_label() const { return nullptr; }
+
+  mem_stats get_mem_stats() const { return {}; }
 };
 
 }
@@ -2,6 +2,7 @@
 
 #include <random>
 #include <atomic>
+#include <cstring>
 
 #include "ityr/common/util.hpp"
 #include "ityr/common/topology.hpp"
@@ -18,6 +19,41 @@ namespace ityr::ito {
  * DAG profiler
  */
 
+/**
+ * @brief Work and span of the strands with the same task label.
+ */
+struct dag_prof_label_result {
+  std::string                    label;    ///< Task label (`(unlabeled)` for strands without labels).
+  common::wallclock::wallclock_t work = 0; ///< Total time of the strands with this label (ns).
+  common::wallclock::wallclock_t span = 0; ///< Time of the strands with this label on the critical path (ns).
+
+  template <typename Fn>
+  void for_each_field(Fn&& fn) {
+    fn("work_ns", work);
+    fn("span_ns", span);
+  }
+};
+
+/**
+ * @brief Work and span of the profiled DAG (the same in all processes).
+ */
+struct dag_prof_result {
+  bool                               enabled   = false; ///< False if the DAG profiler is disabled at compile time.
+  common::wallclock::wallclock_t     work      = 0;     ///< Total time of all strands (ns).
+  common::wallclock::wallclock_t     span      = 0;     ///< Time of the critical path (ns).
+  uint64_t                           n_threads = 0;     ///< Number of threads.
+  uint64_t                           n_strands = 0;     ///< Number of strands.
+  std::vector<dag_prof_label_result> labels;            ///< Breakdown by task labels in descending order of span (only with `ITYR_ITO_DAG_PROF=critpath`).
+
+  template <typename Fn>
+  void for_each_field(Fn&& fn) {
+    fn("work_ns"  , work);
+    fn("span_ns"  , span);
+    fn("n_threads", n_threads);
+    fn("n_strands", n_strands);
+  }
+};
+
 class dag_profiler_disabled {
 public:
   static constexpr bool enabled = false;
@@ -29,6 +65,9 @@ public:
   void merge_parallel(const dag_profiler_disabled&) {}
   void increment_thread_count() {}
   void increment_strand_count() {}
+  void set_label(const char*) {}
+  const char* label() const { return nullptr; }
+  dag_prof_result get_result() const { return {}; }
   void print() const {}
 };
 
@@ -82,6 +121,13 @@ public:
   void increment_thread_count() { n_threads_++; }
   void increment_strand_count() { n_strands_++; }
 
+  void set_label(const char*) {}
+  const char* label() const { return nullptr; }
+
+  dag_prof_result get_result() const {
+    return {true, work_, span_, n_threads_, n_strands_, {}};
+  }
+
   void print() const {
     printf("work: %ld ns span: %ld ns parallelism: %f\n"
            "n_threads: %ld (ave: %ld ns) n_strands: %ld (ave: %ld ns)\n\n",
@@ -99,6 +145,176 @@ private:
   uint64_t                       n_strands_ = 0;
 };
 
+/*
+ * In addition to work and span, the critpath mode attributes the time of each strand to the task
+ * label of the thread (set by `ito::dag_prof_label_scope`), and keeps the per-label breakdown of
+ * the critical path. When two parallel threads are merged, the breakdown of the longer one is kept.
+ * This profiler is copied between processes, and thus labels must be string literals, whose addresses
+ * are the same in all processes (ASLR is disabled).
+ */
+class dag_profiler_critpath {
+public:
+  static constexpr bool enabled = true;
+
+  void start() {
+    ITYR_CHECK(is_stopped());
+    t_start_ = common::wallclock::gettime_ns();
+  }
+
+  void stop() {
+    ITYR_CHECK(!is_stopped());
+    auto t = common::wallclock::gettime_ns() - t_start_;
+    work_ += t;
+    span_ += t;
+    label_entry& e = get_entry(label_);
+    e.work += t;
+    e.span += t;
+    t_start_ = 0;
+  }
+
+  bool is_stopped() const { return t_start_ == 0; }
+
+  // The current label is kept
+  void clear() {
+    t_start_   = 0;
+    work_      = 0;
+    span_      = 0;
+    n_threads_ = 0;
+    n_strands_ = 0;
+    n_entries_ = 0;
+  }
+
+  void merge_serial(const dag_profiler_critpath& dp) {
+    ITYR_CHECK(is_stopped());
+    ITYR_CHECK(dp.is_stopped());
+
+    work_ += dp.work_;
+    span_ += dp.span_;
+    n_threads_ += dp.n_threads_;
+    n_strands_ += dp.n_strands_;
+
+    for (std::size_t i = 0; i < dp.n_entries_; i++) {
+      label_entry& e = get_entry(dp.entries_[i].label);
+      e.work += dp.entries_[i].work;
+      e.span += dp.entries_[i].span;
+    }
+  }
+
+  void merge_parallel(const dag_profiler_critpath& dp) {
+    ITYR_CHECK(is_stopped());
+    ITYR_CHECK(dp.is_stopped());
+
+    bool dp_critical = dp.span_ > span_;
+    if (dp_critical) {
+      for (std::size_t i = 0; i < n_entries_; i++) {
+        entries_[i].span = 0;
+      }
+    }
+
+    work_ += dp.work_;
+    span_ = std::max(span_, dp.span_);
+    n_threads_ += dp.n_threads_;
+    n_strands_ += dp.n_strands_;
+
+    for (std::size_t i = 0; i < dp.n_entries_; i++) {
+      label_entry& e = get_entry(dp.entries_[i].label);
+      e.work += dp.entries_[i].work;
+      if (dp_critical) {
+        e.span = dp.entries_[i].span;
+      }
+    }
+  }
+
+  void increment_thread_count() { n_threads_++; }
+  void increment_strand_count() { n_strands_++; }
+
+  void set_label(const char* label) {
+    if (is_stopped()) {
+      label_ = label;
+    } else {
+      stop();
+      label_ = label;
+      start();
+    }
+  }
+
+  const char* label() const { return label_; }
+
+  dag_prof_result get_result() const {
+    dag_prof_result ret {true, work_, span_, n_threads_, n_strands_, {}};
+    for (std::size_t i = 0; i < n_entries_; i++) {
+      const label_entry& e = entries_[i];
+      ret.labels.push_back({e.label ? e.label : "(unlabeled)", e.work, e.span});
+    }
+    std::sort(ret.labels.begin(), ret.labels.end(), [](const auto& a, const auto& b) {
+      return a.span != b.span ? a.span > b.span : a.work > b.work;
+    });
+    return ret;
+  }
+
+  void print() const {
+    printf("work: %ld ns span: %ld ns parallelism: %f\n"
+           "n_threads: %ld (ave: %ld ns) n_strands: %ld (ave: %ld ns)\n\n",
+           work_, span_, (span_ == 0) ? 0 : static_cast<double>(work_) / span_,
+           n_threads_, (n_threads_ == 0) ? 0 : work_ / n_threads_,
+           n_strands_, (n_strands_ == 0) ? 0 : work_ / n_strands_);
+
+    auto labels = get_result().labels;
+    std::size_t top_n = std::min(labels.size(), dag_prof_top_n_option::value());
+
+    printf("Top %ld contributors to span:\n", top_n);
+    printf("  %-32s %16s %8s %16s %12s\n", "label", "span (ns)", "span %", "work (ns)", "parallelism");
+    for (std::size_t i = 0; i < top_n; i++) {
+      const auto& l = labels[i];
+      printf("  %-32s %16ld %7.2f%% %16ld %12f\n",
+             l.label.c_str(), l.span, (span_ == 0) ? 0 : 100.0 * l.span / span_,
+             l.work, (l.span == 0) ? 0 : static_cast<double>(l.work) / l.span);
+    }
+    printf("\n");
+    fflush(stdout);
+  }
+
+private:
+  static constexpr std::size_t max_entries = ITYR_ITO_DAG_PROF_MAX_LABELS;
+  static_assert(max_entries > 0);
+
+  static constexpr const char* others_label = "(others)";
+
+  struct label_entry {
+    const char*                    label;
+    common::wallclock::wallclock_t work;
+    common::wallclock::wallclock_t span;
+  };
+
+  static bool label_equal(const char* l1, const char* l2) {
+    return l1 == l2 || (l1 && l2 && std::strcmp(l1, l2) == 0);
+  }
+
+  label_entry& get_entry(const char* label) {
+    for (std::size_t i = 0; i < n_entries_; i++) {
+      if (label_equal(entries_[i].label, label)) {
+        return entries_[i];
+      }
+    }
+    if (n_entries_ < max_entries) {
+      entries_[n_entries_] = {label, 0, 0};
+      return entries_[n_entries_++];
+    }
+    // Labels that do not fit are accumulated into the last entry
+    entries_[max_entries - 1].label = others_label;
+    return entries_[max_entries - 1];
+  }
+
+  common::wallclock::wallclock_t t_start_   = 0;
+  common::wallclock::wallclock_t work_      = 0;
+  common::wallclock::wallclock_t span_      = 0;
+  uint64_t                       n_threads_ = 0;
+  uint64_t                       n_strands_ = 0;
+  const char*                    label_     = nullptr;
+  std::size_t                    n_entries_ = 0;
+  label_entry                    entries_[max_entries];
+};
+
 using dag_profiler = ITYR_CONCAT(dag_profiler_, ITYR_ITO_DAG_PROF);
 
 /*
@@ -0,0 +1,367 @@
+#pragma once
+
+#include <array>
+
+#include "ityr/common/util.hpp"
+#include "ityr/common/mpi_util.hpp"
+#include "ityr/common/topology.hpp"
+#include "ityr/common/wallclock.hpp"
+#include "ityr/ito/options.hpp"
+
+namespace ityr::ito {
+
+// Histogram with power-of-two bins ([0, 1), [1, 2), [2, 4), ...)
+class log2_histogram {
+public:
+  static constexpr int n_bins = 48;
+
+  void add(uint64_t v) {
+    int b = (v == 0) ? 0 : std::min(64 - __builtin_clzll(v), n_bins - 1);
+    bins_[b]++;
+  }
+
+  void clear() { bins_.fill(0); }
+
+  // Sum up histograms of all processes to rank 0 (collective)
+  log2_histogram reduce() const {
+    log2_histogram h;
+    common::mpi_reduce(bins_.data(), h.bins_.data(), n_bins, 0, common::topology::mpicomm());
+    return h;
+  }
+
+  uint64_t count() const {
+    uint64_t c = 0;
+    for (auto b : bins_) c += b;
+    return c;
+  }
+
+  void print(const char* unit) const {
+    uint64_t total = count();
+    if (total == 0) {
+      printf("    (no samples)\n");
+      return;
+    }
+    for (int b = 0; b < n_bins; b++) {
+      if (bins_[b] == 0) continue;
+      uint64_t lo = (b == 0) ? 0 : (uint64_t(1) << (b - 1));
+      uint64_t hi = uint64_t(1) << b;
+      printf("    [%12lu, %12lu) %-5s : %10lu (%5.1f %%)\n",
+             lo, hi, unit, bins_[b], 100.0 * bins_[b] / total);
+    }
+  }
+
+private:
+  std::array<uint64_t, n_bins> bins_ = {};
+};
+
+/*
+ * Steal analytics (who stole from whom)
+ *
+ * Each process records steal attempts, successes, and copied bytes for each victim, latency
+ * histograms of steals, and the amount of work executed after each successful steal (the time until
+ * the next steal attempt), which approximates the size of stolen tasks.
+ * All of them are aggregated at rank 0 when the profiler is flushed.
+ */
+class steal_analytics {
+public:
+  steal_analytics()
+    : n_ranks_(common::topology::n_ranks()),
+      attempts_(n_ranks_),
+      successes_(n_ranks_),
+      bytes_(n_ranks_) {}
+
+  void record(common::wallclock::wallclock_t t0,
+              common::wallclock::wallclock_t t1,
+              common::topology::rank_t       victim,
+              bool                           success,
+              std::size_t                    bytes) {
+    ITYR_CHECK(0 <= victim);
+    ITYR_CHECK(victim < n_ranks_);
+
+    if (work_begin_ != 0) {
+      work_hist_.add(t0 - work_begin_);
+      work_begin_ = 0;
+    }
+
+    attempts_[victim]++;
+    if (success) {
+      successes_[victim]++;
+      bytes_[victim] += bytes;
+      latency_success_hist_.add(t1 - t0);
+      if (common::topology::inter_rank(victim) == common::topology::inter_my_rank()) {
+        latency_sum_intra_ += t1 - t0;
+      } else {
+        latency_sum_inter_ += t1 - t0;
+      }
+      work_begin_ = t1;
+    } else {
+      latency_fail_hist_.add(t1 - t0);
+    }
+  }
+
+  void clear() {
+    std::fill(attempts_.begin(), attempts_.end(), 0);
+    std::fill(successes_.begin(), successes_.end(), 0);
+    std::fill(bytes_.begin(), bytes_.end(), 0);
+    latency_success_hist_.clear();
+    latency_fail_hist_.clear();
+    work_hist_.clear();
+    latency_sum_intra_ = 0;
+    latency_sum_inter_ = 0;
+    work_begin_        = 0;
+  }
+
+  // Collective
+  void print() const {
+    auto my_rank = common::topology::my_rank();
+    auto n       = static_cast<std::size_t>(n_ranks_);
+
+    // Each process owns its own row (thief) of the matrices, which are gathered only to rank 0
+    std::vector<uint64_t> my_row(n * 3);
+    std::copy(attempts_.begin() , attempts_.end() , my_row.begin());
+    std::copy(successes_.begin(), successes_.end(), my_row.begin() + n);
+    std::copy(bytes_.begin()    , bytes_.end()    , my_row.begin() + 2 * n);
+    std::vector<uint64_t> mats(my_rank == 0 ? n * n * 3 : 0);
+    common::mpi_gather(my_row.data(), mats.data(), n * 3, 0, common::topology::mpicomm());
+
+    auto latency_success_hist = latency_success_hist_.reduce();
+    auto latency_fail_hist    = latency_fail_hist_.reduce();
+    auto work_hist            = work_hist_.reduce();
+    auto latency_sum_intra    = common::mpi_reduce_value(latency_sum_intra_, 0, common::topology::mpicomm());
+    auto latency_sum_inter    = common::mpi_reduce_value(latency_sum_inter_, 0, common::topology::mpicomm());
+
+    if (my_rank != 0) return;
+
+    auto attempts  = [&](std::size_t t, std::size_t v) { return mats[t * n * 3 + v]; };
+    auto successes = [&](std::size_t t, std::size_t v) { return mats[t * n * 3 + n + v]; };
+    auto bytes     = [&](std::size_t t, std::size_t v) { return mats[t * n * 3 + 2 * n + v]; };
+
+    uint64_t attempts_intra = 0, attempts_inter = 0;
+    uint64_t success_intra  = 0, success_inter  = 0;
+    uint64_t bytes_total    = 0;
+    std::vector<uint64_t> victim_successes(n, 0);
+    for (std::size_t t = 0; t < n; t++) {
+      for (std::size_t v = 0; v < n; v++) {
+        bool intra = common::topology::inter_rank(t) == common::topology::inter_rank(v);
+        (intra ? attempts_intra : attempts_inter) += attempts(t, v);
+        (intra ? success_intra  : success_inter ) += successes(t, v);
+        bytes_total += bytes(t, v);
+        victim_successes[v] += successes(t, v);
+      }
+    }
+    uint64_t attempts_total = attempts_intra + attempts_inter;
+    uint64_t success_total  = success_intra + success_inter;
+
+    auto ratio = [](uint64_t a, uint64_t b) { return b == 0 ? 0.0 : 100.0 * a / b; };
+    auto ave   = [](uint64_t a, uint64_t b) { return b == 0 ? uint64_t(0) : a / b; };
+
+    printf("[Steal analytics]\n");
+    printf("  Attempts:           %14lu (success: %lu, %5.1f %%)\n",
+           attempts_total, success_total, ratio(success_total, attempts_total));
+    printf("  Intra-node steals:  %14lu (success: %lu, %5.1f %%) ave latency: %lu ns\n",
+           attempts_intra, success_intra, ratio(success_intra, attempts_intra),
+           ave(latency_sum_intra, success_intra));
+    printf("  Inter-node steals:  %14lu (success: %lu, %5.1f %%) ave latency: %lu ns\n",
+           attempts_inter, success_inter, ratio(success_inter, attempts_inter),
+           ave(latency_sum_inter, success_inter));
+    printf("  Stack bytes copied: %14lu (ave: %lu bytes per steal)\n",
+           bytes_total, ave(bytes_total, success_total));
+
+    printf("  Successful steal latency:\n");
+    latency_success_hist.print("ns");
+    printf("  Failed steal latency:\n");
+    latency_fail_hist.print("ns");
+    printf("  Work executed after each successful steal:\n");
+    work_hist.print("ns");
+
+    if (n <= max_printed_matrix_size) {
+      printf("  Successful steals (row: thief, column: victim):\n");
+      printf("    %6s", "");
+      for (std::size_t v = 0; v < n; v++) printf(" %8ld", v);
+      printf("\n");
+      for (std::size_t t = 0; t < n; t++) {
+        printf("    %6ld", t);
+        for (std::size_t v = 0; v < n; v++) printf(" %8lu", successes(t, v));
+        printf("\n");
+      }
+    } else {
+      std::vector<std::pair<uint64_t, std::size_t>> pairs;
+      for (std::size_t t = 0; t < n; t++) {
+        for (std::size_t v = 0; v < n; v++) {
+          if (successes(t, v) > 0) pairs.emplace_back(successes(t, v), t * n + v);
+        }
+      }
+      std::size_t n_top = std::min(pairs.size(), max_printed_matrix_size);
+      std::partial_sort(pairs.begin(), pairs.begin() + n_top, pairs.end(), std::greater<>{});
+      printf("  Top %ld (thief, victim) pairs of successful steals:\n", n_top);
+      for (std::size_t i = 0; i < n_top; i++) {
+        std::size_t t = pairs[i].second / n, v = pairs[i].second % n;
+        printf("    %6ld <- %6ld : %10lu (attempts: %lu, %s)\n", t, v, pairs[i].first, attempts(t, v),
+               common::topology::inter_rank(t) == common::topology::inter_rank(v) ? "intra-node" : "inter-node");
+      }
+    }
+
+    uint64_t victim_max = *std::max_element(victim_successes.begin(), victim_successes.end());
+    printf("  Most stolen victim: %14lu steals (ave: %lu steals per rank)\n",
+           victim_max, ave(success_total, n));
+
+    // Hints for scheduler choices
+    if (success_inter > 0 && success_intra > 0 &&
+        ave(latency_sum_inter, success_inter) > 2 * ave(latency_sum_intra, success_intra) &&
+        ratio(success_inter, success_total) > 50.0) {
+      printf("  Hint: most steals cross nodes and take %.1fx longer than intra-node ones;"
+             " topology-aware victim selection may help.\n",
+             double(ave(latency_sum_inter, success_inter)) / ave(latency_sum_intra, success_intra));
+    }
+    if (ratio(success_total, attempts_total) < 10.0 && attempts_total > 0) {
+      printf("  Hint: less than 10 %% of steal attempts succeed; parallelism may be insufficient or"
+             " concentrated on a few ranks%s.\n",
+             std::string(ITYR_STR(ITYR_ITO_SCHEDULER)) == "randws" ?
+               " (ITYR_ITO_SCHEDULER=adws distributes work deterministically)" : "");
+    }
+    printf("\n");
+    fflush(stdout);
+  }
+
+private:
+  static constexpr std::size_t max_printed_matrix_size = 16;
+
+  common::topology::rank_t       n_ranks_;
+  std::vector<uint64_t>          attempts_;
+  std::vector<uint64_t>          successes_;
+  std::vector<uint64_t>          bytes_;
+  log2_histogram                 latency_success_hist_;
+  log2_histogram                 latency_fail_hist_;
+  log2_histogram                 work_hist_;
+  uint64_t                       latency_sum_intra_ = 0;
+  uint64_t                       latency_sum_inter_ = 0;
+  common::wallclock::wallclock_t work_begin_        = 0;
+};
+
+/*
+ * Idle-time timeline
+ *
+ * Idle time (time spent in the scheduler loop) is accumulated in fixed-width time bins since
+ * the profiler began, and then printed for each rank in `n_columns` time slices.
+ * The bin width starts at 1 ms and is doubled by merging adjacent bins when the number of bins
+ * reaches `max_bins`, so that the memory usage is bounded for long profiling intervals.
+ */
+class idle_timeline {
+public:
+  void add(common::wallclock::wallclock_t t_begin,
+           common::wallclock::wallclock_t t0,
+           common::wallclock::wallclock_t t1) {
+    if (t0 < t_begin) t0 = t_begin;
+    while (t0 < t1) {
+      std::size_t b = (t0 - t_begin) / bin_ns_;
+      while (b >= max_bins) {
+        merge_bins();
+        b = (t0 - t_begin) / bin_ns_;
+      }
+      if (b >= bins_.size()) bins_.resize(b + 1, 0);
+      auto t_bin_end = t_begin + (b + 1) * bin_ns_;
+      auto t = std::min(t1, t_bin_end);
+      bins_[b] += t - t0;
+      t0 = t;
+    }
+  }
+
+  void clear() {
+    bins_.clear();
+    bin_ns_ = initial_bin_ns;
+  }
+
+  uint64_t total() const {
+    uint64_t t = 0;
+    for (auto b : bins_) t += b;
+    return t;
+  }
+
+  std::size_t n_bins() const { return bins_.size(); }
+
+  common::wallclock::wallclock_t bin_width() const { return bin_ns_; }
+
+  // Collective
+  void print(common::wallclock::wallclock_t t_begin,
+             common::wallclock::wallclock_t t_end) const {
+    auto my_rank = common::topology::my_rank();
+    auto n_ranks = common::topology::n_ranks();
+    auto t_total = std::max(t_end - t_begin, common::wallclock::wallclock_t(1));
+
+    // Rebin into n_columns time slices aligned to the bin boundaries
+    std::size_t n_bins_total = (t_total + bin_ns_ - 1) / bin_ns_;
+    std::array<uint64_t, n_columns> cols = {};
+    for (std::size_t b = 0; b < std::min(bins_.size(), n_bins_total); b++) {
+      cols[b * n_columns / n_bins_total] += bins_[b];
+    }
+    std::array<uint64_t, n_columns> col_widths = {};
+    for (std::size_t b = 0; b < n_bins_total; b++) {
+      col_widths[b * n_columns / n_bins_total] += std::min(bin_ns_, t_total - b * bin_ns_);
+    }
+    uint64_t idle_total = total();
+
+    std::vector<uint64_t> all_cols(n_columns * n_ranks);
+    common::mpi_allgather(cols.data(), n_columns, all_cols.data(), n_columns, common::topology::mpicomm());
+    auto idle_max = common::mpi_reduce_value(idle_total, 0, common::topology::mpicomm(), MPI_MAX);
+    auto idle_sum = common::mpi_reduce_value(idle_total, 0, common::topology::mpicomm());
+
+    if (my_rank == 0) {
+      printf("[Idle time (%% of each of %ld time slices)]\n", n_columns);
+      for (common::topology::rank_t i = 0; i < n_ranks; i++) {
+        printf("  rank %5d :", i);
+        for (std::size_t c = 0; c < n_columns; c++) {
+          printf(" %5.1f", col_widths[c] == 0 ? 0.0 : 100.0 * all_cols[i * n_columns + c] / col_widths[c]);
+        }
+        printf("\n");
+      }
+      printf("  Imbalance (max / ave idle time): %.3f\n",
+             idle_sum == 0 ? 0.0 : double(idle_max) / (double(idle_sum) / n_ranks));
+      printf("\n");
+      fflush(stdout);
+    }
+  }
+
+  static constexpr std::size_t max_bins = 1024;
+
+private:
+  static constexpr common::wallclock::wallclock_t initial_bin_ns = 1000000; // 1 ms
+  static constexpr std::size_t                    n_columns      = 10;
+
+  void merge_bins() {
+    for (std::size_t i = 0; i < bins_.size(); i += 2) {
+      bins_[i / 2] = bins_[i] + (i + 1 < bins_.size() ? bins_[i + 1] : 0);
+    }
+    bins_.resize((bins_.size() + 1) / 2);
+    bin_ns_ *= 2;
+  }
+
+  std::vector<uint64_t>          bins_;
+  common::wallclock::wallclock_t bin_ns_ = initial_bin_ns;
+};
+
+ITYR_TEST_CASE("[ityr::ito::steal_analytics] histogram and idle timeline") {
+  log2_histogram h;
+  h.add(0);
+  h.add(1);
+  h.add(3);
+  h.add(uint64_t(1) << 63);
+  ITYR_CHECK(h.count() == 4);
+
+  idle_timeline tl;
+  // [0.5 ms, 2.5 ms) spans three 1-ms bins
+  tl.add(1000, 1000 + 500000, 1000 + 2500000);
+  ITYR_CHECK(tl.n_bins() == 3);
+  ITYR_CHECK(tl.total() == 2000000);
+  // intervals before the beginning of profiling are clipped
+  tl.add(1000, 0, 1000 + 100000);
+  ITYR_CHECK(tl.total() == 2100000);
+  // the number of bins is bounded by merging adjacent bins
+  tl.add(1000, 1000 + 3000000000, 1000 + 3001000000);
+  ITYR_CHECK(tl.n_bins() <= idle_timeline::max_bins);
+  ITYR_CHECK(tl.bin_width() == 4000000);
+  ITYR_CHECK(tl.total() == 3100000);
+  tl.clear();
+  ITYR_CHECK(tl.bin_width() == 1000000);
+}
+
+}
@@ -19,6 +19,14 @@ struct workhint {
   W work_rest;
 };
 
+// Task label for the critical path profiler (ITYR_ITO_DAG_PROF=critpath); it must be a string literal
+struct task_label {
+  constexpr explicit task_label(const char* n)
+    : name(n) {}
+
+  const char* name;
+};
+
 template <typename T>
 class thread {
   // If the return value is void, set `no_retval_t` as the return type for the internal of the scheduler
@@ -52,6 +60,11 @@ public:
          wh, std::forward<Fn>(fn), std::forward<Args>(args)...);
   }
 
+  template <typename Fn, typename... Args>
+  thread(task_label label, Fn&& fn, Args&&... args) {
+    fork(label, std::forward<Fn>(fn), std::forward<Args>(args)...);
+  }
+
   thread(const thread&) = delete;
   thread& operator=(const thread&) = delete;
 
@@ -95,6 +108,18 @@ public:
                    wh.work_new, wh.work_rest, std::forward<Fn>(fn), std::forward<Args>(args)...);
   }
 
+  template <typename Fn, typename... Args>
+  void fork(task_label label, Fn&& fn, Args&&... args) {
+    if constexpr (dag_profiler::enabled) {
+      fork([label, fn = std::forward<Fn>(fn)](auto&&... args_) mutable -> T {
+        worker::instance::get().sched().dag_prof_set_label(label.name);
+        return std::forward<decltype(fn)>(fn)(std::forward<decltype(args_)>(args_)...);
+      }, std::forward<Args>(args)...);
+    } else {
+      fork(std::forward<Fn>(fn), std::forward<Args>(args)...);
+    }
+  }
+
   T join() {
     auto& w = worker::instance::get();
     ITYR_CHECK(!w.is_spmd());
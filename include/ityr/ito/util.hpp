@@ -3,9 +3,20 @@
 #include "ityr/common/util.hpp"
 #include "ityr/common/mpi_util.hpp"
 #include "ityr/common/topology.hpp"
+#include "ityr/common/mem_usage.hpp"
 
 namespace ityr::ito {
 
+/**
+ * @brief Memory usage of the threading layer in this process.
+ */
+struct mem_stats {
+  common::mem_usage stack;                 ///< Call stack depth (in bytes).
+  common::mem_usage wsqueue;               ///< Work-stealing queue depth (in entries).
+  common::mem_usage thread_state_heap;     ///< Thread state allocator (in bytes).
+  common::mem_usage suspended_thread_heap; ///< Suspended thread allocator (in bytes).
+};
+
 // Check if address space layout randomization (ASLR) is disabled
 class aslr_checker {
 public:
@@ -11,6 +11,7 @@
 #include "ityr/common/mpi_rma.hpp"
 #include "ityr/common/topology.hpp"
 #include "ityr/common/global_lock.hpp"
+#include "ityr/common/mem_usage.hpp"
 #include "ityr/common/profiler.hpp"
 #include "ityr/ito/prof_events.hpp"
 
@@ -58,6 +59,9 @@ public:
 
     qs.top.store(t + 1, std::memory_order_release);
 
+    std::size_t depth = qs.size();
+    if (depth > peak_size_) peak_size_ = depth;
+
     if constexpr (!EnablePass) {
       local_empty_[idx] = false;
     }
@@ -268,6 +272,17 @@ public:
     return local_queue_state(idx).size();
   }
 
+  // Number of entries in the local queues (the maximum among queues if there are multiple queues)
+  common::mem_usage usage() const {
+    common::mem_usage mu;
+    for (int idx = 0; idx < n_queues_; idx++) {
+      mu.current = std::max(mu.current, std::size_t(size(idx)));
+    }
+    mu.peak     = std::max(peak_size_, mu.current);
+    mu.capacity = n_entries_;
+    return mu;
+  }
+
   bool empty(common::topology::rank_t target_rank, int idx = 0) const {
     ITYR_PROFILER_RECORD(prof_event_wsqueue_empty, target_rank);
 
@@ -407,6 +422,7 @@ private:
   common::mpi_win_manager<Entry>               entries_win_;
   common::global_lock                          queue_lock_;
   std::vector<bool>                            local_empty_;
+  std::size_t                                  peak_size_ = 0;
 };
 
 ITYR_TEST_CASE("[ityr::ito::wsqueue] single queue") {
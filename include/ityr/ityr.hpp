@@ -5,6 +5,7 @@
 #include "ityr/common/topology.hpp"
 #include "ityr/common/wallclock.hpp"
 #include "ityr/common/profiler.hpp"
+#include "ityr/common/sampling.hpp"
 #include "ityr/ito/ito.hpp"
 #include "ityr/ori/ori.hpp"
 #include "ityr/pattern/count_iterator.hpp"
@@ -16,14 +17,20 @@
 #include "ityr/pattern/parallel_merge.hpp"
 #include "ityr/pattern/parallel_sort.hpp"
 #include "ityr/pattern/parallel_search.hpp"
+#include "ityr/pattern/parallel_select.hpp"
 #include "ityr/pattern/parallel_shuffle.hpp"
 #include "ityr/pattern/random.hpp"
 #include "ityr/pattern/reducer_extra.hpp"
 #include "ityr/container/global_span.hpp"
 #include "ityr/container/global_vector.hpp"
+#include "ityr/container/global_unordered_map.hpp"
+#include "ityr/container/search_index.hpp"
+#include "ityr/container/global_mdarray.hpp"
 #include "ityr/container/checkout_span.hpp"
 #include "ityr/container/workhint.hpp"
 #include "ityr/container/unique_file_ptr.hpp"
+#include "ityr/container/global_file.hpp"
+#include "ityr/container/checkpoint.hpp"
 
 namespace ityr {
 
@@ -37,12 +44,20 @@ public:
       ito_(comm),
       ori_(comm) {}
 
+  ~ityr() {
+    if (common::print_memory_stats_option::value()) {
+      ito::mem_stats_print();
+      ori::mem_stats_print();
+    }
+  }
+
 private:
   common::mpi_initializer                                    mi_;
   common::runtime_options                                    opts_;
   common::singleton_initializer<common::topology::instance>  topo_;
   common::singleton_initializer<common::wallclock::instance> clock_;
   common::singleton_initializer<common::profiler::instance>  prof_;
+  common::singleton_initializer<common::sampling::instance>  sampler_;
   common::singleton_initializer<ito::instance>               ito_;
   common::singleton_initializer<ori::instance>               ori_;
 };
@@ -172,6 +187,137 @@ inline wallclock_t gettime_ns() {
   return common::wallclock::gettime_ns();
 }
 
+/**
+ * @brief Profiled results.
+ *
+ * Phases (the events whose names start with `P_`) are exclusive to each other, and thus the sum of
+ * their times equals the total profiled time; they can be used for a per-phase breakdown.
+ *
+ * @see `ityr::profiler_get_result()`.
+ */
+struct profiler_result {
+  std::vector<common::profiler::event_stats> events; ///< Profiler events and phases.
+  ito::dag_prof_result                       dag;    ///< Work and span of the profiled DAG.
+  ori::cache_prof_result                     cache;  ///< Cache statistics.
+  ori::home_prof_result                      home;   ///< Home segment statistics.
+  std::vector<ori::alloc_prof_result>        allocs; ///< Statistics of each collective memory allocation.
+};
+
+namespace internal {
+
+inline profiler_result get_local_profiler_result() {
+  return {common::profiler::get_stats(),
+          ito::dag_prof_get_result(),
+          ori::cache_prof_get_result(),
+          ori::home_prof_get_result(),
+          ori::alloc_prof_get_result()};
+}
+
+template <typename Result>
+inline Result allreduce_fields(Result r) {
+  std::vector<uint64_t> vals;
+  r.for_each_field([&](const char*, auto& v) { vals.push_back(v); });
+
+  std::vector<uint64_t> vals_all(vals.size());
+  common::mpi_allreduce(vals.data(), vals_all.data(), vals.size(), common::topology::mpicomm(), MPI_SUM);
+
+  std::size_t i = 0;
+  r.for_each_field([&](const char*, auto& v) { v = vals_all[i++]; });
+  return r;
+}
+
+inline profiler_result allreduce_profiler_result(profiler_result r) {
+  r.events = common::profiler::allreduce_stats(std::move(r.events));
+  r.cache  = allreduce_fields(r.cache);
+  r.home   = allreduce_fields(r.home);
+  for (auto&& a : r.allocs) {
+    auto size = a.size;
+    a = allreduce_fields(a);
+    a.size = size;
+  }
+  return r;
+}
+
+inline void append_output_records(std::vector<common::profiler::output_record>& records,
+                                  int rank, profiler_result& r) {
+  auto append = [&](const char* category, const std::string& name, auto& fields) {
+    fields.for_each_field([&](const char* metric, auto& v) {
+      records.push_back({rank, category, name, metric, uint64_t(v)});
+    });
+  };
+
+  for (auto&& e : r.events) {
+    append(e.is_phase() ? "phase" : "event", e.name, e);
+  }
+  // DAG results are already the same in all processes
+  if (r.dag.enabled && rank < 0) {
+    append("dag", "", r.dag);
+    for (auto&& l : r.dag.labels) {
+      append("dag_label", l.label, l);
+    }
+  }
+  if (r.cache.enabled) append("cache", "", r.cache);
+  if (r.home.enabled) append("home", "", r.home);
+  for (std::size_t i = 0; i < r.allocs.size(); i++) {
+    append("alloc", r.allocs[i].label.empty() ? "alloc" + std::to_string(i) : r.allocs[i].label, r.allocs[i]);
+  }
+}
+
+// Write profiled results to the file specified by ITYR_PROF_OUTPUT_FILE (collective)
+inline void output_profiler_result() {
+  if (common::prof_output_file_option::value().empty()) return;
+
+  profiler_result local_result = get_local_profiler_result();
+  profiler_result result = allreduce_profiler_result(local_result);
+
+  std::vector<common::profiler::output_record> records;
+  append_output_records(records, -1, result);
+
+  if (common::prof_output_per_rank_option::value()) {
+    std::vector<common::profiler::output_record> local_records;
+    append_output_records(local_records, 0, local_result);
+
+    std::vector<uint64_t> vals;
+    for (auto&& r : local_records) {
+      vals.push_back(r.value);
+    }
+
+    auto n_ranks = common::topology::n_ranks();
+    std::vector<uint64_t> vals_all(vals.size() * n_ranks);
+    common::mpi_allgather(vals.data(), vals.size(), vals_all.data(), vals.size(), common::topology::mpicomm());
+
+    for (common::topology::rank_t i = 0; i < n_ranks; i++) {
+      for (std::size_t j = 0; j < local_records.size(); j++) {
+        auto r = local_records[j];
+        r.rank  = i;
+        r.value = vals_all[i * vals.size() + j];
+        records.push_back(r);
+      }
+    }
+  }
+
+  if (common::topology::my_rank() == 0) {
+    common::profiler::write_output(records);
+  }
+}
+
+}
+
+/**
+ * @brief Return the profiled results summed over all processes (collective).
+ *
+ * This function should be called after `ityr::profiler_end()` and before `ityr::profiler_flush()`,
+ * which clears the profiled results. The maximum time of events is the maximum among all processes.
+ * Results of the profilers disabled at compile time are empty.
+ *
+ * @see `ityr::profiler_end()`.
+ * @see `ityr::profiler_flush()`.
+ */
+inline profiler_result profiler_get_result() {
+  ITYR_CHECK(is_spmd());
+  return internal::allreduce_profiler_result(internal::get_local_profiler_result());
+}
+
 /**
  * @brief Start the profiler (collective).
  * @see `ityr::profiler_end()`.
@@ -206,19 +352,61 @@ inline void profiler_end() {
 
 /**
  * @brief Print the profiled results to stdout (collective).
+ *
+ * If `ITYR_PROF_OUTPUT_FILE` is set, the results are also written to the file in the format
+ * specified by `ITYR_PROF_OUTPUT_FORMAT` (`json` or `csv`), together with the results of each
+ * process if `ITYR_PROF_OUTPUT_PER_RANK=1` is set. The file contains one output for each call.
+ *
  * @see `ityr::profiler_begin()`.
  * @see `ityr::profiler_end()`.
+ * @see `ityr::profiler_get_result()`.
  */
 inline void profiler_flush() {
   ITYR_CHECK(is_spmd());
 #if ITYR_DEBUG_UCX
   common::ityr_ucx_log_flush();
 #endif
+  internal::output_profiler_result();
   common::profiler::flush();
   ito::dag_prof_print();
   ori::cache_prof_print();
 }
 
+/**
+ * @brief Memory usage of the runtime system in this process.
+ *
+ * Each pool has the current and peak usage, and its capacity (if fixed), which can be used to
+ * size the corresponding runtime options (e.g., `ITYR_ORI_CACHE_SIZE` and `ITYR_ITO_STACK_SIZE`).
+ *
+ * @see `ityr::memory_stats()`.
+ */
+struct mem_stats {
+  ito::mem_stats ito; ///< Threading layer (call stack, work-stealing queue, and thread allocators).
+  ori::mem_stats ori; ///< Global memory layer (cache, noncollective heap, and collective memory).
+};
+
+/**
+ * @brief Return the memory usage of the runtime system in this process.
+ *
+ * The stack depth is sampled when threads are forked. If `ITYR_PRINT_MEMORY_STATS=1` is set,
+ * the maximum usage among all processes is printed to stdout when `ityr::fini()` is called.
+ *
+ * @see `ityr::print_memory_stats()`.
+ */
+inline mem_stats memory_stats() {
+  return {ito::get_mem_stats(), ori::get_mem_stats()};
+}
+
+/**
+ * @brief Print the maximum memory usage among all processes to stdout (collective).
+ * @see `ityr::memory_stats()`.
+ */
+inline void print_memory_stats() {
+  ITYR_CHECK(is_spmd());
+  ito::mem_stats_print();
+  ori::mem_stats_print();
+}
+
 /**
  * @brief Print the compile-time options to stdout.
  * @see `ityr::print_runtime_options()`.
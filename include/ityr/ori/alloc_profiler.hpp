@@ -0,0 +1,323 @@
+#pragma once
+
+#include <map>
+
+#include "ityr/common/util.hpp"
+#include "ityr/common/mpi_util.hpp"
+#include "ityr/common/topology.hpp"
+#include "ityr/ori/util.hpp"
+#include "ityr/ori/options.hpp"
+
+namespace ityr::ori {
+
+/**
+ * @brief Cache and communication statistics of each collective memory allocation.
+ */
+struct alloc_prof_result {
+  std::string label;                      ///< User label (see `ityr::ori::set_coll_label()`), or "(other)" for noncollective memory.
+  std::size_t size                   = 0; ///< Allocation size in bytes.
+  std::size_t requested_bytes        = 0; ///< Bytes requested for cache blocks.
+  std::size_t fetched_bytes          = 0; ///< Bytes fetched from remote processes.
+  std::size_t written_back_bytes     = 0; ///< Bytes written back to remote processes.
+  std::size_t block_hit_count        = 0; ///< Cache hits counted for each block.
+  std::size_t block_miss_count       = 0; ///< Cache misses counted for each block.
+  std::size_t home_requested_bytes   = 0; ///< Bytes requested for home segments.
+  std::size_t home_seg_hit_count     = 0; ///< Home segments already mapped.
+  std::size_t home_seg_miss_count    = 0; ///< Home segments newly mapped by mmap.
+  std::size_t remote_owner_count     = 0; ///< Remote processes accessed (summed over processes if reduced).
+
+  template <typename Fn>
+  void for_each_field(Fn&& fn) {
+    fn("size"                , size);
+    fn("requested_bytes"     , requested_bytes);
+    fn("fetched_bytes"       , fetched_bytes);
+    fn("written_back_bytes"  , written_back_bytes);
+    fn("block_hit_count"     , block_hit_count);
+    fn("block_miss_count"    , block_miss_count);
+    fn("home_requested_bytes", home_requested_bytes);
+    fn("home_seg_hit_count"  , home_seg_hit_count);
+    fn("home_seg_miss_count" , home_seg_miss_count);
+    fn("remote_owner_count"  , remote_owner_count);
+  }
+};
+
+class alloc_profiler_disabled {
+public:
+  alloc_profiler_disabled() {}
+  void register_alloc(void*, std::size_t) {}
+  void deregister_alloc(void*) {}
+  void set_label(void*, const std::string&) {}
+  void record_cache(const std::byte*, std::size_t, std::size_t, common::topology::rank_t) {}
+  void record_writeback(const std::byte*, std::size_t) {}
+  void record_home(const std::byte*, std::size_t, bool) {}
+  void record_home(std::byte*, std::size_t, std::byte*, std::size_t, bool) {}
+  void start() {}
+  void stop() {}
+  std::vector<alloc_prof_result> get_result() const { return {}; }
+  void print() const {}
+};
+
+/*
+ * Per-allocation statistics
+ *
+ * Collective memory allocations are registered in the same order in all processes, so that
+ * the statistics of the same allocation can be reduced by the registration order.
+ * Accesses to memory not registered here (i.e., noncollective memory) are accounted for the
+ * special entry at index 0. Statistics of freed allocations are kept until the next `start()`.
+ */
+class alloc_profiler_stats {
+public:
+  alloc_profiler_stats()
+    : n_owner_words_((common::topology::n_ranks() + 63) / 64) {
+    allocs_.emplace_back(nullptr, 0, "(other)", n_owner_words_);
+  }
+
+  void register_alloc(void* addr, std::size_t size) {
+    std::byte* addr_b = reinterpret_cast<std::byte*>(addr);
+    live_allocs_[addr_b] = allocs_.size();
+    allocs_.emplace_back(addr_b, size, "", n_owner_words_);
+    last_idx_ = 0;
+  }
+
+  void deregister_alloc(void* addr) {
+    auto it = live_allocs_.find(reinterpret_cast<std::byte*>(addr));
+    if (it != live_allocs_.end()) {
+      allocs_[it->second].freed = true;
+      live_allocs_.erase(it);
+    }
+    last_idx_ = 0;
+  }
+
+  void set_label(void* addr, const std::string& label) {
+    std::size_t idx = find(reinterpret_cast<std::byte*>(addr));
+    if (idx != 0) {
+      allocs_[idx].label = label;
+    }
+  }
+
+  void record_cache(const std::byte*         addr,
+                    std::size_t              requested_bytes,
+                    std::size_t              fetched_bytes,
+                    common::topology::rank_t owner) {
+    if (enabled_) {
+      alloc_entry& a = allocs_[find(addr)];
+      a.requested_bytes += requested_bytes;
+      a.fetched_bytes   += fetched_bytes;
+      if (fetched_bytes == 0) {
+        a.block_hit_count++;
+      } else {
+        a.block_miss_count++;
+      }
+      a.owners[owner / 64] |= uint64_t(1) << (owner % 64);
+    }
+  }
+
+  void record_writeback(const std::byte* addr, std::size_t bytes) {
+    if (enabled_) {
+      allocs_[find(addr)].written_back_bytes += bytes;
+    }
+  }
+
+  void record_home(const std::byte* addr, std::size_t bytes, bool hit) {
+    if (enabled_) {
+      alloc_entry& a = allocs_[find(addr)];
+      a.home_requested_bytes += bytes;
+      if (hit) {
+        a.home_seg_hit_count++;
+      } else {
+        a.home_seg_miss_count++;
+      }
+    }
+  }
+
+  void record_home(std::byte* seg_addr, std::size_t seg_size,
+                   std::byte* req_addr, std::size_t req_size, bool hit) {
+    std::byte* addr_b = std::max(seg_addr, req_addr);
+    std::byte* addr_e = std::min(seg_addr + seg_size, req_addr + req_size);
+    record_home(addr_b, addr_e - addr_b, hit);
+  }
+
+  void start() {
+    // Entries of freed allocations are no longer needed
+    std::vector<alloc_entry> allocs;
+    for (auto&& a : allocs_) {
+      if (!a.freed) {
+        allocs.emplace_back(a.addr, a.size, a.label, n_owner_words_);
+      }
+    }
+    allocs_ = std::move(allocs);
+
+    live_allocs_.clear();
+    for (std::size_t i = 1; i < allocs_.size(); i++) {
+      live_allocs_[allocs_[i].addr] = i;
+    }
+    last_idx_ = 0;
+
+    enabled_ = true;
+  }
+
+  void stop() {
+    enabled_ = false;
+  }
+
+  std::vector<alloc_prof_result> get_result() const {
+    std::vector<alloc_prof_result> ret;
+    for (std::size_t i = 0; i < allocs_.size(); i++) {
+      ret.push_back(to_result(i));
+    }
+    return ret;
+  }
+
+  void print() const {
+    constexpr std::size_t n_fields = 9;
+
+    std::vector<std::size_t> vals;
+    std::vector<uint64_t> owners;
+    for (std::size_t i = 0; i < allocs_.size(); i++) {
+      auto r = to_result(i);
+      std::size_t n = 0;
+      r.for_each_field([&](const char*, std::size_t v) {
+        if (n++ < n_fields) vals.push_back(v);
+      });
+      owners.insert(owners.end(), allocs_[i].owners.begin(), allocs_[i].owners.end());
+    }
+
+    std::vector<std::size_t> vals_all(vals.size());
+    std::vector<uint64_t> owners_all(owners.size());
+    common::mpi_reduce(vals.data(), vals_all.data(), vals.size(), 0, common::topology::mpicomm());
+    common::mpi_reduce(owners.data(), owners_all.data(), owners.size(), 0, common::topology::mpicomm(), MPI_BOR);
+
+    if (common::topology::my_rank() == 0) {
+      // Print allocations in descending order of communication volume
+      std::vector<std::size_t> order;
+      for (std::size_t i = 0; i < allocs_.size(); i++) {
+        const std::size_t* v = &vals_all[i * n_fields];
+        if (v[1] + v[6] > 0) order.push_back(i);
+      }
+      auto comm_bytes = [&](std::size_t i) { return vals_all[i * n_fields + 2] + vals_all[i * n_fields + 3]; };
+      std::stable_sort(order.begin(), order.end(),
+                       [&](std::size_t i, std::size_t j) { return comm_bytes(i) > comm_bytes(j); });
+
+      printf("[Allocations]\n");
+      printf("  %-20s %14s %14s %14s %8s %7s %10s %7s\n",
+             "Label", "Size", "Fetched", "Written back", "Hit", "Owners", "Home req", "mmap hit");
+      for (std::size_t i : order) {
+        const std::size_t* v = &vals_all[i * n_fields];
+        std::size_t n_owners = 0;
+        for (std::size_t w = 0; w < n_owner_words_; w++) {
+          n_owners += __builtin_popcountll(owners_all[i * n_owner_words_ + w]);
+        }
+        std::string label = allocs_[i].label.empty() ? "alloc" + std::to_string(i) : allocs_[i].label;
+        printf("  %-20s %14ld %14ld %14ld %7.2f%% %7ld %10ld %7.2f%%\n",
+               label.c_str(), allocs_[i].size, v[2], v[3],
+               v[4] + v[5] == 0 ? 0.0 : 100.0 * v[4] / (v[4] + v[5]),
+               n_owners, v[6],
+               v[7] + v[8] == 0 ? 0.0 : 100.0 * v[7] / (v[7] + v[8]));
+      }
+      printf("\n");
+      fflush(stdout);
+    }
+  }
+
+private:
+  struct alloc_entry {
+    std::byte*            addr;
+    std::size_t           size;
+    std::string           label;
+    bool                  freed                = false;
+    std::size_t           requested_bytes      = 0;
+    std::size_t           fetched_bytes        = 0;
+    std::size_t           written_back_bytes   = 0;
+    std::size_t           block_hit_count      = 0;
+    std::size_t           block_miss_count     = 0;
+    std::size_t           home_requested_bytes = 0;
+    std::size_t           home_seg_hit_count   = 0;
+    std::size_t           home_seg_miss_count  = 0;
+    std::vector<uint64_t> owners; // bitmap of remote processes
+
+    alloc_entry(std::byte* addr, std::size_t size, const std::string& label, std::size_t n_owner_words)
+      : addr(addr), size(size), label(label), owners(n_owner_words, 0) {}
+  };
+
+  std::size_t find(const std::byte* addr) {
+    // Consecutive accesses are likely to the same allocation
+    const alloc_entry& last = allocs_[last_idx_];
+    if (last_idx_ != 0 && last.addr <= addr && addr < last.addr + last.size) {
+      return last_idx_;
+    }
+
+    auto it = live_allocs_.upper_bound(const_cast<std::byte*>(addr));
+    if (it == live_allocs_.begin()) return 0;
+    --it;
+
+    const alloc_entry& a = allocs_[it->second];
+    if (addr < a.addr + a.size) {
+      last_idx_ = it->second;
+      return it->second;
+    }
+    return 0;
+  }
+
+  alloc_prof_result to_result(std::size_t i) const {
+    const alloc_entry& a = allocs_[i];
+    std::size_t n_owners = 0;
+    for (auto w : a.owners) {
+      n_owners += __builtin_popcountll(w);
+    }
+    return {a.label, a.size, a.requested_bytes, a.fetched_bytes, a.written_back_bytes,
+            a.block_hit_count, a.block_miss_count,
+            a.home_requested_bytes, a.home_seg_hit_count, a.home_seg_miss_count, n_owners};
+  }
+
+  std::size_t                        n_owner_words_;
+  std::vector<alloc_entry>           allocs_;
+  std::map<std::byte*, std::size_t>  live_allocs_;
+  std::size_t                        last_idx_ = 0;
+  bool                               enabled_  = false;
+};
+
+using alloc_profiler = ITYR_CONCAT(alloc_profiler_, ITYR_ORI_CACHE_PROF);
+
+ITYR_TEST_CASE("[ityr::ori::alloc_profiler] per-allocation attribution") {
+  common::runtime_options common_opts;
+  common::singleton_initializer<common::topology::instance> topo;
+
+  std::vector<std::byte> mem(1000);
+  std::byte* p1 = mem.data();
+  std::byte* p2 = mem.data() + 400;
+
+  alloc_profiler_stats ap;
+  ap.register_alloc(p1, 400);
+  ap.register_alloc(p2, 600);
+  ap.set_label(p2, "B");
+  ap.start();
+
+  ap.record_cache(p1 + 10, 8, 64, 0);
+  ap.record_cache(p1 + 20, 8, 0, 0);
+  ap.record_cache(p2 + 599, 1, 0, 0);
+  ap.record_writeback(p2, 32);
+  ap.record_home(p2 + 100, 16, false);
+  ap.record_cache(mem.data() + 1000, 4, 4, 0);
+
+  ap.deregister_alloc(p1);
+  ap.record_writeback(p1, 16); // not attributed to the freed allocation
+
+  auto r = ap.get_result();
+  ITYR_CHECK(r.size() == 3);
+  ITYR_CHECK(r[0].fetched_bytes == 4);
+  ITYR_CHECK(r[0].written_back_bytes == 16);
+  ITYR_CHECK(r[1].fetched_bytes == 64);
+  ITYR_CHECK(r[1].block_hit_count == 1);
+  ITYR_CHECK(r[1].block_miss_count == 1);
+  ITYR_CHECK(r[1].remote_owner_count == 1);
+  ITYR_CHECK(r[2].label == "B");
+  ITYR_CHECK(r[2].block_hit_count == 1);
+  ITYR_CHECK(r[2].written_back_bytes == 32);
+  ITYR_CHECK(r[2].home_seg_miss_count == 1);
+
+  // freed allocations are removed at the next start
+  ap.start();
+  ITYR_CHECK(ap.get_result().size() == 2);
+}
+
+}
@@ -10,6 +10,7 @@
 #include "ityr/common/rma.hpp"
 #include "ityr/common/virtual_mem.hpp"
 #include "ityr/common/physical_mem.hpp"
+#include "ityr/common/sampling.hpp"
 #include "ityr/ori/util.hpp"
 #include "ityr/ori/options.hpp"
 #include "ityr/ori/prof_events.hpp"
@@ -18,31 +19,39 @@
 #include "ityr/ori/tlb.hpp"
 #include "ityr/ori/release_manager.hpp"
 #include "ityr/ori/cache_profiler.hpp"
+#include "ityr/ori/alloc_profiler.hpp"
+#include "ityr/ori/compressed_view.hpp"
 
 namespace ityr::ori {
 
-template <block_size_t BlockSize>
+template <block_size_t BlockSize, int TLBSize = ITYR_ORI_CACHE_TLB_SIZE>
 class cache_manager {
   static constexpr bool enable_write_through = ITYR_ORI_ENABLE_WRITE_THROUGH;
   static constexpr bool enable_lazy_release = ITYR_ORI_ENABLE_LAZY_RELEASE;
   static constexpr bool enable_vm_map = ITYR_ORI_ENABLE_VM_MAP;
 
 public:
-  cache_manager(std::size_t cache_size, std::size_t sub_block_size)
+  cache_manager(std::size_t cache_size, std::size_t sub_block_size, alloc_profiler& aprof)
     : cache_size_(cache_size),
       sub_block_size_(sub_block_size),
-      vm_(cache_size_, BlockSize),
+      vm_(cache_size_, std::max(std::size_t(BlockSize), common::hugepage_alignment())),
       pm_(init_cache_pm()),
       cs_(cache_size / BlockSize, cache_block(this)),
       cache_win_(common::rma::create_win(reinterpret_cast<std::byte*>(vm_.addr()), vm_.size())),
       cache_tlb_(nullptr, nullptr),
       max_dirty_cache_blocks_(max_dirty_cache_size_option::value() / BlockSize),
-      cprof_(cs_.num_entries()) {
+      cprof_(cs_.num_entries()),
+      aprof_(aprof) {
     ITYR_CHECK(cache_size_ > 0);
     ITYR_CHECK(common::is_pow2(cache_size_));
     ITYR_CHECK(cache_size_ % BlockSize == 0);
     ITYR_CHECK(common::is_pow2(sub_block_size_));
     ITYR_CHECK(sub_block_size_ <= BlockSize);
+
+    pinned_usage_.capacity = cs_.num_entries();
+    dirty_usage_.capacity  = max_dirty_cache_blocks_ * BlockSize;
+
+    common::topology::check_numa_placement("the software cache", vm_.addr(), vm_.size());
   }
 
   // return [entry_found, fetch_completed]
@@ -73,7 +82,10 @@ public:
 
     if constexpr (SkipFetch) {
       cprof_.record_writeonly(cb.entry_idx, br, cb.valid_regions);
+      aprof_.record_cache(cb.addr + br.begin, br.size(), 0, cb.owner);
       cb.valid_regions.add(br);
+      // write-only checkout never fetches; counted as a hit (read checkouts are counted in fetch_begin())
+      common::sampling::count(common::sampling::counter::cache_hit);
     } else {
       if (fetch_begin(cb, br)) {
         add_fetching_win(*cb.win);
@@ -83,7 +95,7 @@ public:
 
     if constexpr (IncrementRef) {
       ITYR_CHECK(cb.ref_count >= 0);
-      cb.ref_count++;
+      if (cb.ref_count++ == 0) pinned_usage_.add(1);
     }
 
     return {true, fetch_completed};
@@ -106,7 +118,8 @@ public:
 
     bool checkout_completed = true;
 
-    if (blk_addr != cb.mapped_addr) {
+    bool blk_cached = blk_addr == cb.mapped_addr;
+    if (!blk_cached) {
       cb.addr      = blk_addr;
       cb.win       = &win;
       cb.owner     = owner;
@@ -123,7 +136,10 @@ public:
 
     if constexpr (SkipFetch) {
       cprof_.record_writeonly(cb.entry_idx, br, cb.valid_regions);
+      aprof_.record_cache(cb.addr + br.begin, br.size(), 0, cb.owner);
       cb.valid_regions.add(br);
+      common::sampling::count(blk_cached ? common::sampling::counter::cache_hit
+                                         : common::sampling::counter::cache_miss);
     } else {
       if (fetch_begin(cb, br)) {
         add_fetching_win(win);
@@ -133,7 +149,7 @@ public:
 
     if constexpr (IncrementRef) {
       ITYR_CHECK(cb.ref_count >= 0);
-      cb.ref_count++;
+      if (cb.ref_count++ == 0) pinned_usage_.add(1);
     }
 
     cache_tlb_.add(blk_addr, &cb);
@@ -145,14 +161,119 @@ public:
     // Overlap communication and memory remapping
     if constexpr (enable_vm_map) {
       if (!cache_blocks_to_map_.empty()) {
-        for (cache_block* cb : cache_blocks_to_map_) {
-          update_mapping(*cb);
-        }
+        update_mappings(cache_blocks_to_map_);
         cache_blocks_to_map_.clear();
       }
     }
 
     fetch_complete();
+
+    if (!transparent_blocks_to_protect_.empty()) {
+      protect_transparent_blocks();
+    }
+  }
+
+  /*
+   * Transparent access: cache blocks are directly accessed without checkout/checkin calls.
+   * A block in a transparent region is fetched as a whole and kept referenced while it is accessible.
+   * It is first mapped read-only; on the first write (a protection fault), a twin (copy) of the
+   * block is created and it becomes writable. Modified bytes are found by comparing the block
+   * with its twin at release fences, and at acquire fences all blocks are protected again
+   * so that subsequent accesses fetch the latest data.
+   */
+  template <bool Write>
+  bool checkout_transparent_blk(std::byte*               blk_addr,
+                                const common::rma::win&  win,
+                                common::topology::rank_t owner,
+                                std::size_t              pm_offset) {
+    cache_block& cb = get_entry(blk_addr);
+
+    if (cb.tstate == transparent_state::none) {
+      checkout_blk<false, true>(blk_addr, blk_addr, blk_addr + BlockSize, win, owner, pm_offset);
+      cb.tstate = Write ? transparent_state::write : transparent_state::read;
+      transparent_blocks_.push_back(&cb);
+      transparent_blocks_to_protect_.push_back(&cb);
+      has_writable_transparent_ |= Write;
+      return false;
+
+    } else if (Write && cb.tstate == transparent_state::read) {
+      cb.tstate = transparent_state::write;
+      transparent_blocks_to_protect_.push_back(&cb);
+      has_writable_transparent_ = true;
+      return false;
+    }
+
+    return true;
+  }
+
+  // Returns false if the fault was not caused by transparent access (e.g., the block is already writable)
+  bool transparent_fault(std::byte*               blk_addr,
+                         const common::rma::win&  win,
+                         common::topology::rank_t owner,
+                         std::size_t              pm_offset) {
+    if (is_cached(blk_addr)) {
+      switch (get_entry<false>(blk_addr).tstate) {
+        case transparent_state::write: return false;
+        // a read-only block was written
+        case transparent_state::read:  return !checkout_transparent_blk<true>(blk_addr, win, owner, pm_offset);
+        default: break;
+      }
+    }
+    return !checkout_transparent_blk<false>(blk_addr, win, owner, pm_offset);
+  }
+
+  // Allocate the bookkeeping buffers for transparent access in advance, so that
+  // servicing a fault does not need to allocate memory
+  void init_transparent() {
+    std::size_t max_blocks = cs_.num_entries() / 2;
+    transparent_blocks_.reserve(max_blocks);
+    // a block can be queued twice (on the first access and on the first write)
+    transparent_blocks_to_protect_.reserve(2 * max_blocks);
+    if (!twins_) {
+      twins_ = std::make_unique<std::byte[]>(cache_size_);
+    }
+  }
+
+  // Protect and release all blocks for transparent access if new `n_blocks` blocks would exceed the limit
+  void ensure_transparent_capacity(std::size_t n_blocks) {
+    if (transparent_blocks_to_protect_.empty() &&
+        transparent_blocks_.size() + n_blocks > std::size_t(cs_.num_entries() / 2)) {
+      flush_transparent_dirty();
+      drop_transparent_blocks();
+    }
+  }
+
+  // Register modified bytes of writable blocks as dirty and make them read-only again
+  void flush_transparent_dirty() {
+    ITYR_CHECK(transparent_blocks_to_protect_.empty());
+    // skip the scan if no block has become writable since the last flush
+    if (!has_writable_transparent_) return;
+
+    for (cache_block* cb : transparent_blocks_) {
+      if (cb->tstate == transparent_state::write) {
+        diff_twin(*cb);
+        cb->tstate = transparent_state::read;
+        transparent_blocks_to_protect_.push_back(cb);
+      }
+    }
+    mprotect_blocks(transparent_blocks_to_protect_.begin(), transparent_blocks_to_protect_.end(), PROT_READ);
+    transparent_blocks_to_protect_.clear();
+    has_writable_transparent_ = false;
+  }
+
+  // Make all blocks for transparent access inaccessible and release their references
+  void drop_transparent_blocks() {
+    if (transparent_blocks_.empty()) return;
+    release_transparent_blocks(transparent_blocks_.begin(), transparent_blocks_.end());
+    transparent_blocks_.clear();
+  }
+
+  // Same as above, but only for blocks within [addr_b, addr_e)
+  void drop_transparent_blocks(std::byte* addr_b, std::byte* addr_e) {
+    auto it = std::partition(transparent_blocks_.begin(), transparent_blocks_.end(),
+                             [=](const cache_block* cb) { return cb->addr < addr_b || addr_e <= cb->addr; });
+    release_transparent_blocks(it, transparent_blocks_.end());
+    transparent_blocks_.erase(it, transparent_blocks_.end());
   }
 
   template <bool RegisterDirty, bool DecrementRef>
@@ -182,7 +303,7 @@ public:
     }
 
     if constexpr (DecrementRef) {
-      cb.ref_count--;
+      if (--cb.ref_count == 0) pinned_usage_.sub(1);
       ITYR_CHECK(cb.ref_count >= 0);
     }
 
@@ -207,13 +328,15 @@ public:
     }
 
     if constexpr (DecrementRef) {
-      cb.ref_count--;
+      if (--cb.ref_count == 0) pinned_usage_.sub(1);
       ITYR_CHECK(cb.ref_count >= 0);
     }
   }
 
   void release() {
     ITYR_PROFILER_RECORD(prof_event_release);
+    common::sampling::count(common::sampling::counter::release);
+    flush_transparent_dirty();
     ensure_all_cache_clean();
   }
 
@@ -221,6 +344,8 @@ public:
 
   auto release_lazy() {
     if constexpr (enable_lazy_release) {
+      common::sampling::count(common::sampling::counter::release);
+      flush_transparent_dirty();
       if (has_dirty_cache_) {
         return rm_.get_release_handler();
       } else {
@@ -234,17 +359,23 @@ public:
 
   void acquire() {
     ITYR_PROFILER_RECORD(prof_event_acquire);
+    common::sampling::count(common::sampling::counter::acquire);
 
     // FIXME: no need to writeback dirty data here?
+    flush_transparent_dirty();
     ensure_all_cache_clean();
+    drop_transparent_blocks();
     invalidate_all();
   }
 
   template <typename ReleaseHandler>
   void acquire(ReleaseHandler rh) {
     ITYR_PROFILER_RECORD(prof_event_acquire);
+    common::sampling::count(common::sampling::counter::acquire);
 
+    flush_transparent_dirty();
     ensure_all_cache_clean();
+    drop_transparent_blocks();
     if constexpr (enable_lazy_release) {
       rm_.ensure_released(rh);
     }
@@ -261,11 +392,23 @@ public:
                               reinterpret_cast<uintptr_t>(addr) + size});
   }
 
+  void register_compressed_view(const compressed_view<BlockSize>& cv) {
+    compressed_views_.push_back(&cv);
+  }
+
+  void unregister_compressed_view(const compressed_view<BlockSize>& cv) {
+    ITYR_CHECK(pending_decodes_.empty());
+    auto it = std::find(compressed_views_.begin(), compressed_views_.end(), &cv);
+    ITYR_CHECK(it != compressed_views_.end());
+    compressed_views_.erase(it);
+  }
+
   void poll() {
     if constexpr (enable_lazy_release) {
       if (rm_.release_requested()) {
         ITYR_PROFILER_RECORD(prof_event_release_lazy);
 
+        flush_transparent_dirty();
         ensure_all_cache_clean();
         ITYR_CHECK(!rm_.release_requested());
       }
@@ -303,7 +446,9 @@ public:
       }
 
       block_region br = {req_addr_b - blk_addr, req_addr_e - blk_addr};
+      dirty_usage_.sub(cb.dirty_regions.size());
       cb.dirty_regions.remove(br);
+      dirty_usage_.add(cb.dirty_regions.size());
     }
   }
 
@@ -347,13 +492,29 @@ public:
     std::memcpy(to_addr, from_addr, req_addr_e - req_addr_b);
   }
 
+  // Cache blocks holding data (including clean ones that can be evicted)
+  const common::mem_usage& block_usage() const { return cs_.usage(); }
+
+  // Cache blocks that cannot be evicted because they are checked out
+  const common::mem_usage& pinned_usage() const { return pinned_usage_; }
+
+  // Dirty bytes not yet written back
+  const common::mem_usage& dirty_usage() const { return dirty_usage_; }
+
   void cache_prof_begin() { invalidate_all(); cprof_.start(); }
   void cache_prof_end() { cprof_.stop(); }
   void cache_prof_print() const { cprof_.print(); }
+  cache_prof_result cache_prof_get_result() const { return cprof_.get_result(); }
 
 private:
   using writeback_epoch_t = uint64_t;
 
+  enum class transparent_state {
+    none,  // not accessible by transparent access
+    read,  // read-only
+    write, // writable (with a twin)
+  };
+
   struct cache_block {
     cache_entry_idx_t        entry_idx       = std::numeric_limits<cache_entry_idx_t>::max();
     std::byte*               addr            = nullptr;
@@ -365,6 +526,7 @@ private:
     writeback_epoch_t        writeback_epoch = 0;
     block_region_set         valid_regions;
     block_region_set         dirty_regions;
+    transparent_state        tstate          = transparent_state::none;
     cache_manager*           outer;
 
     explicit cache_block(cache_manager* outer_p) : outer(outer_p) {}
@@ -413,8 +575,12 @@ private:
   }
 
   common::physical_mem init_cache_pm() {
-    common::physical_mem pm(cache_shmem_name(common::topology::my_rank()), vm_.size(), true);
+    // cache blocks are remapped one by one
+    common::validate_hugepage_granularity(BlockSize, "the block size (ITYR_ORI_BLOCK_SIZE)");
+    common::physical_mem pm(cache_shmem_name(common::topology::my_rank()), vm_.size(), true, true);
     pm.map_to_vm(vm_.addr(), vm_.size(), 0);
+    // The policy is shared with the mappings at global addresses, as the cache is on shared memory
+    common::topology::numa_bind_local(vm_.addr(), vm_.size());
     return pm;
   }
 
@@ -441,26 +607,153 @@ private:
       try {
         return cs_.template ensure_cached<UpdateLRU>(cache_key(addr));
       } catch (cache_full_exception& e) {
-        common::die("cache is exhausted (too much checked-out memory)");
+        common::die("cache is exhausted (too much checked-out memory: %ld/%ld blocks are checked out); "
+                    "consider increasing ITYR_ORI_CACHE_SIZE", pinned_usage_.current, pinned_usage_.capacity);
       }
     }
   }
 
-  void update_mapping(cache_block& cb) {
+  /*
+   * Remap cache blocks with as few mmap calls as possible. Blocks that are virtually contiguous and
+   * also contiguous in the cache (physical memory) are mapped by a single mmap call, and previous
+   * mappings are unmapped in contiguous runs.
+   */
+  void update_mappings(std::vector<cache_block*>& cbs) {
     ITYR_PROFILER_RECORD(prof_event_cache_mmap);
 
+    std::sort(cbs.begin(), cbs.end(),
+              [](const cache_block* cb1, const cache_block* cb2) { return cb1->addr < cb2->addr; });
+    cbs.erase(std::unique(cbs.begin(), cbs.end()), cbs.end());
+
+    std::size_t n_syscalls = 0;
+
     // save the number of mmap entries by unmapping previous virtual memory
-    if (cb.mapped_addr) {
-      common::verbose<3>("Unmap cache block %d from [%p, %p) (size=%ld)",
-                         cb.entry_idx, cb.mapped_addr, cb.mapped_addr + BlockSize, BlockSize);
-      common::mmap_no_physical_mem(cb.mapped_addr, BlockSize, true);
+    unmap_addrs_.clear();
+    for (cache_block* cb : cbs) {
+      // Skip if the address is (or is going to be) mapped by another cache block
+      if (cb->mapped_addr && cb->mapped_addr != cb->addr &&
+          !cs_.is_cached(cache_key(cb->mapped_addr))) {
+        unmap_addrs_.push_back(cb->mapped_addr);
+      }
+    }
+    std::sort(unmap_addrs_.begin(), unmap_addrs_.end());
+
+    for (auto it = unmap_addrs_.begin(); it != unmap_addrs_.end();) {
+      std::byte* addr_b = *it;
+      std::byte* addr_e = addr_b + BlockSize;
+      for (++it; it != unmap_addrs_.end() && *it == addr_e; ++it) {
+        addr_e += BlockSize;
+      }
+      common::verbose<3>("Unmap cache blocks from [%p, %p) (size=%ld)",
+                         addr_b, addr_e, addr_e - addr_b);
+      common::mmap_no_physical_mem(addr_b, addr_e - addr_b, true);
+      n_syscalls++;
     }
 
-    ITYR_CHECK(cb.addr);
-    common::verbose<3>("Map cache block %d to [%p, %p) (size=%ld)",
-                       cb.entry_idx, cb.addr, cb.addr + BlockSize, BlockSize);
-    pm_.map_to_vm(cb.addr, BlockSize, cb.entry_idx * BlockSize);
-    cb.mapped_addr = cb.addr;
+    for (auto it = cbs.begin(); it != cbs.end();) {
+      cache_block& cb_b = **it;
+      std::size_t n_blocks = 1;
+      for (++it; it != cbs.end() &&
+                 (*it)->addr == cb_b.addr + n_blocks * BlockSize &&
+                 (*it)->entry_idx == cb_b.entry_idx + cache_entry_idx_t(n_blocks); ++it) {
+        n_blocks++;
+      }
+      ITYR_CHECK(cb_b.addr);
+      common::verbose<3>("Map cache blocks %d-%d to [%p, %p) (size=%ld)",
+                         cb_b.entry_idx, cb_b.entry_idx + n_blocks - 1,
+                         cb_b.addr, cb_b.addr + n_blocks * BlockSize, n_blocks * BlockSize);
+      pm_.map_to_vm(cb_b.addr, n_blocks * BlockSize, cb_b.entry_idx * BlockSize);
+      n_syscalls++;
+    }
+
+    for (cache_block* cb : cbs) {
+      cb->mapped_addr = cb->addr;
+    }
+
+    cprof_.record_remap(n_syscalls, cbs.size());
+  }
+
+  std::byte* cache_view(const cache_block& cb) const {
+    return reinterpret_cast<std::byte*>(vm_.addr()) + cb.entry_idx * BlockSize;
+  }
+
+  std::byte* twin(const cache_block& cb) {
+    if (!twins_) {
+      twins_ = std::make_unique<std::byte[]>(cache_size_);
+    }
+    return twins_.get() + cb.entry_idx * BlockSize;
+  }
+
+  void protect_transparent_blocks() {
+    // Blocks to be writable get twins after their data are fetched
+    auto it = std::partition(transparent_blocks_to_protect_.begin(), transparent_blocks_to_protect_.end(),
+                             [](const cache_block* cb) { return cb->tstate == transparent_state::read; });
+    for (auto it2 = it; it2 != transparent_blocks_to_protect_.end(); ++it2) {
+      std::memcpy(twin(**it2), cache_view(**it2), BlockSize);
+    }
+
+    mprotect_blocks(transparent_blocks_to_protect_.begin(), it, PROT_READ);
+    mprotect_blocks(it, transparent_blocks_to_protect_.end(), PROT_READ | PROT_WRITE);
+    transparent_blocks_to_protect_.clear();
+  }
+
+  template <typename Iterator>
+  void release_transparent_blocks(Iterator first, Iterator last) {
+    mprotect_blocks(first, last, PROT_NONE);
+    for (auto it = first; it != last; ++it) {
+      cache_block* cb = *it;
+      ITYR_CHECK(cb->tstate == transparent_state::read);
+      cb->tstate = transparent_state::none;
+      if (--cb->ref_count == 0) pinned_usage_.sub(1);
+      ITYR_CHECK(cb->ref_count >= 0);
+    }
+  }
+
+  // Change the protection of blocks with as few mprotect calls as possible
+  template <typename Iterator>
+  void mprotect_blocks(Iterator first, Iterator last, int prot) {
+    std::sort(first, last,
+              [](const cache_block* cb1, const cache_block* cb2) { return cb1->addr < cb2->addr; });
+
+    for (auto it = first; it != last;) {
+      std::byte* addr_b = (*it)->addr;
+      std::byte* addr_e = addr_b + BlockSize;
+      for (++it; it != last && (*it)->addr == addr_e; ++it) {
+        addr_e += BlockSize;
+      }
+      ITYR_CHECK(addr_b);
+      if (mprotect(addr_b, addr_e - addr_b, prot) == -1) {
+        perror("mprotect");
+        common::die("[ityr::ori::cache_manager] mprotect(%p, %lu, %d) failed", addr_b, addr_e - addr_b, prot);
+      }
+    }
+  }
+
+  // Register bytes that differ from the twin as dirty
+  void diff_twin(cache_block& cb) {
+    const std::byte* cur = cache_view(cb);
+    const std::byte* old = twin(cb);
+
+    block_size_t i = 0;
+    while (i < BlockSize) {
+      // skip unmodified words quickly
+      while (i + sizeof(uint64_t) <= BlockSize &&
+             std::memcmp(cur + i, old + i, sizeof(uint64_t)) == 0) {
+        i += sizeof(uint64_t);
+      }
+      if (i >= BlockSize) break;
+
+      if (cur[i] == old[i]) {
+        i++;
+        continue;
+      }
+
+      block_size_t b = i;
+      while (i < BlockSize && cur[i] != old[i]) {
+        i++;
+      }
+      add_dirty_region(cb, {b, i});
+    }
   }
 
   bool fetch_begin(cache_block& cb, block_region br) {
@@ -469,9 +762,18 @@ private:
     if (cb.valid_regions.include(br)) {
       // fast path (the requested region is already fetched)
       cprof_.record(cb.entry_idx, br, {});
+      aprof_.record_cache(cb.addr + br.begin, br.size(), 0, cb.owner);
+      common::sampling::count(common::sampling::counter::cache_hit);
       return false;
     }
 
+    common::sampling::count(common::sampling::counter::cache_miss);
+
+    if (!compressed_views_.empty() && cb.dirty_regions.empty() &&
+        fetch_compressed_begin(cb, br)) {
+      return true;
+    }
+
     block_region br_pad = pad_fetch_region(br);
 
     std::byte* cache_begin = reinterpret_cast<std::byte*>(vm_.addr());
@@ -491,16 +793,22 @@ private:
                          cb.entry_idx, cb.owner, cb.win, pm_offset);
 
       common::rma::get_nb(*cache_win_, addr, size, *cb.win, cb.owner, pm_offset);
+      common::sampling::count(common::sampling::counter::fetched_bytes, size);
     }
 
     cb.valid_regions.add(br_pad);
 
     cprof_.record(cb.entry_idx, br, fetch_regions);
+    aprof_.record_cache(cb.addr + br.begin, br.size(), fetch_regions.size(), cb.owner);
 
     return true;
   }
 
   void fetch_complete() {
+    if (fetching_wins_.empty() && pending_decodes_.empty()) return;
+
+    ITYR_PROFILER_RECORD(prof_event_cache_fetch_comp);
+
     if (!fetching_wins_.empty()) {
       for (const common::rma::win* win : fetching_wins_) {
         // TODO: remove duplicates
@@ -509,6 +817,61 @@ private:
       }
       fetching_wins_.clear();
     }
+
+    if (!pending_decodes_.empty()) {
+      std::byte* cache_begin = reinterpret_cast<std::byte*>(vm_.addr());
+      for (auto [cb, cv, staging_offset] : pending_decodes_) {
+        decompress_block(cv->get_codec(), staging_buf_.get() + staging_offset,
+                         cache_begin + cb->entry_idx * BlockSize, BlockSize);
+      }
+      pending_decodes_.clear();
+      staging_used_ = 0;
+    }
+  }
+
+  // Fetch the whole block in compressed form if it belongs to a compressed view.
+  // The block is decoded into the cache in `fetch_complete()`.
+  bool fetch_compressed_begin(cache_block& cb, block_region br) {
+    auto it = std::find_if(compressed_views_.begin(), compressed_views_.end(),
+                           [&](const compressed_view<BlockSize>* cv) { return cv->contains(cb.addr); });
+    if (it == compressed_views_.end()) {
+      return false;
+    }
+
+    const compressed_view<BlockSize>* cv = *it;
+    auto e = cv->entry(cb.addr, cb.owner, cb.pm_offset);
+    if (e.size == 0) {
+      // incompressible block
+      cprof_.record_compress_bypass();
+      return false;
+    }
+
+    if (!staging_buf_) {
+      staging_buf_ = std::make_unique<std::byte[]>(cache_size_);
+    }
+
+    if (staging_used_ + e.size > cache_size_) {
+      // The staging buffer cannot be full unless blocks are fetched without checking in
+      fetch_complete();
+    }
+
+    common::verbose<3>("Fetching [%p, %p) in compressed form (%ld bytes) to cache block %d from rank %d",
+                       cb.addr, cb.addr + BlockSize, e.size, cb.entry_idx, e.rank);
+
+    common::rma::get_nb(staging_buf_.get() + staging_used_, e.size, cv->win(), e.rank, e.offset);
+    common::sampling::count(common::sampling::counter::fetched_bytes, e.size);
+    add_fetching_win(cv->win());
+    pending_decodes_.push_back({&cb, cv, staging_used_});
+    staging_used_ += e.size;
+
+    block_region_set fetch_regions = cb.valid_regions.complement({0, BlockSize});
+    cb.valid_regions.add({0, BlockSize});
+
+    cprof_.record(cb.entry_idx, br, fetch_regions);
+    cprof_.record_compressed(BlockSize, e.size);
+    aprof_.record_cache(cb.addr + br.begin, br.size(), e.size, e.rank);
+
+    return true;
   }
 
   void add_fetching_win(const common::rma::win& win) {
@@ -521,7 +884,9 @@ private:
   void add_dirty_region(cache_block& cb, block_region br) {
     bool is_new_dirty_block = cb.dirty_regions.empty();
 
+    std::size_t prev_dirty_size = cb.dirty_regions.size();
     cb.dirty_regions.add(br);
+    dirty_usage_.add(cb.dirty_regions.size() - prev_dirty_size);
 
     if (is_new_dirty_block) {
       dirty_cache_blocks_.push_back(&cb);
@@ -568,8 +933,11 @@ private:
                          cb.owner, cb.win, pm_offset);
 
       common::rma::put_nb(*cache_win_, addr, size, *cb.win, cb.owner, pm_offset);
+      common::sampling::count(common::sampling::counter::written_back_bytes, size);
+      aprof_.record_writeback(cb.addr + blk_offset_b, size);
     }
 
+    dirty_usage_.sub(cb.dirty_regions.size());
     cb.dirty_regions.clear();
 
     cb.writeback_epoch = writeback_epoch_;
@@ -579,6 +947,8 @@ private:
 
   void writeback_complete() {
     if (!writing_back_wins_.empty()) {
+      ITYR_PROFILER_RECORD(prof_event_cache_writeback_comp);
+
       // sort | uniq
       // FIXME: costly?
       std::sort(writing_back_wins_.begin(), writing_back_wins_.end());
@@ -634,7 +1004,7 @@ private:
     }
   }
 
-  using cache_tlb = tlb<std::byte*, cache_block*, ITYR_ORI_CACHE_TLB_SIZE>;
+  using cache_tlb = tlb<std::byte*, cache_block*, TLBSize>;
 
   std::size_t                            cache_size_;
   block_size_t                           sub_block_size_;
@@ -642,7 +1012,7 @@ private:
   common::virtual_mem                    vm_;
   common::physical_mem                   pm_;
 
-  cache_system<cache_key_t, cache_block> cs_;
+  cache_system<cache_key_t, cache_block, true> cs_;
 
   std::unique_ptr<common::rma::win>      cache_win_;
 
@@ -650,6 +1020,12 @@ private:
 
   std::vector<const common::rma::win*>   fetching_wins_;
   std::vector<cache_block*>              cache_blocks_to_map_;
+  std::vector<std::byte*>                unmap_addrs_;
+
+  std::vector<cache_block*>              transparent_blocks_;
+  std::vector<cache_block*>              transparent_blocks_to_protect_;
+  bool                                   has_writable_transparent_ = false;
+  std::unique_ptr<std::byte[]>           twins_;
 
   std::vector<cache_block*>              dirty_cache_blocks_;
   std::size_t                            max_dirty_cache_blocks_;
@@ -670,7 +1046,22 @@ private:
 
   region_set<uintptr_t>                  readonly_regions_;
 
+  struct pending_decode {
+    cache_block*                      cb;
+    const compressed_view<BlockSize>* cv;
+    std::size_t                       staging_offset;
+  };
+
+  std::vector<const compressed_view<BlockSize>*> compressed_views_;
+  std::vector<pending_decode>            pending_decodes_;
+  std::unique_ptr<std::byte[]>           staging_buf_;
+  std::size_t                            staging_used_ = 0;
+
+  common::mem_usage                      pinned_usage_;
+  common::mem_usage                      dirty_usage_;
+
   cache_profiler                         cprof_;
+  alloc_profiler&                        aprof_;
 };
 
 }
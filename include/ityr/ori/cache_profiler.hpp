@@ -10,14 +10,55 @@
 
 namespace ityr::ori {
 
+/**
+ * @brief Cache statistics (see `cache_profiler_stats` for the meaning of each field).
+ */
+struct cache_prof_result {
+  bool        enabled                      = false; ///< False if the cache profiler is disabled at compile time.
+  std::size_t requested_bytes              = 0;
+  std::size_t fetched_bytes                = 0;
+  std::size_t wasted_fetched_bytes         = 0;
+  std::size_t temporal_hit_bytes           = 0;
+  std::size_t spatial_hit_bytes            = 0;
+  std::size_t skip_fetch_hit_bytes         = 0;
+  std::size_t block_hit_count              = 0;
+  std::size_t block_miss_count             = 0;
+  std::size_t remap_syscall_count          = 0;
+  std::size_t remap_block_count            = 0;
+  std::size_t compressed_raw_bytes         = 0;
+  std::size_t compressed_transferred_bytes = 0;
+  std::size_t compress_bypass_count        = 0;
+
+  template <typename Fn>
+  void for_each_field(Fn&& fn) {
+    fn("requested_bytes"             , requested_bytes);
+    fn("fetched_bytes"               , fetched_bytes);
+    fn("wasted_fetched_bytes"        , wasted_fetched_bytes);
+    fn("temporal_hit_bytes"          , temporal_hit_bytes);
+    fn("spatial_hit_bytes"           , spatial_hit_bytes);
+    fn("skip_fetch_hit_bytes"        , skip_fetch_hit_bytes);
+    fn("block_hit_count"             , block_hit_count);
+    fn("block_miss_count"            , block_miss_count);
+    fn("remap_syscall_count"         , remap_syscall_count);
+    fn("remap_block_count"           , remap_block_count);
+    fn("compressed_raw_bytes"        , compressed_raw_bytes);
+    fn("compressed_transferred_bytes", compressed_transferred_bytes);
+    fn("compress_bypass_count"       , compress_bypass_count);
+  }
+};
+
 class cache_profiler_disabled {
 public:
   cache_profiler_disabled(cache_entry_idx_t) {}
   void record(cache_entry_idx_t, block_region, const block_region_set&) {}
   void record_writeonly(cache_entry_idx_t, block_region, const block_region_set&) {}
   void invalidate(cache_entry_idx_t, const block_region_set&) {}
+  void record_remap(std::size_t, std::size_t) {}
+  void record_compressed(std::size_t, std::size_t) {}
+  void record_compress_bypass() {}
   void start() {}
   void stop() {}
+  cache_prof_result get_result() const { return {}; }
   void print() const {}
 };
 
@@ -98,6 +139,26 @@ public:
     blk.requested_regions.clear();
   }
 
+  void record_remap(std::size_t n_syscalls, std::size_t n_blocks) {
+    if (enabled_) {
+      remap_syscall_count_ += n_syscalls;
+      remap_block_count_   += n_blocks;
+    }
+  }
+
+  void record_compressed(std::size_t raw_bytes, std::size_t transferred_bytes) {
+    if (enabled_) {
+      compressed_raw_bytes_         += raw_bytes;
+      compressed_transferred_bytes_ += transferred_bytes;
+    }
+  }
+
+  void record_compress_bypass() {
+    if (enabled_) {
+      compress_bypass_count_++;
+    }
+  }
+
   void start() {
     requested_bytes_      = 0;
     fetched_bytes_        = 0;
@@ -107,6 +168,12 @@ public:
     skip_fetch_hit_bytes_ = 0;
     block_hit_count_      = 0;
     block_miss_count_     = 0;
+    remap_syscall_count_  = 0;
+    remap_block_count_    = 0;
+
+    compressed_raw_bytes_         = 0;
+    compressed_transferred_bytes_ = 0;
+    compress_bypass_count_        = 0;
 
     enabled_ = true;
   }
@@ -115,6 +182,15 @@ public:
     enabled_ = false;
   }
 
+  cache_prof_result get_result() const {
+    return {true,
+            requested_bytes_, fetched_bytes_, wasted_fetched_bytes_,
+            temporal_hit_bytes_, spatial_hit_bytes_, skip_fetch_hit_bytes_,
+            block_hit_count_, block_miss_count_,
+            remap_syscall_count_, remap_block_count_,
+            compressed_raw_bytes_, compressed_transferred_bytes_, compress_bypass_count_};
+  }
+
   void print() const {
     auto requested_bytes_all      = common::mpi_reduce_value(requested_bytes_     , 0, common::topology::mpicomm());
     auto fetched_bytes_all        = common::mpi_reduce_value(fetched_bytes_       , 0, common::topology::mpicomm());
@@ -124,6 +200,11 @@ public:
     auto skip_fetch_hit_bytes_all = common::mpi_reduce_value(skip_fetch_hit_bytes_, 0, common::topology::mpicomm());
     auto block_hit_count_all      = common::mpi_reduce_value(block_hit_count_     , 0, common::topology::mpicomm());
     auto block_miss_count_all     = common::mpi_reduce_value(block_miss_count_    , 0, common::topology::mpicomm());
+    auto remap_syscall_count_all  = common::mpi_reduce_value(remap_syscall_count_ , 0, common::topology::mpicomm());
+    auto remap_block_count_all    = common::mpi_reduce_value(remap_block_count_   , 0, common::topology::mpicomm());
+    auto compressed_raw_bytes_all         = common::mpi_reduce_value(compressed_raw_bytes_        , 0, common::topology::mpicomm());
+    auto compressed_transferred_bytes_all = common::mpi_reduce_value(compressed_transferred_bytes_, 0, common::topology::mpicomm());
+    auto compress_bypass_count_all        = common::mpi_reduce_value(compress_bypass_count_       , 0, common::topology::mpicomm());
 
     if (common::topology::my_rank() == 0) {
       printf("[Cache blocks]\n");
@@ -135,6 +216,15 @@ public:
       printf("  Skip-fetch hit:   %18ld bytes\n" , skip_fetch_hit_bytes_all);
       printf("  Hit count:        %18ld blocks\n", block_hit_count_all);
       printf("  Miss count:       %18ld blocks\n", block_miss_count_all);
+      printf("  Remapped:         %18ld blocks\n", remap_block_count_all);
+      printf("  Remap syscalls:   %18ld\n"       , remap_syscall_count_all);
+      if (compressed_raw_bytes_all > 0 || compress_bypass_count_all > 0) {
+        printf("  Compressed fetch: %18ld bytes (%ld bytes transferred, ratio %.3f)\n",
+               compressed_raw_bytes_all, compressed_transferred_bytes_all,
+               compressed_raw_bytes_all > 0 ?
+                 double(compressed_transferred_bytes_all) / compressed_raw_bytes_all : 0.0);
+        printf("  Compress bypass:  %18ld blocks\n", compress_bypass_count_all);
+      }
       printf("\n");
       fflush(stdout);
     }
@@ -156,6 +246,11 @@ private:
   std::size_t              skip_fetch_hit_bytes_ = 0; // cache hit for write-only data (skipping remote fetch)
   std::size_t              block_hit_count_      = 0; // Cache hits counted for each block
   std::size_t              block_miss_count_     = 0; // Cache misses counted for each block
+  std::size_t              remap_syscall_count_  = 0; // mmap calls issued to remap cache blocks
+  std::size_t              remap_block_count_    = 0; // Cache blocks remapped to different virtual addresses
+  std::size_t              compressed_raw_bytes_         = 0; // uncompressed size of blocks fetched in compressed form
+  std::size_t              compressed_transferred_bytes_ = 0; // bytes actually transferred for compressed blocks
+  std::size_t              compress_bypass_count_        = 0; // blocks in compressed views fetched without compression
 
   bool                     enabled_ = false;
 };
@@ -10,6 +10,7 @@
 #include <iterator>
 
 #include "ityr/common/util.hpp"
+#include "ityr/common/mem_usage.hpp"
 
 #if __has_include(<ankerl/unordered_dense.h>)
 #include <ankerl/unordered_dense.h>
@@ -31,7 +32,12 @@ using cache_entry_idx_t = int;
 
 class cache_full_exception : public std::exception {};
 
-template <typename Key, typename Entry>
+/*
+ * If `PreferContiguousSlots` is true, a newly cached key is assigned the slot next to the one for
+ * the preceding key (`key - 1`) if that slot is free or has not been used recently, so that
+ * consecutive keys tend to occupy consecutive slots (e.g., to coalesce memory mappings).
+ */
+template <typename Key, typename Entry, bool PreferContiguousSlots = false>
 class cache_system {
 public:
   cache_system(cache_entry_idx_t nentries) : cache_system(nentries, Entry{}) {}
@@ -40,10 +46,15 @@ public:
       entry_initial_state_(e),
       entries_(init_entries()),
       lru_(init_lru()),
-      table_(init_table()) {}
+      table_(init_table()) {
+    usage_.capacity = nentries_;
+  }
 
   cache_entry_idx_t num_entries() const { return nentries_; }
 
+  // Number of entries in use
+  const common::mem_usage& usage() const { return usage_; }
+
   bool is_cached(Key key) const {
     return table_.find(key) != table_.end();
   }
@@ -52,7 +63,7 @@ public:
   Entry& ensure_cached(Key key) {
     auto it = table_.find(key);
     if (it == table_.end()) {
-      cache_entry_idx_t idx = get_empty_slot();
+      cache_entry_idx_t idx = get_empty_slot(key);
       cache_entry& ce = entries_[idx];
 
       ce.entry.on_cache_map(idx);
@@ -60,6 +71,7 @@ public:
       ce.allocated = true;
       ce.key = key;
       table_[key] = idx;
+      usage_.add(1);
       if constexpr (UpdateLRU) {
         move_to_back_lru(ce);
       }
@@ -85,6 +97,7 @@ public:
       ce.entry = entry_initial_state_;
       table_.erase(key);
       ce.allocated = false;
+      usage_.sub(1);
     }
   }
 
@@ -104,6 +117,7 @@ private:
     Entry                                           entry;
     cache_entry_idx_t                               idx = std::numeric_limits<cache_entry_idx_t>::max();
     typename std::list<cache_entry_idx_t>::iterator lru_it;
+    uint64_t                                        last_access = 0;
 
     cache_entry(const Entry& e) : entry(e) {}
   };
@@ -136,12 +150,28 @@ private:
   }
 
   void move_to_back_lru(cache_entry& ce) {
+    if constexpr (PreferContiguousSlots) {
+      ce.last_access = ++access_count_;
+    }
     lru_.splice(lru_.end(), lru_, ce.lru_it);
     ITYR_CHECK(std::prev(lru_.end()) == ce.lru_it);
     ITYR_CHECK(*ce.lru_it == ce.idx);
   }
 
-  cache_entry_idx_t get_empty_slot() {
+  cache_entry_idx_t get_empty_slot(Key key) {
+    if constexpr (PreferContiguousSlots) {
+      auto it = table_.find(key - 1);
+      if (it != table_.end() && it->second + 1 < nentries_) {
+        cache_entry& ce = entries_[it->second + 1];
+        // Do not evict entries in the recently used half of the LRU list
+        if (!ce.allocated ||
+            (ce.entry.is_evictable() && access_count_ - ce.last_access >= uint64_t(nentries_ / 2))) {
+          if (ce.allocated) evict(ce);
+          return ce.idx;
+        }
+      }
+    }
+
     // FIXME: Performance issue?
     for (const auto& idx : lru_) {
       cache_entry& ce = entries_[idx];
@@ -149,21 +179,28 @@ private:
         return ce.idx;
       }
       if (ce.entry.is_evictable()) {
-        Key prev_key = ce.key;
-        table_.erase(prev_key);
-        ce.entry.on_evict();
-        ce.allocated = false;
+        evict(ce);
         return ce.idx;
       }
     }
     throw cache_full_exception{};
   }
 
+  void evict(cache_entry& ce) {
+    Key prev_key = ce.key;
+    table_.erase(prev_key);
+    ce.entry.on_evict();
+    ce.allocated = false;
+    usage_.sub(1);
+  }
+
   cache_entry_idx_t                     nentries_;
   Entry                                 entry_initial_state_;
   std::vector<cache_entry>              entries_; // index (cache_entry_idx_t) -> entry (cache_entry)
   std::list<cache_entry_idx_t>          lru_; // front (oldest) <----> back (newest)
   unordered_map<Key, cache_entry_idx_t> table_; // hash table (Key -> cache_entry_idx_t)
+  uint64_t                              access_count_ = 0;
+  common::mem_usage                     usage_;
 };
 
 ITYR_TEST_CASE("[ityr::ori::cache_system] testing cache system") {
@@ -266,4 +303,39 @@ ITYR_TEST_CASE("[ityr::ori::cache_system] testing cache system") {
   }
 }
 
+
+ITYR_TEST_CASE("[ityr::ori::cache_system] contiguous slots") {
+  using key_t = int;
+  struct test_entry {
+    cache_entry_idx_t entry_idx = std::numeric_limits<cache_entry_idx_t>::max();
+
+    bool is_evictable() const { return true; }
+    void on_evict() {}
+    void on_cache_map(cache_entry_idx_t idx) { entry_idx = idx; }
+  };
+
+  int nelems = 100;
+  cache_system<key_t, test_entry, true> cs(nelems);
+
+  for (key_t k = 0; k < nelems; k++) {
+    ITYR_CHECK(cs.ensure_cached(k).entry_idx == k);
+  }
+
+  // The slot next to the preceding key is chosen rather than the least recently used one
+  cs.ensure_evicted(11);
+  ITYR_CHECK(cs.ensure_cached(11).entry_idx == 11);
+  ITYR_CHECK(cs.is_cached(0));
+
+  // Entries that are not recently used can be evicted to keep slots contiguous
+  ITYR_CHECK(cs.ensure_cached(1000).entry_idx == 0);
+  ITYR_CHECK(cs.ensure_cached(1001).entry_idx == 1);
+  ITYR_CHECK(!cs.is_cached(1));
+
+  // Recently used entries are not evicted
+  cs.ensure_cached(2);
+  ITYR_CHECK(cs.ensure_cached(5000).entry_idx == 3);
+  ITYR_CHECK(cs.ensure_cached(1002).entry_idx == 4);
+  ITYR_CHECK(cs.is_cached(2));
+}
+
 }
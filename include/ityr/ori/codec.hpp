@@ -0,0 +1,202 @@
+#pragma once
+
+#include <cstring>
+
+#include "ityr/common/util.hpp"
+#include "ityr/ori/util.hpp"
+
+namespace ityr::ori {
+
+/**
+ * @brief Block codecs for compressed transfers of collective memory.
+ *
+ * Both codecs work on 8-byte words, and thus they assume that the data are 8-byte aligned
+ * (e.g., arrays of 8-byte integers or doubles).
+ *
+ * - `codec::zero_words`: only nonzero words are stored with a bitmap of nonzero words
+ *   (suitable for sparse arrays, e.g., floats with many zeros)
+ * - `codec::delta`: differences between consecutive words are stored as variable-length integers
+ *   (suitable for integer arrays with small deltas, e.g., sorted indices)
+ */
+enum class codec {
+  none,
+  zero_words,
+  delta,
+};
+
+inline std::string str(codec c) {
+  switch (c) {
+    case codec::none:       return "none";
+    case codec::zero_words: return "zero_words";
+    case codec::delta:      return "delta";
+  }
+  return "unknown";
+}
+
+namespace codec_impl {
+
+inline uint64_t load_word(const std::byte* p) {
+  uint64_t w;
+  std::memcpy(&w, p, sizeof(w));
+  return w;
+}
+
+inline void store_word(std::byte* p, uint64_t w) {
+  std::memcpy(p, &w, sizeof(w));
+}
+
+inline std::size_t compress_zero_words(const std::byte* src, std::size_t size,
+                                       std::byte* dst, std::size_t max_size) {
+  std::size_t n_words     = size / sizeof(uint64_t);
+  std::size_t bitmap_size = (n_words + 7) / 8;
+  if (bitmap_size > max_size) return 0;
+
+  std::memset(dst, 0, bitmap_size);
+  std::size_t out = bitmap_size;
+
+  for (std::size_t i = 0; i < n_words; i++) {
+    uint64_t w = load_word(src + i * sizeof(uint64_t));
+    if (w != 0) {
+      if (out + sizeof(uint64_t) > max_size) return 0;
+      dst[i / 8] |= std::byte(1 << (i % 8));
+      store_word(dst + out, w);
+      out += sizeof(uint64_t);
+    }
+  }
+  return out;
+}
+
+inline void decompress_zero_words(const std::byte* src, std::byte* dst, std::size_t size) {
+  std::size_t n_words     = size / sizeof(uint64_t);
+  std::size_t bitmap_size = (n_words + 7) / 8;
+  const std::byte* in = src + bitmap_size;
+
+  for (std::size_t i = 0; i < n_words; i++) {
+    if (std::to_integer<int>(src[i / 8]) & (1 << (i % 8))) {
+      std::memcpy(dst + i * sizeof(uint64_t), in, sizeof(uint64_t));
+      in += sizeof(uint64_t);
+    } else {
+      store_word(dst + i * sizeof(uint64_t), 0);
+    }
+  }
+}
+
+inline std::size_t compress_delta(const std::byte* src, std::size_t size,
+                                  std::byte* dst, std::size_t max_size) {
+  std::size_t n_words = size / sizeof(uint64_t);
+  std::size_t out = 0;
+  uint64_t prev = 0;
+
+  for (std::size_t i = 0; i < n_words; i++) {
+    uint64_t w = load_word(src + i * sizeof(uint64_t));
+    int64_t  d = static_cast<int64_t>(w - prev);
+    prev = w;
+
+    // zigzag encoding so that small negative deltas are also short
+    uint64_t z = (static_cast<uint64_t>(d) << 1) ^ static_cast<uint64_t>(d >> 63);
+
+    // LEB128
+    do {
+      if (out >= max_size) return 0;
+      uint8_t b = z & 0x7f;
+      z >>= 7;
+      dst[out++] = std::byte(z ? (b | 0x80) : b);
+    } while (z);
+  }
+  return out;
+}
+
+inline void decompress_delta(const std::byte* src, std::byte* dst, std::size_t size) {
+  std::size_t n_words = size / sizeof(uint64_t);
+  const std::byte* in = src;
+  uint64_t prev = 0;
+
+  for (std::size_t i = 0; i < n_words; i++) {
+    uint64_t z = 0;
+    int shift = 0;
+    uint8_t b;
+    do {
+      b = std::to_integer<uint8_t>(*in++);
+      z |= uint64_t(b & 0x7f) << shift;
+      shift += 7;
+    } while (b & 0x80);
+
+    int64_t d = static_cast<int64_t>(z >> 1) ^ -static_cast<int64_t>(z & 1);
+    prev += static_cast<uint64_t>(d);
+    store_word(dst + i * sizeof(uint64_t), prev);
+  }
+}
+
+}
+
+/*
+ * Compress `size` bytes at `src` into `dst` (at most `max_size` bytes).
+ * Returns the compressed size, or 0 if the compressed data would not fit in `max_size` bytes
+ * (i.e., the data are incompressible and should be transferred without compression).
+ */
+inline std::size_t compress_block(codec c, const std::byte* src, std::size_t size,
+                                  std::byte* dst, std::size_t max_size) {
+  ITYR_CHECK(size % sizeof(uint64_t) == 0);
+  switch (c) {
+    case codec::zero_words: return codec_impl::compress_zero_words(src, size, dst, max_size);
+    case codec::delta:      return codec_impl::compress_delta(src, size, dst, max_size);
+    default:                return 0;
+  }
+}
+
+inline void decompress_block(codec c, const std::byte* src, std::byte* dst, std::size_t size) {
+  ITYR_CHECK(size % sizeof(uint64_t) == 0);
+  switch (c) {
+    case codec::zero_words: codec_impl::decompress_zero_words(src, dst, size); break;
+    case codec::delta:      codec_impl::decompress_delta(src, dst, size); break;
+    default:                common::die("[ityr::ori::codec] invalid codec");
+  }
+}
+
+ITYR_TEST_CASE("[ityr::ori::codec] compress and decompress blocks") {
+  constexpr std::size_t n = 4096;
+  std::vector<uint64_t> src(n);
+  std::vector<std::byte> buf(n * sizeof(uint64_t));
+  std::vector<uint64_t> dst(n);
+
+  auto roundtrip = [&](codec c) {
+    std::size_t s = compress_block(c, reinterpret_cast<const std::byte*>(src.data()), n * sizeof(uint64_t),
+                                   buf.data(), buf.size());
+    if (s > 0) {
+      decompress_block(c, buf.data(), reinterpret_cast<std::byte*>(dst.data()), n * sizeof(uint64_t));
+      ITYR_CHECK(dst == src);
+    }
+    return s;
+  };
+
+  ITYR_SUBCASE("sparse") {
+    for (std::size_t i = 0; i < n; i++) {
+      double v = (i % 17 == 0) ? i * 0.5 : 0.0;
+      std::memcpy(&src[i], &v, sizeof(double));
+    }
+    std::size_t s = roundtrip(codec::zero_words);
+    ITYR_CHECK(s > 0);
+    ITYR_CHECK(s < n * sizeof(uint64_t) / 8);
+  }
+
+  ITYR_SUBCASE("small deltas") {
+    for (std::size_t i = 0; i < n; i++) {
+      src[i] = 1000000 + i * 3 - (i % 5);
+    }
+    std::size_t s = roundtrip(codec::delta);
+    ITYR_CHECK(s > 0);
+    ITYR_CHECK(s < n * sizeof(uint64_t) / 4);
+  }
+
+  ITYR_SUBCASE("incompressible") {
+    uint64_t x = 88172645463325252ull;
+    for (std::size_t i = 0; i < n; i++) {
+      x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+      src[i] = x;
+    }
+    ITYR_CHECK(roundtrip(codec::zero_words) == 0);
+    ITYR_CHECK(roundtrip(codec::delta) == 0);
+  }
+}
+
+}
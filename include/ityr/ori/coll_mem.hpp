@@ -1,5 +1,9 @@
 #pragma once
 
+#include <optional>
+#include <sys/vfs.h>
+#include <linux/magic.h>
+
 #include "ityr/common/util.hpp"
 #include "ityr/common/mpi_util.hpp"
 #include "ityr/common/topology.hpp"
@@ -7,25 +11,105 @@
 #include "ityr/common/rma.hpp"
 #include "ityr/common/virtual_mem.hpp"
 #include "ityr/common/physical_mem.hpp"
+#include "ityr/ori/options.hpp"
 #include "ityr/ori/mem_mapper.hpp"
 
 namespace ityr::ori {
 
 using coll_mem_id_t = uint64_t;
 
+/*
+ * Backing file of file-backed collective memory.
+ * While mapped, the file is extended to the effective size (a multiple of the block size) so that
+ * every home segment has a file region; it is truncated to the requested size at destruction.
+ */
+class coll_mem_file {
+public:
+  coll_mem_file() {}
+  coll_mem_file(const std::string& fpath, std::size_t size, std::size_t effective_size)
+    : fpath_(fpath), size_(size) {
+    if (common::topology::my_rank() == 0) {
+      int fd = open(fpath_.c_str(), O_RDWR | O_CREAT, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+      if (fd == -1) {
+        perror("open");
+        common::die("[ityr::ori::coll_mem_file] open(%s) failed", fpath_.c_str());
+      }
+      if (ftruncate(fd, effective_size) == -1) {
+        perror("ftruncate");
+        common::die("[ityr::ori::coll_mem_file] ftruncate(%s, %lu) failed", fpath_.c_str(), effective_size);
+      }
+      close(fd);
+    }
+    common::mpi_barrier(common::topology::mpicomm());
+  }
+
+  ~coll_mem_file() { destroy(); }
+
+  coll_mem_file(const coll_mem_file&) = delete;
+  coll_mem_file& operator=(const coll_mem_file&) = delete;
+
+  coll_mem_file(coll_mem_file&& cmf) : fpath_(std::move(cmf.fpath_)), size_(cmf.size_) { cmf.fpath_.clear(); }
+  coll_mem_file& operator=(coll_mem_file&& cmf) {
+    destroy();
+    fpath_ = std::move(cmf.fpath_);
+    size_  = cmf.size_;
+    cmf.fpath_.clear();
+    return *this;
+  }
+
+  bool enabled() const { return !fpath_.empty(); }
+  const std::string& path() const { return fpath_; }
+
+private:
+  void destroy() {
+    if (enabled()) {
+      // wait for all processes to unmap the file
+      common::mpi_barrier(common::topology::mpicomm());
+      if (common::topology::my_rank() == 0 && truncate(fpath_.c_str(), size_) == -1) {
+        perror("truncate");
+        common::die("[ityr::ori::coll_mem_file] truncate(%s, %lu) failed", fpath_.c_str(), size_);
+      }
+    }
+  }
+
+  std::string fpath_;
+  std::size_t size_ = 0;
+};
+
+struct scratch_backed_t {};
+inline constexpr scratch_backed_t scratch_backed;
+
 class coll_mem {
 public:
   coll_mem(std::size_t                       size,
            coll_mem_id_t                     id,
            std::unique_ptr<mem_mapper::base> mmapper)
-    : size_(size),
-      id_(id),
-      mmapper_(std::move(mmapper)),
-      vm_(common::reserve_same_vm_coll(mmapper_->effective_size(), mmapper_->block_size())),
-      home_pm_(init_intra_home_pm()),
-      home_vm_(init_intra_home_vm()),
-      win_(common::rma::create_win(reinterpret_cast<std::byte*>(home_vm().addr()), home_vm().size())),
-      home_all_mapped_(map_ahead_of_time()) {}
+    : coll_mem(size, id, std::move(mmapper), coll_mem_file{}, false) {}
+
+  /*
+   * Out-of-core collective memory: the home segments of each process are backed by a scratch file
+   * in `ITYR_ORI_SCRATCH_DIR` (`/var/tmp` by default), instead of shared memory. As file pages can
+   * be written back to the storage and evicted by the OS, the total size can exceed the physical
+   * memory capacity. This does not hold if the scratch directory is on tmpfs (e.g., `/tmp` on some
+   * systems), for which a warning is printed. Also, RDMA transports may register (pin) the home segments exposed
+   * as the RMA window, which prevents the OS from evicting their pages.
+   */
+  coll_mem(std::size_t                       size,
+           coll_mem_id_t                     id,
+           std::unique_ptr<mem_mapper::base> mmapper,
+           scratch_backed_t)
+    : coll_mem(size, id, std::move(mmapper), coll_mem_file{}, true) {}
+
+  /*
+   * File-backed collective memory: the home segments of each process are mapped (`MAP_SHARED`)
+   * to its slice of the file, so that writebacks from caches are directly stored to the file.
+   */
+  coll_mem(std::size_t                       size,
+           coll_mem_id_t                     id,
+           std::unique_ptr<mem_mapper::base> mmapper,
+           const std::string&                fpath)
+    : coll_mem(size, id, std::move(mmapper),
+               coll_mem_file(fpath, size, mmapper->effective_size()), false) {}
 
   coll_mem(coll_mem&&) = default;
   coll_mem& operator=(coll_mem&&) = default;
@@ -35,6 +119,8 @@ public:
   std::size_t local_size() const { return home_vm().size(); }
   std::size_t effective_size() const { return vm_.size(); }
   bool home_all_mapped() const { return home_all_mapped_; }
+  bool file_backed() const { return file_.enabled(); }
+  bool scratch_backed() const { return scratch_; }
 
   const mem_mapper::base& mem_mapper() const { return *mmapper_; }
 
@@ -50,18 +136,120 @@ public:
 
   const common::rma::win& win() const { return *win_; }
 
+  /*
+   * Synchronously write the file region of the local home segments to the storage.
+   */
+  void sync_file() const {
+    ITYR_CHECK(file_backed());
+    if (home_pm_.file_backed() && common::topology::intra_my_rank() == 0) {
+      if (msync(home_vm_.addr(), home_vm_.size(), MS_SYNC) == -1) {
+        perror("msync");
+        common::die("[ityr::ori::coll_mem] msync(%p, %lu) failed", home_vm_.addr(), home_vm_.size());
+      }
+    }
+  }
+
 private:
+  // `mmapper` is taken by reference so that other arguments can safely use it before it is moved
+  coll_mem(std::size_t                         size,
+           coll_mem_id_t                       id,
+           std::unique_ptr<mem_mapper::base>&& mmapper,
+           coll_mem_file&&                     file,
+           bool                                scratch)
+    : file_(std::move(file)),
+      scratch_(scratch),
+      size_(size),
+      id_(id),
+      mmapper_(std::move(mmapper)),
+      vm_(common::reserve_same_vm_coll(mmapper_->effective_size(),
+                                       std::max(mmapper_->block_size(), common::hugepage_alignment()))),
+      home_pm_(init_intra_home_pm()),
+      home_vm_(init_intra_home_vm()),
+      win_(common::rma::create_win(reinterpret_cast<std::byte*>(home_vm().addr()), home_vm().size())),
+      home_all_mapped_(map_ahead_of_time()) {}
+
   static std::string home_shmem_name(coll_mem_id_t id, int inter_rank) {
     std::stringstream ss;
     ss << "/ityr_ori_coll_mem_" << id << "_" << inter_rank;
     return ss.str();
   }
 
+  static void warn_if_scratch_on_tmpfs() {
+    static bool warned = false;
+    if (warned || common::topology::intra_my_rank() != 0) return;
+    warned = true;
+
+    struct statfs sfs;
+    const std::string& dir = scratch_dir_option::value();
+    if (statfs(dir.c_str(), &sfs) == 0 && sfs.f_type == TMPFS_MAGIC) {
+      fprintf(stderr, "[ityr::ori::coll_mem] Warning: the scratch directory %s for out-of-core memory is on tmpfs, "
+                      "which resides in memory. Set ITYR_ORI_SCRATCH_DIR to a directory on storage.\n",
+              dir.c_str());
+    }
+  }
+
+  static std::string scratch_file_name(coll_mem_id_t id, int inter_rank, int leader_pid) {
+    std::stringstream ss;
+    ss << scratch_dir_option::value() << "/ityr_ori_coll_mem_" << leader_pid << "_" << id << "_" << inter_rank;
+    return ss.str();
+  }
+
   common::physical_mem init_intra_home_pm() const {
+    if (file_backed()) {
+      // Each process maps its slice of the file, which must be contiguous
+      std::optional<std::size_t> file_offset;
+      std::size_t offset = 0;
+      while (offset < size_) {
+        auto seg = mmapper_->get_segment(offset);
+        if (seg.owner == common::topology::inter_my_rank()) {
+          if (file_offset.has_value() && *file_offset != seg.offset_b - seg.pm_offset) {
+            common::die("[ityr::ori::coll_mem] File-backed memory requires a memory mapper that "
+                        "assigns a contiguous range to each process (e.g., block)");
+          }
+          file_offset = seg.offset_b - seg.pm_offset;
+        }
+        offset = seg.offset_e;
+      }
+
+      if (file_offset.has_value()) {
+        return common::physical_mem::from_file(file_.path(),
+                                               mmapper_->local_size(common::topology::inter_my_rank()),
+                                               *file_offset);
+      }
+      // Fall back to anonymous shared memory if no segment is assigned to this process
+    }
+
+    if (scratch_) {
+      warn_if_scratch_on_tmpfs();
+
+      // The scratch file is unlinked as soon as all intra-node processes open it, so that it is
+      // removed even if the program is aborted
+      int leader_pid = common::mpi_bcast_value(int(getpid()), 0, common::topology::intra_mpicomm());
+      std::string fpath = scratch_file_name(id_, common::topology::inter_my_rank(), leader_pid);
+      std::size_t local_size = mmapper_->local_size(common::topology::inter_my_rank());
+
+      if (common::topology::intra_my_rank() == 0) {
+        auto pm = common::physical_mem::from_file(fpath, local_size, 0, true);
+        common::mpi_barrier(common::topology::intra_mpicomm());
+        common::mpi_barrier(common::topology::intra_mpicomm());
+        unlink(fpath.c_str());
+        return pm;
+
+      } else {
+        common::mpi_barrier(common::topology::intra_mpicomm());
+        auto pm = common::physical_mem::from_file(fpath, local_size, 0);
+        common::mpi_barrier(common::topology::intra_mpicomm());
+        return pm;
+      }
+    }
+
+    // home segments are mapped in units of blocks
+    common::validate_hugepage_granularity(mmapper_->block_size(), "the block size of collective memory");
+
     if (common::topology::intra_my_rank() == 0) {
       common::physical_mem pm(home_shmem_name(id_, common::topology::inter_my_rank()),
                               mmapper_->local_size(common::topology::inter_my_rank()),
-                              true);
+                              true, true);
       common::mpi_barrier(common::topology::intra_mpicomm());
       return pm;
 
@@ -69,18 +257,18 @@ private:
       common::mpi_barrier(common::topology::intra_mpicomm());
       common::physical_mem pm(home_shmem_name(id_, common::topology::inter_my_rank()),
                               mmapper_->local_size(common::topology::inter_my_rank()),
-                              false);
+                              false, true);
       return pm;
     }
   }
 
   common::virtual_mem init_intra_home_vm() const {
-    common::virtual_mem vm(home_pm_.size(), mmapper_->block_size());
+    common::virtual_mem vm(home_pm_.size(), std::max(mmapper_->block_size(), common::hugepage_alignment()));
     home_pm_.map_to_vm(vm.addr(), vm.size(), 0);
 
     common::mpi_barrier(common::topology::intra_mpicomm());
 
-    if (common::topology::numa_enabled()) {
+    if (common::topology::numa_enabled() && !home_pm_.file_backed()) {
       std::size_t pm_offset = 0;
       while (pm_offset < vm.size()) {
         auto numa_seg = mmapper_->get_numa_segment(common::topology::inter_my_rank(), pm_offset);
@@ -127,6 +315,8 @@ private:
     return false;
   }
 
+  coll_mem_file                     file_; // destroyed last
+  bool                              scratch_;
   std::size_t                       size_;
   coll_mem_id_t                     id_;
   std::unique_ptr<mem_mapper::base> mmapper_;
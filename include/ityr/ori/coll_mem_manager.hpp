@@ -1,6 +1,7 @@
 #pragma once
 
 #include "ityr/common/util.hpp"
+#include "ityr/common/mem_usage.hpp"
 #include "ityr/ori/util.hpp"
 #include "ityr/ori/mem_mapper.hpp"
 #include "ityr/ori/coll_mem.hpp"
@@ -20,14 +21,19 @@ public:
     common::die("Address %p was passed but not allocated by Itoyori", addr);
   }
 
-  coll_mem& create(std::size_t size, std::unique_ptr<mem_mapper::base> mmapper) {
+  template <typename... Args>
+  coll_mem& create(std::size_t size, std::unique_ptr<mem_mapper::base> mmapper, Args&&... args) {
     coll_mem_id_t id = coll_mems_.size();
 
-    coll_mem& cm = *coll_mems_.emplace_back(std::in_place, size, id, std::move(mmapper));
+    coll_mem& cm = *coll_mems_.emplace_back(std::in_place, size, id, std::move(mmapper),
+                                            std::forward<Args>(args)...);
     std::byte* raw_ptr = reinterpret_cast<std::byte*>(cm.vm().addr());
 
     coll_mem_ids_.emplace_back(std::make_tuple(raw_ptr, raw_ptr + size, id));
 
+    usage_.add(cm.size());
+    home_usage_.add(cm.local_size());
+
     return cm;
   }
 
@@ -38,12 +44,23 @@ public:
     ITYR_CHECK(it != coll_mem_ids_.end());
     coll_mem_ids_.erase(it);
 
+    usage_.sub(cm.size());
+    home_usage_.sub(cm.local_size());
+
     coll_mems_[cm.id()].reset();
   }
 
+  // Total size of allocated collective memory
+  const common::mem_usage& usage() const { return usage_; }
+
+  // Size of home segments of collective memory in this node
+  const common::mem_usage& home_usage() const { return home_usage_; }
+
 private:
   std::vector<std::optional<coll_mem>>                 coll_mems_;
   std::vector<std::tuple<void*, void*, coll_mem_id_t>> coll_mem_ids_;
+  common::mem_usage                                    usage_;
+  common::mem_usage                                    home_usage_;
 };
 
 }
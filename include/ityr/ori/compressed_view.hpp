@@ -0,0 +1,163 @@
+#pragma once
+
+#include <cstring>
+#include <limits>
+
+#include "ityr/common/util.hpp"
+#include "ityr/common/mpi_util.hpp"
+#include "ityr/common/topology.hpp"
+#include "ityr/common/logger.hpp"
+#include "ityr/common/rma.hpp"
+#include "ityr/ori/util.hpp"
+#include "ityr/ori/codec.hpp"
+
+namespace ityr::ori {
+
+/*
+ * Compressed snapshot of a read-only range of collective memory.
+ *
+ * As RMA operations are one-sided, owners cannot compress data on demand for each fetch.
+ * Instead, while a range is read-only, its home blocks are compressed once by the processes
+ * that have them locally, and the compressed data are exposed through another RMA window.
+ * Cache misses on the range then fetch compressed blocks and decode them into cache blocks.
+ *
+ * Blocks whose compressed size exceeds `max_ratio` of the block size are not compressed
+ * (bypassed) and fetched as usual from home memory.
+ *
+ * The index of compressed blocks is distributed: each process exposes the (size, offset) entries
+ * of the blocks it compressed at the beginning of its window, and a fetcher reads the entry with
+ * a small get before fetching the compressed data.
+ */
+template <block_size_t BlockSize>
+class compressed_view {
+public:
+  struct local_block {
+    std::size_t      pm_blk; // index of the block in the home physical memory of this node
+    const std::byte* src;    // local address of the home block
+  };
+
+  struct block_entry {
+    std::size_t              size;   // compressed size (0 if bypassed)
+    common::topology::rank_t rank;   // rank that holds the compressed data
+    std::size_t              offset; // offset in the window of `rank`
+  };
+
+  // Collective; `local_blocks` are all home blocks of the view in this node
+  compressed_view(std::byte*                      addr,
+                  std::size_t                     n_blocks,
+                  codec                           c,
+                  const std::vector<local_block>& local_blocks)
+    : addr_(addr), n_blocks_(n_blocks), codec_(c) {
+    std::size_t max_size = BlockSize / 8 * max_ratio_x8;
+
+    std::size_t pm_blk_begin = std::numeric_limits<std::size_t>::max();
+    for (auto&& lb : local_blocks) {
+      pm_blk_begin = std::min(pm_blk_begin, lb.pm_blk);
+    }
+
+    // Home blocks in this node are compressed by intra-node processes in a round-robin manner.
+    // The index of each process is placed at the beginning of its window, followed by the data.
+    auto intra_rank    = common::topology::intra_my_rank();
+    auto intra_n_ranks = common::topology::intra_n_ranks();
+
+    std::vector<std::pair<std::size_t, const std::byte*>> my_blocks; // (slot in the index, src)
+    for (auto&& lb : local_blocks) {
+      std::size_t i = lb.pm_blk - pm_blk_begin;
+      if (i % intra_n_ranks == std::size_t(intra_rank)) {
+        my_blocks.emplace_back(i / intra_n_ranks, lb.src);
+      }
+    }
+
+    std::size_t n_slots = 0;
+    for (auto [slot, src] : my_blocks) {
+      n_slots = std::max(n_slots, slot + 1);
+    }
+
+    std::size_t index_bytes = n_slots * sizeof(index_entry);
+    buf_.resize(index_bytes);
+
+    std::size_t n_compressed = 0;
+    for (auto [slot, src] : my_blocks) {
+      std::size_t offset = buf_.size();
+      buf_.resize(offset + max_size);
+      std::size_t s = compress_block(codec_, src, BlockSize, buf_.data() + offset, max_size);
+      buf_.resize(offset + s);
+      if (s > 0) {
+        index_entry ie = {s, offset};
+        std::memcpy(buf_.data() + slot * sizeof(index_entry), &ie, sizeof(index_entry));
+        n_compressed++;
+      }
+    }
+    std::size_t compressed_bytes = buf_.size() - index_bytes;
+
+    // Only the first home block of each node and the processes of each node are replicated,
+    // so that the compressor of a block can be computed from its home location
+    node_pm_blk_begin_ = common::mpi_allgather_value(uint64_t(pm_blk_begin), common::topology::mpicomm());
+    auto n_ranks = common::topology::n_ranks();
+    node_ranks_.resize(common::topology::inter_n_ranks());
+    for (common::topology::rank_t r = 0; r < n_ranks; r++) {
+      auto& nr = node_ranks_[common::topology::inter_rank(r)];
+      auto ir = common::topology::intra_rank(r);
+      if (nr.size() <= std::size_t(ir)) nr.resize(ir + 1);
+      nr[ir] = r;
+    }
+
+    buf_.resize(std::max(buf_.size(), sizeof(uint64_t)));
+    win_ = common::rma::create_win(buf_.data(), buf_.size());
+
+    common::verbose("Compressed view [%p, %p) (codec=%s): %ld/%ld blocks compressed by this process (%ld -> %ld bytes)",
+                    addr_, addr_ + n_blocks_ * BlockSize, str(codec_).c_str(),
+                    n_compressed, my_blocks.size(), n_compressed * BlockSize, compressed_bytes);
+  }
+
+  compressed_view(const compressed_view&) = delete;
+  compressed_view& operator=(const compressed_view&) = delete;
+
+  std::byte* addr() const { return addr_; }
+  std::size_t size() const { return n_blocks_ * BlockSize; }
+  codec get_codec() const { return codec_; }
+  const common::rma::win& win() const { return *win_; }
+
+  bool contains(const std::byte* blk_addr) const {
+    return addr_ <= blk_addr && blk_addr < addr_ + n_blocks_ * BlockSize;
+  }
+
+  // Read the index entry of the block from the process that compressed it (blocking).
+  // `owner` and `pm_offset` are the home location of the block, as used for raw fetches.
+  block_entry entry(const std::byte*         blk_addr,
+                    common::topology::rank_t owner,
+                    std::size_t              pm_offset) const {
+    ITYR_CHECK(contains(blk_addr));
+    ITYR_CHECK(pm_offset % BlockSize == 0);
+
+    auto inter_rank = common::topology::inter_rank(owner);
+    const auto& nr = node_ranks_[inter_rank];
+
+    std::size_t i = pm_offset / BlockSize - node_pm_blk_begin_[owner];
+    auto rank = nr[i % nr.size()];
+
+    index_entry ie;
+    common::rma::get_nb(&ie, 1, *win_, rank, (i / nr.size()) * sizeof(index_entry));
+    common::rma::flush(*win_);
+
+    return {ie.size, rank, ie.offset};
+  }
+
+private:
+  // blocks are transferred uncompressed if the compressed size exceeds 7/8 of the block size
+  static constexpr std::size_t max_ratio_x8 = 7;
+
+  struct index_entry {
+    uint64_t size;
+    uint64_t offset;
+  };
+
+  std::byte*                                         addr_;
+  std::size_t                                        n_blocks_;
+  codec                                              codec_;
+  std::vector<std::byte>                             buf_;
+  std::vector<uint64_t>                              node_pm_blk_begin_; // per rank
+  std::vector<std::vector<common::topology::rank_t>> node_ranks_;        // [inter rank][intra rank]
+  std::unique_ptr<common::rma::win>                  win_;
+};
+}
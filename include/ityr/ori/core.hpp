@@ -1,7 +1,12 @@
 #pragma once
 
 #include <optional>
+#include <variant>
 #include <algorithm>
+#include <map>
+#include <unordered_map>
+#include <signal.h>
+#include <unistd.h>
 
 #include "ityr/common/util.hpp"
 #include "ityr/common/mpi_util.hpp"
@@ -17,6 +22,8 @@
 #include "ityr/ori/noncoll_mem.hpp"
 #include "ityr/ori/home_manager.hpp"
 #include "ityr/ori/cache_manager.hpp"
+#include "ityr/ori/codec.hpp"
+#include "ityr/ori/compressed_view.hpp"
 
 namespace ityr::ori::core {
 
@@ -58,22 +65,95 @@ void for_each_seg_blk(const coll_mem& cm, void* addr, std::size_t size,
   });
 }
 
+// Allocation of out-of-core and file-backed collective memory, shared by the cores with global memory
+
+template <block_size_t BlockSize, template <block_size_t> typename MemMapper, typename... MemMapperArgs>
+inline coll_mem& create_coll_mem_ooc(coll_mem_manager& cm_manager, std::size_t size, MemMapperArgs&&... mmargs) {
+  ITYR_REQUIRE_MESSAGE(size > 0, "Memory allocation size cannot be 0");
+  ITYR_REQUIRE_MESSAGE(size == common::mpi_bcast_value(size, 0, common::topology::mpicomm()),
+                       "The size passed to malloc_coll_ooc() is different among workers");
+
+  auto mmapper = std::make_unique<MemMapper<BlockSize>>(size,
+                                                        common::topology::inter_n_ranks(),
+                                                        common::topology::intra_n_ranks(),
+                                                        std::forward<MemMapperArgs>(mmargs)...);
+  coll_mem& cm = cm_manager.create(size, std::move(mmapper), scratch_backed);
+  void* addr = cm.vm().addr();
+
+  common::verbose("Allocate out-of-core collective memory [%p, %p) (%ld bytes) (win=%p)",
+                  addr, reinterpret_cast<std::byte*>(addr) + size, size, &cm.win());
+
+  return cm;
+}
+
 template <block_size_t BlockSize>
+inline coll_mem& create_coll_mem_file(coll_mem_manager& cm_manager, const std::string& fpath, std::size_t size) {
+  ITYR_REQUIRE_MESSAGE(size > 0, "Memory allocation size cannot be 0");
+  ITYR_REQUIRE_MESSAGE(size == common::mpi_bcast_value(size, 0, common::topology::mpicomm()),
+                       "The size passed to malloc_coll_file() is different among workers");
+
+  // The file is split into contiguous slices, each of which is the home of one process
+  auto mmapper = std::make_unique<mem_mapper::block<BlockSize>>(size,
+                                                                common::topology::inter_n_ranks(),
+                                                                common::topology::intra_n_ranks());
+  coll_mem& cm = cm_manager.create(size, std::move(mmapper), fpath);
+  void* addr = cm.vm().addr();
+
+  common::verbose("Allocate file-backed collective memory [%p, %p) (%ld bytes) (file=%s)",
+                  addr, reinterpret_cast<std::byte*>(addr) + size, size, fpath.c_str());
+
+  return cm;
+}
+
+// Calls `fn(home_addr, offset, size)` for each part of the collective memory range [addr, addr + size)
+// whose home is this process, where `home_addr` is the local address of the home memory and `offset`
+// is the offset from `addr`.
+template <typename Fn>
+inline void for_each_local_home_seg(const coll_mem& cm, void* addr, std::size_t size, Fn&& fn) {
+  std::byte* req_b  = reinterpret_cast<std::byte*>(addr);
+  std::byte* req_e  = req_b + size;
+  std::byte* base   = reinterpret_cast<std::byte*>(cm.vm().addr());
+  std::byte* home_b = reinterpret_cast<std::byte*>(cm.home_vm().addr());
+
+  for_each_mem_segment(cm, addr, size, [&](const auto& seg) {
+    if (seg.owner == common::topology::inter_my_rank()) {
+      std::byte* seg_b = std::max(req_b, base + seg.offset_b);
+      std::byte* seg_e = std::min(req_e, base + seg.offset_e);
+      fn(home_b + seg.pm_offset + (seg_b - (base + seg.offset_b)),
+         std::size_t(seg_b - req_b),
+         std::size_t(seg_e - seg_b));
+    }
+  });
+}
+
+template <block_size_t BlockSize,
+          int CacheTLBSize = ITYR_ORI_CACHE_TLB_SIZE,
+          int HomeTLBSize  = ITYR_ORI_HOME_TLB_SIZE>
 class core_default {
   static constexpr bool enable_vm_map = ITYR_ORI_ENABLE_VM_MAP;
 
 public:
   core_default(std::size_t cache_size, std::size_t sub_block_size)
     : noncoll_mem_(noncoll_allocator_size_option::value(), BlockSize),
-      home_manager_(calc_home_mmap_limit(cache_size / BlockSize)),
-      cache_manager_(cache_size, sub_block_size) {}
+      home_manager_(calc_home_mmap_limit(cache_size / BlockSize), aprof_),
+      cache_manager_(cache_size, sub_block_size, aprof_) {}
+
+  ~core_default() {
+    if (transparent_core_ == this) {
+      sigaction(SIGSEGV, &prev_segv_action_, nullptr);
+      transparent_core_ = nullptr;
+    }
+  }
 
-  static constexpr block_size_t block_size = BlockSize;
+  static constexpr block_size_t block_size     = BlockSize;
+  static constexpr int          cache_tlb_size = CacheTLBSize;
+  static constexpr int          home_tlb_size  = HomeTLBSize;
 
   void* malloc_coll(std::size_t size) { return malloc_coll<default_mem_mapper>(size); }
 
   template <template <block_size_t> typename MemMapper, typename... MemMapperArgs>
   void* malloc_coll(std::size_t size, MemMapperArgs&&... mmargs) {
+    runtime_section rs;
     ITYR_REQUIRE_MESSAGE(size > 0, "Memory allocation size cannot be 0");
     ITYR_REQUIRE_MESSAGE(size == common::mpi_bcast_value(size, 0, common::topology::mpicomm()),
                          "The size passed to malloc_coll() is different among workers");
@@ -88,10 +168,83 @@ public:
     common::verbose("Allocate collective memory [%p, %p) (%ld bytes) (win=%p)",
                     addr, reinterpret_cast<std::byte*>(addr) + size, size, &cm.win());
 
+    aprof_.register_alloc(addr, size);
+
+    return addr;
+  }
+
+  template <template <block_size_t> typename MemMapper, typename... MemMapperArgs>
+  void* malloc_coll_ooc(std::size_t size, MemMapperArgs&&... mmargs) {
+    runtime_section rs;
+    coll_mem& cm = create_coll_mem_ooc<BlockSize, MemMapper>(cm_manager_, size, std::forward<MemMapperArgs>(mmargs)...);
+    void* addr = cm.vm().addr();
+
+    aprof_.register_alloc(addr, size);
+
+    return addr;
+  }
+
+  void* malloc_coll_file(const std::string& fpath, std::size_t size) {
+    runtime_section rs;
+    coll_mem& cm = create_coll_mem_file<BlockSize>(cm_manager_, fpath, size);
+    void* addr = cm.vm().addr();
+
+    aprof_.register_alloc(addr, size);
+
+    return addr;
+  }
+
+  /*
+   * Collective memory that can be directly accessed by loads/stores without checkout/checkin calls.
+   * Accesses to blocks that are not accessible cause page faults (SIGSEGV), which are serviced by
+   * fetching the blocks into the cache. Explicit checkout calls are still allowed and work as
+   * prefetching; checkin calls are no-op.
+   *
+   * The fault handler issues RMA operations and mmap/mprotect calls, which are not async-signal-safe.
+   * Faults are serviced only when they are raised synchronously by loads/stores in user code; faults
+   * raised while the runtime is running (and thus possibly inside MPI) are reported as errors without
+   * entering MPI, and the bookkeeping buffers are allocated here so that the handler does not call
+   * malloc. Transparent memory must not be passed to ori/MPI calls as local buffers or accessed from
+   * other signal handlers.
+   */
+  template <template <block_size_t> typename MemMapper, typename... MemMapperArgs>
+  void* malloc_coll_transparent(std::size_t size, MemMapperArgs&&... mmargs) {
+    if constexpr (!enable_vm_map) {
+      common::die("ITYR_ORI_ENABLE_VM_MAP must be true for transparent access");
+    }
+
+    void* addr = malloc_coll<MemMapper>(size, std::forward<MemMapperArgs>(mmargs)...);
+
+    std::byte* addr_b = reinterpret_cast<std::byte*>(addr);
+    transparent_regions_[addr_b] = addr_b + size;
+
+    if (!transparent_core_) {
+      cache_manager_.init_transparent();
+      install_segv_handler();
+    }
+
+    return addr;
+  }
+
+  /*
+   * Collective memory whose blocks are fetched in compressed form while the memory is read-only
+   * (between `set_readonly_coll()` and `unset_readonly_coll()`). Outside of read-only phases,
+   * it behaves as usual collective memory.
+   */
+  template <template <block_size_t> typename MemMapper, typename... MemMapperArgs>
+  void* malloc_coll_compressed(std::size_t size, codec c, MemMapperArgs&&... mmargs) {
+    void* addr = malloc_coll<MemMapper>(size, std::forward<MemMapperArgs>(mmargs)...);
+
+    if (c != codec::none) {
+      std::byte* addr_b = reinterpret_cast<std::byte*>(addr);
+      compressed_regions_.push_back({addr_b, addr_b + size, c});
+    }
+
     return addr;
   }
 
   void* malloc(std::size_t size) {
+    runtime_section rs;
     ITYR_CHECK_MESSAGE(size > 0, "Memory allocation size cannot be 0");
 
     void* addr = noncoll_mem_.allocate(size);
@@ -103,10 +256,26 @@ public:
   }
 
   void free_coll(void* addr) {
+    runtime_section rs;
     ITYR_REQUIRE_MESSAGE(addr, "Null pointer was passed to free()");
     ITYR_REQUIRE_MESSAGE(addr == common::mpi_bcast_value(addr, 0, common::topology::mpicomm()),
                          "The address passed to free_coll() is different among workers");
 
+    auto tr_it = transparent_regions_.find(reinterpret_cast<std::byte*>(addr));
+    if (tr_it != transparent_regions_.end()) {
+      // blocks of other transparent regions remain accessible
+      cache_manager_.flush_transparent_dirty();
+      cache_manager_.drop_transparent_blocks(tr_it->first, tr_it->second);
+      transparent_regions_.erase(tr_it);
+    }
+
+    auto cr_it = std::find_if(compressed_regions_.begin(), compressed_regions_.end(),
+                              [&](const auto& r) { return r.addr_b == addr; });
+    if (cr_it != compressed_regions_.end()) {
+      destroy_compressed_views(cr_it->addr_b, cr_it->addr_e);
+      compressed_regions_.erase(cr_it);
+    }
+
     // ensure free safety
     cache_manager_.ensure_all_cache_clean();
 
@@ -126,11 +295,14 @@ public:
     common::verbose("Deallocate collective memory [%p, %p) (%ld bytes) (win=%p)",
                     addr, reinterpret_cast<std::byte*>(addr) + cm.size(), cm.size(), &cm.win());
 
+    aprof_.deregister_alloc(addr);
+
     cm_manager_.destroy(cm);
   }
 
   // TODO: remove size from parameters
   void free(void* addr, std::size_t size) {
+    runtime_section rs;
     ITYR_CHECK_MESSAGE(addr, "Null pointer was passed to free()");
     ITYR_CHECK(noncoll_mem_.has(addr));
 
@@ -158,10 +330,19 @@ public:
   }
 
   void get(const void* from_addr, void* to_addr, std::size_t size) {
+    runtime_section rs;
     ITYR_PROFILER_RECORD(prof_event_get);
 
     std::byte* from_addr_ = reinterpret_cast<std::byte*>(const_cast<void*>(from_addr));
 
+    if (is_transparent(from_addr_)) {
+      if (!checkout_transparent_nb<mode::read_t>(from_addr_, size)) {
+        checkout_complete_impl();
+      }
+      std::memcpy(to_addr, from_addr_, size);
+      return;
+    }
+
     // TODO: support get/put for data larger than the cache size
     if (common::round_down_pow2(from_addr_, BlockSize) ==
         common::round_down_pow2(from_addr_ + size, BlockSize)) {
@@ -180,10 +361,19 @@ public:
   }
 
   void put(const void* from_addr, void* to_addr, std::size_t size) {
+    runtime_section rs;
     ITYR_PROFILER_RECORD(prof_event_put);
 
     std::byte* to_addr_ = reinterpret_cast<std::byte*>(to_addr);
 
+    if (is_transparent(to_addr_)) {
+      if (!checkout_transparent_nb<mode::write_t>(to_addr_, size)) {
+        checkout_complete_impl();
+      }
+      std::memcpy(to_addr_, from_addr, size);
+      return;
+    }
+
     if (common::round_down_pow2(to_addr_, BlockSize) ==
         common::round_down_pow2(to_addr_ + size, BlockSize)) {
       // if the size is sufficiently small, it is safe to skip incrementing reference count for cache blocks
@@ -203,6 +393,7 @@ public:
 
   template <typename Mode>
   bool checkout_nb(void* addr, std::size_t size, Mode) {
+    runtime_section rs;
     if constexpr (!enable_vm_map) {
       common::die("ITYR_ORI_ENABLE_VM_MAP must be true for core::checkout/checkin");
     }
@@ -214,6 +405,10 @@ public:
     ITYR_CHECK(addr);
     ITYR_CHECK(size > 0);
 
+    if (is_transparent(addr)) {
+      return checkout_transparent_nb<Mode>(reinterpret_cast<std::byte*>(addr), size);
+    }
+
     return checkout_impl_nb<Mode, true>(reinterpret_cast<std::byte*>(addr), size);
   }
 
@@ -225,12 +420,14 @@ public:
   }
 
   void checkout_complete() {
+    runtime_section rs;
     ITYR_PROFILER_RECORD(prof_event_checkout_comp);
     checkout_complete_impl();
   }
 
   template <typename Mode>
   void checkin(void* addr, std::size_t size, Mode) {
+    runtime_section rs;
     if constexpr (!enable_vm_map) {
       common::die("ITYR_ORI_ENABLE_VM_MAP must be true for core::checkout/checkin");
     }
@@ -242,26 +439,35 @@ public:
     ITYR_CHECK(addr);
     ITYR_CHECK(size > 0);
 
+    if (is_transparent(addr)) {
+      // modified bytes are detected at release fences
+      return;
+    }
+
     checkin_impl<Mode, true>(reinterpret_cast<std::byte*>(addr), size);
   }
 
   void release() {
+    runtime_section rs;
     common::verbose("Release fence begin");
 
     cache_manager_.release();
+    noncoll_mem_.flush_remote_frees();
 
     common::verbose("Release fence end");
   }
 
-  using release_handler = typename cache_manager<BlockSize>::release_handler;
+  using release_handler = typename cache_manager<BlockSize, CacheTLBSize>::release_handler;
 
   release_handler release_lazy() {
+    runtime_section rs;
     common::verbose<2>("Lazy release handler is created");
 
     return cache_manager_.release_lazy();
   }
 
   void acquire() {
+    runtime_section rs;
     common::verbose("Acquire fence begin");
 
     cache_manager_.acquire();
@@ -270,6 +476,7 @@ public:
   }
 
   void acquire(release_handler rh) {
+    runtime_section rs;
     common::verbose("Acquire fence (lazy) begin");
 
     cache_manager_.acquire(rh);
@@ -278,43 +485,105 @@ public:
   }
 
   void set_readonly_coll(void* addr, std::size_t size) {
+    runtime_section rs;
     release();
     common::mpi_barrier(common::topology::mpicomm());
 
     cache_manager_.set_readonly(addr, size);
 
+    // the snapshot is built after the barrier, as home blocks are updated by writebacks until then
+    create_compressed_view(reinterpret_cast<std::byte*>(addr), size);
+
     common::mpi_barrier(common::topology::mpicomm());
   }
 
   void unset_readonly_coll(void* addr, std::size_t size) {
+    runtime_section rs;
     common::mpi_barrier(common::topology::mpicomm());
 
     cache_manager_.unset_readonly(addr, size);
 
+    destroy_compressed_views(reinterpret_cast<std::byte*>(addr),
+                             reinterpret_cast<std::byte*>(addr) + size);
+
+    common::mpi_barrier(common::topology::mpicomm());
+  }
+
+  void sync_file_coll(void* addr) {
+    runtime_section rs;
+    // write back dirty cache blocks to the home (file) of each process
+    release();
+    common::mpi_barrier(common::topology::mpicomm());
+
+    cm_manager_.get(addr).sync_file();
+
     common::mpi_barrier(common::topology::mpicomm());
   }
 
   void poll() {
+    runtime_section rs;
     cache_manager_.poll();
+    noncoll_mem_.flush_remote_frees();
   }
 
   void collect_deallocated() {
+    runtime_section rs;
     noncoll_mem_.collect_deallocated();
   }
 
+  void set_coll_label(void* addr, const std::string& label) {
+    aprof_.set_label(addr, label);
+  }
+
   void cache_prof_begin() {
     home_manager_.home_prof_begin();
     cache_manager_.cache_prof_begin();
+    aprof_.start();
   }
 
   void cache_prof_end() {
     home_manager_.home_prof_end();
     cache_manager_.cache_prof_end();
+    aprof_.stop();
   }
 
   void cache_prof_print() const {
     home_manager_.home_prof_print();
     cache_manager_.cache_prof_print();
+    aprof_.print();
+  }
+
+  cache_prof_result cache_prof_get_result() const {
+    return cache_manager_.cache_prof_get_result();
+  }
+
+  home_prof_result home_prof_get_result() const {
+    return home_manager_.home_prof_get_result();
+  }
+
+  std::vector<alloc_prof_result> alloc_prof_get_result() const {
+    return aprof_.get_result();
+  }
+
+  mem_stats get_mem_stats() const {
+    mem_stats ms;
+    ms.cache_blocks      = cache_manager_.block_usage();
+    ms.cache_pinned      = cache_manager_.pinned_usage();
+    ms.cache_dirty       = cache_manager_.dirty_usage();
+    ms.noncoll_heap      = noncoll_mem_.heap_usage();
+    ms.home_mmap_entries = home_manager_.mmap_usage();
+    ms.coll_mem          = cm_manager_.usage();
+    ms.coll_mem_home     = cm_manager_.home_usage();
+    return ms;
+  }
+
+  // Calls `fn(home_addr, offset, size)` for each part of the collective memory range [addr, addr + size)
+  // whose home is this process, where `home_addr` is the local address of the home memory and `offset`
+  // is the offset from `addr`. Home memory is directly accessed without going through the cache.
+  template <typename Fn>
+  void for_each_local_home(void* addr, std::size_t size, Fn&& fn) {
+    ITYR_REQUIRE_MESSAGE(!noncoll_mem_.has(addr), "Only collective memory is allowed");
+    for_each_local_home_seg(cm_manager_.get(addr), addr, size, std::forward<Fn>(fn));
   }
 
   /* APIs for debugging */
@@ -325,6 +594,48 @@ public:
   }
 
 private:
+  void create_compressed_view(std::byte* addr, std::size_t size) {
+    auto cr_it = std::find_if(compressed_regions_.begin(), compressed_regions_.end(),
+                              [&](const auto& r) { return r.addr_b <= addr && addr < r.addr_e; });
+    if (cr_it == compressed_regions_.end()) return;
+
+    // Only blocks entirely within the read-only region are compressed, as other parts of
+    // the boundary blocks may be updated during the read-only phase
+    std::byte* view_b = common::round_up_pow2(addr, BlockSize);
+    std::byte* view_e = common::round_down_pow2(std::min(addr + size, cr_it->addr_e), BlockSize);
+    if (view_b >= view_e) return;
+
+    std::size_t n_blocks = (view_e - view_b) / BlockSize;
+
+    // home blocks in this node, identified by their offsets in the home physical memory
+    coll_mem& cm = cm_manager_.get(view_b);
+    std::byte* home_b = reinterpret_cast<std::byte*>(cm.home_vm().addr());
+    std::vector<typename compressed_view<BlockSize>::local_block> local_blocks;
+    for_each_local_home(view_b, view_e - view_b, [&](std::byte* home_addr, std::size_t offset, std::size_t seg_size) {
+      ITYR_CHECK(offset % BlockSize == 0);
+      ITYR_CHECK(seg_size % BlockSize == 0);
+      for (std::size_t o = 0; o < seg_size; o += BlockSize) {
+        local_blocks.push_back({std::size_t(home_addr + o - home_b) / BlockSize, home_addr + o});
+      }
+    });
+
+    auto& cv = compressed_views_.emplace_back(
+        std::make_unique<compressed_view<BlockSize>>(view_b, n_blocks, cr_it->c, local_blocks));
+    cache_manager_.register_compressed_view(*cv);
+  }
+
+  void destroy_compressed_views(std::byte* addr_b, std::byte* addr_e) {
+    for (auto it = compressed_views_.begin(); it != compressed_views_.end();) {
+      std::byte* view_b = (*it)->addr();
+      if (addr_b <= view_b && view_b < addr_e) {
+        cache_manager_.unregister_compressed_view(**it);
+        it = compressed_views_.erase(it);
+      } else {
+        it++;
+      }
+    }
+  }
+
   std::size_t calc_home_mmap_limit(std::size_t n_cache_blocks) const {
     std::size_t sys_limit = sys_mmap_entry_limit();
     std::size_t margin = 1000;
@@ -336,6 +647,133 @@ private:
     return std::min(max_val, candidate);
   }
 
+  bool is_transparent(const void* addr) const {
+    // Called on every get/put/checkout/checkin; programs without transparent memory pay only for this check
+    if (transparent_regions_.empty()) return false;
+
+    // the region that begins at or before `addr`, if any
+    auto it = transparent_regions_.upper_bound(reinterpret_cast<std::byte*>(const_cast<void*>(addr)));
+    if (it == transparent_regions_.begin()) return false;
+    --it;
+    return addr < it->second;
+  }
+
+  template <typename Mode>
+  bool checkout_transparent_nb(std::byte* addr, std::size_t size) {
+    // Whole blocks are fetched even for the write-only mode, as other bytes can be read afterwards
+    constexpr bool write = !std::is_same_v<Mode, mode::read_t>;
+
+    coll_mem& cm = cm_manager_.get(addr);
+
+    std::byte* blk_addr_b = common::round_down_pow2(addr, BlockSize);
+    std::byte* blk_addr_e = common::round_up_pow2(addr + size, BlockSize);
+
+    cache_manager_.ensure_transparent_capacity((blk_addr_e - blk_addr_b) / BlockSize);
+
+    bool checkout_completed = true;
+
+    for_each_seg_blk<BlockSize>(cm, blk_addr_b, blk_addr_e - blk_addr_b,
+      // home segment
+      [&](std::byte* seg_addr, std::size_t seg_size, std::size_t pm_offset) {
+        checkout_completed &=
+          home_manager_.template checkout_seg<false>(
+              seg_addr, seg_size, addr, size,
+              cm.home_pm(), pm_offset, cm.home_all_mapped());
+      },
+      // cache block
+      [&](std::byte* blk_addr, std::byte*, std::byte*,
+          common::topology::rank_t owner, std::size_t pm_offset) {
+        checkout_completed &=
+          cache_manager_.template checkout_transparent_blk<write>(
+              blk_addr, cm.win(), common::topology::inter2global_rank(owner), pm_offset);
+      });
+
+    return checkout_completed;
+  }
+
+  // Returns false if the fault is not caused by transparent access
+  bool handle_transparent_fault(std::byte* addr) {
+    if (!is_transparent(addr)) return false;
+
+    coll_mem& cm = cm_manager_.get(addr);
+
+    cache_manager_.ensure_transparent_capacity(1);
+
+    bool handled = false;
+
+    for_each_seg_blk<BlockSize>(cm, common::round_down_pow2(addr, BlockSize), BlockSize,
+      // home segment
+      [&](std::byte* seg_addr, std::size_t seg_size, std::size_t pm_offset) {
+        // home segments are always writable once mapped
+        handled = !home_manager_.template checkout_seg<false>(
+            seg_addr, seg_size, addr, 1,
+            cm.home_pm(), pm_offset, cm.home_all_mapped());
+      },
+      // cache block
+      [&](std::byte* blk_addr, std::byte*, std::byte*,
+          common::topology::rank_t owner, std::size_t pm_offset) {
+        handled = cache_manager_.transparent_fault(
+            blk_addr, cm.win(), common::topology::inter2global_rank(owner), pm_offset);
+      });
+
+    if (handled) {
+      checkout_complete_impl();
+    }
+
+    return handled;
+  }
+
+  static void segv_handler(int sig, siginfo_t* si, void* ucontext) {
+    if (in_segv_handler_) {
+      // A fault within the handler (e.g., in the runtime or MPI) cannot be serviced safely
+      static constexpr char msg[] = "[ityr::ori::core] Segmentation fault while handling a fault on transparent memory\n";
+      [[maybe_unused]] auto ret = write(STDERR_FILENO, msg, sizeof(msg) - 1);
+      signal(SIGSEGV, SIG_DFL);
+      return;
+    }
+
+    std::byte* addr = reinterpret_cast<std::byte*>(si->si_addr);
+
+    if (transparent_core_ && in_runtime_ > 0) {
+      // The runtime (or MPI called by it) may be in the middle of updating its state, and
+      // the handler must not reenter it
+      if (transparent_core_->is_transparent(addr)) {
+        static constexpr char msg[] = "[ityr::ori::core] Transparent memory was accessed inside the runtime (e.g., passed to get/put or MPI as a local buffer)\n";
+        [[maybe_unused]] auto ret = write(STDERR_FILENO, msg, sizeof(msg) - 1);
+      }
+
+    } else if (transparent_core_) {
+      // The faulting instruction is retried after returning from the handler
+      in_segv_handler_ = 1;
+      bool handled = transparent_core_->handle_transparent_fault(addr);
+      in_segv_handler_ = 0;
+      if (handled) return;
+    }
+
+    if (prev_segv_action_.sa_flags & SA_SIGINFO) {
+      prev_segv_action_.sa_sigaction(sig, si, ucontext);
+    } else if (prev_segv_action_.sa_handler != SIG_DFL &&
+               prev_segv_action_.sa_handler != SIG_IGN) {
+      prev_segv_action_.sa_handler(sig);
+    } else {
+      // a real segmentation fault; the default action is taken when the fault happens again
+      sigaction(SIGSEGV, &prev_segv_action_, nullptr);
+    }
+  }
+
+  void install_segv_handler() {
+    struct sigaction sa = {};
+    sa.sa_sigaction = segv_handler;
+    // SA_NODEFER lets nested faults reach the handler and be reported, instead of killing the process silently
+    sa.sa_flags     = SA_SIGINFO | SA_NODEFER;
+    sigemptyset(&sa.sa_mask);
+    if (sigaction(SIGSEGV, &sa, &prev_segv_action_) == -1) {
+      perror("sigaction");
+      common::die("[ityr::ori::core] sigaction() failed");
+    }
+    transparent_core_ = this;
+  }
+
   template <typename Mode, bool IncrementRef>
   bool checkout_impl_nb(std::byte* addr, std::size_t size) {
     constexpr bool skip_fetch = std::is_same_v<Mode, mode::write_t>;
@@ -605,17 +1043,45 @@ private:
 
   coll_mem_manager         cm_manager_;
   noncoll_mem              noncoll_mem_;
-  home_manager<BlockSize>  home_manager_;
-  cache_manager<BlockSize> cache_manager_;
+  alloc_profiler           aprof_;
+  home_manager<BlockSize, HomeTLBSize>   home_manager_;
+  cache_manager<BlockSize, CacheTLBSize> cache_manager_;
+
+  // Marks the runtime code in which faults on transparent memory cannot be serviced
+  struct runtime_section {
+    runtime_section() { in_runtime_ = in_runtime_ + 1; }
+    ~runtime_section() { in_runtime_ = in_runtime_ - 1; }
+  };
+
+  // transparent regions [addr_b, addr_e) indexed by addr_b
+  std::map<std::byte*, std::byte*> transparent_regions_;
+
+  struct compressed_region {
+    std::byte* addr_b;
+    std::byte* addr_e;
+    codec      c;
+  };
+
+  std::vector<compressed_region>                           compressed_regions_;
+  std::vector<std::unique_ptr<compressed_view<BlockSize>>> compressed_views_;
+
+  inline static core_default*          transparent_core_ = nullptr;
+  inline static volatile sig_atomic_t in_segv_handler_  = 0;
+  inline static volatile sig_atomic_t in_runtime_       = 0;
+  inline static struct sigaction       prev_segv_action_ = {};
 };
 
-template <block_size_t BlockSize>
+template <block_size_t BlockSize,
+          int CacheTLBSize = ITYR_ORI_CACHE_TLB_SIZE,
+          int HomeTLBSize  = ITYR_ORI_HOME_TLB_SIZE>
 class core_nocache {
 public:
   core_nocache(std::size_t, std::size_t)
     : noncoll_mem_(noncoll_allocator_size_option::value(), BlockSize) {}
 
-  static constexpr block_size_t block_size = BlockSize;
+  static constexpr block_size_t block_size     = BlockSize;
+  static constexpr int          cache_tlb_size = CacheTLBSize;
+  static constexpr int          home_tlb_size  = HomeTLBSize;
 
   void* malloc_coll(std::size_t size) { return malloc_coll<default_mem_mapper>(size); }
 
@@ -638,6 +1104,32 @@ public:
     return addr;
   }
 
+  template <template <block_size_t> typename MemMapper, typename... MemMapperArgs>
+  void* malloc_coll_ooc(std::size_t size, MemMapperArgs&&... mmargs) {
+    coll_mem& cm = create_coll_mem_ooc<BlockSize, MemMapper>(cm_manager_, size, std::forward<MemMapperArgs>(mmargs)...);
+    void* addr = cm.vm().addr();
+
+    return addr;
+  }
+
+  void* malloc_coll_file(const std::string& fpath, std::size_t size) {
+    coll_mem& cm = create_coll_mem_file<BlockSize>(cm_manager_, fpath, size);
+    void* addr = cm.vm().addr();
+
+    return addr;
+  }
+
+  template <template <block_size_t> typename MemMapper, typename... MemMapperArgs>
+  void* malloc_coll_transparent(std::size_t, MemMapperArgs&&...) {
+    common::die("Transparent access is not supported for the no-cache mode");
+  }
+
+  // Compression is only for cache fetches
+  template <template <block_size_t> typename MemMapper, typename... MemMapperArgs>
+  void* malloc_coll_compressed(std::size_t size, codec, MemMapperArgs&&... mmargs) {
+    return malloc_coll<MemMapper>(size, std::forward<MemMapperArgs>(mmargs)...);
+  }
+
   void* malloc(std::size_t size) {
     ITYR_CHECK_MESSAGE(size > 0, "Memory allocation size cannot be 0");
 
@@ -716,7 +1208,9 @@ public:
     common::die("core::checkout/checkin is disabled");
   }
 
-  void release() {}
+  void release() {
+    noncoll_mem_.flush_remote_frees();
+  }
 
   using release_handler = void*;
 
@@ -729,15 +1223,47 @@ public:
   void set_readonly_coll(void*, std::size_t) {}
   void unset_readonly_coll(void*, std::size_t) {}
 
-  void poll() {}
+  void sync_file_coll(void* addr) {
+    common::mpi_barrier(common::topology::mpicomm());
+
+    cm_manager_.get(addr).sync_file();
+
+    common::mpi_barrier(common::topology::mpicomm());
+  }
+
+  void poll() {
+    noncoll_mem_.flush_remote_frees();
+  }
 
   void collect_deallocated() {
     noncoll_mem_.collect_deallocated();
   }
 
+  void set_coll_label(void*, const std::string&) {}
+
   void cache_prof_begin() {}
   void cache_prof_end() {}
   void cache_prof_print() const {}
+  cache_prof_result cache_prof_get_result() const { return {}; }
+  home_prof_result home_prof_get_result() const { return {}; }
+  std::vector<alloc_prof_result> alloc_prof_get_result() const { return {}; }
+
+  mem_stats get_mem_stats() const {
+    mem_stats ms;
+    ms.noncoll_heap  = noncoll_mem_.heap_usage();
+    ms.coll_mem      = cm_manager_.usage();
+    ms.coll_mem_home = cm_manager_.home_usage();
+    return ms;
+  }
+
+  // Calls `fn(home_addr, offset, size)` for each part of the collective memory range [addr, addr + size)
+  // whose home is this process, where `home_addr` is the local address of the home memory and `offset`
+  // is the offset from `addr`. Home memory is directly accessed without going through the cache.
+  template <typename Fn>
+  void for_each_local_home(void* addr, std::size_t size, Fn&& fn) {
+    ITYR_REQUIRE_MESSAGE(!noncoll_mem_.has(addr), "Only collective memory is allowed");
+    for_each_local_home_seg(cm_manager_.get(addr), addr, size, std::forward<Fn>(fn));
+  }
 
   /* APIs for debugging */
 
@@ -876,12 +1402,16 @@ private:
   noncoll_mem      noncoll_mem_;
 };
 
-template <block_size_t BlockSize>
+template <block_size_t BlockSize,
+          int CacheTLBSize = ITYR_ORI_CACHE_TLB_SIZE,
+          int HomeTLBSize  = ITYR_ORI_HOME_TLB_SIZE>
 class core_serial {
 public:
   core_serial(std::size_t, std::size_t) {}
 
-  static constexpr block_size_t block_size = BlockSize;
+  static constexpr block_size_t block_size     = BlockSize;
+  static constexpr int          cache_tlb_size = CacheTLBSize;
+  static constexpr int          home_tlb_size  = HomeTLBSize;
 
   void* malloc_coll(std::size_t size) { return std::malloc(size); }
 
@@ -890,12 +1420,54 @@ public:
     return std::malloc(size);
   }
 
+  template <template <block_size_t> typename MemMapper, typename... MemMapperArgs>
+  void* malloc_coll_ooc(std::size_t size, MemMapperArgs&&...) {
+    // The OS swaps out anonymous memory if needed
+    return std::malloc(size);
+  }
+
+  template <template <block_size_t> typename MemMapper, typename... MemMapperArgs>
+  void* malloc_coll_transparent(std::size_t size, MemMapperArgs&&...) {
+    return std::malloc(size);
+  }
+
+  template <template <block_size_t> typename MemMapper, typename... MemMapperArgs>
+  void* malloc_coll_compressed(std::size_t size, codec, MemMapperArgs&&...) {
+    return std::malloc(size);
+  }
+
+  void* malloc_coll_file(const std::string& fpath, std::size_t size) {
+    ITYR_REQUIRE_MESSAGE(size > 0, "Memory allocation size cannot be 0");
+
+    int fd = open(fpath.c_str(), O_RDWR | O_CREAT, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+    if (fd == -1 || ftruncate(fd, size) == -1) {
+      perror("open/ftruncate");
+      common::die("[ityr::ori::core] Failed to open file %s", fpath.c_str());
+    }
+
+    void* addr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED) {
+      perror("mmap");
+      common::die("[ityr::ori::core] mmap() for file %s failed", fpath.c_str());
+    }
+
+    file_mems_[addr] = size;
+    return addr;
+  }
+
   void* malloc(std::size_t size) {
     return std::malloc(size);
   }
 
   void free_coll(void* addr) {
-    std::free(addr);
+    auto it = file_mems_.find(addr);
+    if (it != file_mems_.end()) {
+      munmap(addr, it->second);
+      file_mems_.erase(it);
+    } else {
+      std::free(addr);
+    }
   }
 
   void free(void* addr, std::size_t) {
@@ -934,46 +1506,325 @@ public:
   void set_readonly_coll(void*, std::size_t) {}
   void unset_readonly_coll(void*, std::size_t) {}
 
+  void sync_file_coll(void* addr) {
+    auto it = file_mems_.find(addr);
+    ITYR_CHECK(it != file_mems_.end());
+    msync(addr, it->second, MS_SYNC);
+  }
+
   void poll() {}
 
   void collect_deallocated() {}
 
+  void set_coll_label(void*, const std::string&) {}
+
   void cache_prof_begin() {}
   void cache_prof_end() {}
   void cache_prof_print() const {}
+  cache_prof_result cache_prof_get_result() const { return {}; }
+  home_prof_result home_prof_get_result() const { return {}; }
+  std::vector<alloc_prof_result> alloc_prof_get_result() const { return {}; }
+
+  mem_stats get_mem_stats() const { return {}; }
+
+  template <typename Fn>
+  void for_each_local_home(void* addr, std::size_t size, Fn&& fn) {
+    fn(reinterpret_cast<std::byte*>(addr), std::size_t(0), size);
+  }
 
   /* APIs for debugging */
 
   void* get_local_mem(void* addr) { return addr; }
+
+private:
+  std::unordered_map<void*, std::size_t> file_mems_;
 };
 
-template <block_size_t BlockSize>
-using core = ITYR_CONCAT(core_, ITYR_ORI_CORE)<BlockSize>;
+template <block_size_t BlockSize,
+          int CacheTLBSize = ITYR_ORI_CACHE_TLB_SIZE,
+          int HomeTLBSize  = ITYR_ORI_HOME_TLB_SIZE>
+using core = ITYR_CONCAT(core_, ITYR_ORI_CORE)<BlockSize, CacheTLBSize, HomeTLBSize>;
+
+/*
+ * Multi-variant core
+ *
+ * The core is instantiated for all combinations of the block sizes and TLB sizes listed in
+ * ITYR_ORI_BLOCK_SIZE_VARIANTS, ITYR_ORI_CACHE_TLB_SIZE_VARIANTS, and ITYR_ORI_HOME_TLB_SIZE_VARIANTS
+ * at compile time, and one of them is selected at initialization by the runtime options
+ * ITYR_ORI_BLOCK_SIZE, ITYR_ORI_CACHE_TLB_SIZE, and ITYR_ORI_HOME_TLB_SIZE. Each core is still
+ * specialized for its block size and TLB sizes; only one branch is added to each API call for
+ * dispatching, which is eliminated if only one variant is compiled (the default).
+ */
+
+template <typename BlockSizes, typename CacheTLBSizes, typename HomeTLBSizes>
+struct core_variants;
+
+template <block_size_t... BlockSizes, int... CacheTLBSizes, int... HomeTLBSizes>
+struct core_variants<std::integer_sequence<block_size_t, BlockSizes...>,
+                     std::integer_sequence<int, CacheTLBSizes...>,
+                     std::integer_sequence<int, HomeTLBSizes...>> {
+  template <block_size_t BlockSize, int CacheTLBSize>
+  using with_cache_tlb = std::tuple<core<BlockSize, CacheTLBSize, HomeTLBSizes>...>;
+
+  template <block_size_t BlockSize>
+  using with_block_size = decltype(std::tuple_cat(std::declval<with_cache_tlb<BlockSize, CacheTLBSizes>>()...));
+
+  using type = decltype(std::tuple_cat(std::declval<with_block_size<BlockSizes>>()...));
+};
 
-using instance = common::singleton<core<ITYR_ORI_BLOCK_SIZE>>;
+template <typename CoreTuple>
+class core_dispatcher;
 
-ITYR_TEST_CASE("[ityr::ori::core] malloc/free with block policy") {
-  common::runtime_options common_opts;
-  runtime_options opts;
-  common::singleton_initializer<common::topology::instance> topo;
-  common::singleton_initializer<common::rma::instance> rma;
-  constexpr block_size_t bs = 65536;
-  core<bs> c(16 * bs, bs / 4);
+template <typename... Cores>
+class core_dispatcher<std::tuple<Cores...>> {
+  using first_core = std::tuple_element_t<0, std::tuple<Cores...>>;
 
-  ITYR_SUBCASE("free immediately") {
-    int n = 10;
-    for (int i = 1; i < n; i++) {
-      auto p = c.malloc_coll<mem_mapper::block>(i * 1234);
-      c.free_coll(p);
+public:
+  core_dispatcher(std::size_t cache_size, std::size_t sub_block_size) {
+    std::size_t bs  = block_size_option::value();
+    int         cts = cache_tlb_size_option::value();
+    int         hts = home_tlb_size_option::value();
+    if (!init_core<0>(bs, cts, hts, cache_size, sub_block_size)) {
+      std::string variants;
+      ((variants += "  (" + std::to_string(Cores::block_size) +
+                    ", " + std::to_string(Cores::cache_tlb_size) +
+                    ", " + std::to_string(Cores::home_tlb_size) + ")\n"), ...);
+      common::die("[ityr::ori::core] The variant (ITYR_ORI_BLOCK_SIZE, ITYR_ORI_CACHE_TLB_SIZE, ITYR_ORI_HOME_TLB_SIZE)"
+                  " = (%ld, %d, %d) is not compiled. Available variants are:\n%s"
+                  "Please add it to ITYR_ORI_BLOCK_SIZE_VARIANTS, ITYR_ORI_CACHE_TLB_SIZE_VARIANTS, and"
+                  " ITYR_ORI_HOME_TLB_SIZE_VARIANTS at compile time.",
+                  bs, cts, hts, variants.c_str());
     }
   }
 
-  ITYR_SUBCASE("free after accumulation") {
-    int n = 10;
-    void* ptrs[n];
-    for (int i = 1; i < n; i++) {
-      ptrs[i] = c.malloc_coll<mem_mapper::block>(i * 2743);
-    }
+  block_size_t block_size() const {
+    return visit([](const auto& c) { return c.block_size; });
+  }
+
+  void* malloc_coll(std::size_t size) {
+    return visit([&](auto& c) { return c.malloc_coll(size); });
+  }
+
+  template <template <block_size_t> typename MemMapper, typename... MemMapperArgs>
+  void* malloc_coll(std::size_t size, MemMapperArgs&&... mmargs) {
+    return visit([&](auto& c) {
+      return c.template malloc_coll<MemMapper>(size, std::forward<MemMapperArgs>(mmargs)...);
+    });
+  }
+
+  template <template <block_size_t> typename MemMapper, typename... MemMapperArgs>
+  void* malloc_coll_ooc(std::size_t size, MemMapperArgs&&... mmargs) {
+    return visit([&](auto& c) {
+      return c.template malloc_coll_ooc<MemMapper>(size, std::forward<MemMapperArgs>(mmargs)...);
+    });
+  }
+
+  template <template <block_size_t> typename MemMapper, typename... MemMapperArgs>
+  void* malloc_coll_transparent(std::size_t size, MemMapperArgs&&... mmargs) {
+    return visit([&](auto& c) {
+      return c.template malloc_coll_transparent<MemMapper>(size, std::forward<MemMapperArgs>(mmargs)...);
+    });
+  }
+
+  template <template <block_size_t> typename MemMapper, typename... MemMapperArgs>
+  void* malloc_coll_compressed(std::size_t size, codec cd, MemMapperArgs&&... mmargs) {
+    return visit([&](auto& c) {
+      return c.template malloc_coll_compressed<MemMapper>(size, cd, std::forward<MemMapperArgs>(mmargs)...);
+    });
+  }
+
+  void* malloc_coll_file(const std::string& fpath, std::size_t size) {
+    return visit([&](auto& c) { return c.malloc_coll_file(fpath, size); });
+  }
+
+  void* malloc(std::size_t size) {
+    return visit([&](auto& c) { return c.malloc(size); });
+  }
+
+  void free_coll(void* addr) {
+    visit([&](auto& c) { c.free_coll(addr); });
+  }
+
+  void free(void* addr, std::size_t size) {
+    visit([&](auto& c) { c.free(addr, size); });
+  }
+
+  void get(const void* from_addr, void* to_addr, std::size_t size) {
+    visit([&](auto& c) { c.get(from_addr, to_addr, size); });
+  }
+
+  void put(const void* from_addr, void* to_addr, std::size_t size) {
+    visit([&](auto& c) { c.put(from_addr, to_addr, size); });
+  }
+
+  template <typename Mode>
+  bool checkout_nb(void* addr, std::size_t size, Mode mode) {
+    return visit([&](auto& c) { return c.checkout_nb(addr, size, mode); });
+  }
+
+  template <typename Mode>
+  void checkout(void* addr, std::size_t size, Mode mode) {
+    visit([&](auto& c) { c.checkout(addr, size, mode); });
+  }
+
+  void checkout_complete() {
+    visit([](auto& c) { c.checkout_complete(); });
+  }
+
+  template <typename Mode>
+  void checkin(void* addr, std::size_t size, Mode mode) {
+    visit([&](auto& c) { c.checkin(addr, size, mode); });
+  }
+
+  void release() {
+    visit([](auto& c) { c.release(); });
+  }
+
+  using release_handler = typename first_core::release_handler;
+  static_assert((std::is_same_v<release_handler, typename Cores::release_handler> && ...));
+
+  release_handler release_lazy() {
+    return visit([](auto& c) { return c.release_lazy(); });
+  }
+
+  void acquire() {
+    visit([](auto& c) { c.acquire(); });
+  }
+
+  void acquire(release_handler rh) {
+    visit([&](auto& c) { c.acquire(rh); });
+  }
+
+  void set_readonly_coll(void* addr, std::size_t size) {
+    visit([&](auto& c) { c.set_readonly_coll(addr, size); });
+  }
+
+  void unset_readonly_coll(void* addr, std::size_t size) {
+    visit([&](auto& c) { c.unset_readonly_coll(addr, size); });
+  }
+
+  void sync_file_coll(void* addr) {
+    visit([&](auto& c) { c.sync_file_coll(addr); });
+  }
+
+  void poll() {
+    visit([](auto& c) { c.poll(); });
+  }
+
+  void collect_deallocated() {
+    visit([](auto& c) { c.collect_deallocated(); });
+  }
+
+  void set_coll_label(void* addr, const std::string& label) {
+    visit([&](auto& c) { c.set_coll_label(addr, label); });
+  }
+
+  void cache_prof_begin() {
+    visit([](auto& c) { c.cache_prof_begin(); });
+  }
+
+  void cache_prof_end() {
+    visit([](auto& c) { c.cache_prof_end(); });
+  }
+
+  void cache_prof_print() const {
+    visit([](const auto& c) { c.cache_prof_print(); });
+  }
+
+  cache_prof_result cache_prof_get_result() const {
+    return visit([](const auto& c) { return c.cache_prof_get_result(); });
+  }
+
+  home_prof_result home_prof_get_result() const {
+    return visit([](const auto& c) { return c.home_prof_get_result(); });
+  }
+
+  std::vector<alloc_prof_result> alloc_prof_get_result() const {
+    return visit([](const auto& c) { return c.alloc_prof_get_result(); });
+  }
+
+  mem_stats get_mem_stats() const {
+    return visit([](const auto& c) { return c.get_mem_stats(); });
+  }
+
+  template <typename Fn>
+  void for_each_local_home(void* addr, std::size_t size, Fn&& fn) {
+    visit([&](auto& c) { c.for_each_local_home(addr, size, std::forward<Fn>(fn)); });
+  }
+
+  /* APIs for debugging */
+
+  void* get_local_mem(void* addr) {
+    return visit([&](auto& c) { return c.get_local_mem(addr); });
+  }
+
+private:
+  template <std::size_t I>
+  bool init_core(std::size_t bs, int cts, int hts, std::size_t cache_size, std::size_t sub_block_size) {
+    if constexpr (I < sizeof...(Cores)) {
+      using core_t = std::tuple_element_t<I, std::tuple<Cores...>>;
+      if (core_t::block_size == bs && core_t::cache_tlb_size == cts && core_t::home_tlb_size == hts) {
+        cores_.template emplace<I + 1>(cache_size, sub_block_size);
+        return true;
+      }
+      return init_core<I + 1>(bs, cts, hts, cache_size, sub_block_size);
+    } else {
+      return false;
+    }
+  }
+
+  template <std::size_t I = 0, typename Self, typename Fn>
+  static decltype(auto) visit_impl(Self& self, Fn&& fn) {
+    // index 0 is std::monostate
+    if constexpr (I + 1 == sizeof...(Cores)) {
+      ITYR_CHECK(self.cores_.index() == I + 1);
+      return std::forward<Fn>(fn)(*std::get_if<I + 1>(&self.cores_));
+    } else {
+      if (self.cores_.index() == I + 1) {
+        return std::forward<Fn>(fn)(*std::get_if<I + 1>(&self.cores_));
+      } else {
+        return visit_impl<I + 1>(self, std::forward<Fn>(fn));
+      }
+    }
+  }
+
+  template <typename Fn>
+  decltype(auto) visit(Fn&& fn) { return visit_impl(*this, std::forward<Fn>(fn)); }
+
+  template <typename Fn>
+  decltype(auto) visit(Fn&& fn) const { return visit_impl(*this, std::forward<Fn>(fn)); }
+
+  std::variant<std::monostate, Cores...> cores_;
+};
+
+using variants = typename core_variants<std::integer_sequence<block_size_t, ITYR_ORI_BLOCK_SIZE_VARIANTS>,
+                                        std::integer_sequence<int, ITYR_ORI_CACHE_TLB_SIZE_VARIANTS>,
+                                        std::integer_sequence<int, ITYR_ORI_HOME_TLB_SIZE_VARIANTS>>::type;
+
+using instance = common::singleton<core_dispatcher<variants>>;
+
+ITYR_TEST_CASE("[ityr::ori::core] malloc/free with block policy") {
+  common::runtime_options common_opts;
+  runtime_options opts;
+  common::singleton_initializer<common::topology::instance> topo;
+  common::singleton_initializer<common::rma::instance> rma;
+  constexpr block_size_t bs = 65536;
+  core<bs> c(16 * bs, bs / 4);
+
+  ITYR_SUBCASE("free immediately") {
+    int n = 10;
+    for (int i = 1; i < n; i++) {
+      auto p = c.malloc_coll<mem_mapper::block>(i * 1234);
+      c.free_coll(p);
+    }
+  }
+
+  ITYR_SUBCASE("free after accumulation") {
+    int n = 10;
+    void* ptrs[n];
+    for (int i = 1; i < n; i++) {
+      ptrs[i] = c.malloc_coll<mem_mapper::block>(i * 2743);
+    }
     for (int i = 1; i < n; i++) {
       c.free_coll(ptrs[i]);
     }
@@ -1139,6 +1990,299 @@ ITYR_TEST_CASE("[ityr::ori::core] get/put") {
   c.free_coll(ps[1]);
 }
 
+ITYR_TEST_CASE("[ityr::ori::core] out-of-core collective memory") {
+  common::runtime_options common_opts;
+  runtime_options opts;
+  common::singleton_initializer<common::topology::instance> topo;
+  common::singleton_initializer<common::rma::instance> rma;
+  constexpr block_size_t bs = 65536;
+  int n_cb = 16;
+  core<bs> c(n_cb * bs, bs / 4);
+
+  auto my_rank = common::topology::my_rank();
+  auto n_ranks = common::topology::n_ranks();
+
+  // larger than the cache size
+  std::size_t n = n_cb * 4 * bs / sizeof(std::size_t);
+  std::size_t chunk = bs / sizeof(std::size_t);
+
+  std::size_t* ps[2];
+  ps[0] = reinterpret_cast<std::size_t*>(c.malloc_coll_ooc<mem_mapper::block >(n * sizeof(std::size_t)));
+  ps[1] = reinterpret_cast<std::size_t*>(c.malloc_coll_ooc<mem_mapper::cyclic>(n * sizeof(std::size_t)));
+
+  auto barrier = [&]() {
+    c.release();
+    common::mpi_barrier(common::topology::mpicomm());
+    c.acquire();
+  };
+
+  for (auto p : ps) {
+    for (std::size_t ib = my_rank * chunk; ib < n; ib += n_ranks * chunk) {
+      c.checkout(p + ib, chunk * sizeof(std::size_t), mode::write);
+      for (std::size_t i = ib; i < ib + chunk; i++) {
+        p[i] = i;
+      }
+      c.checkin(p + ib, chunk * sizeof(std::size_t), mode::write);
+    }
+
+    barrier();
+
+    for (std::size_t ib = 0; ib < n; ib += chunk) {
+      c.checkout(p + ib, chunk * sizeof(std::size_t), mode::read);
+      for (std::size_t i = ib; i < ib + chunk; i++) {
+        ITYR_CHECK(p[i] == i);
+      }
+      c.checkin(p + ib, chunk * sizeof(std::size_t), mode::read);
+    }
+
+    barrier();
+  }
+
+  c.free_coll(ps[0]);
+  c.free_coll(ps[1]);
+}
+
+ITYR_TEST_CASE("[ityr::ori::core] transparent access") {
+  common::runtime_options common_opts;
+  runtime_options opts;
+  common::singleton_initializer<common::topology::instance> topo;
+  common::singleton_initializer<common::rma::instance> rma;
+  constexpr block_size_t bs = 65536;
+  int n_cb = 16;
+  core_default<bs> c(n_cb * bs, bs / 4);
+
+  auto my_rank = common::topology::my_rank();
+  auto n_ranks = common::topology::n_ranks();
+
+  // larger than the cache size
+  std::size_t n = n_cb * 2 * bs / sizeof(std::size_t);
+
+  std::size_t* ps[2];
+  ps[0] = reinterpret_cast<std::size_t*>(c.malloc_coll_transparent<mem_mapper::block >(n * sizeof(std::size_t)));
+  ps[1] = reinterpret_cast<std::size_t*>(c.malloc_coll_transparent<mem_mapper::cyclic>(n * sizeof(std::size_t)));
+
+  auto barrier = [&]() {
+    c.release();
+    common::mpi_barrier(common::topology::mpicomm());
+    c.acquire();
+  };
+
+  for (auto p : ps) {
+    // interleaved writes by raw stores
+    for (std::size_t i = my_rank; i < n; i += n_ranks) {
+      p[i] = i;
+    }
+
+    barrier();
+
+    for (std::size_t i = 0; i < n; i++) {
+      ITYR_CHECK(p[i] == i);
+    }
+
+    barrier();
+
+    // explicit checkout/checkin and get/put calls can be mixed
+    std::size_t chunk = bs / sizeof(std::size_t);
+    if (my_rank == 0) {
+      c.checkout(p + chunk / 2, chunk * sizeof(std::size_t), mode::read_write);
+      for (std::size_t i = chunk / 2; i < chunk / 2 + chunk; i++) {
+        p[i] *= 2;
+      }
+      c.checkin(p + chunk / 2, chunk * sizeof(std::size_t), mode::read_write);
+
+      std::size_t v = 7;
+      c.put(&v, p + n - 1, sizeof(std::size_t));
+    }
+
+    barrier();
+
+    for (std::size_t i = 0; i < n; i++) {
+      std::size_t v;
+      c.get(p + i, &v, sizeof(std::size_t));
+      std::size_t expected = (i == n - 1)                            ? 7 :
+                             (chunk / 2 <= i && i < chunk / 2 + chunk) ? i * 2 : i;
+      ITYR_CHECK(v == expected);
+      ITYR_CHECK(p[i] == expected);
+    }
+
+    barrier();
+  }
+
+  c.free_coll(ps[0]);
+
+  // freeing a transparent region does not affect the other ones
+  std::size_t chunk = bs / sizeof(std::size_t);
+  for (std::size_t i = 0; i < n; i++) {
+    std::size_t expected = (i == n - 1)                            ? 7 :
+                           (chunk / 2 <= i && i < chunk / 2 + chunk) ? i * 2 : i;
+    ITYR_CHECK(ps[1][i] == expected);
+  }
+
+  c.free_coll(ps[1]);
+}
+
+ITYR_TEST_CASE("[ityr::ori::core] compressed read-only fetch") {
+  common::runtime_options common_opts;
+  runtime_options opts;
+  common::singleton_initializer<common::topology::instance> topo;
+  common::singleton_initializer<common::rma::instance> rma;
+  constexpr block_size_t bs = 65536;
+  int n_cb = 16;
+  core<bs> c(n_cb * bs, bs / 4);
+
+  auto my_rank = common::topology::my_rank();
+  auto n_ranks = common::topology::n_ranks();
+
+  std::size_t n = n_cb * 2 * bs / sizeof(std::size_t);
+
+  for (codec cd : {codec::zero_words, codec::delta}) {
+    std::size_t* p = reinterpret_cast<std::size_t*>(c.malloc_coll_compressed<mem_mapper::cyclic>(n * sizeof(std::size_t), cd));
+
+    auto value = [&](std::size_t i) -> std::size_t {
+      return cd == codec::zero_words ? (i % 13 == 0 ? i : 0) : i * 3 + i % 4;
+    };
+
+    for (std::size_t i = my_rank; i < n; i += n_ranks) {
+      std::size_t v = value(i);
+      c.put(&v, p + i, sizeof(std::size_t));
+    }
+
+    // the read-only region is not aligned to blocks
+    std::size_t ro_b = 3;
+    std::size_t ro_e = n - 5;
+    c.set_readonly_coll(p + ro_b, (ro_e - ro_b) * sizeof(std::size_t));
+
+    auto fetched_bytes = [] {
+      return common::sampling::snapshot()[static_cast<std::size_t>(common::sampling::counter::fetched_bytes)];
+    };
+    auto fetched_bytes0 = fetched_bytes();
+
+    for (std::size_t i = ro_b; i < ro_e; i += bs / sizeof(std::size_t) / 4) {
+      std::size_t m = std::min(bs / sizeof(std::size_t), ro_e - i);
+      c.checkout(p + i, m * sizeof(std::size_t), mode::read);
+      for (std::size_t j = i; j < i + m; j++) {
+        ITYR_CHECK(p[j] == value(j));
+      }
+      c.checkin(p + i, m * sizeof(std::size_t), mode::read);
+    }
+
+    if (cd == codec::zero_words) {
+      // most words are zero, so remote blocks are fetched in compressed form
+      ITYR_CHECK(fetched_bytes() - fetched_bytes0 < n * sizeof(std::size_t) / 4);
+    }
+
+    c.unset_readonly_coll(p + ro_b, (ro_e - ro_b) * sizeof(std::size_t));
+
+    // the memory is writable again after the read-only phase
+    if (my_rank == 0) {
+      std::size_t v = 42;
+      c.put(&v, p + n / 2, sizeof(std::size_t));
+    }
+
+    c.release();
+    common::mpi_barrier(common::topology::mpicomm());
+    c.acquire();
+
+    std::size_t v;
+    c.get(p + n / 2, &v, sizeof(std::size_t));
+    ITYR_CHECK(v == 42);
+
+    c.get(p + n - 1, &v, sizeof(std::size_t));
+    ITYR_CHECK(v == value(n - 1));
+
+    common::mpi_barrier(common::topology::mpicomm());
+
+    c.free_coll(p);
+  }
+}
+
+ITYR_TEST_CASE("[ityr::ori::core] memory stats") {
+  common::runtime_options common_opts;
+  runtime_options opts;
+  common::singleton_initializer<common::topology::instance> topo;
+  common::singleton_initializer<common::rma::instance> rma;
+  constexpr block_size_t bs = 65536;
+  int n_cb = 16;
+  core_default<bs> c(n_cb * bs, bs / 4);
+
+  auto n_ranks = common::topology::n_ranks();
+
+  std::size_t n = bs * n_ranks;
+  void* p = c.malloc_coll<mem_mapper::cyclic>(n);
+
+  mem_stats ms = c.get_mem_stats();
+  ITYR_CHECK(ms.coll_mem.current == n);
+
+  // pin all blocks at once
+  c.checkout(p, n, mode::read_write);
+  c.checkin(p, n, mode::read_write);
+
+  void* q = c.malloc(1000);
+  ms = c.get_mem_stats();
+  ITYR_CHECK(ms.noncoll_heap.current > 0);
+  c.free(q, 1000);
+
+  c.release();
+  ms = c.get_mem_stats();
+  ITYR_CHECK(ms.cache_pinned.current == 0);
+  ITYR_CHECK(ms.cache_dirty.current == 0);
+  if (common::topology::inter_n_ranks() > 1) {
+    ITYR_CHECK(ms.cache_pinned.peak > 0);
+    ITYR_CHECK(ms.cache_dirty.peak > 0);
+  }
+
+  common::mpi_barrier(common::topology::mpicomm());
+  c.free_coll(p);
+
+  ms = c.get_mem_stats();
+  ITYR_CHECK(ms.coll_mem.current == 0);
+  ITYR_CHECK(ms.coll_mem.peak == n);
+}
+
+ITYR_TEST_CASE("[ityr::ori::core] cache hit sampling counters") {
+  common::runtime_options common_opts;
+  runtime_options opts;
+  common::singleton_initializer<common::topology::instance> topo;
+  common::singleton_initializer<common::rma::instance> rma;
+  constexpr block_size_t bs = 65536;
+  int n_cb = 16;
+  core_default<bs> c(n_cb * bs, bs / 4);
+
+  auto n_ranks = common::topology::n_ranks();
+
+  std::size_t n = bs * n_ranks;
+  uint8_t* p = reinterpret_cast<uint8_t*>(c.malloc_coll<mem_mapper::cyclic>(n));
+
+  if (common::topology::inter_n_ranks() > 1) {
+    // a block in another node
+    uint8_t* q = p + bs * ((common::topology::my_rank() + common::topology::intra_n_ranks()) % n_ranks);
+
+    auto n_hits = [] {
+      return common::sampling::snapshot()[static_cast<std::size_t>(common::sampling::counter::cache_hit)];
+    };
+
+    for (auto m : {0, 1}) {
+      c.checkout(q, 8, mode::read);
+      c.checkin(q, 8, mode::read);
+
+      // the second checkout of the same block is served by the TLB
+      auto h0 = n_hits();
+      if (m == 0) {
+        c.checkout(q, 8, mode::read);
+        c.checkin(q, 8, mode::read);
+      } else {
+        c.checkout(q, 8, mode::write);
+        c.checkin(q, 8, mode::write);
+      }
+      ITYR_CHECK(n_hits() == h0 + 1);
+    }
+  }
+
+  c.release();
+  common::mpi_barrier(common::topology::mpicomm());
+  c.free_coll(p);
+}
+
 ITYR_TEST_CASE("[ityr::ori::core] checkout/checkin (small, aligned)") {
   common::runtime_options common_opts;
   runtime_options opts;
@@ -1558,4 +2702,55 @@ ITYR_TEST_CASE("[ityr::ori::core] release/acquire fence") {
   c.free_coll(p);
 }
 
+
+ITYR_TEST_CASE("[ityr::ori::core] runtime selection of block size and TLB sizes") {
+  common::runtime_options common_opts;
+  runtime_options opts;
+  common::singleton_initializer<common::topology::instance> topo;
+  common::singleton_initializer<common::rma::instance> rma;
+
+  using test_variants = core_variants<std::integer_sequence<block_size_t, 65536, 16384>,
+                                      std::integer_sequence<int, 3, 0>,
+                                      std::integer_sequence<int, 3>>::type;
+  static_assert(std::tuple_size_v<test_variants> == 4);
+
+  constexpr block_size_t bs = 16384;
+  auto prev_bs       = block_size_option::value();
+  auto prev_tlb_size = cache_tlb_size_option::value();
+  block_size_option::set(bs);
+  cache_tlb_size_option::set(0);
+
+  {
+    int n_cb = 16;
+    core_dispatcher<test_variants> c(n_cb * bs, bs / 4);
+    ITYR_CHECK(c.block_size() == bs);
+
+    auto my_rank = common::topology::my_rank();
+    auto n_ranks = common::topology::n_ranks();
+
+    int n = bs * n_ranks;
+    uint8_t* p = reinterpret_cast<uint8_t*>(c.malloc_coll<mem_mapper::block>(n));
+
+    uint8_t* home_ptr = reinterpret_cast<uint8_t*>(c.get_local_mem(p));
+    for (std::size_t i = 0; i < bs; i++) {
+      home_ptr[i] = my_rank;
+    }
+
+    c.release();
+    common::mpi_barrier(common::topology::mpicomm());
+    c.acquire();
+
+    c.checkout(p, n, mode::read);
+    for (int i = 0; i < n; i++) {
+      ITYR_CHECK_MESSAGE(p[i] == i / bs, "rank: ", my_rank, ", i: ", i);
+    }
+    c.checkin(p, n, mode::read);
+
+    c.free_coll(p);
+  }
+
+  block_size_option::set(prev_bs);
+  cache_tlb_size_option::set(prev_tlb_size);
+}
+
 }
@@ -536,7 +536,7 @@ ITYR_TEST_CASE("[ityr::ori::global_ptr] global reference") {
   runtime_options opts;
   common::singleton_initializer<common::topology::instance> topo_;
   common::singleton_initializer<common::rma::instance> rma_;
-  constexpr block_size_t bs = core::instance::instance_type::block_size;
+  constexpr block_size_t bs = ITYR_ORI_BLOCK_SIZE;
   int n_cb = 16;
   common::singleton_initializer<core::instance> core_(n_cb * bs, bs / 4);
 
@@ -14,18 +14,23 @@
 #include "ityr/ori/cache_system.hpp"
 #include "ityr/ori/tlb.hpp"
 #include "ityr/ori/home_profiler.hpp"
+#include "ityr/ori/alloc_profiler.hpp"
 
 namespace ityr::ori {
 
-template <block_size_t BlockSize>
+template <block_size_t BlockSize, int TLBSize = ITYR_ORI_HOME_TLB_SIZE>
 class home_manager {
   static constexpr bool enable_vm_map = ITYR_ORI_ENABLE_VM_MAP;
 
 public:
-  home_manager(std::size_t mmap_entry_limit)
+  home_manager(std::size_t mmap_entry_limit, alloc_profiler& aprof)
     : mmap_entry_limit_(mmap_entry_limit),
       cs_(mmap_entry_limit_, mmap_entry(this)),
-      home_tlb_({nullptr, 0}, nullptr) {}
+      home_tlb_({nullptr, 0}, nullptr),
+      aprof_(aprof) {}
+
+  // Home segments mapped to the global address space (each consuming an mmap entry)
+  const common::mem_usage& mmap_usage() const { return cs_.usage(); }
 
   template <bool IncrementRef>
   bool checkout_fast(std::byte* addr, std::size_t size) {
@@ -51,6 +56,7 @@ public:
     }
 
     hprof_.record(size, true);
+    aprof_.record_home(addr, size, true);
 
     return true;
   }
@@ -73,6 +79,7 @@ public:
     if (mapped_always) {
       home_tlb_.add({seg_addr, seg_size}, &mmap_entry_dummy_);
       hprof_.record(seg_addr, seg_size, req_addr, req_size, true);
+      aprof_.record_home(seg_addr, seg_size, req_addr, req_size, true);
       return true;
     }
 
@@ -98,6 +105,7 @@ public:
     home_tlb_.add({seg_addr, seg_size}, &me);
 
     hprof_.record(seg_addr, seg_size, req_addr, req_size, mmap_hit);
+    aprof_.record_home(seg_addr, seg_size, req_addr, req_size, mmap_hit);
 
     return checkout_completed;
   }
@@ -149,9 +157,7 @@ public:
     }
 
     if (!home_segments_to_map_.empty()) {
-      for (mmap_entry* me : home_segments_to_map_) {
-        update_mapping(*me);
-      }
+      update_mappings(home_segments_to_map_);
       home_segments_to_map_.clear();
     }
   }
@@ -176,6 +182,7 @@ public:
   void home_prof_begin() { hprof_.start(); }
   void home_prof_end() { hprof_.stop(); }
   void home_prof_print() const { hprof_.print(); }
+  home_prof_result home_prof_get_result() const { return hprof_.get_result(); }
 
 private:
   using cache_key_t = uintptr_t;
@@ -186,6 +193,7 @@ private:
     std::byte*                  mapped_addr = nullptr;
     std::size_t                 size        = 0;
     std::size_t                 mapped_size = 0;
+    bool                        mapped_file_backed = false;
     const common::physical_mem* pm          = nullptr;
     std::size_t                 pm_offset   = 0;
     int                         ref_count   = 0;
@@ -217,26 +225,76 @@ private:
     try {
       return cs_.template ensure_cached<UpdateLRU>(cache_key(addr));
     } catch (cache_full_exception& e) {
-      common::die("home segments are exhausted (too much checked-out memory)");
+      common::die("home segments are exhausted (too much checked-out memory: %ld mmap entries in use)",
+                  cs_.usage().current);
     }
   }
 
-  void update_mapping(mmap_entry& me) {
+  /*
+   * Remap home segments with as few mmap calls as possible; segments that are contiguous both in
+   * virtual memory and in the same physical memory are mapped by a single mmap call.
+   */
+  void update_mappings(std::vector<mmap_entry*>& mes) {
     ITYR_PROFILER_RECORD(prof_event_home_mmap);
 
-    if (me.mapped_addr) {
-      common::verbose<3>("Unmap home segment [%p, %p) (size=%ld)",
-                         me.mapped_addr, me.mapped_addr + me.mapped_size, me.mapped_size);
-      common::mmap_no_physical_mem(me.mapped_addr, me.mapped_size, true);
+    std::sort(mes.begin(), mes.end(),
+              [](const mmap_entry* me1, const mmap_entry* me2) { return me1->addr < me2->addr; });
+    mes.erase(std::unique(mes.begin(), mes.end()), mes.end());
+
+    unmap_regions_.clear();
+    for (mmap_entry* me : mes) {
+      // Skip if the address is (or is going to be) mapped by another entry
+      if (me->mapped_addr && me->mapped_addr != me->addr &&
+          !cs_.is_cached(cache_key(me->mapped_addr))) {
+#ifdef MADV_COLD
+        if (me->mapped_file_backed) {
+          // The LRU order of home segments is passed to the OS so that file pages of less recently
+          // used segments are reclaimed first (for out-of-core memory)
+          madvise(me->mapped_addr, me->mapped_size, MADV_COLD);
+        }
+#endif
+        unmap_regions_.push_back({me->mapped_addr, me->mapped_size});
+      }
+    }
+    std::sort(unmap_regions_.begin(), unmap_regions_.end());
+
+    for (auto it = unmap_regions_.begin(); it != unmap_regions_.end();) {
+      std::byte* addr_b = it->first;
+      std::byte* addr_e = addr_b + it->second;
+      for (++it; it != unmap_regions_.end() && it->first == addr_e; ++it) {
+        addr_e += it->second;
+      }
+      common::verbose<3>("Unmap home segments [%p, %p) (size=%ld)",
+                         addr_b, addr_e, addr_e - addr_b);
+      common::mmap_no_physical_mem(addr_b, addr_e - addr_b, true);
     }
 
-    ITYR_CHECK(me.pm);
-    ITYR_CHECK(me.addr);
-    common::verbose<3>("Map home segment [%p, %p) (size=%ld)",
-                       me.addr, me.addr + me.size, me.size);
-    me.pm->map_to_vm(me.addr, me.size, me.pm_offset);
-    me.mapped_addr = me.addr;
-    me.mapped_size = me.size;
+    for (auto it = mes.begin(); it != mes.end();) {
+      mmap_entry& me_b = **it;
+      std::size_t size = me_b.size;
+      for (++it; it != mes.end() &&
+                 (*it)->pm == me_b.pm &&
+                 (*it)->addr == me_b.addr + size &&
+                 (*it)->pm_offset == me_b.pm_offset + size; ++it) {
+        size += (*it)->size;
+      }
+      ITYR_CHECK(me_b.pm);
+      ITYR_CHECK(me_b.addr);
+      common::verbose<3>("Map home segments [%p, %p) (size=%ld)",
+                         me_b.addr, me_b.addr + size, size);
+      me_b.pm->map_to_vm(me_b.addr, size, me_b.pm_offset);
+
+      if (me_b.pm->file_backed()) {
+        // Asynchronously read the file pages that are not resident
+        madvise(me_b.addr, size, MADV_WILLNEED);
+      }
+    }
+
+    for (mmap_entry* me : mes) {
+      me->mapped_addr        = me->addr;
+      me->mapped_size        = me->size;
+      me->mapped_file_backed = me->pm->file_backed();
+    }
   }
 
   cache_key_t cache_key(void* addr) const {
@@ -247,14 +305,16 @@ private:
 
   using home_tlb = tlb<std::pair<std::byte*, std::size_t>,
                        mmap_entry*,
-                       ITYR_ORI_HOME_TLB_SIZE>;
+                       TLBSize>;
 
   std::size_t                             mmap_entry_limit_;
   cache_system<cache_key_t, mmap_entry>   cs_;
   mmap_entry                              mmap_entry_dummy_ = mmap_entry{nullptr};
   home_tlb                                home_tlb_;
   std::vector<mmap_entry*>                home_segments_to_map_;
+  std::vector<std::pair<std::byte*, std::size_t>> unmap_regions_;
   home_profiler                           hprof_;
+  alloc_profiler&                         aprof_;
 };
 
 }
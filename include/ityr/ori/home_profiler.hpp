@@ -8,6 +8,23 @@
 
 namespace ityr::ori {
 
+/**
+ * @brief Home segment statistics.
+ */
+struct home_prof_result {
+  bool        enabled         = false; ///< False if the home profiler is disabled at compile time.
+  std::size_t requested_bytes = 0;     ///< Bytes requested for home segments.
+  std::size_t seg_hit_count   = 0;     ///< Home segments already mapped.
+  std::size_t seg_miss_count  = 0;     ///< Home segments newly mapped by mmap.
+
+  template <typename Fn>
+  void for_each_field(Fn&& fn) {
+    fn("requested_bytes", requested_bytes);
+    fn("seg_hit_count"  , seg_hit_count);
+    fn("seg_miss_count" , seg_miss_count);
+  }
+};
+
 class home_profiler_disabled {
 public:
   home_profiler_disabled() {}
@@ -15,6 +32,7 @@ public:
   void record(std::byte*, std::size_t, std::byte*, std::size_t, bool) {}
   void start() {}
   void stop() {}
+  home_prof_result get_result() const { return {}; }
   void print() const {}
 };
 
@@ -52,6 +70,10 @@ public:
     enabled_ = false;
   }
 
+  home_prof_result get_result() const {
+    return {true, requested_bytes_, seg_hit_count_, seg_miss_count_};
+  }
+
   void print() const {
     auto requested_bytes_all = common::mpi_reduce_value(requested_bytes_, 0, common::topology::mpicomm());
     auto seg_hit_count_all   = common::mpi_reduce_value(seg_hit_count_  , 0, common::topology::mpicomm());
@@ -3,6 +3,8 @@
 #include "ityr/common/util.hpp"
 #include "ityr/common/rma.hpp"
 #include "ityr/common/allocator.hpp"
+#include "ityr/common/mem_usage.hpp"
+#include "ityr/ori/options.hpp"
 
 namespace ityr::ori {
 
@@ -13,7 +15,11 @@ public:
   root_resource(void* addr, std::size_t size)
     : addr_(addr),
       size_(size),
-      freelist_(reinterpret_cast<uintptr_t>(addr_), size_) {}
+      freelist_(reinterpret_cast<uintptr_t>(addr_), size_) {
+    usage_.capacity = size_;
+  }
+
+  const common::mem_usage& usage() const { return usage_; }
 
   void* do_allocate(std::size_t bytes, std::size_t alignment) override {
     ITYR_CHECK(bytes <= size_);
@@ -23,6 +29,8 @@ public:
       throw std::bad_alloc();
     }
 
+    usage_.add(bytes);
+
     return reinterpret_cast<void*>(*s);
   }
 
@@ -31,6 +39,8 @@ public:
     ITYR_CHECK(bytes <= size_);
 
     freelist_.add(reinterpret_cast<uintptr_t>(p), bytes);
+
+    usage_.sub(bytes);
   }
 
   bool do_is_equal(const common::pmr::memory_resource& other) const noexcept override {
@@ -38,11 +48,22 @@ public:
   }
 
 private:
-  void*            addr_;
-  std::size_t      size_;
-  common::freelist freelist_;
+  void*             addr_;
+  std::size_t       size_;
+  common::freelist  freelist_;
+  common::mem_usage usage_;
 };
 
+/*
+ * Small objects (up to `slab_max_obj_size`) are allocated from slabs, each of which is a
+ * `slab_size`-aligned chunk divided into equal-sized slots of a size class. A slab has a free flag
+ * (one byte) for each slot and a `remote_freed` word in its header, both in the RMA window.
+ * A remote free puts the slot's flag, and the `remote_freed` words of the slabs are put in a batch
+ * after the flags are flushed. Therefore, the owner only has to scan the flags of slabs whose
+ * `remote_freed` is set, instead of walking the list of all live objects.
+ *
+ * Larger objects are allocated from the pool resource with a header that has a free flag.
+ */
 class noncoll_mem final : public common::pmr::memory_resource {
 public:
   noncoll_mem(std::size_t local_max_size, std::size_t alignment)
@@ -52,19 +73,32 @@ public:
       local_base_addr_(reinterpret_cast<std::byte*>(vm_.addr()) + local_max_size_ * common::topology::my_rank()),
       pm_(init_pm()),
       win_(common::rma::create_win(local_base_addr_, local_max_size_)),
-      root_mr_(local_base_addr_, local_max_size_ - sizeof(int)), // The last element is used for a flag value for deallocation
+      root_mr_(local_base_addr_, local_max_size_ - sizeof(remote_free_values)), // The last bytes are used for flag values for deallocation
       std_pool_mr_(my_std_pool_options(), &root_mr_),
       max_unflushed_free_objs_(common::allocator_max_unflushed_free_objs_option::value()),
       allocated_size_(0),
       collect_threshold_(std::size_t(16) * 1024),
-      collect_threshold_max_(local_max_size_ * 8 / 10) {
-    // Set the flag value for deallocation
-    *reinterpret_cast<int*>(
-      reinterpret_cast<std::byte*>(local_base_addr_) + local_max_size_ - sizeof(int)) = remote_free_flag_value;
+      collect_threshold_max_(local_max_size_ * 8 / 10),
+      slab_size_(noncoll_slab_size_option::value()),
+      slab_max_obj_size_(calc_slab_max_obj_size()) {
+    ITYR_REQUIRE_MESSAGE(slab_size_ == 0 || common::is_pow2(slab_size_),
+                         "The slab size (%ld) must be a power of two", slab_size_);
+
+    // Set the flag values for deallocation
+    new (remote_free_values_ptr()) remote_free_values{};
+
+    for (int c = 0; c < n_size_classes; c++) {
+      slab_layouts_[c] = calc_slab_layout(c);
+    }
+
+    common::topology::check_numa_placement("noncollective memory", local_base_addr_, local_max_size_);
   }
 
   const common::rma::win& win() const { return *win_; }
 
+  // Memory usage of the local heap (including the pool's and slabs' internal fragmentation)
+  const common::mem_usage& heap_usage() const { return root_mr_.usage(); }
+
   bool has(const void* p) const {
     return vm_.addr() <= p && p < reinterpret_cast<std::byte*>(vm_.addr()) + global_max_size_;
   }
@@ -80,6 +114,13 @@ public:
   void* do_allocate(std::size_t bytes, std::size_t alignment = alignof(max_align_t)) override {
     ITYR_PROFILER_RECORD(common::prof_event_allocator_alloc);
 
+    if (is_slab_obj(bytes, alignment)) {
+      if (allocated_size_ >= collect_threshold_) {
+        collect_deallocated();
+      }
+      return slab_allocate(size_class(bytes));
+    }
+
     std::size_t pad_bytes = common::round_up_pow2(sizeof(header), alignment);
     std::size_t real_bytes = bytes + pad_bytes;
 
@@ -97,7 +138,7 @@ public:
         p = reinterpret_cast<std::byte*>(std_pool_mr_.allocate(real_bytes, alignment));
       } catch (std::bad_alloc& e) {
         // TODO: throw std::bad_alloc?
-        common::die("[ityr::ori::noncoll_mem] Could not allocate memory for malloc_local()");
+        die_out_of_memory(real_bytes);
       }
     };
 
@@ -136,6 +177,11 @@ public:
 
     ITYR_CHECK(get_owner(p) == common::topology::my_rank());
 
+    if (is_slab_obj(bytes, alignment)) {
+      slab_deallocate(get_slab(p), p);
+      return;
+    }
+
     std::size_t pad_bytes = common::round_up_pow2(sizeof(header), alignment);
     std::size_t real_bytes = bytes + pad_bytes;
 
@@ -153,26 +199,78 @@ public:
     ITYR_CHECK(common::topology::my_rank() != target_rank);
     ITYR_CHECK(get_owner(p) == target_rank);
 
-    int* flag_val_p = reinterpret_cast<int*>(
-      reinterpret_cast<std::byte*>(local_base_addr_) + local_max_size_ - sizeof(int));
-    common::rma::put_nb(win(), flag_val_p, 1, win(), target_rank, get_header_disp(p, alignment));
+    remote_free_values* vals = remote_free_values_ptr();
 
-    static int count = 0;
-    count++;
-    if (count >= max_unflushed_free_objs_) {
+    if (is_slab_obj(bytes, alignment)) {
+      // The slab layout is determined by the size class, so no remote read is needed
+      const slab_layout& sl = slab_layouts_[size_class(bytes)];
+      std::byte* slab_addr = common::round_down_pow2(reinterpret_cast<std::byte*>(p), slab_size_);
+      std::size_t slot_idx = (reinterpret_cast<std::byte*>(p) - (slab_addr + sl.objs_offset)) / sl.obj_size;
+      ITYR_CHECK(slot_idx < sl.n_slots);
+
+      common::rma::put_nb(win(), &vals->slab_flag, 1, win(), target_rank,
+                          get_disp(slab_addr + sizeof(slab) + slot_idx));
+
+      std::size_t hint_disp = get_disp(slab_addr + offsetof(slab, remote_freed));
+      if (pending_slab_hints_.empty() ||
+          pending_slab_hints_.back() != std::make_pair(target_rank, hint_disp)) {
+        pending_slab_hints_.emplace_back(target_rank, hint_disp);
+      }
+    } else {
+      common::rma::put_nb(win(), &vals->header_flag, 1, win(), target_rank, get_header_disp(p, alignment));
+    }
+
+    n_unflushed_free_objs_++;
+    if (n_unflushed_free_objs_ >= max_unflushed_free_objs_) {
+      flush_remote_frees();
+    }
+  }
+
+  // Make remote frees issued so far visible to the owners
+  void flush_remote_frees() {
+    if (n_unflushed_free_objs_ == 0) return;
+
+    common::rma::flush(win());
+
+    if (!pending_slab_hints_.empty()) {
+      // The free flags must have been written before the owners see the hints
+      std::sort(pending_slab_hints_.begin(), pending_slab_hints_.end());
+      pending_slab_hints_.erase(std::unique(pending_slab_hints_.begin(), pending_slab_hints_.end()),
+                                pending_slab_hints_.end());
+
+      remote_free_values* vals = remote_free_values_ptr();
+      for (auto [target_rank, hint_disp] : pending_slab_hints_) {
+        common::rma::put_nb(win(), &vals->slab_hint, 1, win(), target_rank, hint_disp);
+      }
       common::rma::flush(win());
-      count = 0;
+
+      pending_slab_hints_.clear();
     }
+
+    n_unflushed_free_objs_ = 0;
   }
 
   void collect_deallocated() {
     ITYR_PROFILER_RECORD(common::prof_event_allocator_collect);
 
+    flush_remote_frees();
+
+    for (int c = 0; c < n_size_classes; c++) {
+      slab* s = slabs_[c];
+      while (s) {
+        slab* s_next = s->next;
+        if (s->remote_freed.load(std::memory_order_acquire)) {
+          collect_slab(s);
+        }
+        s = s_next;
+      }
+    }
+
     header *h = allocated_list_.next;
     while (h) {
       int flag = h->freed.load(std::memory_order_acquire);
       if (flag) {
-        ITYR_CHECK_MESSAGE(flag == remote_free_flag_value, "noncoll memory corruption");
+        ITYR_CHECK_MESSAGE(flag == header_free_flag_value, "noncoll memory corruption");
         header* h_next = h->next;
         local_deallocate_impl(h, h->size, h->alignment);
         h = h_next;
@@ -191,9 +289,20 @@ public:
     return common::topology::is_locally_accessible(get_owner(p));
   }
 
-  bool is_remotely_freed(void* p, std::size_t alignment = alignof(max_align_t)) {
+  bool is_remotely_freed(void* p, std::size_t bytes, std::size_t alignment = alignof(max_align_t)) {
     ITYR_CHECK(get_owner(p) == common::topology::my_rank());
 
+    if (is_slab_obj(bytes, alignment)) {
+      slab* s = get_slab(p);
+      std::size_t slot_idx = (reinterpret_cast<std::byte*>(p) - slab_objs(s)) / s->obj_size;
+      if (slab_flags(s)[slot_idx]) {
+        slab_flags(s)[slot_idx] = 0;
+        slab_deallocate(s, p);
+        return true;
+      }
+      return false;
+    }
+
     std::size_t pad_bytes = common::round_up_pow2(sizeof(header), alignment);
     header* h = reinterpret_cast<header*>(reinterpret_cast<std::byte*>(p) - pad_bytes);
 
@@ -206,7 +315,7 @@ public:
 
   // mainly for debugging
   bool empty() {
-    return allocated_list_.next == nullptr;
+    return allocated_list_.next == nullptr && n_slab_objs_ == 0;
   }
 
 private:
@@ -240,7 +349,7 @@ private:
     }
 
     if (common::topology::numa_enabled()) {
-      common::numa::bind_to(local_base_addr_, local_max_size_, common::topology::numa_my_node());
+      common::topology::numa_bind_local(local_base_addr_, local_max_size_);
       common::mpi_barrier(common::topology::intra_mpicomm());
     }
 
@@ -290,7 +399,263 @@ private:
     allocated_size_ -= size;
   }
 
-  static constexpr int remote_free_flag_value = 417;
+  /* Slab allocation for small objects */
+
+  // 8 classes of 16-byte steps up to 128 bytes, and then 4 classes for each power of two up to 2 KiB
+  static constexpr int         n_size_classes    = 24;
+  static constexpr std::size_t slab_obj_align    = alignof(max_align_t);
+  static constexpr std::size_t slab_min_n_slots  = 8;
+
+  static constexpr std::size_t class_obj_size(int c) {
+    if (c < 8) return slab_obj_align * (c + 1);
+    std::size_t base = std::size_t(1) << (7 + (c - 8) / 4);
+    return base + (base / 4) * ((c - 8) % 4 + 1);
+  }
+
+  static int size_class(std::size_t bytes) {
+    ITYR_CHECK(bytes <= class_obj_size(n_size_classes - 1));
+    if (bytes <= 128) {
+      return (std::max(bytes, std::size_t(1)) - 1) / slab_obj_align;
+    }
+    int lg = 63 - __builtin_clzl(bytes - 1);
+    std::size_t base = std::size_t(1) << lg;
+    return 8 + (lg - 7) * 4 + (bytes - 1 - base) / (base / 4);
+  }
+
+  struct slab {
+    std::atomic<int> remote_freed = 0; // hint written by remote processes; must be at the beginning
+    int              size_class   = 0;
+    uint32_t         obj_size     = 0;
+    uint32_t         n_slots      = 0;
+    uint32_t         n_used       = 0;
+    uint32_t         n_touched    = 0; // slots [n_touched, n_slots) have never been used
+    void*            free_list    = nullptr;
+    slab*            prev         = nullptr;
+    slab*            next         = nullptr;
+    slab*            avail_prev   = nullptr;
+    slab*            avail_next   = nullptr;
+    bool             available    = false;
+    // followed by free flags (uint8_t[n_slots]) and objects
+  };
+
+  struct slab_layout {
+    std::size_t obj_size;
+    std::size_t n_slots;
+    std::size_t objs_offset;
+  };
+
+  struct remote_free_values {
+    int     header_flag = header_free_flag_value;
+    int     slab_hint   = 1;
+    uint8_t slab_flag   = slab_free_flag_value;
+  };
+
+  remote_free_values* remote_free_values_ptr() const {
+    return reinterpret_cast<remote_free_values*>(
+        reinterpret_cast<std::byte*>(local_base_addr_) + local_max_size_ - sizeof(remote_free_values));
+  }
+
+  std::size_t calc_slab_max_obj_size() const {
+    if (slab_size_ == 0) return 0;
+    std::size_t max_size = 0;
+    for (int c = 0; c < n_size_classes; c++) {
+      std::size_t s = class_obj_size(c);
+      if (sizeof(slab) + slab_min_n_slots * (s + 1) + slab_obj_align <= slab_size_) {
+        max_size = s;
+      }
+    }
+    return max_size;
+  }
+
+  slab_layout calc_slab_layout(int c) const {
+    std::size_t obj_size = class_obj_size(c);
+    if (obj_size > slab_max_obj_size_) return {obj_size, 0, 0};
+
+    std::size_t n_slots = (slab_size_ - sizeof(slab)) / (obj_size + 1);
+    std::size_t objs_offset;
+    while (true) {
+      objs_offset = common::round_up_pow2(sizeof(slab) + n_slots, slab_obj_align);
+      if (objs_offset + n_slots * obj_size <= slab_size_) break;
+      n_slots--;
+    }
+    ITYR_CHECK(n_slots >= slab_min_n_slots);
+    return {obj_size, n_slots, objs_offset};
+  }
+
+  bool is_slab_obj(std::size_t bytes, std::size_t alignment) const {
+    return slab_size_ != 0 && bytes <= slab_max_obj_size_ && alignment <= slab_obj_align;
+  }
+
+  slab* get_slab(void* p) const {
+    return reinterpret_cast<slab*>(common::round_down_pow2(reinterpret_cast<std::byte*>(p), slab_size_));
+  }
+
+  uint8_t* slab_flags(slab* s) const {
+    return reinterpret_cast<uint8_t*>(s) + sizeof(slab);
+  }
+
+  std::byte* slab_objs(slab* s) const {
+    return reinterpret_cast<std::byte*>(s) + slab_layouts_[s->size_class].objs_offset;
+  }
+
+  [[noreturn]] void die_out_of_memory(std::size_t bytes) const {
+    const auto& u = root_mr_.usage();
+    common::die("[ityr::ori::noncoll_mem] Could not allocate %ld bytes of noncollective memory "
+                "(%ld/%ld bytes in use, peak %ld bytes); consider increasing ITYR_ORI_NONCOLL_ALLOCATOR_SIZE",
+                bytes, u.current, u.capacity, u.peak);
+  }
+
+  slab* new_slab(int c) {
+    void* p;
+    if (empty_slabs_) {
+      // Empty slabs are never returned to the upstream, as delayed hints from remote processes
+      // may be written to their headers
+      p = empty_slabs_;
+      empty_slabs_ = empty_slabs_->next;
+    } else {
+      try {
+        p = root_mr_.allocate(slab_size_, slab_size_);
+      } catch (std::bad_alloc& e) {
+        collect_deallocated();
+        try {
+          p = root_mr_.allocate(slab_size_, slab_size_);
+        } catch (std::bad_alloc& e) {
+          die_out_of_memory(slab_size_);
+        }
+      }
+    }
+
+    const slab_layout& sl = slab_layouts_[c];
+
+    slab* s = new (p) slab;
+    s->size_class = c;
+    s->obj_size   = sl.obj_size;
+    s->n_slots    = sl.n_slots;
+    std::memset(slab_flags(s), 0, sl.n_slots);
+
+    s->next = slabs_[c];
+    if (s->next) s->next->prev = s;
+    slabs_[c] = s;
+
+    return s;
+  }
+
+  void add_available_slab(slab* s) {
+    ITYR_CHECK(!s->available);
+    s->available  = true;
+    s->avail_prev = nullptr;
+    s->avail_next = available_slabs_[s->size_class];
+    if (s->avail_next) s->avail_next->avail_prev = s;
+    available_slabs_[s->size_class] = s;
+  }
+
+  void remove_available_slab(slab* s) {
+    ITYR_CHECK(s->available);
+    s->available = false;
+    if (s->avail_prev) {
+      s->avail_prev->avail_next = s->avail_next;
+    } else {
+      available_slabs_[s->size_class] = s->avail_next;
+    }
+    if (s->avail_next) s->avail_next->avail_prev = s->avail_prev;
+  }
+
+  void* slab_allocate(int c) {
+    slab* s = available_slabs_[c];
+    if (!s) {
+      s = new_slab(c);
+      add_available_slab(s);
+    }
+
+    void* ret;
+    if (s->free_list) {
+      ret = s->free_list;
+      s->free_list = *reinterpret_cast<void**>(ret);
+    } else {
+      ITYR_CHECK(s->n_touched < s->n_slots);
+      ret = slab_objs(s) + std::size_t(s->n_touched) * s->obj_size;
+      s->n_touched++;
+    }
+
+    s->n_used++;
+    if (s->n_used == s->n_slots) {
+      remove_available_slab(s);
+    }
+
+    n_slab_objs_++;
+    allocated_size_ += s->obj_size;
+
+    return ret;
+  }
+
+  void slab_deallocate(slab* s, void* p) {
+    ITYR_CHECK(s->n_used > 0);
+    ITYR_CHECK((reinterpret_cast<std::byte*>(p) - slab_objs(s)) % s->obj_size == 0);
+
+    *reinterpret_cast<void**>(p) = s->free_list;
+    s->free_list = p;
+
+    if (s->n_used == s->n_slots) {
+      add_available_slab(s);
+    }
+    s->n_used--;
+
+    ITYR_CHECK(n_slab_objs_ > 0);
+    n_slab_objs_--;
+    ITYR_CHECK(allocated_size_ >= s->obj_size);
+    allocated_size_ -= s->obj_size;
+
+    // Keep at least one slab for each size class
+    if (s->n_used == 0 && (s->prev || s->next)) {
+      remove_available_slab(s);
+      if (s->prev) {
+        s->prev->next = s->next;
+      } else {
+        slabs_[s->size_class] = s->next;
+      }
+      if (s->next) s->next->prev = s->prev;
+
+      // The header is kept as is, as remote processes may still write `remote_freed`
+      s->next = empty_slabs_;
+      empty_slabs_ = s;
+    }
+  }
+
+  void collect_slab(slab* s) {
+    // Reset the hint before scanning flags; flags set after this will come with another hint
+    s->remote_freed.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    uint8_t* flags = slab_flags(s);
+    std::byte* objs = slab_objs(s);
+    std::size_t n_slots = s->n_slots;
+    std::size_t obj_size = s->obj_size;
+
+    std::size_t i = 0;
+    while (i < n_slots) {
+      // skip words with no flag quickly
+      if (i + sizeof(uint64_t) <= n_slots) {
+        uint64_t w;
+        std::memcpy(&w, flags + i, sizeof(uint64_t));
+        if (w == 0) {
+          i += sizeof(uint64_t);
+          continue;
+        }
+      }
+      if (flags[i]) {
+        ITYR_CHECK_MESSAGE(flags[i] == slab_free_flag_value, "noncoll memory corruption");
+        flags[i] = 0;
+        // `s` can be moved to the list of empty slabs, but its memory is never reused during the scan
+        bool last = (s->n_used == 1);
+        slab_deallocate(s, objs + i * obj_size);
+        if (last) break;
+      }
+      i++;
+    }
+  }
+
+  static constexpr int     header_free_flag_value = 417;
+  static constexpr uint8_t slab_free_flag_value   = 0x5a;
 
   std::size_t                               local_max_size_;
   std::size_t                               global_max_size_;
@@ -306,6 +671,84 @@ private:
   std::size_t                               allocated_size_;
   std::size_t                               collect_threshold_;
   std::size_t                               collect_threshold_max_;
+  int                                       n_unflushed_free_objs_ = 0;
+  std::size_t                               slab_size_;
+  std::size_t                               slab_max_obj_size_;
+  std::array<slab_layout, n_size_classes>   slab_layouts_;
+  std::array<slab*, n_size_classes>         slabs_           = {};
+  std::array<slab*, n_size_classes>         available_slabs_ = {};
+  slab*                                     empty_slabs_     = nullptr;
+  std::size_t                               n_slab_objs_     = 0;
+  std::vector<std::pair<common::topology::rank_t, std::size_t>> pending_slab_hints_;
 };
 
+ITYR_TEST_CASE("[ityr::ori::noncoll_mem] slab allocation and remote free") {
+  common::runtime_options common_opts;
+  runtime_options opts;
+  common::singleton_initializer<common::topology::instance> topo;
+  common::singleton_initializer<common::rma::instance> rma;
+
+  noncoll_mem nm(std::size_t(16) * 1024 * 1024, 65536);
+
+  auto my_rank = common::topology::my_rank();
+  auto n_ranks = common::topology::n_ranks();
+  auto mpicomm = common::topology::mpicomm();
+
+  // includes sizes for both slabs and the pool resource
+  std::vector<std::size_t> sizes = {1, 8, 16, 17, 100, 128, 129, 1000, 2048, 2049, 10000};
+  constexpr int n = 300;
+
+  std::vector<std::pair<void*, std::size_t>> objs;
+  for (int i = 0; i < n; i++) {
+    for (auto size : sizes) {
+      void* p = nm.allocate(size);
+      ITYR_CHECK(nm.get_owner(p) == my_rank);
+      ITYR_CHECK(reinterpret_cast<uintptr_t>(p) % alignof(max_align_t) == 0);
+      std::memset(p, my_rank + 1, size);
+      objs.emplace_back(p, size);
+    }
+  }
+
+  for (auto [p, size] : objs) {
+    for (std::size_t j = 0; j < size; j++) {
+      ITYR_CHECK(reinterpret_cast<uint8_t*>(p)[j] == my_rank + 1);
+    }
+  }
+
+  ITYR_SUBCASE("local free") {
+    for (auto [p, size] : objs) {
+      nm.deallocate(p, size);
+    }
+  }
+
+  ITYR_SUBCASE("remote free") {
+    // exchange objects with the neighbor and free them remotely
+    std::size_t n_objs = objs.size();
+    std::vector<std::pair<void*, std::size_t>> objs_recv(n_objs);
+    auto req_send = common::mpi_isend(objs.data(), n_objs, (n_ranks + my_rank + 1) % n_ranks, 0, mpicomm);
+    auto req_recv = common::mpi_irecv(objs_recv.data(), n_objs, (n_ranks + my_rank - 1) % n_ranks, 0, mpicomm);
+    common::mpi_wait(req_send);
+    common::mpi_wait(req_recv);
+
+    for (auto [p, size] : objs_recv) {
+      nm.deallocate(p, size);
+    }
+
+    nm.flush_remote_frees();
+    common::mpi_barrier(mpicomm);
+  }
+
+  nm.collect_deallocated();
+  ITYR_CHECK(nm.empty());
+
+  // freed slots are reused
+  for (auto [p, size] : objs) {
+    void* p2 = nm.allocate(size);
+    nm.deallocate(p2, size);
+  }
+  ITYR_CHECK(nm.empty());
+
+  common::mpi_barrier(mpicomm);
+}
+
 }
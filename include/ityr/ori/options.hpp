@@ -55,8 +55,42 @@ inline void print_compile_options() {
 #define ITYR_ORI_HOME_TLB_SIZE 3
 #endif
   ITYR_PRINT_MACRO(ITYR_ORI_HOME_TLB_SIZE);
+
+  // Comma-separated lists of the variants selectable at runtime (see core_dispatcher)
+#ifndef ITYR_ORI_BLOCK_SIZE_VARIANTS
+#define ITYR_ORI_BLOCK_SIZE_VARIANTS ITYR_ORI_BLOCK_SIZE
+#endif
+  ITYR_PRINT_MACRO(ITYR_ORI_BLOCK_SIZE_VARIANTS);
+
+#ifndef ITYR_ORI_CACHE_TLB_SIZE_VARIANTS
+#define ITYR_ORI_CACHE_TLB_SIZE_VARIANTS ITYR_ORI_CACHE_TLB_SIZE
+#endif
+  ITYR_PRINT_MACRO(ITYR_ORI_CACHE_TLB_SIZE_VARIANTS);
+
+#ifndef ITYR_ORI_HOME_TLB_SIZE_VARIANTS
+#define ITYR_ORI_HOME_TLB_SIZE_VARIANTS ITYR_ORI_HOME_TLB_SIZE
+#endif
+  ITYR_PRINT_MACRO(ITYR_ORI_HOME_TLB_SIZE_VARIANTS);
 }
 
+struct block_size_option : public common::option<block_size_option, std::size_t> {
+  using option::option;
+  static std::string name() { return "ITYR_ORI_BLOCK_SIZE"; }
+  static std::size_t default_value() { return ITYR_ORI_BLOCK_SIZE; }
+};
+
+struct cache_tlb_size_option : public common::option<cache_tlb_size_option, int> {
+  using option::option;
+  static std::string name() { return "ITYR_ORI_CACHE_TLB_SIZE"; }
+  static int default_value() { return ITYR_ORI_CACHE_TLB_SIZE; }
+};
+
+struct home_tlb_size_option : public common::option<home_tlb_size_option, int> {
+  using option::option;
+  static std::string name() { return "ITYR_ORI_HOME_TLB_SIZE"; }
+  static int default_value() { return ITYR_ORI_HOME_TLB_SIZE; }
+};
+
 struct cache_size_option : public common::option<cache_size_option, std::size_t> {
   using option::option;
   static std::string name() { return "ITYR_ORI_CACHE_SIZE"; }
@@ -81,6 +115,12 @@ struct noncoll_allocator_size_option : public common::option<noncoll_allocator_s
   static std::size_t default_value() { return std::size_t(4) * 1024 * 1024; }
 };
 
+struct noncoll_slab_size_option : public common::option<noncoll_slab_size_option, std::size_t> {
+  using option::option;
+  static std::string name() { return "ITYR_ORI_NONCOLL_SLAB_SIZE"; }
+  static std::size_t default_value() { return std::size_t(16) * 1024; }
+};
+
 struct lazy_release_check_interval_option : public common::option<lazy_release_check_interval_option, int> {
   using option::option;
   static std::string name() { return "ITYR_ORI_LAZY_RELEASE_CHECK_INTERVAL"; }
@@ -93,13 +133,24 @@ struct lazy_release_make_mpi_progress_option : public common::option<lazy_releas
   static bool default_value() { return true; }
 };
 
+struct scratch_dir_option : public common::option<scratch_dir_option, std::string> {
+  using option::option;
+  static std::string name() { return "ITYR_ORI_SCRATCH_DIR"; }
+  static std::string default_value() { return "/var/tmp"; }
+};
+
 struct runtime_options {
+  common::option_initializer<block_size_option>                     ITYR_ANON_VAR;
+  common::option_initializer<cache_tlb_size_option>                 ITYR_ANON_VAR;
+  common::option_initializer<home_tlb_size_option>                  ITYR_ANON_VAR;
   common::option_initializer<cache_size_option>                     ITYR_ANON_VAR;
   common::option_initializer<sub_block_size_option>                 ITYR_ANON_VAR;
   common::option_initializer<max_dirty_cache_size_option>           ITYR_ANON_VAR;
   common::option_initializer<noncoll_allocator_size_option>         ITYR_ANON_VAR;
+  common::option_initializer<noncoll_slab_size_option>              ITYR_ANON_VAR;
   common::option_initializer<lazy_release_check_interval_option>    ITYR_ANON_VAR;
   common::option_initializer<lazy_release_make_mpi_progress_option> ITYR_ANON_VAR;
+  common::option_initializer<scratch_dir_option>                    ITYR_ANON_VAR;
 };
 
 }
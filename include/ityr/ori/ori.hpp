@@ -10,12 +10,14 @@
 #include "ityr/ori/util.hpp"
 #include "ityr/ori/options.hpp"
 #include "ityr/ori/core.hpp"
+#include "ityr/ori/codec.hpp"
 #include "ityr/ori/global_ptr.hpp"
 #include "ityr/ori/file_mem_manager.hpp"
 #include "ityr/ori/prof_events.hpp"
 
 namespace ityr::ori {
 
+// Default block size; the actual one can be selected at runtime (see `get_block_size()`)
 inline constexpr block_size_t block_size = ITYR_ORI_BLOCK_SIZE;
 
 class ori {
@@ -50,6 +52,10 @@ inline void fini() {
   instance::fini();
 }
 
+inline block_size_t get_block_size() {
+  return core::instance::get().block_size();
+}
+
 template <typename T>
 inline global_ptr<T> malloc_coll(std::size_t count) {
   return global_ptr<T>(reinterpret_cast<T*>(core::instance::get().malloc_coll(count * sizeof(T))));
@@ -61,11 +67,65 @@ inline global_ptr<T> malloc_coll(std::size_t count, MemMapperArgs&&... mmargs) {
                                                                                          std::forward<MemMapperArgs>(mmargs)...)));
 }
 
+template <typename T>
+inline global_ptr<T> malloc_coll_ooc(std::size_t count) {
+  return malloc_coll_ooc<T, mem_mapper::ITYR_ORI_DEFAULT_MEM_MAPPER>(count);
+}
+
+template <typename T, template <block_size_t> typename MemMapper, typename... MemMapperArgs>
+inline global_ptr<T> malloc_coll_ooc(std::size_t count, MemMapperArgs&&... mmargs) {
+  return global_ptr<T>(reinterpret_cast<T*>(core::instance::get().template malloc_coll_ooc<MemMapper>(
+          count * sizeof(T), std::forward<MemMapperArgs>(mmargs)...)));
+}
+
+template <typename T>
+inline global_ptr<T> malloc_coll_transparent(std::size_t count) {
+  return malloc_coll_transparent<T, mem_mapper::ITYR_ORI_DEFAULT_MEM_MAPPER>(count);
+}
+
+template <typename T, template <block_size_t> typename MemMapper, typename... MemMapperArgs>
+inline global_ptr<T> malloc_coll_transparent(std::size_t count, MemMapperArgs&&... mmargs) {
+  return global_ptr<T>(reinterpret_cast<T*>(core::instance::get().template malloc_coll_transparent<MemMapper>(
+          count * sizeof(T), std::forward<MemMapperArgs>(mmargs)...)));
+}
+
+template <typename T>
+inline global_ptr<T> malloc_coll_compressed(std::size_t count, codec c) {
+  return malloc_coll_compressed<T, mem_mapper::ITYR_ORI_DEFAULT_MEM_MAPPER>(count, c);
+}
+
+template <typename T, template <block_size_t> typename MemMapper, typename... MemMapperArgs>
+inline global_ptr<T> malloc_coll_compressed(std::size_t count, codec c, MemMapperArgs&&... mmargs) {
+  return global_ptr<T>(reinterpret_cast<T*>(core::instance::get().template malloc_coll_compressed<MemMapper>(
+          count * sizeof(T), c, std::forward<MemMapperArgs>(mmargs)...)));
+}
+
+template <typename T>
+inline global_ptr<T> malloc_coll_file(const std::string& fpath, std::size_t count) {
+  return global_ptr<T>(reinterpret_cast<T*>(core::instance::get().malloc_coll_file(fpath, count * sizeof(T))));
+}
+
+template <typename T>
+inline void sync_file_coll(global_ptr<T> ptr) {
+  core::instance::get().sync_file_coll(const_cast<std::remove_const_t<T>*>(ptr.raw_ptr()));
+}
+
 template <typename T>
 inline global_ptr<T> malloc(std::size_t count) {
   return global_ptr<T>(reinterpret_cast<T*>(core::instance::get().malloc(count * sizeof(T))));
 }
 
+/**
+ * @brief Attach a label to the collective memory allocation that contains `ptr`.
+ *
+ * Labels are used to report cache and communication statistics for each allocation
+ * when the cache profiler is enabled (`ITYR_ORI_CACHE_PROF=stats`); otherwise they are ignored.
+ */
+template <typename T>
+inline void set_coll_label(global_ptr<T> ptr, const std::string& label) {
+  core::instance::get().set_coll_label(const_cast<std::remove_const_t<T>*>(ptr.raw_ptr()), label);
+}
+
 template <typename T>
 inline void free_coll(global_ptr<T> ptr) {
   core::instance::get().free_coll(ptr.raw_ptr());
@@ -241,6 +301,46 @@ inline void cache_prof_print() {
   core::instance::get().cache_prof_print();
 }
 
+inline cache_prof_result cache_prof_get_result() {
+  return core::instance::get().cache_prof_get_result();
+}
+
+inline home_prof_result home_prof_get_result() {
+  return core::instance::get().home_prof_get_result();
+}
+
+inline std::vector<alloc_prof_result> alloc_prof_get_result() {
+  return core::instance::get().alloc_prof_get_result();
+}
+
+inline mem_stats get_mem_stats() {
+  return core::instance::get().get_mem_stats();
+}
+
+inline void mem_stats_print() {
+  mem_stats ms = get_mem_stats();
+  if (common::topology::my_rank() == 0) {
+    printf("[Global memory]\n");
+  }
+  common::print_mem_usage("Cache blocks:"          , ms.cache_blocks     , "blocks");
+  common::print_mem_usage("Checked-out cache:"     , ms.cache_pinned     , "blocks");
+  common::print_mem_usage("Dirty cache:"           , ms.cache_dirty      , "bytes");
+  common::print_mem_usage("Noncollective heap:"    , ms.noncoll_heap     , "bytes");
+  common::print_mem_usage("Home mmap entries:"     , ms.home_mmap_entries, "entries");
+  common::print_mem_usage("Collective memory:"     , ms.coll_mem         , "bytes");
+  common::print_mem_usage("Collective memory home:", ms.coll_mem_home    , "bytes");
+  if (common::topology::my_rank() == 0) {
+    printf("\n");
+    fflush(stdout);
+  }
+}
+
+template <typename T, typename Fn>
+inline void for_each_local_home(global_ptr<T> ptr, std::size_t count, Fn&& fn) {
+  core::instance::get().for_each_local_home(const_cast<std::remove_const_t<T>*>(ptr.raw_ptr()),
+                                            count * sizeof(T), std::forward<Fn>(fn));
+}
+
 inline void* file_mem_alloc_coll(const std::string& fpath, bool mlock) {
   return file_mem_manager::instance::get().create(fpath, mlock);
 }
@@ -63,22 +63,34 @@ struct prof_event_home_mmap : public common::profiler::event {
   std::string str() const override { return "home_mmap"; }
 };
 
+struct prof_event_cache_fetch_comp : public common::profiler::event {
+  using event::event;
+  std::string str() const override { return "cache_fetch_comp"; }
+};
+
+struct prof_event_cache_writeback_comp : public common::profiler::event {
+  using event::event;
+  std::string str() const override { return "cache_writeback_comp"; }
+};
+
 class prof_events {
 public:
   prof_events() {}
 
 private:
-  common::profiler::event_initializer<prof_event_get>           ITYR_ANON_VAR;
-  common::profiler::event_initializer<prof_event_put>           ITYR_ANON_VAR;
-  common::profiler::event_initializer<prof_event_checkout_nb>   ITYR_ANON_VAR;
-  common::profiler::event_initializer<prof_event_checkout_comp> ITYR_ANON_VAR;
-  common::profiler::event_initializer<prof_event_checkin>       ITYR_ANON_VAR;
-  common::profiler::event_initializer<prof_event_release>       ITYR_ANON_VAR;
-  common::profiler::event_initializer<prof_event_acquire>       ITYR_ANON_VAR;
-  common::profiler::event_initializer<prof_event_release_lazy>  ITYR_ANON_VAR;
-  common::profiler::event_initializer<prof_event_acquire_wait>  ITYR_ANON_VAR;
-  common::profiler::event_initializer<prof_event_cache_mmap>    ITYR_ANON_VAR;
-  common::profiler::event_initializer<prof_event_home_mmap>     ITYR_ANON_VAR;
+  common::profiler::event_initializer<prof_event_get>                  ITYR_ANON_VAR;
+  common::profiler::event_initializer<prof_event_put>                  ITYR_ANON_VAR;
+  common::profiler::event_initializer<prof_event_checkout_nb>          ITYR_ANON_VAR;
+  common::profiler::event_initializer<prof_event_checkout_comp>        ITYR_ANON_VAR;
+  common::profiler::event_initializer<prof_event_checkin>              ITYR_ANON_VAR;
+  common::profiler::event_initializer<prof_event_release>              ITYR_ANON_VAR;
+  common::profiler::event_initializer<prof_event_acquire>              ITYR_ANON_VAR;
+  common::profiler::event_initializer<prof_event_release_lazy>         ITYR_ANON_VAR;
+  common::profiler::event_initializer<prof_event_acquire_wait>         ITYR_ANON_VAR;
+  common::profiler::event_initializer<prof_event_cache_mmap>           ITYR_ANON_VAR;
+  common::profiler::event_initializer<prof_event_home_mmap>            ITYR_ANON_VAR;
+  common::profiler::event_initializer<prof_event_cache_fetch_comp>     ITYR_ANON_VAR;
+  common::profiler::event_initializer<prof_event_cache_writeback_comp> ITYR_ANON_VAR;
 };
 
 }
@@ -3,6 +3,7 @@
 #include <fstream>
 
 #include "ityr/common/util.hpp"
+#include "ityr/common/mem_usage.hpp"
 
 namespace ityr::ori {
 
@@ -29,6 +30,19 @@ inline std::string str(mode::read_write_t) {
 
 using block_size_t = uint32_t;
 
+/**
+ * @brief Memory usage of the global memory layer in this process.
+ */
+struct mem_stats {
+  common::mem_usage cache_blocks;      ///< Cache blocks holding data (in blocks).
+  common::mem_usage cache_pinned;      ///< Checked-out (unevictable) cache blocks (in blocks).
+  common::mem_usage cache_dirty;       ///< Dirty data in the cache (in bytes).
+  common::mem_usage noncoll_heap;      ///< Local heap for noncollective memory (in bytes).
+  common::mem_usage home_mmap_entries; ///< Home segments mapped by mmap (in entries).
+  common::mem_usage coll_mem;          ///< Allocated collective memory (in bytes).
+  common::mem_usage coll_mem_home;     ///< Home segments of collective memory in this node (in bytes).
+};
+
 inline std::size_t sys_mmap_entry_limit() {
   std::ifstream ifs("/proc/sys/vm/max_map_count");
   if (!ifs) {
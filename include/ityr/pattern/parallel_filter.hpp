@@ -3,6 +3,7 @@
 #include "ityr/common/util.hpp"
 #include "ityr/pattern/parallel_invoke.hpp"
 #include "ityr/pattern/parallel_loop.hpp"
+#include "ityr/pattern/parallel_reduce.hpp"
 
 namespace ityr {
 
@@ -35,6 +36,64 @@ stable_partition_aux(const execution::parallel_policy<W>& policy,
   return rotate(policy, m1, mid, m2);
 }
 
+template <typename W, typename BidirectionalIterator, typename Predicate, typename... PivotIterators>
+inline BidirectionalIterator
+partition_aux(const execution::parallel_policy<W>& policy,
+              BidirectionalIterator                first,
+              BidirectionalIterator                last,
+              Predicate                            pred,
+              PivotIterators...                    pivots) {
+  // Each element `x` is tested with `pred(x, *pivots...)`. Pivots are referenced via iterators
+  // (rather than captured by value) so that non-trivially-copyable pivots can be used; they must
+  // not be within the range [first, last).
+  std::size_t d = std::distance(first, last);
+
+  if (d == 0) return first;
+
+  if (d <= policy.cutoff_count) {
+    // TODO: consider policy.checkout_count
+    ITYR_CHECK(policy.cutoff_count == policy.checkout_count);
+
+    auto&& [css, its] = checkout_global_iterators(d, first);
+    auto&& first_ = std::get<0>(its);
+
+    auto m = [&] {
+      if constexpr (sizeof...(PivotIterators) > 0) {
+        auto&& [css_p, its_p] = checkout_global_iterators(1, pivots...);
+        return std::apply([&](auto&&... pivots_) {
+          return std::partition(first_, std::next(first_, d),
+                                [&](const auto& x) { return pred(x, *pivots_...); });
+        }, its_p);
+      } else {
+        return std::partition(first_, std::next(first_, d), pred);
+      }
+    }();
+
+    return std::next(first, std::distance(first_, m));
+  }
+
+  auto mid = std::next(first, d / 2);
+
+  auto [m1, m2] = parallel_invoke(
+      [=] { return partition_aux(policy, first, mid , pred, pivots...); },
+      [=] { return partition_aux(policy, mid  , last, pred, pivots...); });
+
+  // Unlike the stable version, the misplaced elements around `mid` are just swapped, which moves
+  // only `min(mid - m1, m2 - mid)` elements rather than rotating all of them.
+  //      m1        mid        m2
+  // ... | F F F F F || T T T | ...
+  auto n_false_l = std::distance(m1, mid);
+  auto n_true_r  = std::distance(mid, m2);
+
+  if (n_false_l <= n_true_r) {
+    swap_ranges(policy, m1, mid, std::prev(m2, n_false_l));
+  } else {
+    swap_ranges(policy, mid, m2, m1);
+  }
+
+  return std::next(m1, n_true_r);
+}
+
 }
 
 /**
@@ -228,12 +287,15 @@ ITYR_TEST_CASE("[ityr::pattern::parallel_filter] stable_partition") {
  * or `ityr::execution::parallel_policy::checkout_count` if parallel) without explicitly passing them
  * as global iterators.
  *
+ * Compared to `ityr::stable_partition()`, this function moves fewer elements, as misplaced elements
+ * are swapped rather than rotated when partial results are merged.
+ *
  * Example:
  * ```
  * ityr::global_vector<int> v = {1, 2, 3, 4, 5};
  * auto it = ityr::partition(ityr::execution::par, v.begin(), v.end(),
  *                           [](int x) { return x % 2 == 0; });
- * // v = {2, 4, 1, 3, 5}
+ * // v = {4, 2, 3, 1, 5} (the order within each group is unspecified)
  * //            ^
  * //            it
  * ```
@@ -248,8 +310,94 @@ inline BidirectionalIterator partition(const ExecutionPolicy& policy,
                                        BidirectionalIterator  first,
                                        BidirectionalIterator  last,
                                        Predicate              pred) {
-  // TODO: implement faster unstable partition
-  return stable_partition(policy, first, last, pred);
+  if constexpr (ori::is_global_ptr_v<BidirectionalIterator>) {
+    return partition(
+        policy,
+        internal::convert_to_global_iterator(first, checkout_mode::read_write),
+        internal::convert_to_global_iterator(last , checkout_mode::read_write),
+        pred);
+
+  } else {
+    return internal::partition_aux(policy, first, last, pred);
+  }
+}
+
+ITYR_TEST_CASE("[ityr::pattern::parallel_filter] partition") {
+  ito::init();
+  ori::init();
+
+  ITYR_SUBCASE("split 1:2") {
+    long n = 90000;
+    ori::global_ptr<long> p = ori::malloc_coll<long>(n);
+
+    ito::root_exec([=] {
+      transform(
+          execution::parallel_policy(100),
+          count_iterator<long>(0), count_iterator<long>(n), p,
+          [=](long i) { return i; });
+
+      auto pp = partition(
+          execution::parallel_policy(100),
+          p, p + n,
+          [](long x) { return x % 3 == 0; });
+
+      ITYR_CHECK(pp == p + n / 3);
+
+      for_each(
+          execution::parallel_policy(100),
+          make_global_iterator(p , checkout_mode::read),
+          make_global_iterator(pp, checkout_mode::read),
+          [](long x) { ITYR_CHECK(x % 3 == 0); });
+
+      for_each(
+          execution::parallel_policy(100),
+          make_global_iterator(pp   , checkout_mode::read),
+          make_global_iterator(p + n, checkout_mode::read),
+          [](long x) { ITYR_CHECK(x % 3 != 0); });
+
+      ITYR_CHECK(reduce(execution::parallel_policy(100), p, p + n) == n * (n - 1) / 2);
+    });
+
+    ori::free_coll(p);
+  }
+
+  ITYR_SUBCASE("corner cases") {
+    long n = 100000;
+    ori::global_ptr<long> p = ori::malloc_coll<long>(n);
+
+    ito::root_exec([=] {
+      transform(
+          execution::parallel_policy(100),
+          count_iterator<long>(0), count_iterator<long>(n), p,
+          [=](long i) { return i; });
+
+      auto pp1 = partition(
+          execution::parallel_policy(100),
+          p, p + n,
+          [](long) { return true; });
+
+      ITYR_CHECK(pp1 == p + n);
+
+      auto pp2 = partition(
+          execution::parallel_policy(100),
+          p, p + n,
+          [](long) { return false; });
+
+      ITYR_CHECK(pp2 == p);
+
+      for_each(
+          execution::parallel_policy(100),
+          make_global_iterator(p,     checkout_mode::read),
+          make_global_iterator(p + n, checkout_mode::read),
+          count_iterator<long>(0),
+          [](long x, long i) { ITYR_CHECK(x == i); });
+    });
+
+    ori::free_coll(p);
+  }
+
+  ori::fini();
+  ito::fini();
 }
 
 }
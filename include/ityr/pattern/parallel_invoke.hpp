@@ -16,6 +16,16 @@ struct workhint {
   W value;
 };
 
+/**
+ * @brief Task label for the critical path profiler.
+ *
+ * The label must be a string literal. The time of tasks with labels is reported separately
+ * by the DAG profiler when `ITYR_ITO_DAG_PROF=critpath` is set at compile time.
+ *
+ * @see `ityr::parallel_invoke()`.
+ */
+using task_label = ito::task_label;
+
 namespace internal {
 
 template <typename... Args>
@@ -70,7 +80,8 @@ constexpr inline W get_total_work(const Fn&, const std::tuple<Args...>&, workhin
 template <typename ReleaseHandler>
 struct parallel_invoke_state {
 public:
-  parallel_invoke_state(ReleaseHandler rh) : rh_(rh) {}
+  parallel_invoke_state(ReleaseHandler rh, const char* label = nullptr)
+    : rh_(rh), label_(label) {}
 
   bool all_serialized() const { return all_serialized_; }
 
@@ -149,6 +160,9 @@ private:
   inline auto do_parallel_invoke(Fn&& fn, ArgsTuple&& args_tuple) {
     using retval_t = std::invoke_result_t<decltype(std::apply<Fn, ArgsTuple>), Fn, ArgsTuple>;
 
+    // the last task is executed by the current thread
+    ito::dag_prof_label_scope dls(label_);
+
     if constexpr (std::is_void_v<retval_t>) {
       std::apply(std::forward<Fn>(fn), std::forward<ArgsTuple>(args_tuple));
       return std::make_tuple(std::monostate{});
@@ -172,8 +186,10 @@ private:
 
     ito::thread<retval_t> th(
         ito::with_callback, [rh = rh_] { ori::acquire(rh); }, [] { ori::release(); }, iwh,
-        [fn         = std::forward<Fn>(fn),
+        [label      = label_,
+         fn         = std::forward<Fn>(fn),
          args_tuple = std::forward<ArgsTuple>(args_tuple)]() mutable {
+          ito::dag_prof_label_scope dls(label);
           return std::apply(std::forward<decltype(fn)>(fn),
                             std::forward<decltype(args_tuple)>(args_tuple));
         });
@@ -202,11 +218,52 @@ private:
   }
 
   ReleaseHandler rh_;
+  const char*    label_;
   bool           all_serialized_ = true;
 };
 
 }
 
+/**
+ * @brief Fork parallel tasks with a task label and join them.
+ *
+ * @param label   Task label for the critical path profiler.
+ * @param args... Sequence of function objects and their arguments (see `ityr::parallel_invoke()`).
+ *
+ * The child tasks and their descendants are attributed to `label` (unless they are relabeled)
+ * in the critical path profiler enabled by `ITYR_ITO_DAG_PROF=critpath`. The label is ignored
+ * if the profiler is disabled.
+ *
+ * Example:
+ * ```
+ * ityr::parallel_invoke(
+ *   ityr::task_label("merge"),
+ *   [=] { merge(a1, b1, c1); },
+ *   [=] { merge(a2, b2, c2); }
+ * );
+ * ```
+ */
+template <typename... Args>
+inline auto parallel_invoke(task_label label, Args&&... args) {
+  auto rh = ori::release_lazy();
+
+  ito::task_group_data tgdata;
+  ito::task_group_begin(&tgdata);
+
+  internal::parallel_invoke_state s(rh, label.name);
+  auto&& ret = s.parallel_invoke_aux(std::forward<Args>(args)...);
+
+  // No lazy release here because the suspended thread (cross-worker tasks in ADWS) is
+  // always resumed by another process.
+  ito::task_group_end([] { ori::release(); }, [] { ori::acquire(); });
+
+  // TODO: avoid duplicated acquire calls
+  if (!s.all_serialized()) {
+    ori::acquire();
+  }
+  return std::move(ret);
+}
+
 /**
  * @brief Fork parallel tasks and join them.
  *
@@ -236,23 +293,7 @@ private:
  */
 template <typename... Args>
 inline auto parallel_invoke(Args&&... args) {
-  auto rh = ori::release_lazy();
-
-  ito::task_group_data tgdata;
-  ito::task_group_begin(&tgdata);
-
-  internal::parallel_invoke_state s(rh);
-  auto&& ret = s.parallel_invoke_aux(std::forward<Args>(args)...);
-
-  // No lazy release here because the suspended thread (cross-worker tasks in ADWS) is
-  // always resumed by another process.
-  ito::task_group_end([] { ori::release(); }, [] { ori::acquire(); });
-
-  // TODO: avoid duplicated acquire calls
-  if (!s.all_serialized()) {
-    ori::acquire();
-  }
-  return std::move(ret);
+  return parallel_invoke(task_label(nullptr), std::forward<Args>(args)...);
 }
 
 ITYR_TEST_CASE("[ityr::pattern::parallel_invoke] parallel invoke") {
@@ -332,6 +373,18 @@ ITYR_TEST_CASE("[ityr::pattern::parallel_invoke] parallel invoke") {
     });
   }
 
+  ITYR_SUBCASE("with task labels") {
+    ito::root_exec([=] {
+      auto [x, y] = parallel_invoke(
+        task_label("test"),
+        []() { return 1; },
+        [](int i) { return i * 2; }, std::make_tuple(2)
+      );
+      ITYR_CHECK(x == 1);
+      ITYR_CHECK(y == 4);
+    });
+  }
+
   ITYR_SUBCASE("corner cases") {
     ito::root_exec([=] {
       ITYR_CHECK(parallel_invoke() == std::make_tuple());
@@ -984,6 +984,105 @@ ITYR_TEST_CASE("[ityr::pattern::parallel_loop] move") {
   ito::fini();
 }
 
+/**
+ * @brief Swap elements between two ranges.
+ *
+ * @param policy Execution policy (`ityr::execution`).
+ * @param first1 1st begin iterator.
+ * @param last1  1st end iterator.
+ * @param first2 2nd begin iterator.
+ *
+ * @return The end iterator of the 2nd range (`first2 + (last1 - first1)`).
+ *
+ * This function exchanges the elements in the range `[first1, last1)` with those in the range
+ * `[first2, first2 + (last1 - first1))`.
+ *
+ * If given iterators are global pointers, they are automatically checked out in the read-write mode
+ * in the specified granularity (`ityr::execution::sequenced_policy::checkout_count` if serial,
+ * or `ityr::execution::parallel_policy::checkout_count` if parallel) without explicitly passing them
+ * as global iterators.
+ *
+ * The two ranges should not be overlapped.
+ *
+ * Example:
+ * ```
+ * ityr::global_vector<int> v1 = {1, 2, 3, 4, 5};
+ * ityr::global_vector<int> v2 = {6, 7, 8, 9, 10};
+ * ityr::swap_ranges(ityr::execution::par, v1.begin(), v1.begin() + 3, v2.begin());
+ * // v1 = {6, 7, 8, 4, 5}
+ * // v2 = {1, 2, 3, 9, 10}
+ * ```
+ *
+ * @see [std::swap_ranges -- cppreference.com](https://en.cppreference.com/w/cpp/algorithm/swap_ranges)
+ * @see `ityr::reverse()`
+ * @see `ityr::execution::sequenced_policy`, `ityr::execution::seq`,
+ *      `ityr::execution::parallel_policy`, `ityr::execution::par`
+ */
+template <typename ExecutionPolicy, typename ForwardIterator1, typename ForwardIterator2>
+inline ForwardIterator2 swap_ranges(const ExecutionPolicy& policy,
+                                    ForwardIterator1       first1,
+                                    ForwardIterator1       last1,
+                                    ForwardIterator2       first2) {
+  if constexpr (ori::is_global_ptr_v<ForwardIterator1> ||
+                ori::is_global_ptr_v<ForwardIterator2>) {
+    return swap_ranges(
+        policy,
+        internal::convert_to_global_iterator(first1, checkout_mode::read_write),
+        internal::convert_to_global_iterator(last1 , checkout_mode::read_write),
+        internal::convert_to_global_iterator(first2, checkout_mode::read_write));
+
+  } else {
+    auto op = [=](auto&& r1, auto&& r2) {
+      using std::swap;
+      swap(r1, r2);
+    };
+
+    internal::loop_generic(policy, op, first1, last1, first2);
+
+    return std::next(first2, std::distance(first1, last1));
+  }
+}
+
+ITYR_TEST_CASE("[ityr::pattern::parallel_loop] swap_ranges") {
+  ito::init();
+  ori::init();
+
+  long n = 100000;
+  ori::global_ptr<long> p1 = ori::malloc_coll<long>(n);
+  ori::global_ptr<long> p2 = ori::malloc_coll<long>(n);
+
+  ito::root_exec([=] {
+    for_each(
+        execution::parallel_policy(100),
+        make_global_iterator(p1    , checkout_mode::write),
+        make_global_iterator(p1 + n, checkout_mode::write),
+        make_global_iterator(p2    , checkout_mode::write),
+        count_iterator<long>(0),
+        [=](long& v1, long& v2, long i) { v1 = i; v2 = -i; });
+
+    long m = n / 3;
+    auto ret = swap_ranges(execution::parallel_policy(100), p1, p1 + m, p2 + (n - m));
+    ITYR_CHECK(ret == p2 + n);
+
+    for_each(
+        execution::parallel_policy(100),
+        make_global_iterator(p1    , checkout_mode::read),
+        make_global_iterator(p1 + n, checkout_mode::read),
+        make_global_iterator(p2    , checkout_mode::read),
+        count_iterator<long>(0),
+        [=](long v1, long v2, long i) {
+          ITYR_CHECK(v1 == (i < m ? -(n - m + i) : i));
+          ITYR_CHECK(v2 == (i >= n - m ? i - (n - m) : -i));
+        });
+  });
+
+  ori::free_coll(p1);
+  ori::free_coll(p2);
+
+  ori::fini();
+  ito::fini();
+}
+
 /**
  * @brief Reverse a range.
  *
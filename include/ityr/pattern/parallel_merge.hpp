@@ -4,6 +4,7 @@
 #include "ityr/pattern/parallel_invoke.hpp"
 #include "ityr/pattern/parallel_loop.hpp"
 #include "ityr/pattern/parallel_reduce.hpp"
+#include "ityr/pattern/parallel_search.hpp"
 
 namespace ityr {
 
@@ -437,4 +438,622 @@ ITYR_TEST_CASE("[ityr::pattern::parallel_merge] inplace_merge") {
   ito::fini();
 }
 
+
+namespace internal {
+
+template <typename W, typename RandomAccessIterator1, typename RandomAccessIterator2,
+          typename RandomAccessIteratorD, typename Compare>
+inline void merge_aux(const execution::parallel_policy<W>& policy,
+                      RandomAccessIterator1                first1,
+                      RandomAccessIterator1                last1,
+                      RandomAccessIterator2                first2,
+                      RandomAccessIterator2                last2,
+                      RandomAccessIteratorD                first_d,
+                      Compare                              comp) {
+  std::size_t n1 = std::distance(first1, last1);
+  std::size_t n2 = std::distance(first2, last2);
+  std::size_t d = n1 + n2;
+
+  if (n1 == 0) {
+    copy(policy, first2, last2, first_d);
+    return;
+  }
+
+  if (n2 == 0) {
+    copy(policy, first1, last1, first_d);
+    return;
+  }
+
+  if (d <= policy.cutoff_count) {
+    auto&& [css1, its1] = checkout_global_iterators(n1, first1);
+    auto&& [css2, its2] = checkout_global_iterators(n2, first2);
+    auto&& [cssd, itsd] = checkout_global_iterators(d, first_d);
+    auto first1_ = std::get<0>(its1);
+    auto first2_ = std::get<0>(its2);
+    std::merge(first1_, std::next(first1_, n1),
+               first2_, std::next(first2_, n2),
+               std::get<0>(itsd), comp);
+    return;
+  }
+
+  // Find the co-rank of the middle of the output, i.e., the number of elements `c1` (and `c2`) to
+  // be taken from the first (and second) input so that c1 + c2 = d / 2. Elements from the first
+  // input precede equal elements from the second input for stability.
+  std::size_t k = d / 2;
+  std::size_t lo = k > n2 ? k - n2 : 0;
+  std::size_t hi = std::min(k, n1);
+
+  auto c1_it = partition_point_aux(
+      1, count_iterator<std::size_t>(lo), count_iterator<std::size_t>(hi),
+      [=](std::size_t i) {
+        auto&& [css, its] = checkout_global_iterators(1, std::next(first1, i), std::next(first2, k - i - 1));
+        auto [it1, it2] = its;
+        return !comp(*it2, *it1);
+      });
+
+  std::size_t c1 = *c1_it;
+  std::size_t c2 = k - c1;
+
+  parallel_invoke(
+      [=] { merge_aux(policy, first1, std::next(first1, c1), first2, std::next(first2, c2), first_d, comp); },
+      [=] { merge_aux(policy, std::next(first1, c1), last1, std::next(first2, c2), last2, std::next(first_d, k), comp); });
+}
+
+inline constexpr std::size_t kway_merge_max_runs = 64;
+
+template <typename RandomAccessIterator>
+struct kway_merge_runs {
+  std::array<RandomAccessIterator, kway_merge_max_runs> firsts;
+  std::array<RandomAccessIterator, kway_merge_max_runs> lasts;
+  std::size_t                                           n_runs;
+
+  std::size_t size(std::size_t i) const { return std::distance(firsts[i], lasts[i]); }
+
+  std::size_t total_size() const {
+    std::size_t s = 0;
+    for (std::size_t i = 0; i < n_runs; i++) {
+      s += size(i);
+    }
+    return s;
+  }
+};
+
+template <typename Iterator, typename Compare>
+class loser_tree {
+public:
+  loser_tree(const std::vector<std::pair<Iterator, Iterator>>& runs, Compare comp)
+    : runs_(runs),
+      n_leaves_(common::next_pow2(std::max(runs.size(), std::size_t(1)))),
+      losers_(n_leaves_),
+      comp_(comp) {
+    // Pad with empty runs so that the tree is complete
+    runs_.resize(n_leaves_, std::make_pair(Iterator{}, Iterator{}));
+
+    std::vector<std::size_t> winners(2 * n_leaves_);
+    for (std::size_t i = 0; i < n_leaves_; i++) {
+      winners[n_leaves_ + i] = i;
+    }
+    for (std::size_t node = n_leaves_ - 1; node >= 1; node--) {
+      std::size_t a = winners[2 * node];
+      std::size_t b = winners[2 * node + 1];
+      if (beats(a, b)) {
+        winners[node] = a;
+        losers_[node] = b;
+      } else {
+        winners[node] = b;
+        losers_[node] = a;
+      }
+    }
+    winner_ = winners[1];
+  }
+
+  bool empty() const { return runs_[winner_].first == runs_[winner_].second; }
+
+  Iterator top() const { return runs_[winner_].first; }
+
+  void pop() {
+    ++runs_[winner_].first;
+
+    // Replay the matches on the path from the leaf to the root
+    std::size_t w = winner_;
+    for (std::size_t node = (n_leaves_ + winner_) / 2; node >= 1; node /= 2) {
+      if (beats(losers_[node], w)) {
+        std::swap(losers_[node], w);
+      }
+    }
+    winner_ = w;
+  }
+
+private:
+  bool beats(std::size_t a, std::size_t b) const {
+    // An exhausted run never wins; ties are broken by the run index for stability
+    if (runs_[a].first == runs_[a].second) return false;
+    if (runs_[b].first == runs_[b].second) return true;
+    if (comp_(*runs_[b].first, *runs_[a].first)) return false;
+    if (comp_(*runs_[a].first, *runs_[b].first)) return true;
+    return a < b;
+  }
+
+  std::vector<std::pair<Iterator, Iterator>> runs_;
+  std::size_t                                n_leaves_;
+  std::vector<std::size_t>                   losers_;
+  std::size_t                                winner_;
+  Compare                                    comp_;
+};
+
+template <typename RandomAccessIterator, typename RandomAccessIteratorD, typename Compare>
+inline void kway_merge_leaf(const kway_merge_runs<RandomAccessIterator>& runs,
+                            RandomAccessIteratorD                       first_d,
+                            Compare                                     comp) {
+  std::size_t d = runs.total_size();
+
+  using checkout_t = decltype(checkout_global_iterators(1, std::declval<RandomAccessIterator>()));
+  using iterator_t = std::decay_t<decltype(std::get<0>(std::get<1>(std::declval<checkout_t>())))>;
+
+  std::vector<checkout_t> css;
+  std::vector<std::pair<iterator_t, iterator_t>> runs_;
+  css.reserve(runs.n_runs);
+  runs_.reserve(runs.n_runs);
+
+  for (std::size_t i = 0; i < runs.n_runs; i++) {
+    std::size_t n = runs.size(i);
+    if (n > 0) {
+      css.push_back(checkout_global_iterators(n, runs.firsts[i]));
+      auto it = std::get<0>(std::get<1>(css.back()));
+      runs_.emplace_back(it, std::next(it, n));
+    }
+  }
+
+  auto&& [cssd, itsd] = checkout_global_iterators(d, first_d);
+  auto first_d_ = std::get<0>(itsd);
+
+  loser_tree<iterator_t, Compare> lt(runs_, comp);
+  for (std::size_t i = 0; i < d; i++) {
+    ITYR_CHECK(!lt.empty());
+    *first_d_ = *lt.top();
+    ++first_d_;
+    lt.pop();
+  }
+}
+
+template <typename W, typename RandomAccessIterator, typename RandomAccessIteratorD, typename Compare>
+inline void kway_merge_aux(const execution::parallel_policy<W>&        policy,
+                           const kway_merge_runs<RandomAccessIterator>& runs,
+                           RandomAccessIteratorD                       first_d,
+                           Compare                                     comp) {
+  std::size_t d = runs.total_size();
+
+  if (d == 0) return;
+
+  if (d <= policy.cutoff_count) {
+    kway_merge_leaf(runs, first_d, comp);
+    return;
+  }
+
+  // Choose the pivot as the weighted median of the middle elements of the runs, so that
+  // at least about a quarter of the elements go to each side.
+  std::array<std::size_t, kway_merge_max_runs> order;
+  std::size_t n_nonempty = 0;
+  for (std::size_t i = 0; i < runs.n_runs; i++) {
+    if (runs.size(i) > 0) {
+      order[n_nonempty++] = i;
+    }
+  }
+
+  auto mid_of = [&](std::size_t i) { return std::next(runs.firsts[i], runs.size(i) / 2); };
+
+  std::stable_sort(order.begin(), std::next(order.begin(), n_nonempty), [&](std::size_t i, std::size_t j) {
+    auto&& [css, its] = checkout_global_iterators(1, mid_of(i), mid_of(j));
+    auto [it_i, it_j] = its;
+    return comp(*it_i, *it_j) || (!comp(*it_j, *it_i) && i < j);
+  });
+
+  std::size_t pivot_run = order[0];
+  std::size_t acc = 0;
+  for (std::size_t o = 0; o < n_nonempty; o++) {
+    acc += runs.size(order[o]);
+    if (2 * acc >= d) {
+      pivot_run = order[o];
+      break;
+    }
+  }
+
+  auto pivot = mid_of(pivot_run);
+
+  kway_merge_runs<RandomAccessIterator> runs_l = runs;
+  kway_merge_runs<RandomAccessIterator> runs_r = runs;
+  std::size_t d_l = 0;
+
+  {
+    // Elements equal to the pivot in runs before (after) the pivot run go to the left (right)
+    auto&& [css, its] = checkout_global_iterators(1, pivot);
+    const auto& pv = *std::get<0>(its);
+
+    for (std::size_t i = 0; i < runs.n_runs; i++) {
+      RandomAccessIterator s;
+      if (i == pivot_run) {
+        s = pivot;
+      } else if (i < pivot_run) {
+        s = partition_point_aux(policy.checkout_count, runs.firsts[i], runs.lasts[i],
+                                [&](const auto& x) { return !comp(pv, x); });
+      } else {
+        s = partition_point_aux(policy.checkout_count, runs.firsts[i], runs.lasts[i],
+                                [&](const auto& x) { return comp(x, pv); });
+      }
+      runs_l.lasts[i]  = s;
+      runs_r.firsts[i] = s;
+      d_l += std::distance(runs.firsts[i], s);
+    }
+  }
+
+  if (d_l == 0 || d_l == d) {
+    // The split can be empty only for tiny inputs (e.g., the pivot run has only the minimum element)
+    kway_merge_leaf(runs, first_d, comp);
+    return;
+  }
+
+  parallel_invoke(
+      [=] { kway_merge_aux(policy, runs_l, first_d, comp); },
+      [=] { kway_merge_aux(policy, runs_r, std::next(first_d, d_l), comp); });
+}
+
+}
+
+/**
+ * @brief Merge two sorted ranges into another range.
+ *
+ * @param policy  Execution policy (`ityr::execution`).
+ * @param first1  1st begin iterator.
+ * @param last1   1st end iterator.
+ * @param first2  2nd begin iterator.
+ * @param last2   2nd end iterator.
+ * @param first_d Output begin iterator.
+ * @param comp    Binary comparison operator.
+ *
+ * @return The end iterator of the output range (`first_d + (last1 - first1) + (last2 - first2)`).
+ *
+ * This function merges two sorted ranges (`[first1, last1)` and `[first2, last2)`) into the output
+ * range starting at `first_d`. The output range must not overlap with the input ranges.
+ * This merge operation is stable; for equal elements, those in the first range precede those in
+ * the second range.
+ *
+ * Unlike `ityr::inplace_merge()`, this function does not rotate elements; the output range is
+ * recursively split at the middle and the corresponding split points of the inputs (co-ranks) are
+ * found by binary search, so each element is copied exactly once.
+ *
+ * If global pointers are provided as iterators, they are automatically checked out in the specified
+ * granularity (`ityr::execution::sequenced_policy::checkout_count` if serial,
+ * or `ityr::execution::parallel_policy::checkout_count` if parallel) without explicitly passing them
+ * as global iterators.
+ * Input global pointers are automatically checked out with the read-only mode if their value type
+ * is *trivially copyable*; otherwise, they are checked out with the read-write mode, even if they
+ * are actually not modified.
+ *
+ * Example:
+ * ```
+ * ityr::global_vector<int> v1 = {1, 3, 5};
+ * ityr::global_vector<int> v2 = {2, 3, 4, 6};
+ * ityr::global_vector<int> v3(v1.size() + v2.size());
+ * ityr::merge(ityr::execution::par, v1.begin(), v1.end(), v2.begin(), v2.end(), v3.begin(),
+ *             std::less<>{});
+ * // v3 = {1, 2, 3, 3, 4, 5, 6}
+ * ```
+ *
+ * @see [std::merge -- cppreference.com](https://en.cppreference.com/w/cpp/algorithm/merge)
+ * @see `ityr::inplace_merge()`
+ * @see `ityr::kway_merge()`
+ * @see `ityr::execution::parallel_policy`, `ityr::execution::par`
+ */
+template <typename ExecutionPolicy, typename RandomAccessIterator1, typename RandomAccessIterator2,
+          typename RandomAccessIteratorD, typename Compare>
+inline RandomAccessIteratorD merge(const ExecutionPolicy& policy,
+                                   RandomAccessIterator1  first1,
+                                   RandomAccessIterator1  last1,
+                                   RandomAccessIterator2  first2,
+                                   RandomAccessIterator2  last2,
+                                   RandomAccessIteratorD  first_d,
+                                   Compare                comp) {
+  using value_type1  = typename std::iterator_traits<RandomAccessIterator1>::value_type;
+  using value_type2  = typename std::iterator_traits<RandomAccessIterator2>::value_type;
+  using value_type_d = typename std::iterator_traits<RandomAccessIteratorD>::value_type;
+
+  internal::merge_aux(
+      policy,
+      internal::convert_to_global_iterator(first1 , internal::src_checkout_mode_t<value_type1>{}),
+      internal::convert_to_global_iterator(last1  , internal::src_checkout_mode_t<value_type1>{}),
+      internal::convert_to_global_iterator(first2 , internal::src_checkout_mode_t<value_type2>{}),
+      internal::convert_to_global_iterator(last2  , internal::src_checkout_mode_t<value_type2>{}),
+      internal::convert_to_global_iterator(first_d, internal::dest_checkout_mode_t<value_type_d>{}),
+      comp);
+
+  return std::next(first_d, std::distance(first1, last1) + std::distance(first2, last2));
+}
+
+/**
+ * @brief Merge two sorted ranges into another range.
+ *
+ * @param policy  Execution policy (`ityr::execution`).
+ * @param first1  1st begin iterator.
+ * @param last1   1st end iterator.
+ * @param first2  2nd begin iterator.
+ * @param last2   2nd end iterator.
+ * @param first_d Output begin iterator.
+ *
+ * @return The end iterator of the output range (`first_d + (last1 - first1) + (last2 - first2)`).
+ *
+ * Equivalent to `ityr::merge(policy, first1, last1, first2, last2, first_d, std::less<>{});`
+ *
+ * @see [std::merge -- cppreference.com](https://en.cppreference.com/w/cpp/algorithm/merge)
+ * @see `ityr::inplace_merge()`
+ * @see `ityr::kway_merge()`
+ * @see `ityr::execution::parallel_policy`, `ityr::execution::par`
+ */
+template <typename ExecutionPolicy, typename RandomAccessIterator1, typename RandomAccessIterator2,
+          typename RandomAccessIteratorD>
+inline RandomAccessIteratorD merge(const ExecutionPolicy& policy,
+                                   RandomAccessIterator1  first1,
+                                   RandomAccessIterator1  last1,
+                                   RandomAccessIterator2  first2,
+                                   RandomAccessIterator2  last2,
+                                   RandomAccessIteratorD  first_d) {
+  return merge(policy, first1, last1, first2, last2, first_d, std::less<>{});
+}
+
+ITYR_TEST_CASE("[ityr::pattern::parallel_merge] merge") {
+  ito::init();
+  ori::init();
+
+  // std::pair is not trivially copyable
+  struct item {
+    long key;
+    long val;
+  };
+
+  long n = 100000;
+  long n_keys = 1000;
+  ori::global_ptr<item> p = ori::malloc_coll<item>(n);
+  ori::global_ptr<item> q = ori::malloc_coll<item>(n);
+
+  ito::root_exec([=] {
+    auto comp_key = [](const auto& a, const auto& b) { return a.key < b.key; };
+
+    for (long m : {0L, 1L, n / 3, n - 1, n}) {
+      // the first range has keys with larger gaps and the second range contains duplicates
+      transform(
+          execution::parallel_policy(100),
+          count_iterator<long>(0), count_iterator<long>(m), p,
+          [=](long i) { return item{i * n_keys / std::max(m, 1L) * 2, i}; });
+
+      transform(
+          execution::parallel_policy(100),
+          count_iterator<long>(m), count_iterator<long>(n), p + m,
+          [=](long i) { return item{(i - m) * n_keys / std::max(n - m, 1L), i}; });
+
+      auto ret = merge(execution::parallel_policy(100), p, p + m, p + m, p + n, q, comp_key);
+      ITYR_CHECK(ret == q + n);
+
+      // stable: equal keys are ordered by `val`, as vals in the first range are smaller
+      auto comp_key_val = [](const item& a, const item& b) {
+        return a.key < b.key || (a.key == b.key && a.val < b.val);
+      };
+      ITYR_CHECK(is_sorted(execution::parallel_policy(100), q, q + n, comp_key_val));
+
+      auto get_val = [](const item& x) { return x.val; };
+      ITYR_CHECK(transform_reduce(execution::parallel_policy(100), q, q + n,
+                                  reducer::plus<long>{}, get_val)
+                 == n * (n - 1) / 2);
+    }
+  });
+
+  ori::free_coll(p);
+  ori::free_coll(q);
+
+  ori::fini();
+  ito::fini();
+}
+
+/**
+ * @brief Merge multiple sorted ranges into another range.
+ *
+ * @param policy     Execution policy (`ityr::execution`).
+ * @param first_runs Begin iterator of the sorted ranges (runs).
+ * @param last_runs  End iterator of the sorted ranges (runs).
+ * @param first_d    Output begin iterator.
+ * @param comp       Binary comparison operator.
+ *
+ * @return The end iterator of the output range.
+ *
+ * This function merges `k = last_runs - first_runs` sorted ranges into the output range starting
+ * at `first_d` in a single pass. Each element of `[first_runs, last_runs)` represents a sorted
+ * range and must provide `begin()` and `end()` (e.g., `ityr::global_span`). The output range must
+ * not overlap with the input ranges. At most 64 runs can be merged at once.
+ * This merge operation is stable; for equal elements, those in earlier runs precede those in later runs.
+ *
+ * The output range is recursively split at a pivot chosen as the weighted median of the middle
+ * elements of the runs, and each run is split at the pivot by binary search. Small subproblems are
+ * merged by a loser tree, which takes `O(log k)` comparisons per element. Compared to merging
+ * the runs pairwise, each element is copied only once.
+ *
+ * If global pointers are provided as iterators, they are automatically checked out in the specified
+ * granularity (`ityr::execution::sequenced_policy::checkout_count` if serial,
+ * or `ityr::execution::parallel_policy::checkout_count` if parallel) without explicitly passing them
+ * as global iterators.
+ * Input global pointers are automatically checked out with the read-only mode if their value type
+ * is *trivially copyable*; otherwise, they are checked out with the read-write mode, even if they
+ * are actually not modified.
+ *
+ * Example:
+ * ```
+ * ityr::global_vector<int> v1 = {1, 4, 7};
+ * ityr::global_vector<int> v2 = {2, 5, 8};
+ * ityr::global_vector<int> v3 = {3, 6, 9};
+ * std::vector<ityr::global_span<int>> runs = {v1, v2, v3};
+ * ityr::global_vector<int> v(9);
+ * ityr::kway_merge(ityr::execution::par, runs.begin(), runs.end(), v.begin(), std::less<>{});
+ * // v = {1, 2, 3, 4, 5, 6, 7, 8, 9}
+ * ```
+ *
+ * @see `ityr::merge()`
+ * @see `ityr::inplace_merge()`
+ * @see `ityr::execution::parallel_policy`, `ityr::execution::par`
+ */
+template <typename ExecutionPolicy, typename RandomAccessIterator, typename RandomAccessIteratorD,
+          typename Compare>
+inline RandomAccessIteratorD kway_merge(const ExecutionPolicy& policy,
+                                        RandomAccessIterator   first_runs,
+                                        RandomAccessIterator   last_runs,
+                                        RandomAccessIteratorD  first_d,
+                                        Compare                comp) {
+  std::size_t k = std::distance(first_runs, last_runs);
+  if (k == 0) return first_d;
+
+  if (k > internal::kway_merge_max_runs) {
+    common::die("The number of runs for ityr::kway_merge() must be at most %ld.",
+                internal::kway_merge_max_runs);
+  }
+
+  using run_t          = typename std::iterator_traits<RandomAccessIterator>::value_type;
+  using run_iterator_t = std::decay_t<decltype(std::begin(std::declval<const run_t&>()))>;
+  using value_type     = typename std::iterator_traits<run_iterator_t>::value_type;
+  using value_type_d   = typename std::iterator_traits<RandomAccessIteratorD>::value_type;
+  using src_mode_t     = internal::src_checkout_mode_t<value_type>;
+  using iterator_t     = decltype(internal::convert_to_global_iterator(std::declval<run_iterator_t>(),
+                                                                       src_mode_t{}));
+
+  // The descriptors of the runs are read only once and passed to child tasks by value
+  internal::kway_merge_runs<iterator_t> runs;
+  runs.n_runs = k;
+  {
+    auto&& [css, its] = internal::checkout_global_iterators(
+        k, internal::convert_to_global_iterator(first_runs, checkout_mode::read));
+    auto first_runs_ = std::get<0>(its);
+    for (std::size_t i = 0; i < k; i++) {
+      runs.firsts[i] = internal::convert_to_global_iterator(std::begin(first_runs_[i]), src_mode_t{});
+      runs.lasts[i]  = internal::convert_to_global_iterator(std::end(first_runs_[i]), src_mode_t{});
+    }
+  }
+
+  std::size_t d = runs.total_size();
+
+  internal::kway_merge_aux(
+      policy, runs,
+      internal::convert_to_global_iterator(first_d, internal::dest_checkout_mode_t<value_type_d>{}),
+      comp);
+
+  return std::next(first_d, d);
+}
+
+/**
+ * @brief Merge multiple sorted ranges into another range.
+ *
+ * @param policy     Execution policy (`ityr::execution`).
+ * @param first_runs Begin iterator of the sorted ranges (runs).
+ * @param last_runs  End iterator of the sorted ranges (runs).
+ * @param first_d    Output begin iterator.
+ *
+ * @return The end iterator of the output range.
+ *
+ * Equivalent to `ityr::kway_merge(policy, first_runs, last_runs, first_d, std::less<>{});`
+ *
+ * @see `ityr::merge()`
+ * @see `ityr::inplace_merge()`
+ * @see `ityr::execution::parallel_policy`, `ityr::execution::par`
+ */
+template <typename ExecutionPolicy, typename RandomAccessIterator, typename RandomAccessIteratorD>
+inline RandomAccessIteratorD kway_merge(const ExecutionPolicy& policy,
+                                        RandomAccessIterator   first_runs,
+                                        RandomAccessIterator   last_runs,
+                                        RandomAccessIteratorD  first_d) {
+  return kway_merge(policy, first_runs, last_runs, first_d, std::less<>{});
+}
+
+ITYR_TEST_CASE("[ityr::pattern::parallel_merge] kway_merge") {
+  ito::init();
+  ori::init();
+
+  struct run {
+    ori::global_ptr<long> b;
+    ori::global_ptr<long> e;
+    ori::global_ptr<long> begin() const { return b; }
+    ori::global_ptr<long> end() const { return e; }
+  };
+
+  long n = 100000;
+  ori::global_ptr<long> p = ori::malloc_coll<long>(n);
+  ori::global_ptr<long> q = ori::malloc_coll<long>(n);
+
+  ito::root_exec([=] {
+    for (long k : {1L, 2L, 7L, 64L}) {
+      // runs of different lengths; run `j` contains values `j, j + k, j + 2k, ...`
+      std::vector<run> runs;
+      long offset = 0;
+      for (long j = 0; j < k; j++) {
+        long len = (j == k - 1) ? n - offset : n / k + (j % 3 - 1) * (n / k / 4);
+        runs.push_back(run{p + offset, p + offset + len});
+        transform(
+            execution::parallel_policy(100),
+            count_iterator<long>(0), count_iterator<long>(len), p + offset,
+            [=](long i) { return i * k + j; });
+        offset += len;
+      }
+
+      auto ret = kway_merge(execution::parallel_policy(100), runs.begin(), runs.end(), q);
+      ITYR_CHECK(ret == q + n);
+
+      ITYR_CHECK(is_sorted(execution::parallel_policy(100), q, q + n));
+      ITYR_CHECK(reduce(execution::parallel_policy(100), q, q + n) ==
+                 reduce(execution::parallel_policy(100), p, p + n));
+    }
+
+    // all elements equal; stability is checked through the source positions
+    ori::global_ptr<long> idx = q;
+    std::vector<run> runs;
+    for (long j = 0; j < 4; j++) {
+      runs.push_back(run{p + j * (n / 4), p + (j + 1) * (n / 4)});
+    }
+    transform(
+        execution::parallel_policy(100),
+        count_iterator<long>(0), count_iterator<long>(n), p,
+        [=](long i) { return i; });
+    kway_merge(execution::parallel_policy(100), runs.begin(), runs.end(), idx,
+               [](long, long) { return false; });
+    for_each(
+        execution::parallel_policy(100),
+        make_global_iterator(idx, checkout_mode::read),
+        make_global_iterator(idx + n, checkout_mode::read),
+        count_iterator<long>(0),
+        [=](long x, long i) { ITYR_CHECK(x == i); });
+
+    // tiny runs with the default cutoff of `execution::par`
+    for (long len : {1L, 2L, 8L}) {
+      for (long k : {2L, 3L}) {
+        std::vector<run> runs;
+        for (long j = 0; j < k; j++) {
+          runs.push_back(run{p + j * len, p + (j + 1) * len});
+          transform(
+              execution::par,
+              count_iterator<long>(0), count_iterator<long>(len), p + j * len,
+              [=](long i) { return i * k + j; });
+        }
+
+        auto ret = kway_merge(execution::par, runs.begin(), runs.end(), q);
+        ITYR_CHECK(ret == q + k * len);
+
+        for_each(
+            execution::par,
+            make_global_iterator(q, checkout_mode::read),
+            make_global_iterator(q + k * len, checkout_mode::read),
+            count_iterator<long>(0),
+            [=](long x, long i) { ITYR_CHECK(x == i); });
+      }
+    }
+  });
+
+  ori::free_coll(p);
+  ori::free_coll(q);
+
+  ori::fini();
+  ito::fini();
+}
+
 }
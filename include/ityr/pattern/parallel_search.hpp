@@ -438,4 +438,666 @@ ITYR_TEST_CASE("[ityr::pattern::parallel_search] min, max, minmax_element") {
   ito::fini();
 }
 
+
+namespace internal {
+
+template <typename RandomAccessIterator, typename Predicate>
+inline RandomAccessIterator partition_point_aux(std::size_t          checkout_count,
+                                                RandomAccessIterator first,
+                                                RandomAccessIterator last,
+                                                Predicate            pred) {
+  std::size_t d = std::distance(first, last);
+
+  // Probe single elements until the remaining range fits in one checkout. Each probe can be a
+  // remote access, as the cache is invalidated at fork/join boundaries; `ityr::search_index`
+  // reduces a lookup to a single remote fetch for repeated lookups over the same range.
+  while (d > checkout_count) {
+    std::size_t half = d / 2;
+    auto mid = std::next(first, half);
+
+    bool left = [&] {
+      auto&& [css, its] = checkout_global_iterators(1, mid);
+      return pred(*std::get<0>(its));
+    }();
+
+    if (left) {
+      first = std::next(mid);
+      d -= half + 1;
+    } else {
+      d = half;
+    }
+  }
+
+  if (d == 0) return first;
+
+  auto&& [css, its] = checkout_global_iterators(d, first);
+  auto first_ = std::get<0>(its);
+  auto it = std::partition_point(first_, std::next(first_, d), pred);
+  return std::next(first, std::distance(first_, it));
+}
+
+template <typename W, typename RandomAccessIterator1, typename RandomAccessIterator2,
+          typename RandomAccessIteratorD, typename Predicate>
+inline void partition_point_batch_aux(const execution::parallel_policy<W>& policy,
+                                      RandomAccessIterator1                first,
+                                      RandomAccessIterator1                last,
+                                      RandomAccessIterator1                base,
+                                      RandomAccessIterator2                first_q,
+                                      RandomAccessIterator2                last_q,
+                                      RandomAccessIteratorD                first_d,
+                                      Predicate                            pred) {
+  // Queries are sorted, so the answer to the middle query splits both the queries and the range.
+  // Each subproblem searches only in its own part of the range, which narrows as the recursion
+  // goes deeper and makes neighbouring queries hit the same cache blocks.
+  std::size_t n_queries = std::distance(first_q, last_q);
+
+  if (n_queries == 0) return;
+
+  if (n_queries <= policy.cutoff_count) {
+    auto&& [css, its] = checkout_global_iterators(n_queries, first_q, first_d);
+    auto [first_q_, first_d_] = its;
+    for (std::size_t i = 0; i < n_queries; i++) {
+      const auto& q = first_q_[i];
+      first = partition_point_aux(policy.checkout_count, first, last,
+                                  [&](const auto& x) { return pred(x, q); });
+      first_d_[i] = std::distance(base, first);
+    }
+    return;
+  }
+
+  auto mid_q = std::next(first_q, n_queries / 2);
+  auto mid_d = std::next(first_d, n_queries / 2);
+
+  auto mid = [&] {
+    auto&& [css, its] = checkout_global_iterators(1, mid_q);
+    const auto& q = *std::get<0>(its);
+    return partition_point_aux(policy.checkout_count, first, last,
+                               [&](const auto& x) { return pred(x, q); });
+  }();
+
+  {
+    auto&& [css, its] = checkout_global_iterators(1, mid_d);
+    *std::get<0>(its) = std::distance(base, mid);
+  }
+
+  parallel_invoke(
+      [=] { partition_point_batch_aux(policy, first, mid, base, first_q, mid_q, first_d, pred); },
+      [=] { partition_point_batch_aux(policy, mid, last, base, std::next(mid_q), last_q, std::next(mid_d), pred); });
+}
+
+template <typename ExecutionPolicy, typename RandomAccessIterator1, typename RandomAccessIterator2,
+          typename RandomAccessIteratorD, typename Predicate>
+inline RandomAccessIteratorD partition_point_batch(const ExecutionPolicy& policy,
+                                                   RandomAccessIterator1  first,
+                                                   RandomAccessIterator1  last,
+                                                   RandomAccessIterator2  first_q,
+                                                   RandomAccessIterator2  last_q,
+                                                   RandomAccessIteratorD  first_d,
+                                                   Predicate              pred) {
+  using value_type_d = typename std::iterator_traits<RandomAccessIteratorD>::value_type;
+
+  auto first_  = convert_to_global_iterator(first  , checkout_mode::read);
+  auto first_q_ = convert_to_global_iterator(first_q, checkout_mode::read);
+  auto first_d_ = convert_to_global_iterator(first_d, dest_checkout_mode_t<value_type_d>{});
+
+  partition_point_batch_aux(
+      policy,
+      first_,
+      convert_to_global_iterator(last  , checkout_mode::read),
+      first_,
+      first_q_,
+      convert_to_global_iterator(last_q, checkout_mode::read),
+      first_d_,
+      pred);
+
+  return std::next(first_d, std::distance(first_q, last_q));
+}
+
+}
+
+/**
+ * @brief Search for the first element in a sorted range that is not less than the given value.
+ *
+ * @param policy Execution policy (`ityr::execution`).
+ * @param first  Begin iterator.
+ * @param last   End iterator.
+ * @param value  Value to be compared.
+ * @param comp   Binary comparison operator. Returns true if the first argument is less than
+ *               the second argument.
+ *
+ * @return Iterator to the first element `x` in `[first, last)` such that `comp(x, value)` is false,
+ *         or `last` if no such element exists.
+ *
+ * The range `[first, last)` must be partitioned with respect to `comp(x, value)` (e.g., sorted by
+ * `comp`). A single lookup is inherently sequential; elements are probed one by one until the
+ * remaining range fits in the checkout granularity, and then the rest of the range is checked out
+ * at once, which costs O(log n) remote accesses. Use `ityr::lower_bound_batch()` for many sorted
+ * lookups, or `ityr::search_index` for repeated independent lookups over the same range.
+ *
+ * If global pointers are provided as iterators, they are automatically checked out with the read-only
+ * mode in the specified granularity (`ityr::execution::sequenced_policy::checkout_count` if serial,
+ * or `ityr::execution::parallel_policy::checkout_count` if parallel) without explicitly passing them
+ * as global iterators.
+ *
+ * Example:
+ * ```
+ * ityr::global_vector<int> v = {1, 2, 2, 4, 5};
+ * auto it = ityr::lower_bound(ityr::execution::par, v.begin(), v.end(), 2, std::less<>{});
+ * // it = v.begin() + 1
+ * ```
+ *
+ * @see [std::lower_bound -- cppreference.com](https://en.cppreference.com/w/cpp/algorithm/lower_bound)
+ * @see `ityr::upper_bound()`
+ * @see `ityr::equal_range()`
+ * @see `ityr::lower_bound_batch()`
+ * @see `ityr::execution::sequenced_policy`, `ityr::execution::seq`,
+ *      `ityr::execution::parallel_policy`, `ityr::execution::par`
+ */
+template <typename ExecutionPolicy, typename RandomAccessIterator, typename T, typename Compare>
+inline RandomAccessIterator lower_bound(const ExecutionPolicy& policy,
+                                        RandomAccessIterator   first,
+                                        RandomAccessIterator   last,
+                                        const T&               value,
+                                        Compare                comp) {
+  auto first_ = internal::convert_to_global_iterator(first, checkout_mode::read);
+  auto last_  = internal::convert_to_global_iterator(last , checkout_mode::read);
+  auto it = internal::partition_point_aux(policy.checkout_count, first_, last_,
+                                          [&](const auto& x) { return comp(x, value); });
+  return std::next(first, std::distance(first_, it));
+}
+
+/**
+ * @brief Search for the first element in a sorted range that is not less than the given value.
+ *
+ * @param policy Execution policy (`ityr::execution`).
+ * @param first  Begin iterator.
+ * @param last   End iterator.
+ * @param value  Value to be compared.
+ *
+ * @return Iterator to the first element `x` in `[first, last)` such that `x < value` is false,
+ *         or `last` if no such element exists.
+ *
+ * Equivalent to `ityr::lower_bound(policy, first, last, value, std::less<>{})`.
+ *
+ * @see [std::lower_bound -- cppreference.com](https://en.cppreference.com/w/cpp/algorithm/lower_bound)
+ * @see `ityr::upper_bound()`
+ * @see `ityr::equal_range()`
+ * @see `ityr::lower_bound_batch()`
+ * @see `ityr::execution::sequenced_policy`, `ityr::execution::seq`,
+ *      `ityr::execution::parallel_policy`, `ityr::execution::par`
+ */
+template <typename ExecutionPolicy, typename RandomAccessIterator, typename T>
+inline RandomAccessIterator lower_bound(const ExecutionPolicy& policy,
+                                        RandomAccessIterator   first,
+                                        RandomAccessIterator   last,
+                                        const T&               value) {
+  return lower_bound(policy, first, last, value, std::less<>{});
+}
+
+/**
+ * @brief Search for the first element in a sorted range that is greater than the given value.
+ *
+ * @param policy Execution policy (`ityr::execution`).
+ * @param first  Begin iterator.
+ * @param last   End iterator.
+ * @param value  Value to be compared.
+ * @param comp   Binary comparison operator. Returns true if the first argument is less than
+ *               the second argument.
+ *
+ * @return Iterator to the first element `x` in `[first, last)` such that `comp(value, x)` is true,
+ *         or `last` if no such element exists.
+ *
+ * The range `[first, last)` must be partitioned with respect to `!comp(value, x)` (e.g., sorted by
+ * `comp`). See `ityr::lower_bound()` for how global memory is accessed.
+ *
+ * If global pointers are provided as iterators, they are automatically checked out with the read-only
+ * mode in the specified granularity (`ityr::execution::sequenced_policy::checkout_count` if serial,
+ * or `ityr::execution::parallel_policy::checkout_count` if parallel) without explicitly passing them
+ * as global iterators.
+ *
+ * Example:
+ * ```
+ * ityr::global_vector<int> v = {1, 2, 2, 4, 5};
+ * auto it = ityr::upper_bound(ityr::execution::par, v.begin(), v.end(), 2, std::less<>{});
+ * // it = v.begin() + 3
+ * ```
+ *
+ * @see [std::upper_bound -- cppreference.com](https://en.cppreference.com/w/cpp/algorithm/upper_bound)
+ * @see `ityr::lower_bound()`
+ * @see `ityr::equal_range()`
+ * @see `ityr::upper_bound_batch()`
+ * @see `ityr::execution::sequenced_policy`, `ityr::execution::seq`,
+ *      `ityr::execution::parallel_policy`, `ityr::execution::par`
+ */
+template <typename ExecutionPolicy, typename RandomAccessIterator, typename T, typename Compare>
+inline RandomAccessIterator upper_bound(const ExecutionPolicy& policy,
+                                        RandomAccessIterator   first,
+                                        RandomAccessIterator   last,
+                                        const T&               value,
+                                        Compare                comp) {
+  auto first_ = internal::convert_to_global_iterator(first, checkout_mode::read);
+  auto last_  = internal::convert_to_global_iterator(last , checkout_mode::read);
+  auto it = internal::partition_point_aux(policy.checkout_count, first_, last_,
+                                          [&](const auto& x) { return !comp(value, x); });
+  return std::next(first, std::distance(first_, it));
+}
+
+/**
+ * @brief Search for the first element in a sorted range that is greater than the given value.
+ *
+ * @param policy Execution policy (`ityr::execution`).
+ * @param first  Begin iterator.
+ * @param last   End iterator.
+ * @param value  Value to be compared.
+ *
+ * @return Iterator to the first element `x` in `[first, last)` such that `value < x` is true,
+ *         or `last` if no such element exists.
+ *
+ * Equivalent to `ityr::upper_bound(policy, first, last, value, std::less<>{})`.
+ *
+ * @see [std::upper_bound -- cppreference.com](https://en.cppreference.com/w/cpp/algorithm/upper_bound)
+ * @see `ityr::lower_bound()`
+ * @see `ityr::equal_range()`
+ * @see `ityr::upper_bound_batch()`
+ * @see `ityr::execution::sequenced_policy`, `ityr::execution::seq`,
+ *      `ityr::execution::parallel_policy`, `ityr::execution::par`
+ */
+template <typename ExecutionPolicy, typename RandomAccessIterator, typename T>
+inline RandomAccessIterator upper_bound(const ExecutionPolicy& policy,
+                                        RandomAccessIterator   first,
+                                        RandomAccessIterator   last,
+                                        const T&               value) {
+  return upper_bound(policy, first, last, value, std::less<>{});
+}
+
+/**
+ * @brief Search for the range of elements equal to the given value in a sorted range.
+ *
+ * @param policy Execution policy (`ityr::execution`).
+ * @param first  Begin iterator.
+ * @param last   End iterator.
+ * @param value  Value to be compared.
+ * @param comp   Binary comparison operator. Returns true if the first argument is less than
+ *               the second argument.
+ *
+ * @return A pair of iterators equivalent to
+ *         `std::make_pair(ityr::lower_bound(...), ityr::upper_bound(...))`.
+ *
+ * The upper bound is searched only in the range starting from the lower bound.
+ *
+ * If global pointers are provided as iterators, they are automatically checked out with the read-only
+ * mode in the specified granularity (`ityr::execution::sequenced_policy::checkout_count` if serial,
+ * or `ityr::execution::parallel_policy::checkout_count` if parallel) without explicitly passing them
+ * as global iterators.
+ *
+ * Example:
+ * ```
+ * ityr::global_vector<int> v = {1, 2, 2, 4, 5};
+ * auto [it1, it2] = ityr::equal_range(ityr::execution::par, v.begin(), v.end(), 2, std::less<>{});
+ * // it1 = v.begin() + 1, it2 = v.begin() + 3
+ * ```
+ *
+ * @see [std::equal_range -- cppreference.com](https://en.cppreference.com/w/cpp/algorithm/equal_range)
+ * @see `ityr::lower_bound()`
+ * @see `ityr::upper_bound()`
+ * @see `ityr::binary_search()`
+ * @see `ityr::execution::sequenced_policy`, `ityr::execution::seq`,
+ *      `ityr::execution::parallel_policy`, `ityr::execution::par`
+ */
+template <typename ExecutionPolicy, typename RandomAccessIterator, typename T, typename Compare>
+inline std::pair<RandomAccessIterator, RandomAccessIterator>
+equal_range(const ExecutionPolicy& policy,
+            RandomAccessIterator   first,
+            RandomAccessIterator   last,
+            const T&               value,
+            Compare                comp) {
+  auto it1 = lower_bound(policy, first, last, value, comp);
+  auto it2 = upper_bound(policy, it1, last, value, comp);
+  return std::make_pair(it1, it2);
+}
+
+/**
+ * @brief Search for the range of elements equal to the given value in a sorted range.
+ *
+ * @param policy Execution policy (`ityr::execution`).
+ * @param first  Begin iterator.
+ * @param last   End iterator.
+ * @param value  Value to be compared.
+ *
+ * @return A pair of iterators equivalent to
+ *         `std::make_pair(ityr::lower_bound(...), ityr::upper_bound(...))`.
+ *
+ * Equivalent to `ityr::equal_range(policy, first, last, value, std::less<>{})`.
+ *
+ * @see [std::equal_range -- cppreference.com](https://en.cppreference.com/w/cpp/algorithm/equal_range)
+ * @see `ityr::lower_bound()`
+ * @see `ityr::upper_bound()`
+ * @see `ityr::binary_search()`
+ * @see `ityr::execution::sequenced_policy`, `ityr::execution::seq`,
+ *      `ityr::execution::parallel_policy`, `ityr::execution::par`
+ */
+template <typename ExecutionPolicy, typename RandomAccessIterator, typename T>
+inline std::pair<RandomAccessIterator, RandomAccessIterator>
+equal_range(const ExecutionPolicy& policy,
+            RandomAccessIterator   first,
+            RandomAccessIterator   last,
+            const T&               value) {
+  return equal_range(policy, first, last, value, std::less<>{});
+}
+
+/**
+ * @brief Check if an element equal to the given value exists in a sorted range.
+ *
+ * @param policy Execution policy (`ityr::execution`).
+ * @param first  Begin iterator.
+ * @param last   End iterator.
+ * @param value  Value to be compared.
+ * @param comp   Binary comparison operator. Returns true if the first argument is less than
+ *               the second argument.
+ *
+ * @return True if an element equivalent to `value` is found in `[first, last)`.
+ *
+ * If global pointers are provided as iterators, they are automatically checked out with the read-only
+ * mode in the specified granularity (`ityr::execution::sequenced_policy::checkout_count` if serial,
+ * or `ityr::execution::parallel_policy::checkout_count` if parallel) without explicitly passing them
+ * as global iterators.
+ *
+ * Example:
+ * ```
+ * ityr::global_vector<int> v = {1, 2, 2, 4, 5};
+ * bool found = ityr::binary_search(ityr::execution::par, v.begin(), v.end(), 3, std::less<>{});
+ * // found = false
+ * ```
+ *
+ * @see [std::binary_search -- cppreference.com](https://en.cppreference.com/w/cpp/algorithm/binary_search)
+ * @see `ityr::lower_bound()`
+ * @see `ityr::equal_range()`
+ * @see `ityr::execution::sequenced_policy`, `ityr::execution::seq`,
+ *      `ityr::execution::parallel_policy`, `ityr::execution::par`
+ */
+template <typename ExecutionPolicy, typename RandomAccessIterator, typename T, typename Compare>
+inline bool binary_search(const ExecutionPolicy& policy,
+                          RandomAccessIterator   first,
+                          RandomAccessIterator   last,
+                          const T&               value,
+                          Compare                comp) {
+  auto it = lower_bound(policy, first, last, value, comp);
+  if (it == last) return false;
+
+  auto&& [css, its] = internal::checkout_global_iterators(
+      1, internal::convert_to_global_iterator(it, checkout_mode::read));
+  return !comp(value, *std::get<0>(its));
+}
+
+/**
+ * @brief Check if an element equal to the given value exists in a sorted range.
+ *
+ * @param policy Execution policy (`ityr::execution`).
+ * @param first  Begin iterator.
+ * @param last   End iterator.
+ * @param value  Value to be compared.
+ *
+ * @return True if an element equal to `value` is found in `[first, last)`.
+ *
+ * Equivalent to `ityr::binary_search(policy, first, last, value, std::less<>{})`.
+ *
+ * @see [std::binary_search -- cppreference.com](https://en.cppreference.com/w/cpp/algorithm/binary_search)
+ * @see `ityr::lower_bound()`
+ * @see `ityr::equal_range()`
+ * @see `ityr::execution::sequenced_policy`, `ityr::execution::seq`,
+ *      `ityr::execution::parallel_policy`, `ityr::execution::par`
+ */
+template <typename ExecutionPolicy, typename RandomAccessIterator, typename T>
+inline bool binary_search(const ExecutionPolicy& policy,
+                          RandomAccessIterator   first,
+                          RandomAccessIterator   last,
+                          const T&               value) {
+  return binary_search(policy, first, last, value, std::less<>{});
+}
+
+ITYR_TEST_CASE("[ityr::pattern::parallel_search] lower_bound, upper_bound, equal_range, binary_search") {
+  ito::init();
+  ori::init();
+
+  long n = 100000;
+  ori::global_ptr<long> p = ori::malloc_coll<long>(n);
+
+  ito::root_exec([=] {
+    // each even number appears twice: {0, 0, 2, 2, 4, 4, ...}
+    transform(
+        execution::parallel_policy(100),
+        count_iterator<long>(0), count_iterator<long>(n), p,
+        [=](long i) { return i / 2 * 2; });
+
+    for (long v : {-1L, 0L, 1L, 2L, n / 2, n / 2 + 1, n - 2, n - 1, n}) {
+      long lb = std::clamp((v + 1) / 2 * 2, 0L, n);
+      long ub = std::clamp(v / 2 * 2 + 2, 0L, n);
+      if (v < 0) ub = 0;
+
+      ITYR_CHECK(lower_bound(execution::parallel_policy(100), p, p + n, v) == p + lb);
+      ITYR_CHECK(upper_bound(execution::parallel_policy(100), p, p + n, v) == p + ub);
+      ITYR_CHECK(lower_bound(execution::sequenced_policy(10), p, p + n, v) == p + lb);
+
+      auto [it1, it2] = equal_range(execution::parallel_policy(100), p, p + n, v);
+      ITYR_CHECK(it1 == p + lb);
+      ITYR_CHECK(it2 == p + ub);
+
+      ITYR_CHECK(binary_search(execution::parallel_policy(100), p, p + n, v) == (lb < ub));
+    }
+
+    ITYR_CHECK(lower_bound(execution::parallel_policy(100), p, p, 0) == p);
+    ITYR_CHECK(binary_search(execution::parallel_policy(100), p, p, 0) == false);
+  });
+
+  ori::free_coll(p);
+
+  ori::fini();
+  ito::fini();
+}
+
+/**
+ * @brief Search for the lower bounds of many values in a sorted range.
+ *
+ * @param policy  Execution policy (`ityr::execution`).
+ * @param first   Begin iterator of the sorted range.
+ * @param last    End iterator of the sorted range.
+ * @param first_q Begin iterator of the values to be searched for (queries).
+ * @param last_q  End iterator of the values to be searched for (queries).
+ * @param first_d Output iterator for the results.
+ * @param comp    Binary comparison operator. Returns true if the first argument is less than
+ *                the second argument.
+ *
+ * @return The end iterator of the output range (`first_d + (last_q - first_q)`).
+ *
+ * For each query `q` in `[first_q, last_q)`, this function writes the position (the number of
+ * elements from `first`) of the lower bound of `q` in `[first, last)` to the corresponding element
+ * in the output range, i.e., `first_d[i] = ityr::lower_bound(policy, first, last, first_q[i], comp) - first`.
+ *
+ * The queries must be sorted by `comp`. This function first searches for the lower bound of the
+ * middle query, which splits both the queries and the range, and then processes the two halves in
+ * parallel. As a result, each subproblem only accesses a narrowing part of the range and the
+ * total number of remote accesses is much smaller than that of independent lookups.
+ *
+ * If global pointers are provided as iterators, they are automatically checked out in the specified
+ * granularity (`ityr::execution::sequenced_policy::checkout_count` if serial,
+ * or `ityr::execution::parallel_policy::checkout_count` if parallel) without explicitly passing them
+ * as global iterators. Input and query global pointers are checked out with the read-only mode.
+ *
+ * Example:
+ * ```
+ * ityr::global_vector<int> v = {1, 2, 2, 4, 5};
+ * ityr::global_vector<int> q = {0, 2, 3, 6};
+ * ityr::global_vector<std::size_t> r(q.size());
+ * ityr::lower_bound_batch(ityr::execution::par, v.begin(), v.end(), q.begin(), q.end(), r.begin(),
+ *                         std::less<>{});
+ * // r = {0, 1, 3, 5}
+ * ```
+ *
+ * @see `ityr::lower_bound()`
+ * @see `ityr::upper_bound_batch()`
+ * @see `ityr::execution::parallel_policy`, `ityr::execution::par`
+ */
+template <typename ExecutionPolicy, typename RandomAccessIterator1, typename RandomAccessIterator2,
+          typename RandomAccessIteratorD, typename Compare>
+inline RandomAccessIteratorD lower_bound_batch(const ExecutionPolicy& policy,
+                                               RandomAccessIterator1  first,
+                                               RandomAccessIterator1  last,
+                                               RandomAccessIterator2  first_q,
+                                               RandomAccessIterator2  last_q,
+                                               RandomAccessIteratorD  first_d,
+                                               Compare                comp) {
+  return internal::partition_point_batch(
+      policy, first, last, first_q, last_q, first_d,
+      [=](const auto& x, const auto& q) { return comp(x, q); });
+}
+
+/**
+ * @brief Search for the lower bounds of many values in a sorted range.
+ *
+ * @param policy  Execution policy (`ityr::execution`).
+ * @param first   Begin iterator of the sorted range.
+ * @param last    End iterator of the sorted range.
+ * @param first_q Begin iterator of the values to be searched for (queries).
+ * @param last_q  End iterator of the values to be searched for (queries).
+ * @param first_d Output iterator for the results.
+ *
+ * @return The end iterator of the output range (`first_d + (last_q - first_q)`).
+ *
+ * Equivalent to `ityr::lower_bound_batch(policy, first, last, first_q, last_q, first_d, std::less<>{})`.
+ *
+ * @see `ityr::lower_bound()`
+ * @see `ityr::upper_bound_batch()`
+ * @see `ityr::execution::parallel_policy`, `ityr::execution::par`
+ */
+template <typename ExecutionPolicy, typename RandomAccessIterator1, typename RandomAccessIterator2,
+          typename RandomAccessIteratorD>
+inline RandomAccessIteratorD lower_bound_batch(const ExecutionPolicy& policy,
+                                               RandomAccessIterator1  first,
+                                               RandomAccessIterator1  last,
+                                               RandomAccessIterator2  first_q,
+                                               RandomAccessIterator2  last_q,
+                                               RandomAccessIteratorD  first_d) {
+  return lower_bound_batch(policy, first, last, first_q, last_q, first_d, std::less<>{});
+}
+
+/**
+ * @brief Search for the upper bounds of many values in a sorted range.
+ *
+ * @param policy  Execution policy (`ityr::execution`).
+ * @param first   Begin iterator of the sorted range.
+ * @param last    End iterator of the sorted range.
+ * @param first_q Begin iterator of the values to be searched for (queries).
+ * @param last_q  End iterator of the values to be searched for (queries).
+ * @param first_d Output iterator for the results.
+ * @param comp    Binary comparison operator. Returns true if the first argument is less than
+ *                the second argument.
+ *
+ * @return The end iterator of the output range (`first_d + (last_q - first_q)`).
+ *
+ * Same as `ityr::lower_bound_batch()`, except that the position of the upper bound is written,
+ * i.e., `first_d[i] = ityr::upper_bound(policy, first, last, first_q[i], comp) - first`.
+ * The queries must be sorted by `comp`.
+ *
+ * @see `ityr::upper_bound()`
+ * @see `ityr::lower_bound_batch()`
+ * @see `ityr::execution::parallel_policy`, `ityr::execution::par`
+ */
+template <typename ExecutionPolicy, typename RandomAccessIterator1, typename RandomAccessIterator2,
+          typename RandomAccessIteratorD, typename Compare>
+inline RandomAccessIteratorD upper_bound_batch(const ExecutionPolicy& policy,
+                                               RandomAccessIterator1  first,
+                                               RandomAccessIterator1  last,
+                                               RandomAccessIterator2  first_q,
+                                               RandomAccessIterator2  last_q,
+                                               RandomAccessIteratorD  first_d,
+                                               Compare                comp) {
+  return internal::partition_point_batch(
+      policy, first, last, first_q, last_q, first_d,
+      [=](const auto& x, const auto& q) { return !comp(q, x); });
+}
+
+/**
+ * @brief Search for the upper bounds of many values in a sorted range.
+ *
+ * @param policy  Execution policy (`ityr::execution`).
+ * @param first   Begin iterator of the sorted range.
+ * @param last    End iterator of the sorted range.
+ * @param first_q Begin iterator of the values to be searched for (queries).
+ * @param last_q  End iterator of the values to be searched for (queries).
+ * @param first_d Output iterator for the results.
+ *
+ * @return The end iterator of the output range (`first_d + (last_q - first_q)`).
+ *
+ * Equivalent to `ityr::upper_bound_batch(policy, first, last, first_q, last_q, first_d, std::less<>{})`.
+ *
+ * @see `ityr::upper_bound()`
+ * @see `ityr::lower_bound_batch()`
+ * @see `ityr::execution::parallel_policy`, `ityr::execution::par`
+ */
+template <typename ExecutionPolicy, typename RandomAccessIterator1, typename RandomAccessIterator2,
+          typename RandomAccessIteratorD>
+inline RandomAccessIteratorD upper_bound_batch(const ExecutionPolicy& policy,
+                                               RandomAccessIterator1  first,
+                                               RandomAccessIterator1  last,
+                                               RandomAccessIterator2  first_q,
+                                               RandomAccessIterator2  last_q,
+                                               RandomAccessIteratorD  first_d) {
+  return upper_bound_batch(policy, first, last, first_q, last_q, first_d, std::less<>{});
+}
+
+ITYR_TEST_CASE("[ityr::pattern::parallel_search] lower_bound_batch, upper_bound_batch") {
+  ito::init();
+  ori::init();
+
+  long n = 100000;
+  long n_queries = 30000;
+  ori::global_ptr<long> p = ori::malloc_coll<long>(n);
+  ori::global_ptr<long> q = ori::malloc_coll<long>(n_queries);
+  ori::global_ptr<long> r = ori::malloc_coll<long>(n_queries);
+
+  ito::root_exec([=] {
+    // each multiple of 3 appears three times: {0, 0, 0, 3, 3, 3, 6, ...}
+    transform(
+        execution::parallel_policy(100),
+        count_iterator<long>(0), count_iterator<long>(n), p,
+        [=](long i) { return i / 3 * 3; });
+
+    // queries are sorted and contain duplicates and out-of-range values
+    transform(
+        execution::parallel_policy(100),
+        count_iterator<long>(0), count_iterator<long>(n_queries), q,
+        [=](long i) { return i * (n + 10) / n_queries - 5; });
+
+    auto ret = lower_bound_batch(execution::parallel_policy(100), p, p + n, q, q + n_queries, r);
+    ITYR_CHECK(ret == r + n_queries);
+
+    for_each(
+        execution::parallel_policy(100),
+        make_global_iterator(q, checkout_mode::read),
+        make_global_iterator(q + n_queries, checkout_mode::read),
+        make_global_iterator(r, checkout_mode::read),
+        [=](long v, long pos) {
+          ITYR_CHECK(pos == std::clamp((v + 2) / 3 * 3, 0L, n));
+        });
+
+    upper_bound_batch(execution::parallel_policy(100), p, p + n, q, q + n_queries, r);
+
+    for_each(
+        execution::parallel_policy(100),
+        make_global_iterator(q, checkout_mode::read),
+        make_global_iterator(q + n_queries, checkout_mode::read),
+        make_global_iterator(r, checkout_mode::read),
+        [=](long v, long pos) {
+          ITYR_CHECK(pos == (v < 0 ? 0 : std::clamp(v / 3 * 3 + 3, 0L, n)));
+        });
+  });
+
+  ori::free_coll(p);
+  ori::free_coll(q);
+  ori::free_coll(r);
+
+  ori::fini();
+  ito::fini();
+}
+
 }
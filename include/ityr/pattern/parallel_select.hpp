@@ -0,0 +1,921 @@
+#pragma once
+
+#include "ityr/common/util.hpp"
+#include "ityr/pattern/parallel_invoke.hpp"
+#include "ityr/pattern/parallel_loop.hpp"
+#include "ityr/pattern/parallel_filter.hpp"
+#include "ityr/pattern/parallel_sort.hpp"
+
+namespace ityr {
+
+namespace internal {
+
+inline constexpr std::size_t select_n_samples = 31;
+
+inline uint64_t select_hash(uint64_t seed, uint64_t x, uint64_t y) {
+  // splitmix64 finalizer
+  uint64_t z = seed + x * 0x9e3779b97f4a7c15 + y * 0xd1b54a32d192ed03;
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+  return z ^ (z >> 31);
+}
+
+template <typename RandomAccessIterator, typename Compare>
+inline bool compare_global_iterators(RandomAccessIterator it1,
+                                     RandomAccessIterator it2,
+                                     Compare              comp) {
+  auto&& [css, its] = checkout_global_iterators(1, it1, it2);
+  auto [it1_, it2_] = its;
+  return comp(*it1_, *it2_);
+}
+
+template <typename RandomAccessIterator, typename Compare>
+inline RandomAccessIterator sample_median(RandomAccessIterator first,
+                                          RandomAccessIterator last,
+                                          Compare              comp) {
+  std::size_t d = std::distance(first, last);
+  std::size_t n_samples = std::min(d, select_n_samples);
+  ITYR_CHECK(n_samples > 0);
+
+  // Samples are taken at regular intervals and only their positions are kept, so that elements
+  // are not copied and non-trivially-copyable types can be handled
+  std::array<RandomAccessIterator, select_n_samples> samples;
+  for (std::size_t i = 0; i < n_samples; i++) {
+    samples[i] = std::next(first, (2 * i + 1) * d / (2 * n_samples));
+  }
+
+  auto mid = std::next(samples.begin(), n_samples / 2);
+  std::nth_element(samples.begin(), mid, std::next(samples.begin(), n_samples),
+                   [&](const auto& it1, const auto& it2) {
+                     return compare_global_iterators(it1, it2, comp);
+                   });
+  return *mid;
+}
+
+template <typename RandomAccessIterator>
+inline void swap_global_iterators(RandomAccessIterator it1,
+                                  RandomAccessIterator it2) {
+  if (it1 == it2) return;
+  auto&& [css, its] = checkout_global_iterators(1, it1, it2);
+  auto [it1_, it2_] = its;
+  using std::swap;
+  swap(*it1_, *it2_);
+}
+
+template <typename W, typename RandomAccessIterator, typename Compare>
+inline void nth_element_aux(const execution::parallel_policy<W>& policy,
+                            RandomAccessIterator                 first,
+                            RandomAccessIterator                 nth,
+                            RandomAccessIterator                 last,
+                            Compare                              comp) {
+  // Quickselect with a sampled pivot; each round narrows the range by a parallel three-way partition,
+  // so the total work is O(n) on average as opposed to O(n log n) for sorting.
+  while (true) {
+    std::size_t d = std::distance(first, last);
+
+    if (d <= 1 || nth == last) return;
+
+    if (d <= policy.cutoff_count) {
+      auto [css, its] = checkout_global_iterators(d, first);
+      auto first_ = std::get<0>(its);
+      std::nth_element(first_,
+                       std::next(first_, std::distance(first, nth)),
+                       std::next(first_, d),
+                       comp);
+      return;
+    }
+
+    // Keep the pivot at the front, so that it is not moved while partitioning the rest
+    swap_global_iterators(first, sample_median(first, last, comp));
+
+    //   pivot     m1
+    // ... p | < ... < | >= ... >= | ...
+    auto m1 = partition_aux(
+        policy, std::next(first), last,
+        [=](const auto& x, const auto& p) { return comp(x, p); },
+        first);
+
+    auto pivot = std::prev(m1);
+    swap_global_iterators(first, pivot);
+
+    if (nth < pivot) {
+      last = pivot;
+      continue;
+    } else if (nth == pivot) {
+      return;
+    }
+
+    //       pivot                m2
+    // ... < | p | == ... == | > ... > | ...
+    auto m2 = partition_aux(
+        policy, m1, last,
+        [=](const auto& x, const auto& p) { return !comp(p, x); },
+        pivot);
+
+    if (nth < m2) {
+      return;
+    }
+
+    first = m2;
+  }
+}
+
+template <typename W, typename RandomAccessIterator, typename Predicate, typename... PivotIterators>
+inline std::size_t count_if_aux(const execution::parallel_policy<W>& policy,
+                                RandomAccessIterator                 first,
+                                RandomAccessIterator                 last,
+                                Predicate                            pred,
+                                PivotIterators...                    pivots) {
+  std::size_t d = std::distance(first, last);
+
+  if (d == 0) return 0;
+
+  if (d <= policy.cutoff_count) {
+    auto&& [css, its] = checkout_global_iterators(d, first);
+    auto&& [css_p, its_p] = checkout_global_iterators(1, pivots...);
+    auto first_ = std::get<0>(its);
+    return std::apply([&](auto&&... pivots_) {
+      return std::count_if(first_, std::next(first_, d),
+                           [&](const auto& x) { return pred(x, *pivots_...); });
+    }, its_p);
+  }
+
+  auto mid = std::next(first, d / 2);
+
+  auto [c1, c2] = parallel_invoke(
+      [=] { return count_if_aux(policy, first, mid , pred, pivots...); },
+      [=] { return count_if_aux(policy, mid  , last, pred, pivots...); });
+
+  return c1 + c2;
+}
+
+template <typename RandomAccessIterator>
+using select_samples_t = std::array<RandomAccessIterator, select_n_samples>;
+
+template <typename W, typename RandomAccessIterator, typename Predicate, typename... PivotIterators>
+inline std::pair<std::size_t, select_samples_t<RandomAccessIterator>>
+sample_if_aux(const execution::parallel_policy<W>& policy,
+              RandomAccessIterator                 first,
+              RandomAccessIterator                 last,
+              RandomAccessIterator                 base,
+              uint64_t                             seed,
+              Predicate                            pred,
+              PivotIterators...                    pivots) {
+  // Draw `select_n_samples` elements uniformly at random (with replacement) from those satisfying
+  // `pred` in a single pass. The number of such elements is also returned.
+  std::size_t d = std::distance(first, last);
+  uint64_t node_id = std::distance(base, first);
+
+  select_samples_t<RandomAccessIterator> samples;
+  samples.fill(first);
+
+  if (d == 0) return std::make_pair(0, samples);
+
+  if (d <= policy.cutoff_count) {
+    auto&& [css, its] = checkout_global_iterators(d, first);
+    auto&& [css_p, its_p] = checkout_global_iterators(1, pivots...);
+    auto first_ = std::get<0>(its);
+    auto test = [&](const auto& x) {
+      return std::apply([&](auto&&... pivots_) { return pred(x, *pivots_...); }, its_p);
+    };
+
+    std::size_t c = std::count_if(first_, std::next(first_, d), test);
+    if (c == 0) return std::make_pair(c, samples);
+
+    // Map each sample slot to the rank of the chosen element among matching elements
+    std::array<std::pair<std::size_t, std::size_t>, select_n_samples> ranks;
+    for (std::size_t j = 0; j < select_n_samples; j++) {
+      ranks[j] = std::make_pair(select_hash(seed ^ d, node_id, j) % c, j);
+    }
+    std::sort(ranks.begin(), ranks.end());
+
+    std::size_t j = 0;
+    std::size_t r = 0;
+    for (std::size_t i = 0; i < d && j < select_n_samples; i++) {
+      if (test(first_[i])) {
+        while (j < select_n_samples && ranks[j].first == r) {
+          samples[ranks[j].second] = std::next(first, i);
+          j++;
+        }
+        r++;
+      }
+    }
+
+    return std::make_pair(c, samples);
+  }
+
+  auto mid = std::next(first, d / 2);
+
+  auto [r1, r2] = parallel_invoke(
+      [=] { return sample_if_aux(policy, first, mid , base, seed, pred, pivots...); },
+      [=] { return sample_if_aux(policy, mid  , last, base, seed, pred, pivots...); });
+
+  std::size_t c = r1.first + r2.first;
+  if (c > 0) {
+    for (std::size_t j = 0; j < select_n_samples; j++) {
+      // Take the sample from the left with probability proportional to its count
+      samples[j] = select_hash(seed ^ d, node_id, j) % c < r1.first ? r1.second[j] : r2.second[j];
+    }
+  }
+
+  return std::make_pair(c, samples);
+}
+
+template <typename W, typename RandomAccessIterator, typename Compare>
+inline std::pair<RandomAccessIterator, std::size_t>
+select_threshold(const execution::parallel_policy<W>& policy,
+                 RandomAccessIterator                 first,
+                 RandomAccessIterator                 last,
+                 std::size_t                          k,
+                 Compare                              comp) {
+  // Find an element `t` in [first, last) such that `#{x < t} < k <= #{x <= t}` without modifying
+  // the range. The candidate window (lo, hi) is narrowed in each round by a pivot chosen from
+  // random samples according to the target rank.
+  std::size_t n = std::distance(first, last);
+  ITYR_CHECK(0 < k);
+  ITYR_CHECK(k <= n);
+
+  // `first` is used as a dummy pivot if the bound does not exist
+  bool                 has_lo = false;
+  bool                 has_hi = false;
+  RandomAccessIterator lo     = first;
+  RandomAccessIterator hi     = first;
+  std::size_t          lo_le  = 0; // #{x <= lo}
+  std::size_t          hi_lt  = n; // #{x < hi}
+
+  for (uint64_t round = 0;; round++) {
+    auto in_window = [=](const auto& x, const auto& lo_v, const auto& hi_v) {
+      return (!has_lo || comp(lo_v, x)) && (!has_hi || comp(x, hi_v));
+    };
+
+    auto [n_in, samples] = sample_if_aux(policy, first, last, first, round, in_window, lo, hi);
+    ITYR_CHECK(n_in == hi_lt - lo_le);
+    ITYR_CHECK(n_in > 0);
+
+    std::sort(samples.begin(), samples.end(), [&](const auto& it1, const auto& it2) {
+      return compare_global_iterators(it1, it2, comp);
+    });
+
+    // Choose the sample whose rank in the window is expected to be closest to k
+    std::size_t target = k - lo_le - 1;
+    auto pivot = samples[std::min(target * select_n_samples / n_in, select_n_samples - 1)];
+
+    std::size_t n_lt = count_if_aux(policy, first, last,
+                                    [=](const auto& x, const auto& p) { return comp(x, p); },
+                                    pivot);
+    if (k <= n_lt) {
+      has_hi = true;
+      hi     = pivot;
+      hi_lt  = n_lt;
+      continue;
+    }
+
+    std::size_t n_le = count_if_aux(policy, first, last,
+                                    [=](const auto& x, const auto& p) { return !comp(p, x); },
+                                    pivot);
+    if (n_le < k) {
+      has_lo = true;
+      lo     = pivot;
+      lo_le  = n_le;
+      continue;
+    }
+
+    return std::make_pair(pivot, n_lt);
+  }
+}
+
+template <typename W, typename RandomAccessIterator, typename RandomAccessIteratorD,
+          typename Predicate, typename PivotIterator>
+inline std::size_t copy_if_capped_aux(const execution::parallel_policy<W>& policy,
+                                      RandomAccessIterator                 first,
+                                      RandomAccessIterator                 last,
+                                      RandomAccessIteratorD                first_d,
+                                      std::size_t                          cap,
+                                      Predicate                            pred,
+                                      PivotIterator                        pivot) {
+  // Copy the first `cap` elements satisfying `pred(x, *pivot)` while preserving their order
+  std::size_t d = std::distance(first, last);
+
+  if (d == 0 || cap == 0) return 0;
+
+  if (d <= policy.cutoff_count) {
+    auto&& [css, its] = checkout_global_iterators(d, first);
+    auto&& [css_p, its_p] = checkout_global_iterators(1, pivot);
+    auto first_ = std::get<0>(its);
+    auto pivot_ = std::get<0>(its_p);
+
+    std::size_t c = std::count_if(first_, std::next(first_, d),
+                                  [&](const auto& x) { return pred(x, *pivot_); });
+    c = std::min(c, cap);
+    if (c == 0) return 0;
+
+    auto&& [css_d, its_d] = checkout_global_iterators(c, first_d);
+    auto first_d_ = std::get<0>(its_d);
+
+    std::size_t i = 0;
+    for (auto it = first_; i < c; ++it) {
+      if (pred(*it, *pivot_)) {
+        *first_d_ = *it;
+        ++first_d_;
+        ++i;
+      }
+    }
+    return c;
+  }
+
+  auto mid = std::next(first, d / 2);
+
+  std::size_t c1 = std::min(cap, count_if_aux(policy, first, mid, pred, pivot));
+
+  auto [c1_, c2] = parallel_invoke(
+      [=] { return copy_if_capped_aux(policy, first, mid, first_d, c1, pred, pivot); },
+      [=] { return copy_if_capped_aux(policy, mid, last, std::next(first_d, c1), cap - c1, pred, pivot); });
+  ITYR_CHECK(c1 == c1_);
+
+  return c1 + c2;
+}
+
+template <typename W, typename RandomAccessIterator, typename RandomAccessIteratorD, typename Compare>
+inline void partial_sort_copy_aux(const execution::parallel_policy<W>& policy,
+                                  RandomAccessIterator                 first,
+                                  RandomAccessIterator                 last,
+                                  RandomAccessIteratorD                first_d,
+                                  std::size_t                          k,
+                                  Compare                              comp) {
+  // Copy the k smallest elements (unordered) to the destination in O(n) passes over the input
+  auto [t, n_lt] = select_threshold(policy, first, last, k, comp);
+  ITYR_CHECK(n_lt < k);
+
+  [[maybe_unused]] std::size_t c_lt = copy_if_capped_aux(
+      policy, first, last, first_d, n_lt,
+      [=](const auto& x, const auto& p) { return comp(x, p); },
+      t);
+  ITYR_CHECK(c_lt == n_lt);
+
+  [[maybe_unused]] std::size_t c_eq = copy_if_capped_aux(
+      policy, first, last, std::next(first_d, n_lt), k - n_lt,
+      [=](const auto& x, const auto& p) { return !comp(x, p) && !comp(p, x); },
+      t);
+  ITYR_CHECK(c_eq == k - n_lt);
+}
+
+}
+
+/**
+ * @brief Partially sort a range so that the n-th element is placed at its sorted position.
+ *
+ * @param policy Execution policy (`ityr::execution`).
+ * @param first  Begin iterator.
+ * @param nth    Iterator to the element to be placed at its sorted position.
+ * @param last   End iterator.
+ * @param comp   Binary comparison operator.
+ *
+ * This function rearranges the elements in the given range (`[first, last)`) so that the element
+ * pointed to by `nth` is the element that would be there if the range were sorted.
+ * All elements in `[first, nth)` are not greater than those in `[nth, last)`.
+ *
+ * Unlike `ityr::sort()`, this function does not sort the entire range; it repeatedly partitions
+ * the range in parallel around a pivot chosen by sampling, and only the part containing `nth` is
+ * further processed. The amount of work is therefore linear in the size of the range on average.
+ *
+ * If global pointers are provided as iterators, they are automatically checked out with the read-write
+ * mode in the specified granularity (`ityr::execution::sequenced_policy::checkout_count` if serial,
+ * or `ityr::execution::parallel_policy::checkout_count` if parallel) without explicitly passing them
+ * as global iterators.
+ *
+ * Example:
+ * ```
+ * ityr::global_vector<int> v = {5, 2, 4, 1, 3};
+ * ityr::nth_element(ityr::execution::par, v.begin(), v.begin() + 2, v.end());
+ * // v[2] = 3 (the median), v[0], v[1] <= 3, and v[3], v[4] >= 3
+ * ```
+ *
+ * @see [std::nth_element -- cppreference.com](https://en.cppreference.com/w/cpp/algorithm/nth_element)
+ * @see `ityr::partial_sort()`
+ * @see `ityr::top_k()`
+ * @see `ityr::sort()`
+ * @see `ityr::execution::sequenced_policy`, `ityr::execution::seq`,
+ *      `ityr::execution::parallel_policy`, `ityr::execution::par`
+ */
+template <typename ExecutionPolicy, typename RandomAccessIterator, typename Compare>
+inline void nth_element(const ExecutionPolicy& policy,
+                        RandomAccessIterator   first,
+                        RandomAccessIterator   nth,
+                        RandomAccessIterator   last,
+                        Compare                comp) {
+  if constexpr (ori::is_global_ptr_v<RandomAccessIterator>) {
+    nth_element(
+        policy,
+        internal::convert_to_global_iterator(first, checkout_mode::read_write),
+        internal::convert_to_global_iterator(nth  , checkout_mode::read_write),
+        internal::convert_to_global_iterator(last , checkout_mode::read_write),
+        comp);
+
+  } else {
+    internal::nth_element_aux(policy, first, nth, last, comp);
+  }
+}
+
+/**
+ * @brief Partially sort a range so that the n-th element is placed at its sorted position.
+ *
+ * @param policy Execution policy (`ityr::execution`).
+ * @param first  Begin iterator.
+ * @param nth    Iterator to the element to be placed at its sorted position.
+ * @param last   End iterator.
+ *
+ * Equivalent to `ityr::nth_element(policy, first, nth, last, std::less<>{})`.
+ *
+ * @see [std::nth_element -- cppreference.com](https://en.cppreference.com/w/cpp/algorithm/nth_element)
+ * @see `ityr::partial_sort()`
+ * @see `ityr::top_k()`
+ * @see `ityr::execution::sequenced_policy`, `ityr::execution::seq`,
+ *      `ityr::execution::parallel_policy`, `ityr::execution::par`
+ */
+template <typename ExecutionPolicy, typename RandomAccessIterator>
+inline void nth_element(const ExecutionPolicy& policy,
+                        RandomAccessIterator   first,
+                        RandomAccessIterator   nth,
+                        RandomAccessIterator   last) {
+  nth_element(policy, first, nth, last, std::less<>{});
+}
+
+ITYR_TEST_CASE("[ityr::pattern::parallel_select] nth_element") {
+  ito::init();
+  ori::init();
+
+  long n = 100000;
+  ori::global_ptr<long> p = ori::malloc_coll<long>(n);
+
+  ITYR_SUBCASE("distinct values") {
+    ito::root_exec([=] {
+      for (long pos : {0L, 1L, n / 3, n / 2, n - 2, n - 1}) {
+        transform(
+            execution::parallel_policy(100),
+            count_iterator<long>(0), count_iterator<long>(n), p,
+            [=](long i) { return (i * 7919) % n; });
+
+        nth_element(execution::parallel_policy(100), p, p + pos, p + n);
+
+        ITYR_CHECK((*(p + pos)).get() == pos);
+
+        for_each(
+            execution::parallel_policy(100),
+            make_global_iterator(p      , checkout_mode::read),
+            make_global_iterator(p + pos, checkout_mode::read),
+            [=](long x) { ITYR_CHECK(x < pos); });
+
+        for_each(
+            execution::parallel_policy(100),
+            make_global_iterator(p + pos, checkout_mode::read),
+            make_global_iterator(p + n  , checkout_mode::read),
+            [=](long x) { ITYR_CHECK(x >= pos); });
+      }
+    });
+  }
+
+  ITYR_SUBCASE("duplicated values") {
+    ito::root_exec([=] {
+      long n_keys = 13;
+      for (long pos : {0L, n / 5, n / 2, n - 1}) {
+        transform(
+            execution::parallel_policy(100),
+            count_iterator<long>(0), count_iterator<long>(n), p,
+            [=](long i) { return (i * 7919) % n % n_keys; });
+
+        nth_element(execution::parallel_policy(100), p, p + pos, p + n);
+
+        // the number of elements equal to key `k` is `ceil((n - k) / n_keys)`
+        long expected = 0;
+        for (long c = (n + n_keys - 1) / n_keys; c <= pos;) {
+          expected++;
+          c += (n - expected + n_keys - 1) / n_keys;
+        }
+        long v = (*(p + pos)).get();
+        ITYR_CHECK(v == expected);
+
+        for_each(
+            execution::parallel_policy(100),
+            make_global_iterator(p      , checkout_mode::read),
+            make_global_iterator(p + pos, checkout_mode::read),
+            [=](long x) { ITYR_CHECK(x <= v); });
+
+        for_each(
+            execution::parallel_policy(100),
+            make_global_iterator(p + pos, checkout_mode::read),
+            make_global_iterator(p + n  , checkout_mode::read),
+            [=](long x) { ITYR_CHECK(x >= v); });
+      }
+    });
+  }
+
+  ori::free_coll(p);
+
+  ori::fini();
+  ito::fini();
+}
+
+/**
+ * @brief Sort the first part of a range.
+ *
+ * @param policy Execution policy (`ityr::execution`).
+ * @param first  Begin iterator.
+ * @param middle Iterator to the end of the range to be sorted.
+ * @param last   End iterator.
+ * @param comp   Binary comparison operator.
+ *
+ * This function rearranges the elements in the given range (`[first, last)`) so that the range
+ * `[first, middle)` contains the `middle - first` smallest elements in sorted order.
+ * The order of the remaining elements in `[middle, last)` is unspecified.
+ * This sort may not be stable.
+ *
+ * The smallest elements are first selected by `ityr::nth_element()`, and then only these are sorted.
+ *
+ * If global pointers are provided as iterators, they are automatically checked out with the read-write
+ * mode in the specified granularity (`ityr::execution::sequenced_policy::checkout_count` if serial,
+ * or `ityr::execution::parallel_policy::checkout_count` if parallel) without explicitly passing them
+ * as global iterators.
+ *
+ * Example:
+ * ```
+ * ityr::global_vector<int> v = {5, 2, 4, 1, 3};
+ * ityr::partial_sort(ityr::execution::par, v.begin(), v.begin() + 2, v.end());
+ * // v = {1, 2, ...}
+ * ```
+ *
+ * @see [std::partial_sort -- cppreference.com](https://en.cppreference.com/w/cpp/algorithm/partial_sort)
+ * @see `ityr::partial_sort_copy()`
+ * @see `ityr::nth_element()`
+ * @see `ityr::top_k()`
+ * @see `ityr::sort()`
+ * @see `ityr::execution::sequenced_policy`, `ityr::execution::seq`,
+ *      `ityr::execution::parallel_policy`, `ityr::execution::par`
+ */
+template <typename ExecutionPolicy, typename RandomAccessIterator, typename Compare>
+inline void partial_sort(const ExecutionPolicy& policy,
+                         RandomAccessIterator   first,
+                         RandomAccessIterator   middle,
+                         RandomAccessIterator   last,
+                         Compare                comp) {
+  if constexpr (ori::is_global_ptr_v<RandomAccessIterator>) {
+    partial_sort(
+        policy,
+        internal::convert_to_global_iterator(first , checkout_mode::read_write),
+        internal::convert_to_global_iterator(middle, checkout_mode::read_write),
+        internal::convert_to_global_iterator(last  , checkout_mode::read_write),
+        comp);
+
+  } else {
+    if (first == middle) return;
+    internal::nth_element_aux(policy, first, middle, last, comp);
+    internal::merge_sort<false>(policy, first, middle, comp);
+  }
+}
+
+/**
+ * @brief Sort the first part of a range.
+ *
+ * @param policy Execution policy (`ityr::execution`).
+ * @param first  Begin iterator.
+ * @param middle Iterator to the end of the range to be sorted.
+ * @param last   End iterator.
+ *
+ * Equivalent to `ityr::partial_sort(policy, first, middle, last, std::less<>{})`.
+ *
+ * @see [std::partial_sort -- cppreference.com](https://en.cppreference.com/w/cpp/algorithm/partial_sort)
+ * @see `ityr::partial_sort_copy()`
+ * @see `ityr::nth_element()`
+ * @see `ityr::top_k()`
+ * @see `ityr::execution::sequenced_policy`, `ityr::execution::seq`,
+ *      `ityr::execution::parallel_policy`, `ityr::execution::par`
+ */
+template <typename ExecutionPolicy, typename RandomAccessIterator>
+inline void partial_sort(const ExecutionPolicy& policy,
+                         RandomAccessIterator   first,
+                         RandomAccessIterator   middle,
+                         RandomAccessIterator   last) {
+  partial_sort(policy, first, middle, last, std::less<>{});
+}
+
+ITYR_TEST_CASE("[ityr::pattern::parallel_select] partial_sort") {
+  ito::init();
+  ori::init();
+
+  long n = 100000;
+  ori::global_ptr<long> p = ori::malloc_coll<long>(n);
+
+  ito::root_exec([=] {
+    for (long m : {0L, 1L, n / 10, n}) {
+      transform(
+          execution::parallel_policy(100),
+          count_iterator<long>(0), count_iterator<long>(n), p,
+          [=](long i) { return (i * 7919) % n; });
+
+      partial_sort(execution::parallel_policy(100), p, p + m, p + n);
+
+      for_each(
+          execution::parallel_policy(100),
+          make_global_iterator(p    , checkout_mode::read),
+          make_global_iterator(p + m, checkout_mode::read),
+          count_iterator<long>(0),
+          [=](long x, long i) { ITYR_CHECK(x == i); });
+
+      ITYR_CHECK(reduce(execution::parallel_policy(100), p, p + n) == n * (n - 1) / 2);
+    }
+  });
+
+  ori::free_coll(p);
+
+  ori::fini();
+  ito::fini();
+}
+
+/**
+ * @brief Copy the smallest elements in a range to another range in sorted order.
+ *
+ * @param policy  Execution policy (`ityr::execution`).
+ * @param first   Input begin iterator.
+ * @param last    Input end iterator.
+ * @param first_d Output begin iterator.
+ * @param last_d  Output end iterator.
+ * @param comp    Binary comparison operator.
+ *
+ * @return The end iterator of the output range (`first_d + min(last - first, last_d - first_d)`).
+ *
+ * This function copies the `k = min(last - first, last_d - first_d)` smallest elements in the input
+ * range `[first, last)` to the output range `[first_d, first_d + k)` in sorted order.
+ * The input range is not modified.
+ * This sort may not be stable.
+ *
+ * If the output range is smaller than the input range, a threshold element is first determined by
+ * repeatedly sampling and counting the input elements in parallel, and then only the elements
+ * below the threshold are copied to the output range and sorted there.
+ *
+ * If global pointers are provided as iterators, they are automatically checked out in the specified
+ * granularity (`ityr::execution::sequenced_policy::checkout_count` if serial,
+ * or `ityr::execution::parallel_policy::checkout_count` if parallel) without explicitly passing them
+ * as global iterators.
+ * Input global pointers (`first` and `last`) are automatically checked out with the read-only mode
+ * if their value type is *trivially copyable*; otherwise, they are checked out with the read-write
+ * mode, even if they are actually not modified.
+ *
+ * Example:
+ * ```
+ * ityr::global_vector<int> v1 = {5, 2, 4, 1, 3};
+ * ityr::global_vector<int> v2(3);
+ * ityr::partial_sort_copy(ityr::execution::par, v1.begin(), v1.end(), v2.begin(), v2.end());
+ * // v2 = {1, 2, 3}
+ * ```
+ *
+ * @see [std::partial_sort_copy -- cppreference.com](https://en.cppreference.com/w/cpp/algorithm/partial_sort_copy)
+ * @see `ityr::partial_sort()`
+ * @see `ityr::execution::sequenced_policy`, `ityr::execution::seq`,
+ *      `ityr::execution::parallel_policy`, `ityr::execution::par`
+ */
+template <typename ExecutionPolicy, typename RandomAccessIterator, typename RandomAccessIteratorD,
+          typename Compare>
+inline RandomAccessIteratorD partial_sort_copy(const ExecutionPolicy& policy,
+                                               RandomAccessIterator   first,
+                                               RandomAccessIterator   last,
+                                               RandomAccessIteratorD  first_d,
+                                               RandomAccessIteratorD  last_d,
+                                               Compare                comp) {
+  std::size_t n = std::distance(first, last);
+  std::size_t k = std::min(n, std::size_t(std::distance(first_d, last_d)));
+
+  if (k == 0) return first_d;
+
+  if (k == n) {
+    copy(policy, first, last, first_d);
+
+  } else {
+    using value_type  = typename std::iterator_traits<RandomAccessIterator>::value_type;
+    using value_type_d = typename std::iterator_traits<RandomAccessIteratorD>::value_type;
+    internal::partial_sort_copy_aux(
+        policy,
+        internal::convert_to_global_iterator(first  , internal::src_checkout_mode_t<value_type>{}),
+        internal::convert_to_global_iterator(last   , internal::src_checkout_mode_t<value_type>{}),
+        internal::convert_to_global_iterator(first_d, internal::dest_checkout_mode_t<value_type_d>{}),
+        k, comp);
+  }
+
+  sort(policy, first_d, std::next(first_d, k), comp);
+
+  return std::next(first_d, k);
+}
+
+/**
+ * @brief Copy the smallest elements in a range to another range in sorted order.
+ *
+ * @param policy  Execution policy (`ityr::execution`).
+ * @param first   Input begin iterator.
+ * @param last    Input end iterator.
+ * @param first_d Output begin iterator.
+ * @param last_d  Output end iterator.
+ *
+ * @return The end iterator of the output range (`first_d + min(last - first, last_d - first_d)`).
+ *
+ * Equivalent to `ityr::partial_sort_copy(policy, first, last, first_d, last_d, std::less<>{})`.
+ *
+ * @see [std::partial_sort_copy -- cppreference.com](https://en.cppreference.com/w/cpp/algorithm/partial_sort_copy)
+ * @see `ityr::partial_sort()`
+ * @see `ityr::execution::sequenced_policy`, `ityr::execution::seq`,
+ *      `ityr::execution::parallel_policy`, `ityr::execution::par`
+ */
+template <typename ExecutionPolicy, typename RandomAccessIterator, typename RandomAccessIteratorD>
+inline RandomAccessIteratorD partial_sort_copy(const ExecutionPolicy& policy,
+                                               RandomAccessIterator   first,
+                                               RandomAccessIterator   last,
+                                               RandomAccessIteratorD  first_d,
+                                               RandomAccessIteratorD  last_d) {
+  return partial_sort_copy(policy, first, last, first_d, last_d, std::less<>{});
+}
+
+ITYR_TEST_CASE("[ityr::pattern::parallel_select] partial_sort_copy") {
+  ito::init();
+  ori::init();
+
+  long n = 100000;
+  ori::global_ptr<long> p1 = ori::malloc_coll<long>(n);
+  ori::global_ptr<long> p2 = ori::malloc_coll<long>(n);
+
+  ITYR_SUBCASE("distinct values") {
+    ito::root_exec([=] {
+      transform(
+          execution::parallel_policy(100),
+          count_iterator<long>(0), count_iterator<long>(n), p1,
+          [=](long i) { return (i * 7919) % n; });
+
+      for (long m : {1L, n / 10, n - 1, n}) {
+        auto ret = partial_sort_copy(execution::parallel_policy(100), p1, p1 + n, p2, p2 + m);
+        ITYR_CHECK(ret == p2 + m);
+
+        for_each(
+            execution::parallel_policy(100),
+            make_global_iterator(p2    , checkout_mode::read),
+            make_global_iterator(p2 + m, checkout_mode::read),
+            count_iterator<long>(0),
+            [=](long x, long i) { ITYR_CHECK(x == i); });
+      }
+
+      // input should not be modified
+      for_each(
+          execution::parallel_policy(100),
+          make_global_iterator(p1    , checkout_mode::read),
+          make_global_iterator(p1 + n, checkout_mode::read),
+          count_iterator<long>(0),
+          [=](long x, long i) { ITYR_CHECK(x == (i * 7919) % n); });
+    });
+  }
+
+  ITYR_SUBCASE("duplicated values") {
+    ito::root_exec([=] {
+      long n_keys = 13;
+      transform(
+          execution::parallel_policy(100),
+          count_iterator<long>(0), count_iterator<long>(n), p1,
+          [=](long i) { return (i * 7919) % n % n_keys; });
+
+      long m = n / 3;
+      partial_sort_copy(execution::parallel_policy(100), p1, p1 + n, p2, p2 + m);
+
+      ITYR_CHECK(is_sorted(execution::parallel_policy(100), p2, p2 + m));
+
+      // the number of elements equal to key `k` is `ceil((n - k) / n_keys)`
+      long expected_sum = 0;
+      for (long key = 0, c = 0; c < m; key++) {
+        long c_key = std::min((n - key + n_keys - 1) / n_keys, m - c);
+        expected_sum += key * c_key;
+        c += c_key;
+      }
+      ITYR_CHECK(reduce(execution::parallel_policy(100), p2, p2 + m) == expected_sum);
+    });
+  }
+
+  ori::free_coll(p1);
+  ori::free_coll(p2);
+
+  ori::fini();
+  ito::fini();
+}
+
+/**
+ * @brief Select the k largest elements in a range in descending order.
+ *
+ * @param policy Execution policy (`ityr::execution`).
+ * @param first  Begin iterator.
+ * @param last   End iterator.
+ * @param k      The number of elements to be selected.
+ * @param comp   Binary comparison operator. Returns true if the first argument is less than
+ *               the second argument.
+ *
+ * @return Iterator to the end of the selected elements (`first + min(k, last - first)`).
+ *
+ * This function rearranges the elements in the given range (`[first, last)`) so that the range
+ * `[first, first + k)` contains the `k` largest elements in descending order.
+ * The order of the remaining elements is unspecified.
+ *
+ * Equivalent to `ityr::partial_sort()` with the reversed comparison operator.
+ *
+ * If global pointers are provided as iterators, they are automatically checked out with the read-write
+ * mode in the specified granularity (`ityr::execution::sequenced_policy::checkout_count` if serial,
+ * or `ityr::execution::parallel_policy::checkout_count` if parallel) without explicitly passing them
+ * as global iterators.
+ *
+ * Example:
+ * ```
+ * ityr::global_vector<int> v = {5, 2, 4, 1, 3};
+ * auto it = ityr::top_k(ityr::execution::par, v.begin(), v.end(), 2,
+ *                       [](int x, int y) { return x < y; });
+ * // v = {5, 4, ...}
+ * //            ^
+ * //            it
+ * ```
+ *
+ * @see `ityr::partial_sort()`
+ * @see `ityr::nth_element()`
+ * @see `ityr::execution::sequenced_policy`, `ityr::execution::seq`,
+ *      `ityr::execution::parallel_policy`, `ityr::execution::par`
+ */
+template <typename ExecutionPolicy, typename RandomAccessIterator, typename Compare>
+inline RandomAccessIterator top_k(const ExecutionPolicy& policy,
+                                  RandomAccessIterator   first,
+                                  RandomAccessIterator   last,
+                                  std::size_t            k,
+                                  Compare                comp) {
+  auto middle = std::next(first, std::min(k, std::size_t(std::distance(first, last))));
+  partial_sort(policy, first, middle, last,
+               [=](const auto& x, const auto& y) { return comp(y, x); });
+  return middle;
+}
+
+/**
+ * @brief Select the k largest elements in a range in descending order.
+ *
+ * @param policy Execution policy (`ityr::execution`).
+ * @param first  Begin iterator.
+ * @param last   End iterator.
+ * @param k      The number of elements to be selected.
+ *
+ * @return Iterator to the end of the selected elements (`first + min(k, last - first)`).
+ *
+ * Equivalent to `ityr::top_k(policy, first, last, k, std::less<>{})`.
+ *
+ * @see `ityr::partial_sort()`
+ * @see `ityr::nth_element()`
+ * @see `ityr::execution::sequenced_policy`, `ityr::execution::seq`,
+ *      `ityr::execution::parallel_policy`, `ityr::execution::par`
+ */
+template <typename ExecutionPolicy, typename RandomAccessIterator>
+inline RandomAccessIterator top_k(const ExecutionPolicy& policy,
+                                  RandomAccessIterator   first,
+                                  RandomAccessIterator   last,
+                                  std::size_t            k) {
+  return top_k(policy, first, last, k, std::less<>{});
+}
+
+ITYR_TEST_CASE("[ityr::pattern::parallel_select] top_k") {
+  ito::init();
+  ori::init();
+
+  // std::pair is not trivially copyable
+  struct item {
+    long key;
+    long val;
+  };
+
+  long n = 100000;
+  ori::global_ptr<item> p = ori::malloc_coll<item>(n);
+
+  ito::root_exec([=] {
+    transform(
+        execution::parallel_policy(100),
+        count_iterator<long>(0), count_iterator<long>(n), p,
+        [=](long i) { return item{(i * 7919) % n, i}; });
+
+    long k = 1000;
+    auto it = top_k(execution::parallel_policy(100), p, p + n, k,
+                    [](const item& a, const item& b) { return a.key < b.key; });
+    ITYR_CHECK(it == p + k);
+
+    for_each(
+        execution::parallel_policy(100),
+        make_global_iterator(p    , checkout_mode::read),
+        make_global_iterator(p + k, checkout_mode::read),
+        count_iterator<long>(0),
+        [=](const item& x, long i) {
+          ITYR_CHECK(x.key == n - i - 1);
+          ITYR_CHECK((x.val * 7919) % n == x.key);
+        });
+
+    auto comp_key = [](const item& a, const item& b) { return a.key < b.key; };
+    ITYR_CHECK(top_k(execution::parallel_policy(100), p, p + 10, 100, comp_key) == p + 10);
+  });
+
+  ori::free_coll(p);
+
+  ori::fini();
+  ito::fini();
+}
+
+}
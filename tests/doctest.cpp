@@ -3,6 +3,7 @@
 #include "doctest/doctest.h"
 
 #include "ityr/ityr.hpp"
+#include "ityr/autotune.hpp"
 
 int main(int argc, char** argv) {
   MPI_Init(&argc, &argv);